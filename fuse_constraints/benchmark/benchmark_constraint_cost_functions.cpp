@@ -0,0 +1,452 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2020, Clearpath Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <benchmark/benchmark.h>
+#include <ceres/cost_function.h>
+#include <Eigen/Geometry>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fuse_constraints/absolute_constraint.hpp>
+#include <fuse_constraints/absolute_orientation_3d_stamped_constraint.hpp>
+#include <fuse_constraints/absolute_orientation_3d_stamped_euler_constraint.hpp>
+#include <fuse_constraints/absolute_pose_2d_stamped_constraint.hpp>
+#include <fuse_constraints/absolute_pose_3d_stamped_constraint.hpp>
+#include <fuse_constraints/marginal_constraint.hpp>
+#include <fuse_constraints/relative_constraint.hpp>
+#include <fuse_constraints/relative_orientation_3d_stamped_constraint.hpp>
+#include <fuse_constraints/relative_pose_2d_stamped_constraint.hpp>
+#include <fuse_constraints/relative_pose_3d_stamped_constraint.hpp>
+#include <fuse_core/constraint.hpp>
+#include <fuse_core/eigen.hpp>
+#include <fuse_core/variable.hpp>
+#include <fuse_variables/acceleration_angular_2d_stamped.hpp>
+#include <fuse_variables/acceleration_linear_2d_stamped.hpp>
+#include <fuse_variables/imu_bias_2d_stamped.hpp>
+#include <fuse_variables/orientation_2d_stamped.hpp>
+#include <fuse_variables/orientation_3d_stamped.hpp>
+#include <fuse_variables/position_2d_stamped.hpp>
+#include <fuse_variables/position_3d_stamped.hpp>
+#include <fuse_variables/velocity_angular_2d_stamped.hpp>
+#include <fuse_variables/velocity_linear_2d_stamped.hpp>
+#include <rclcpp/time.hpp>
+
+#include <boost/iterator/indirect_iterator.hpp>
+
+/**
+ * @brief The cost function of a constraint, with the buffers to evaluate it at the values of the
+ *        constraint variables
+ */
+class CostFunctionEvaluation
+{
+public:
+  CostFunctionEvaluation(
+    const fuse_core::Constraint & constraint,
+    const std::vector<fuse_core::Variable::SharedPtr> & variables)
+  : cost_function_(constraint.costFunction()),
+    residuals_(cost_function_->num_residuals())
+  {
+    const auto & block_sizes = cost_function_->parameter_block_sizes();
+    for (size_t i = 0; i < variables.size(); ++i) {
+      parameters_.push_back(variables[i]->data());
+      jacobian_blocks_.emplace_back(residuals_.size() * block_sizes[i]);
+      jacobians_.push_back(jacobian_blocks_.back().data());
+    }
+  }
+
+  void evaluate(const bool compute_jacobians)
+  {
+    cost_function_->Evaluate(
+      parameters_.data(), residuals_.data(),
+      compute_jacobians ? jacobians_.data() : nullptr);
+    benchmark::DoNotOptimize(residuals_.data());
+    benchmark::ClobberMemory();
+  }
+
+private:
+  std::unique_ptr<ceres::CostFunction> cost_function_;
+  std::vector<const double *> parameters_;
+  std::vector<double> residuals_;
+  std::vector<std::vector<double>> jacobian_blocks_;
+  std::vector<double *> jacobians_;
+};
+
+/**
+ * @brief Register the creation and evaluation benchmarks of a constraint cost function
+ *
+ * @param[in] name       The benchmark name prefix
+ * @param[in] constraint The constraint
+ * @param[in] variables  The constraint variables, in the same order as the constraint uses them
+ */
+void registerConstraintBenchmarks(
+  const std::string & name,
+  const fuse_core::Constraint::SharedPtr & constraint,
+  const std::vector<fuse_core::Variable::SharedPtr> & variables)
+{
+  benchmark::RegisterBenchmark(
+    (name + "/Create").c_str(),
+    [constraint](benchmark::State & state) {
+      for (auto _ : state) {
+        std::unique_ptr<ceres::CostFunction> cost_function(constraint->costFunction());
+        benchmark::DoNotOptimize(cost_function.get());
+      }
+    });
+
+  benchmark::RegisterBenchmark(
+    (name + "/Evaluate").c_str(),
+    [constraint, variables](benchmark::State & state) {
+      CostFunctionEvaluation evaluation(*constraint, variables);
+      for (auto _ : state) {
+        evaluation.evaluate(false);
+      }
+    });
+
+  benchmark::RegisterBenchmark(
+    (name + "/EvaluateWithJacobians").c_str(),
+    [constraint, variables](benchmark::State & state) {
+      CostFunctionEvaluation evaluation(*constraint, variables);
+      for (auto _ : state) {
+        evaluation.evaluate(true);
+      }
+    });
+}
+
+fuse_variables::Position2DStamped::SharedPtr makePosition2D(const int seconds)
+{
+  auto position = fuse_variables::Position2DStamped::make_shared(rclcpp::Time(seconds, 0));
+  position->x() = 1.0 + seconds;
+  position->y() = 2.0 - seconds;
+  return position;
+}
+
+fuse_variables::Orientation2DStamped::SharedPtr makeOrientation2D(const int seconds)
+{
+  auto orientation = fuse_variables::Orientation2DStamped::make_shared(rclcpp::Time(seconds, 0));
+  orientation->yaw() = 0.3 + 0.1 * seconds;
+  return orientation;
+}
+
+fuse_variables::Position3DStamped::SharedPtr makePosition3D(const int seconds)
+{
+  auto position = fuse_variables::Position3DStamped::make_shared(rclcpp::Time(seconds, 0));
+  position->x() = 1.0 + seconds;
+  position->y() = 2.0 - seconds;
+  position->z() = 0.5 * seconds;
+  return position;
+}
+
+fuse_variables::Orientation3DStamped::SharedPtr makeOrientation3D(const int seconds)
+{
+  auto orientation = fuse_variables::Orientation3DStamped::make_shared(rclcpp::Time(seconds, 0));
+  const Eigen::Quaterniond q = Eigen::AngleAxisd(0.3 + 0.1 * seconds, Eigen::Vector3d::UnitZ()) *
+    Eigen::AngleAxisd(0.2, Eigen::Vector3d::UnitY()) *
+    Eigen::AngleAxisd(-0.1, Eigen::Vector3d::UnitX());
+  orientation->w() = q.w();
+  orientation->x() = q.x();
+  orientation->y() = q.y();
+  orientation->z() = q.z();
+  return orientation;
+}
+
+/**
+ * @brief A covariance matrix with correlated dimensions
+ */
+fuse_core::MatrixXd makeCovariance(const int size)
+{
+  fuse_core::MatrixXd covariance = 0.01 * fuse_core::MatrixXd::Ones(size, size);
+  covariance.diagonal().array() += 0.1;
+  return covariance;
+}
+
+/**
+ * @brief A fixed-size stamped variable with distinct values in every dimension
+ */
+template<class Variable>
+typename Variable::SharedPtr makeVariable(const int seconds)
+{
+  auto variable = Variable::make_shared(rclcpp::Time(seconds, 0));
+  for (size_t i = 0; i < Variable::SIZE; ++i) {
+    variable->data()[i] = 0.1 * (i + 1) + 0.2 * seconds;
+  }
+  return variable;
+}
+
+/**
+ * @brief Register the benchmarks of a generic AbsoluteConstraint on all dimensions of a variable
+ */
+template<class Variable>
+void registerGenericAbsoluteConstraintBenchmarks(const std::string & name)
+{
+  auto variable = makeVariable<Variable>(1);
+  registerConstraintBenchmarks(
+    name,
+    fuse_constraints::AbsoluteConstraint<Variable>::make_shared(
+      "benchmark", *variable, fuse_core::VectorXd::Constant(Variable::SIZE, 0.5),
+      makeCovariance(Variable::SIZE)),
+    {variable});
+}
+
+/**
+ * @brief Register the benchmarks of a generic RelativeConstraint on all dimensions of a variable
+ */
+template<class Variable>
+void registerGenericRelativeConstraintBenchmarks(const std::string & name)
+{
+  auto variable1 = makeVariable<Variable>(1);
+  auto variable2 = makeVariable<Variable>(2);
+  registerConstraintBenchmarks(
+    name,
+    fuse_constraints::RelativeConstraint<Variable>::make_shared(
+      "benchmark", *variable1, *variable2, fuse_core::VectorXd::Constant(Variable::SIZE, 0.1),
+      makeCovariance(Variable::SIZE)),
+    {variable1, variable2});
+}
+
+void registerAbsoluteConstraintBenchmarks()
+{
+  registerGenericAbsoluteConstraintBenchmarks<fuse_variables::AccelerationAngular2DStamped>(
+    "AbsoluteAccelerationAngular2DStampedConstraint");
+  registerGenericAbsoluteConstraintBenchmarks<fuse_variables::AccelerationLinear2DStamped>(
+    "AbsoluteAccelerationLinear2DStampedConstraint");
+  registerGenericAbsoluteConstraintBenchmarks<fuse_variables::ImuBias2DStamped>(
+    "AbsoluteImuBias2DStampedConstraint");
+  registerGenericAbsoluteConstraintBenchmarks<fuse_variables::Orientation2DStamped>(
+    "AbsoluteOrientation2DStampedConstraint");
+  registerGenericAbsoluteConstraintBenchmarks<fuse_variables::VelocityAngular2DStamped>(
+    "AbsoluteVelocityAngular2DStampedConstraint");
+  registerGenericAbsoluteConstraintBenchmarks<fuse_variables::VelocityLinear2DStamped>(
+    "AbsoluteVelocityLinear2DStampedConstraint");
+
+  {
+    auto position = makePosition2D(1);
+    registerConstraintBenchmarks(
+      "AbsolutePosition2DStampedConstraint",
+      fuse_constraints::AbsolutePosition2DStampedConstraint::make_shared(
+        "benchmark", *position, fuse_core::Vector2d(1.1, 1.9), makeCovariance(2)),
+      {position});
+  }
+
+  {
+    auto position = makePosition3D(1);
+    registerConstraintBenchmarks(
+      "AbsolutePosition3DStampedConstraint",
+      fuse_constraints::AbsolutePosition3DStampedConstraint::make_shared(
+        "benchmark", *position, fuse_core::Vector3d(1.1, 1.9, 0.6), makeCovariance(3)),
+      {position});
+    registerConstraintBenchmarks(
+      "AbsolutePosition3DStampedConstraint/Partial",
+      fuse_constraints::AbsolutePosition3DStampedConstraint::make_shared(
+        "benchmark", *position, fuse_core::Vector2d(1.1, 0.6), makeCovariance(2),
+        std::vector<size_t>{fuse_variables::Position3DStamped::X,
+          fuse_variables::Position3DStamped::Z}),
+      {position});
+  }
+
+  {
+    auto position = makePosition2D(1);
+    auto orientation = makeOrientation2D(1);
+    registerConstraintBenchmarks(
+      "AbsolutePose2DStampedConstraint",
+      fuse_constraints::AbsolutePose2DStampedConstraint::make_shared(
+        "benchmark", *position, *orientation, fuse_core::Vector3d(1.1, 1.9, 0.35),
+        makeCovariance(3)),
+      {position, orientation});
+    registerConstraintBenchmarks(
+      "AbsolutePose2DStampedConstraint/Partial",
+      fuse_constraints::AbsolutePose2DStampedConstraint::make_shared(
+        "benchmark", *position, *orientation, fuse_core::Vector2d(1.1, 0.35), makeCovariance(2),
+        std::vector<size_t>{fuse_variables::Position2DStamped::X},
+        std::vector<size_t>{fuse_variables::Orientation2DStamped::YAW}),
+      {position, orientation});
+  }
+
+  {
+    auto position = makePosition3D(1);
+    auto orientation = makeOrientation3D(1);
+    fuse_core::Vector7d mean;
+    mean << 1.1, 1.9, 0.6, orientation->w(), orientation->x(), orientation->y(), orientation->z();
+    registerConstraintBenchmarks(
+      "AbsolutePose3DStampedConstraint",
+      fuse_constraints::AbsolutePose3DStampedConstraint::make_shared(
+        "benchmark", *position, *orientation, mean, fuse_core::Matrix6d(makeCovariance(6))),
+      {position, orientation});
+  }
+
+  {
+    auto orientation = makeOrientation3D(1);
+    registerConstraintBenchmarks(
+      "AbsoluteOrientation3DStampedConstraint",
+      fuse_constraints::AbsoluteOrientation3DStampedConstraint::make_shared(
+        "benchmark", *orientation, fuse_core::Vector4d(makeOrientation3D(2)->data()),
+        fuse_core::Matrix3d(makeCovariance(3))),
+      {orientation});
+  }
+
+  {
+    using Euler = fuse_constraints::AbsoluteOrientation3DStampedEulerConstraint::Euler;
+    auto orientation = makeOrientation3D(1);
+    registerConstraintBenchmarks(
+      "AbsoluteOrientation3DStampedEulerConstraint/RollPitchYaw",
+      fuse_constraints::AbsoluteOrientation3DStampedEulerConstraint::make_shared(
+        "benchmark", *orientation, fuse_core::Vector3d(-0.1, 0.2, 0.4), makeCovariance(3),
+        std::vector<Euler>{Euler::ROLL, Euler::PITCH, Euler::YAW}),
+      {orientation});
+    registerConstraintBenchmarks(
+      "AbsoluteOrientation3DStampedEulerConstraint/Yaw",
+      fuse_constraints::AbsoluteOrientation3DStampedEulerConstraint::make_shared(
+        "benchmark", *orientation, fuse_core::Vector1d(0.4), makeCovariance(1),
+        std::vector<Euler>{Euler::YAW}),
+      {orientation});
+  }
+}
+
+void registerRelativeConstraintBenchmarks()
+{
+  registerGenericRelativeConstraintBenchmarks<fuse_variables::AccelerationAngular2DStamped>(
+    "RelativeAccelerationAngular2DStampedConstraint");
+  registerGenericRelativeConstraintBenchmarks<fuse_variables::AccelerationLinear2DStamped>(
+    "RelativeAccelerationLinear2DStampedConstraint");
+  registerGenericRelativeConstraintBenchmarks<fuse_variables::Orientation2DStamped>(
+    "RelativeOrientation2DStampedConstraint");
+  registerGenericRelativeConstraintBenchmarks<fuse_variables::Position3DStamped>(
+    "RelativePosition3DStampedConstraint");
+  registerGenericRelativeConstraintBenchmarks<fuse_variables::VelocityAngular2DStamped>(
+    "RelativeVelocityAngular2DStampedConstraint");
+  registerGenericRelativeConstraintBenchmarks<fuse_variables::VelocityLinear2DStamped>(
+    "RelativeVelocityLinear2DStampedConstraint");
+
+  {
+    auto position1 = makePosition2D(1);
+    auto position2 = makePosition2D(2);
+    registerConstraintBenchmarks(
+      "RelativePosition2DStampedConstraint",
+      fuse_constraints::RelativePosition2DStampedConstraint::make_shared(
+        "benchmark", *position1, *position2, fuse_core::Vector2d(1.1, -0.9), makeCovariance(2)),
+      {position1, position2});
+  }
+
+  {
+    auto position1 = makePosition2D(1);
+    auto orientation1 = makeOrientation2D(1);
+    auto position2 = makePosition2D(2);
+    auto orientation2 = makeOrientation2D(2);
+    registerConstraintBenchmarks(
+      "RelativePose2DStampedConstraint",
+      fuse_constraints::RelativePose2DStampedConstraint::make_shared(
+        "benchmark", *position1, *orientation1, *position2, *orientation2,
+        fuse_core::Vector3d(1.1, -0.9, 0.1), makeCovariance(3)),
+      {position1, orientation1, position2, orientation2});
+    registerConstraintBenchmarks(
+      "RelativePose2DStampedConstraint/Partial",
+      fuse_constraints::RelativePose2DStampedConstraint::make_shared(
+        "benchmark", *position1, *orientation1, *position2, *orientation2,
+        fuse_core::Vector2d(1.1, 0.1), makeCovariance(2),
+        std::vector<size_t>{fuse_variables::Position2DStamped::X},
+        std::vector<size_t>{fuse_variables::Orientation2DStamped::YAW}),
+      {position1, orientation1, position2, orientation2});
+  }
+
+  {
+    auto position1 = makePosition3D(1);
+    auto orientation1 = makeOrientation3D(1);
+    auto position2 = makePosition3D(2);
+    auto orientation2 = makeOrientation3D(2);
+    const Eigen::Quaterniond q(Eigen::AngleAxisd(0.1, Eigen::Vector3d::UnitZ()));
+    fuse_core::Vector7d delta;
+    delta << 1.1, -0.9, 0.4, q.w(), q.x(), q.y(), q.z();
+    registerConstraintBenchmarks(
+      "RelativePose3DStampedConstraint",
+      fuse_constraints::RelativePose3DStampedConstraint::make_shared(
+        "benchmark", *position1, *orientation1, *position2, *orientation2, delta,
+        fuse_core::Matrix6d(makeCovariance(6))),
+      {position1, orientation1, position2, orientation2});
+  }
+
+  {
+    auto orientation1 = makeOrientation3D(1);
+    auto orientation2 = makeOrientation3D(2);
+    registerConstraintBenchmarks(
+      "RelativeOrientation3DStampedConstraint",
+      fuse_constraints::RelativeOrientation3DStampedConstraint::make_shared(
+        "benchmark", *orientation1, *orientation2,
+        Eigen::Quaterniond(Eigen::AngleAxisd(0.1, Eigen::Vector3d::UnitZ())),
+        fuse_core::Matrix3d(makeCovariance(3))),
+      {orientation1, orientation2});
+  }
+}
+
+void registerMarginalConstraintBenchmarks()
+{
+  // Marginal constraints on a chain of 3D poses, as left behind by marginalizing a 3D pose graph
+  for (const int num_poses : {1, 2, 4, 8}) {
+    std::vector<fuse_core::Variable::SharedPtr> variables;
+    for (int i = 0; i < num_poses; ++i) {
+      variables.push_back(makePosition3D(i));
+      variables.push_back(makeOrientation3D(i));
+    }
+
+    const auto num_residuals = static_cast<Eigen::Index>(6 * num_poses);
+    std::vector<fuse_core::MatrixXd> A;
+    for (const auto & variable : variables) {
+      A.push_back(fuse_core::MatrixXd::Random(num_residuals, variable->localSize()));
+    }
+    const fuse_core::VectorXd b = fuse_core::VectorXd::Random(num_residuals);
+
+    auto constraint = fuse_constraints::MarginalConstraint::make_shared(
+      "benchmark",
+      boost::make_indirect_iterator(variables.begin()),
+      boost::make_indirect_iterator(variables.end()),
+      A.begin(),
+      A.end(),
+      b);
+
+    registerConstraintBenchmarks(
+      "MarginalConstraint/Pose3D/" + std::to_string(num_poses), constraint, variables);
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  registerAbsoluteConstraintBenchmarks();
+  registerRelativeConstraintBenchmarks();
+  registerMarginalConstraintBenchmarks();
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
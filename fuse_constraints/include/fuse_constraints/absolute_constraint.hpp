@@ -47,6 +47,7 @@
 #include <fuse_core/uuid.hpp>
 #include <fuse_variables/acceleration_angular_2d_stamped.hpp>
 #include <fuse_variables/acceleration_linear_2d_stamped.hpp>
+#include <fuse_variables/imu_bias_2d_stamped.hpp>
 #include <fuse_variables/orientation_2d_stamped.hpp>
 #include <fuse_variables/position_2d_stamped.hpp>
 #include <fuse_variables/position_3d_stamped.hpp>
@@ -56,6 +57,7 @@
 #include <boost/serialization/access.hpp>
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/export.hpp>
+#include <boost/serialization/version.hpp>
 
 
 namespace fuse_constraints
@@ -150,6 +152,23 @@ public:
    */
   fuse_core::MatrixXd covariance() const;
 
+  /**
+   * @brief Read-only access to the maximum variable change before the prior Jacobians are
+   *        recomputed. Negative (the default) when the Jacobians are not cached.
+   */
+  double jacobianThreshold() const {return jacobian_threshold_;}
+
+  /**
+   * @brief Wrap the prior cost function in a FirstEstimateCostFunction with the given threshold
+   *
+   * @param[in] jacobian_threshold The maximum variable change before the Jacobians are recomputed.
+   *                               A negative value disables the cache.
+   */
+  void jacobianThreshold(const double jacobian_threshold)
+  {
+    jacobian_threshold_ = jacobian_threshold;
+  }
+
   /**
    * @brief Print a human-readable description of the constraint to the provided stream.
    *
@@ -172,6 +191,7 @@ public:
 protected:
   fuse_core::VectorXd mean_;  //!< The measured/prior mean vector for this variable
   fuse_core::MatrixXd sqrt_information_;  //!< The square root information matrix
+  double jacobian_threshold_{-1.0};  //!< The Jacobian cache threshold, negative when disabled
 
 private:
   // Allow Boost Serialization access to private methods
@@ -182,14 +202,18 @@ private:
    *        archive
    *
    * @param[in/out] archive - The archive object that holds the serialized class members
-   * @param[in] version - The version of the archive being read/written. Generally unused.
+   * @param[in] version - The version of the archive being read/written. Version 1 added the
+   *                      Jacobian threshold.
    */
   template<class Archive>
-  void serialize(Archive & archive, const unsigned int /* version */)
+  void serialize(Archive & archive, const unsigned int version)
   {
     archive & boost::serialization::base_object<fuse_core::Constraint>(*this);
     archive & mean_;
     archive & sqrt_information_;
+    if (version >= 1) {
+      archive & jacobian_threshold_;
+    }
   }
 };
 
@@ -198,6 +222,7 @@ using AbsoluteAccelerationAngular2DStampedConstraint =
   AbsoluteConstraint<fuse_variables::AccelerationAngular2DStamped>;
 using AbsoluteAccelerationLinear2DStampedConstraint =
   AbsoluteConstraint<fuse_variables::AccelerationLinear2DStamped>;
+using AbsoluteImuBias2DStampedConstraint = AbsoluteConstraint<fuse_variables::ImuBias2DStamped>;
 using AbsoluteOrientation2DStampedConstraint =
   AbsoluteConstraint<fuse_variables::Orientation2DStamped>;
 using AbsolutePosition2DStampedConstraint = AbsoluteConstraint<fuse_variables::Position2DStamped>;
@@ -213,10 +238,20 @@ using AbsoluteVelocityLinear2DStampedConstraint =
 
 BOOST_CLASS_EXPORT_KEY(fuse_constraints::AbsoluteAccelerationAngular2DStampedConstraint);
 BOOST_CLASS_EXPORT_KEY(fuse_constraints::AbsoluteAccelerationLinear2DStampedConstraint);
+BOOST_CLASS_EXPORT_KEY(fuse_constraints::AbsoluteImuBias2DStampedConstraint);
 BOOST_CLASS_EXPORT_KEY(fuse_constraints::AbsoluteOrientation2DStampedConstraint);
 BOOST_CLASS_EXPORT_KEY(fuse_constraints::AbsolutePosition2DStampedConstraint);
 BOOST_CLASS_EXPORT_KEY(fuse_constraints::AbsolutePosition3DStampedConstraint);
 BOOST_CLASS_EXPORT_KEY(fuse_constraints::AbsoluteVelocityAngular2DStampedConstraint);
 BOOST_CLASS_EXPORT_KEY(fuse_constraints::AbsoluteVelocityLinear2DStampedConstraint);
 
+BOOST_CLASS_VERSION(fuse_constraints::AbsoluteAccelerationAngular2DStampedConstraint, 1);
+BOOST_CLASS_VERSION(fuse_constraints::AbsoluteAccelerationLinear2DStampedConstraint, 1);
+BOOST_CLASS_VERSION(fuse_constraints::AbsoluteImuBias2DStampedConstraint, 1);
+BOOST_CLASS_VERSION(fuse_constraints::AbsoluteOrientation2DStampedConstraint, 1);
+BOOST_CLASS_VERSION(fuse_constraints::AbsolutePosition2DStampedConstraint, 1);
+BOOST_CLASS_VERSION(fuse_constraints::AbsolutePosition3DStampedConstraint, 1);
+BOOST_CLASS_VERSION(fuse_constraints::AbsoluteVelocityAngular2DStampedConstraint, 1);
+BOOST_CLASS_VERSION(fuse_constraints::AbsoluteVelocityLinear2DStampedConstraint, 1);
+
 #endif  // FUSE_CONSTRAINTS__ABSOLUTE_CONSTRAINT_HPP_
@@ -40,6 +40,8 @@
 #include <string>
 #include <vector>
 
+#include <fuse_constraints/first_estimate_cost_function.hpp>
+#include <fuse_constraints/fixed_size_normal_prior.hpp>
 #include <fuse_constraints/normal_prior_orientation_2d.hpp>
 
 
@@ -116,6 +118,9 @@ void AbsoluteConstraint<Variable>::print(std::ostream & stream) const
          << "  variable: " << variables().at(0) << "\n"
          << "  mean: " << mean().transpose() << "\n"
          << "  sqrt_info: " << sqrtInformation() << "\n";
+  if (jacobianThreshold() >= 0.0) {
+    stream << "  jacobian_threshold: " << jacobianThreshold() << "\n";
+  }
 
   if (loss()) {
     stream << "  loss: ";
@@ -126,8 +131,12 @@ void AbsoluteConstraint<Variable>::print(std::ostream & stream) const
 template<class Variable>
 ceres::CostFunction * AbsoluteConstraint<Variable>::costFunction() const
 {
-  // Ceres ships with a "prior" cost function. Just use that here.
-  return new ceres::NormalPrior(sqrt_information_, mean_);
+  // Use a compile-time sized equivalent of the Ceres "prior" cost function when possible
+  auto cost_function = createNormalPrior<Variable::SIZE>(sqrt_information_, mean_);
+  if (jacobian_threshold_ >= 0.0) {
+    return new FirstEstimateCostFunction(cost_function, jacobian_threshold_);
+  }
+  return cost_function;
 }
 
 // Specialization for Orientation2D
@@ -139,7 +148,11 @@ inline ceres::CostFunction * AbsoluteConstraint<
 >::costFunction()
 const
 {
-  return new NormalPriorOrientation2D(sqrt_information_(0, 0), mean_(0));
+  auto cost_function = new NormalPriorOrientation2D(sqrt_information_(0, 0), mean_(0));
+  if (jacobian_threshold_ >= 0.0) {
+    return new FirstEstimateCostFunction(cost_function, jacobian_threshold_);
+  }
+  return cost_function;
 }
 
 // Specialize the type() method to return the name that is registered with the plugins
@@ -155,6 +168,12 @@ inline std::string AbsoluteConstraint<fuse_variables::AccelerationLinear2DStampe
   return "fuse_constraints::AbsoluteAccelerationLinear2DStampedConstraint";
 }
 
+template<>
+inline std::string AbsoluteConstraint<fuse_variables::ImuBias2DStamped>::type() const
+{
+  return "fuse_constraints::AbsoluteImuBias2DStampedConstraint";
+}
+
 template<>
 inline std::string AbsoluteConstraint<fuse_variables::Orientation2DStamped>::type() const
 {
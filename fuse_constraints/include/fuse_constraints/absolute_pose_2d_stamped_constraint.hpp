@@ -51,6 +51,7 @@
 #include <boost/serialization/access.hpp>
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/export.hpp>
+#include <boost/serialization/version.hpp>
 
 
 namespace fuse_constraints
@@ -142,6 +143,23 @@ public:
    */
   fuse_core::Matrix3d covariance() const;
 
+  /**
+   * @brief Read-only access to the maximum variable change before the prior Jacobians are
+   *        recomputed. Negative (the default) when the Jacobians are not cached.
+   */
+  double jacobianThreshold() const {return jacobian_threshold_;}
+
+  /**
+   * @brief Wrap the prior cost function in a FirstEstimateCostFunction with the given threshold
+   *
+   * @param[in] jacobian_threshold The maximum variable change before the Jacobians are recomputed.
+   *                               A negative value disables the cache.
+   */
+  void jacobianThreshold(const double jacobian_threshold)
+  {
+    jacobian_threshold_ = jacobian_threshold;
+  }
+
   /**
    * @brief Print a human-readable description of the constraint to the provided stream.
    *
@@ -164,6 +182,7 @@ public:
 protected:
   fuse_core::Vector3d mean_;  //!< The measured/prior mean vector for this variable
   fuse_core::MatrixXd sqrt_information_;  //!< The square root information matrix
+  double jacobian_threshold_{-1.0};  //!< The Jacobian cache threshold, negative when disabled
 
 private:
   // Allow Boost Serialization access to private methods
@@ -174,19 +193,24 @@ private:
    *        archive
    *
    * @param[in/out] archive - The archive object that holds the serialized class members
-   * @param[in] version - The version of the archive being read/written. Generally unused.
+   * @param[in] version - The version of the archive being read/written. Version 1 added the
+   *                      Jacobian threshold.
    */
   template<class Archive>
-  void serialize(Archive & archive, const unsigned int /* version */)
+  void serialize(Archive & archive, const unsigned int version)
   {
     archive & boost::serialization::base_object<fuse_core::Constraint>(*this);
     archive & mean_;
     archive & sqrt_information_;
+    if (version >= 1) {
+      archive & jacobian_threshold_;
+    }
   }
 };
 
 }  // namespace fuse_constraints
 
 BOOST_CLASS_EXPORT_KEY(fuse_constraints::AbsolutePose2DStampedConstraint);
+BOOST_CLASS_VERSION(fuse_constraints::AbsolutePose2DStampedConstraint, 1);
 
 #endif  // FUSE_CONSTRAINTS__ABSOLUTE_POSE_2D_STAMPED_CONSTRAINT_HPP_
@@ -0,0 +1,126 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2019, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef FUSE_CONSTRAINTS__FIRST_ESTIMATE_COST_FUNCTION_HPP_
+#define FUSE_CONSTRAINTS__FIRST_ESTIMATE_COST_FUNCTION_HPP_
+
+#include <ceres/cost_function.h>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+namespace fuse_constraints
+{
+
+/**
+ * @brief A cost function wrapper that reuses the Jacobians computed at a linearization point
+ *
+ * The residuals are always evaluated by the wrapped cost function at the current parameter values.
+ * The Jacobians are only recomputed when a parameter block moves by more than a threshold from the
+ * values where they were last computed, the linearization point. Otherwise the cached Jacobians are
+ * returned, and the wrapped cost function is asked for the residuals only.
+ *
+ * This is meant for constraints whose variables barely move during an optimization, such as priors
+ * on old variables or marginal constraints, which are already linear, so computing the Jacobians
+ * again on every Ceres iteration is wasted work. A threshold of zero only reuses the Jacobians when
+ * the parameters are exactly the same.
+ *
+ * Any constraint can opt into it by wrapping the cost function it returns from costFunction():
+ * @code
+ * return new FirstEstimateCostFunction(new MyCostFunction(...), jacobian_threshold);
+ * @endcode
+ */
+class FirstEstimateCostFunction : public ceres::CostFunction
+{
+public:
+  /**
+   * @brief Construct a cost function instance
+   *
+   * @param[in] cost_function The cost function to wrap. This object takes ownership of it.
+   * @param[in] threshold     The maximum absolute change of any parameter value, in any parameter
+   *                          block, before the Jacobians of that block are computed again
+   */
+  FirstEstimateCostFunction(ceres::CostFunction * cost_function, const double threshold);
+
+  /**
+   * @brief Destructor
+   */
+  virtual ~FirstEstimateCostFunction() = default;
+
+  /**
+   * @brief Compute the cost values/residuals, and optionally the Jacobians, using the provided
+   *        variable/parameter values
+   */
+  bool Evaluate(
+    double const * const * parameters,
+    double * residuals,
+    double ** jacobians) const override;
+
+  /**
+   * @brief Read-only access to the wrapped cost function
+   */
+  const ceres::CostFunction & costFunction() const {return *cost_function_;}
+
+  /**
+   * @brief Read-only access to the linearization point threshold
+   */
+  double threshold() const {return threshold_;}
+
+private:
+  /**
+   * @brief The Jacobian and linearization point of a single parameter block
+   */
+  struct Linearization
+  {
+    bool valid{false};  //!< Whether the Jacobian has been computed
+    std::vector<double> parameters;  //!< The parameter values at the linearization point
+    std::vector<double> jacobian;  //!< The row-major Jacobian at the linearization point
+  };
+
+  std::unique_ptr<ceres::CostFunction> cost_function_;  //!< The wrapped cost function
+  double threshold_;  //!< The maximum parameter change before the Jacobians are recomputed
+
+  mutable std::mutex mutex_;  //!< Guards the cached linearizations
+  mutable std::vector<Linearization> linearizations_;  //!< The cache, one per parameter block
+
+  /**
+   * @brief Check if the cached Jacobian of a parameter block can be used at the provided values
+   */
+  bool isLinearized(const size_t block, const double * parameters) const;
+};
+
+}  // namespace fuse_constraints
+
+#endif  // FUSE_CONSTRAINTS__FIRST_ESTIMATE_COST_FUNCTION_HPP_
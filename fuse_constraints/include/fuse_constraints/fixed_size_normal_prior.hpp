@@ -0,0 +1,146 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2018, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef FUSE_CONSTRAINTS__FIXED_SIZE_NORMAL_PRIOR_HPP_
+#define FUSE_CONSTRAINTS__FIXED_SIZE_NORMAL_PRIOR_HPP_
+
+#include <ceres/normal_prior.h>
+#include <ceres/sized_cost_function.h>
+#include <Eigen/Core>
+#include <glog/logging.h>
+
+#include <fuse_core/eigen.hpp>
+#include <fuse_core/fuse_macros.hpp>
+
+
+namespace fuse_constraints
+{
+
+/**
+ * @brief A compile-time sized version of ceres::NormalPrior
+ *
+ * The cost function is of the form:
+ *
+ *   cost(x) = ||A(x - b)||^2
+ *
+ * where, the matrix A and the vector b are fixed and x is the variable. Both dimensions are known
+ * at compile time, so the residuals and Jacobian are computed with fixed-size Eigen types and no
+ * heap allocations. kNumResiduals may be smaller than kSize when only a subset of the variable
+ * dimensions is measured.
+ *
+ * @tparam kNumResiduals The number of rows of A, i.e. the number of measured dimensions
+ * @tparam kSize         The size of the variable, i.e. the number of columns of A
+ */
+template<int kNumResiduals, int kSize>
+class FixedSizeNormalPrior : public ceres::SizedCostFunction<kNumResiduals, kSize>
+{
+public:
+  FUSE_MAKE_ALIGNED_OPERATOR_NEW()
+
+  // Row-major to match the Ceres Jacobian layout. Eigen requires column vectors to be column-major.
+  template<int Rows, int Cols>
+  using Matrix = Eigen::Matrix<double, Rows, Cols,
+      (Cols == 1 && Rows != 1) ? Eigen::ColMajor : Eigen::RowMajor>;
+
+  /**
+   * @brief Construct a cost function instance
+   *
+   * @param[in] A The residual weighting matrix, most likely the square root information matrix, of
+   *              size kNumResiduals x kSize
+   * @param[in] b The prior mean, of size kSize
+   */
+  FixedSizeNormalPrior(const fuse_core::MatrixXd & A, const fuse_core::VectorXd & b)
+  {
+    CHECK_EQ(A.rows(), kNumResiduals);
+    CHECK_EQ(A.cols(), kSize);
+    CHECK_EQ(b.rows(), kSize);
+    A_ = A;
+    b_ = b;
+  }
+
+  /**
+   * @brief Compute the cost values/residuals, and optionally the Jacobians, using the provided
+   *        variable/parameter values
+   */
+  bool Evaluate(
+    double const * const * parameters,
+    double * residuals,
+    double ** jacobians) const override
+  {
+    Eigen::Map<const Matrix<kSize, 1>> x(parameters[0]);
+    Eigen::Map<Matrix<kNumResiduals, 1>> r(residuals);
+    r.noalias() = A_ * (x - b_);
+    if (jacobians != nullptr && jacobians[0] != nullptr) {
+      Eigen::Map<Matrix<kNumResiduals, kSize>> jacobian(jacobians[0]);
+      jacobian = A_;
+    }
+    return true;
+  }
+
+private:
+  Matrix<kNumResiduals, kSize> A_;  //!< The residual weighting matrix, most likely the square root
+                                    //!< information matrix
+  Matrix<kSize, 1> b_;  //!< The prior mean
+};
+
+/**
+ * @brief Create the cheapest cost function equivalent to ceres::NormalPrior(A, b)
+ *
+ * A FixedSizeNormalPrior is returned when the number of rows of A is between 1 and kSize, which
+ * covers both full and partial measurements of a fixed-size variable. Any other shape falls back
+ * to the dynamically sized ceres::NormalPrior.
+ *
+ * @tparam kSize         The compile-time size of the variable
+ * @tparam kNumResiduals Used internally to search the supported residual counts; leave defaulted
+ * @param[in] A The residual weighting matrix, most likely the square root information matrix
+ * @param[in] b The prior mean
+ * @return A new cost function, owned by the caller
+ */
+template<int kSize, int kNumResiduals = kSize>
+ceres::CostFunction * createNormalPrior(
+  const fuse_core::MatrixXd & A,
+  const fuse_core::VectorXd & b)
+{
+  if constexpr (kNumResiduals == 0) {
+    return new ceres::NormalPrior(A, b);
+  } else {
+    if (A.rows() == kNumResiduals && A.cols() == kSize) {
+      return new FixedSizeNormalPrior<kNumResiduals, kSize>(A, b);
+    }
+    return createNormalPrior<kSize, kNumResiduals - 1>(A, b);
+  }
+}
+
+}  // namespace fuse_constraints
+
+#endif  // FUSE_CONSTRAINTS__FIXED_SIZE_NORMAL_PRIOR_HPP_
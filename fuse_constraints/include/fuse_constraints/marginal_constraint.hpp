@@ -56,6 +56,7 @@
 #include <boost/serialization/export.hpp>
 #include <boost/serialization/shared_ptr.hpp>
 #include <boost/serialization/vector.hpp>
+#include <boost/serialization/version.hpp>
 #include <boost/tuple/tuple.hpp>
 
 
@@ -133,6 +134,28 @@ public:
     return local_parameterizations_;
   }
 
+  /**
+   * @brief Read-only access to the Jacobian linearization threshold
+   *
+   * @return The maximum variable change before the Jacobians are recomputed, or a negative value if
+   *         the Jacobians are computed on every evaluation
+   */
+  double jacobianThreshold() const {return jacobian_threshold_;}
+
+  /**
+   * @brief Reuse the Jacobians of the cost function while the variables stay close to the values
+   *        they were computed at
+   *
+   * See FirstEstimateCostFunction for details. Disabled by default.
+   *
+   * @param[in] jacobian_threshold The maximum variable change before the Jacobians are recomputed.
+   *                               A negative value disables the cache.
+   */
+  void jacobianThreshold(const double jacobian_threshold)
+  {
+    jacobian_threshold_ = jacobian_threshold;
+  }
+
   /**
    * @brief Print a human-readable description of the constraint to the provided stream.
    *
@@ -161,6 +184,8 @@ protected:
 
   std::vector<fuse_core::VectorXd> x_bar_;  //!< The linearization point of each involved variable
 
+  double jacobian_threshold_{-1.0};  //!< The Jacobian cache threshold, negative when disabled
+
 private:
   // Allow Boost Serialization access to private methods
   friend class boost::serialization::access;
@@ -170,16 +195,20 @@ private:
    *        archive
    *
    * @param[in/out] archive - The archive object that holds the serialized class members
-   * @param[in] version - The version of the archive being read/written. Generally unused.
+   * @param[in] version - The version of the archive being read/written. Version 1 added the
+   *                      Jacobian threshold.
    */
   template<class Archive>
-  void serialize(Archive & archive, const unsigned int /* version */)
+  void serialize(Archive & archive, const unsigned int version)
   {
     archive & boost::serialization::base_object<fuse_core::Constraint>(*this);
     archive & A_;
     archive & b_;
     archive & local_parameterizations_;
     archive & x_bar_;
+    if (version >= 1) {
+      archive & jacobian_threshold_;
+    }
   }
 };
 
@@ -208,6 +237,14 @@ inline const fuse_core::VectorXd getCurrentValue(const fuse_core::Variable & var
 inline fuse_core::LocalParameterization::SharedPtr const getLocalParameterization(
   const fuse_core::Variable & variable)
 {
+  // A shared local parameterization is never deleted, so use a no-op deleter for it. Otherwise the
+  // object created by the deprecated localParameterization() is owned by the constraint.
+  auto shared_local_parameterization = variable.sharedLocalParameterization();
+  if (shared_local_parameterization) {
+    return fuse_core::LocalParameterization::SharedPtr(
+      shared_local_parameterization,
+      [](fuse_core::LocalParameterization *) {});
+  }
   return fuse_core::LocalParameterization::SharedPtr(variable.localParameterization());
 }
 
@@ -255,5 +292,6 @@ MarginalConstraint::MarginalConstraint(
 }  // namespace fuse_constraints
 
 BOOST_CLASS_EXPORT_KEY(fuse_constraints::MarginalConstraint);
+BOOST_CLASS_VERSION(fuse_constraints::MarginalConstraint, 1);
 
 #endif  // FUSE_CONSTRAINTS__MARGINAL_CONSTRAINT_HPP_
@@ -97,13 +97,16 @@ UuidOrdering computeEliminationOrder(
  * @param[in] graph                  A graph containing the variables and constraints that are
  *                                   connected to at least one marginalized variable. The graph may
  *                                   also contain additional variables and constraints.
+ * @param[in] jacobian_threshold     The Jacobian threshold assigned to the created marginal
+ *                                   constraints. See MarginalConstraint::jacobianThreshold().
  * @return A transaction object containing the computed marginal constraints to be added, as well as
  *         the set of variables and constraints to be removed.
  */
 fuse_core::Transaction marginalizeVariables(
   const std::string & source,
   const std::vector<fuse_core::UUID> & marginalized_variables,
-  const fuse_core::Graph & graph);
+  const fuse_core::Graph & graph,
+  const double jacobian_threshold = -1.0);
 
 /**
  * @brief Generate a transaction that, when applied to the graph, will marginalize out the requested
@@ -124,6 +127,8 @@ fuse_core::Transaction marginalizeVariables(
  *                                   connected to at least one marginalized variable. The graph may
  *                                   also contain additional variables and constraints.
  * @param[in] elimination_order      An sequential ordering of at least the marginalized variables
+ * @param[in] jacobian_threshold     The Jacobian threshold assigned to the created marginal
+ *                                   constraints. See MarginalConstraint::jacobianThreshold().
  * @return A transaction object containing the computed marginal constraints to be added, as well as
  *         the set of variables and constraints to be removed.
  */
@@ -131,7 +136,8 @@ fuse_core::Transaction marginalizeVariables(
   const std::string & source,
   const std::vector<fuse_core::UUID> & marginalized_variables,
   const fuse_core::Graph & graph,
-  const fuse_constraints::UuidOrdering & elimination_order);
+  const fuse_constraints::UuidOrdering & elimination_order,
+  const double jacobian_threshold = -1.0);
 
 namespace detail
 {
@@ -186,13 +192,15 @@ LinearTerm marginalizeNext(const std::vector<LinearTerm> & linear_terms);
  * @param[in] linear_term       The LinearTerm object to convert
  * @param[in] graph             The graph object containing the current variable values
  * @param[in] elimination_order The mapping from variable UUID to LinearTerm variable index
+ * @param[in] jacobian_threshold The Jacobian threshold of the created constraint
  * @return An equivalent MarginalConstraint object
  */
 MarginalConstraint::SharedPtr createMarginalConstraint(
   const std::string & source,
   const LinearTerm & linear_term,
   const fuse_core::Graph & graph,
-  const UuidOrdering & elimination_order);
+  const UuidOrdering & elimination_order,
+  const double jacobian_threshold = -1.0);
 }  // namespace detail
 
 }  // namespace fuse_constraints
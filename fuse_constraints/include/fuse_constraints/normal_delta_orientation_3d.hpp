@@ -0,0 +1,95 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2020, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef FUSE_CONSTRAINTS__NORMAL_DELTA_ORIENTATION_3D_HPP_
+#define FUSE_CONSTRAINTS__NORMAL_DELTA_ORIENTATION_3D_HPP_
+
+#include <ceres/sized_cost_function.h>
+
+#include <fuse_core/eigen.hpp>
+#include <fuse_core/fuse_macros.hpp>
+
+
+namespace fuse_constraints
+{
+
+/**
+ * @brief Implements a cost function that models a difference between 3D orientation variables,
+ *        with an analytic Jacobian.
+ *
+ * This computes the same residuals as the NormalDeltaOrientation3DCostFunctor:
+ *
+ *   cost(x) = || A * AngleAxis(b^-1 * q1^-1 * q2) ||^2
+ *
+ * where q1 and q2 are the orientation variables and the matrix A and the quaternion b are fixed,
+ * but avoids the cost of automatic differentiation.
+ */
+class NormalDeltaOrientation3D : public ceres::SizedCostFunction<3, 4, 4>
+{
+public:
+  FUSE_MAKE_ALIGNED_OPERATOR_NEW()
+
+  /**
+   * @brief Construct a cost function instance
+   *
+   * @param[in] A The residual weighting matrix, most likely the square root information matrix in
+   *              order (qx, qy, qz)
+   * @param[in] b The measured change between the two orientation variables in order
+   *              (qw, qx, qy, qz)
+   */
+  NormalDeltaOrientation3D(const fuse_core::Matrix3d & A, const fuse_core::Vector4d & b);
+
+  /**
+   * @brief Destructor
+   */
+  virtual ~NormalDeltaOrientation3D() = default;
+
+  /**
+   * @brief Compute the cost values/residuals, and optionally the Jacobians, using the provided
+   *        variable/parameter values
+   */
+  virtual bool Evaluate(
+    double const * const * parameters,
+    double * residuals,
+    double ** jacobians) const;
+
+private:
+  fuse_core::Matrix3d A_;  //!< The residual weighting matrix, most likely the square root
+                           //!< information matrix
+  fuse_core::Matrix4d b_inverse_product_;  //!< The left product matrix of the inverse of the
+                                           //!< measured orientation change
+};
+
+}  // namespace fuse_constraints
+
+#endif  // FUSE_CONSTRAINTS__NORMAL_DELTA_ORIENTATION_3D_HPP_
@@ -0,0 +1,96 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2020, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef FUSE_CONSTRAINTS__NORMAL_DELTA_POSE_3D_HPP_
+#define FUSE_CONSTRAINTS__NORMAL_DELTA_POSE_3D_HPP_
+
+#include <ceres/sized_cost_function.h>
+
+#include <fuse_core/eigen.hpp>
+#include <fuse_core/fuse_macros.hpp>
+
+
+namespace fuse_constraints
+{
+
+/**
+ * @brief Implements a cost function that models a difference between 3D pose variables, with an
+ *        analytic Jacobian.
+ *
+ * This computes the same residuals as the NormalDeltaPose3DCostFunctor:
+ *
+ *   cost(x) = || A * [ q1^-1 * (p2 - p1) - b(0:2)        ] ||^2
+ *             ||     [ AngleAxis(b(3:6)^-1 * q1^-1 * q2) ] ||
+ *
+ * where p1 and p2 are the position variables, q1 and q2 are the quaternion orientation variables,
+ * and the matrix A and the vector b are fixed, but avoids the cost of automatic differentiation.
+ */
+class NormalDeltaPose3D : public ceres::SizedCostFunction<6, 3, 4, 3, 4>
+{
+public:
+  FUSE_MAKE_ALIGNED_OPERATOR_NEW()
+
+  /**
+   * @brief Constructor
+   *
+   * @param[in] A The residual weighting matrix, most likely the square root information matrix in
+   *              order (dx, dy, dz, dqx, dqy, dqz)
+   * @param[in] b The exposed pose difference in order (dx, dy, dz, dqw, dqx, dqy, dqz)
+   */
+  NormalDeltaPose3D(const fuse_core::Matrix6d & A, const fuse_core::Vector7d & b);
+
+  /**
+   * @brief Destructor
+   */
+  virtual ~NormalDeltaPose3D() = default;
+
+  /**
+   * @brief Compute the cost values/residuals, and optionally the Jacobians, using the provided
+   *        variable/parameter values
+   */
+  virtual bool Evaluate(
+    double const * const * parameters,
+    double * residuals,
+    double ** jacobians) const;
+
+private:
+  fuse_core::Matrix6d A_;  //!< The residual weighting matrix, most likely the square root
+                           //!< information matrix
+  fuse_core::Vector3d b_position_;  //!< The measured position difference
+  fuse_core::Matrix4d b_inverse_product_;  //!< The left product matrix of the inverse of the
+                                           //!< measured orientation difference
+};
+
+}  // namespace fuse_constraints
+
+#endif  // FUSE_CONSTRAINTS__NORMAL_DELTA_POSE_3D_HPP_
@@ -0,0 +1,96 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2020, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef FUSE_CONSTRAINTS__NORMAL_PRIOR_POSE_3D_HPP_
+#define FUSE_CONSTRAINTS__NORMAL_PRIOR_POSE_3D_HPP_
+
+#include <ceres/sized_cost_function.h>
+
+#include <fuse_core/eigen.hpp>
+#include <fuse_core/fuse_macros.hpp>
+
+
+namespace fuse_constraints
+{
+
+/**
+ * @brief Create a prior cost function on both the 3D position and orientation variables at once,
+ *        with an analytic Jacobian.
+ *
+ * This computes the same residuals as the NormalPriorPose3DCostFunctor:
+ *
+ *   cost(x) = || A * [  p - b(0:2)               ] ||^2
+ *             ||     [  AngleAxis(b(3:6)^-1 * q) ] ||
+ *
+ * where the matrix A and the vector b are fixed, p is the position variable, and q is the
+ * orientation variable, but avoids the cost of automatic differentiation.
+ */
+class NormalPriorPose3D : public ceres::SizedCostFunction<6, 3, 4>
+{
+public:
+  FUSE_MAKE_ALIGNED_OPERATOR_NEW()
+
+  /**
+   * @brief Construct a cost function instance
+   *
+   * @param[in] A The residual weighting matrix, most likely the square root information matrix in
+   *              order (x, y, z, qx, qy, qz)
+   * @param[in] b The 3D pose measurement or prior in order (x, y, z, qw, qx, qy, qz)
+   */
+  NormalPriorPose3D(const fuse_core::Matrix6d & A, const fuse_core::Vector7d & b);
+
+  /**
+   * @brief Destructor
+   */
+  virtual ~NormalPriorPose3D() = default;
+
+  /**
+   * @brief Compute the cost values/residuals, and optionally the Jacobians, using the provided
+   *        variable/parameter values
+   */
+  virtual bool Evaluate(
+    double const * const * parameters,
+    double * residuals,
+    double ** jacobians) const;
+
+private:
+  fuse_core::Matrix6d A_;  //!< The residual weighting matrix, most likely the square root
+                           //!< information matrix
+  fuse_core::Vector3d b_position_;  //!< The measured 3D position
+  fuse_core::Matrix4d b_inverse_product_;  //!< The left product matrix of the inverse of the
+                                           //!< measured orientation
+};
+
+}  // namespace fuse_constraints
+
+#endif  // FUSE_CONSTRAINTS__NORMAL_PRIOR_POSE_3D_HPP_
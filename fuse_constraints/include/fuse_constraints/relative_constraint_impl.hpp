@@ -39,6 +39,7 @@
 #include <string>
 #include <vector>
 
+#include <fuse_constraints/fixed_size_normal_delta.hpp>
 #include <fuse_constraints/normal_delta.hpp>
 #include <fuse_constraints/normal_delta_orientation_2d.hpp>
 
@@ -131,8 +132,8 @@ void RelativeConstraint<Variable>::print(std::ostream & stream) const
 template<class Variable>
 ceres::CostFunction * RelativeConstraint<Variable>::costFunction() const
 {
-  // Create a Gaussian/Normal Delta constraint
-  return new fuse_constraints::NormalDelta(sqrt_information_, delta_);
+  // Create a Gaussian/Normal Delta constraint, using compile-time sizes when possible
+  return createNormalDelta<Variable::SIZE>(sqrt_information_, delta_);
 }
 
 // Specialization for Orientation2D
@@ -37,6 +37,7 @@
 
 BOOST_CLASS_EXPORT_IMPLEMENT(fuse_constraints::AbsoluteAccelerationAngular2DStampedConstraint);
 BOOST_CLASS_EXPORT_IMPLEMENT(fuse_constraints::AbsoluteAccelerationLinear2DStampedConstraint);
+BOOST_CLASS_EXPORT_IMPLEMENT(fuse_constraints::AbsoluteImuBias2DStampedConstraint);
 BOOST_CLASS_EXPORT_IMPLEMENT(fuse_constraints::AbsoluteOrientation2DStampedConstraint);
 BOOST_CLASS_EXPORT_IMPLEMENT(fuse_constraints::AbsolutePosition2DStampedConstraint);
 BOOST_CLASS_EXPORT_IMPLEMENT(fuse_constraints::AbsolutePosition3DStampedConstraint);
@@ -49,6 +50,9 @@ PLUGINLIB_EXPORT_CLASS(
 PLUGINLIB_EXPORT_CLASS(
   fuse_constraints::AbsoluteAccelerationLinear2DStampedConstraint,
   fuse_core::Constraint);
+PLUGINLIB_EXPORT_CLASS(
+  fuse_constraints::AbsoluteImuBias2DStampedConstraint,
+  fuse_core::Constraint);
 PLUGINLIB_EXPORT_CLASS(
   fuse_constraints::AbsoluteOrientation2DStampedConstraint,
   fuse_core::Constraint);
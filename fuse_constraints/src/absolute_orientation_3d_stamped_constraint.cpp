@@ -31,14 +31,13 @@
  *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  *  POSSIBILITY OF SUCH DAMAGE.
  */
-#include <ceres/autodiff_cost_function.h>
 #include <Eigen/Geometry>
 
 #include <string>
 
 #include <boost/serialization/export.hpp>
 #include <fuse_constraints/absolute_orientation_3d_stamped_constraint.hpp>
-#include <fuse_constraints/normal_prior_orientation_3d_cost_functor.hpp>
+#include <fuse_constraints/normal_prior_orientation_3d.hpp>
 #include <pluginlib/class_list_macros.hpp>
 
 namespace fuse_constraints
@@ -95,8 +94,7 @@ void AbsoluteOrientation3DStampedConstraint::print(std::ostream & stream) const
 
 ceres::CostFunction * AbsoluteOrientation3DStampedConstraint::costFunction() const
 {
-  return new ceres::AutoDiffCostFunction<NormalPriorOrientation3DCostFunctor, 3, 4>(
-    new NormalPriorOrientation3DCostFunctor(sqrt_information_, mean_));
+  return new NormalPriorOrientation3D(sqrt_information_, mean_);
 }
 
 fuse_core::Vector4d AbsoluteOrientation3DStampedConstraint::toEigen(
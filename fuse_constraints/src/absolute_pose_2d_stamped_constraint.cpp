@@ -39,6 +39,7 @@
 
 #include <boost/serialization/export.hpp>
 #include <fuse_constraints/absolute_pose_2d_stamped_constraint.hpp>
+#include <fuse_constraints/first_estimate_cost_function.hpp>
 #include <fuse_constraints/normal_prior_pose_2d.hpp>
 #include <pluginlib/class_list_macros.hpp>
 
@@ -110,6 +111,9 @@ void AbsolutePose2DStampedConstraint::print(std::ostream & stream) const
          << "  orientation variable: " << variables().at(1) << "\n"
          << "  mean: " << mean().transpose() << "\n"
          << "  sqrt_info: " << sqrtInformation() << "\n";
+  if (jacobianThreshold() >= 0.0) {
+    stream << "  jacobian_threshold: " << jacobianThreshold() << "\n";
+  }
 
   if (loss()) {
     stream << "  loss: ";
@@ -119,7 +123,11 @@ void AbsolutePose2DStampedConstraint::print(std::ostream & stream) const
 
 ceres::CostFunction * AbsolutePose2DStampedConstraint::costFunction() const
 {
-  return new NormalPriorPose2D(sqrt_information_, mean_);
+  auto cost_function = new NormalPriorPose2D(sqrt_information_, mean_);
+  if (jacobian_threshold_ >= 0.0) {
+    return new FirstEstimateCostFunction(cost_function, jacobian_threshold_);
+  }
+  return cost_function;
 }
 
 }  // namespace fuse_constraints
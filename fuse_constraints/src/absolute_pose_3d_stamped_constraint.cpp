@@ -31,14 +31,14 @@
  *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  *  POSSIBILITY OF SUCH DAMAGE.
  */
-#include <ceres/autodiff_cost_function.h>
 #include <Eigen/Dense>
 
 #include <string>
 
 #include <boost/serialization/export.hpp>
 #include <fuse_constraints/absolute_pose_3d_stamped_constraint.hpp>
-#include <fuse_constraints/normal_prior_pose_3d_cost_functor.hpp>
+#include <fuse_constraints/first_estimate_cost_function.hpp>
+#include <fuse_constraints/normal_prior_pose_3d.hpp>
 #include <pluginlib/class_list_macros.hpp>
 
 namespace fuse_constraints
@@ -65,6 +65,9 @@ void AbsolutePose3DStampedConstraint::print(std::ostream & stream) const
          << "  orientation variable: " << variables().at(1) << "\n"
          << "  mean: " << mean().transpose() << "\n"
          << "  sqrt_info: " << sqrtInformation() << "\n";
+  if (jacobianThreshold() >= 0.0) {
+    stream << "  jacobian_threshold: " << jacobianThreshold() << "\n";
+  }
 
   if (loss()) {
     stream << "  loss: ";
@@ -74,8 +77,11 @@ void AbsolutePose3DStampedConstraint::print(std::ostream & stream) const
 
 ceres::CostFunction * AbsolutePose3DStampedConstraint::costFunction() const
 {
-  return new ceres::AutoDiffCostFunction<NormalPriorPose3DCostFunctor, 6, 3, 4>(
-    new NormalPriorPose3DCostFunctor(sqrt_information_, mean_));
+  auto cost_function = new NormalPriorPose3D(sqrt_information_, mean_);
+  if (jacobian_threshold_ >= 0.0) {
+    return new FirstEstimateCostFunction(cost_function, jacobian_threshold_);
+  }
+  return cost_function;
 }
 
 }  // namespace fuse_constraints
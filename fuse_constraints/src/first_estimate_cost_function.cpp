@@ -0,0 +1,126 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2019, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <mutex>
+
+#include <fuse_constraints/first_estimate_cost_function.hpp>
+
+namespace fuse_constraints
+{
+
+FirstEstimateCostFunction::FirstEstimateCostFunction(
+  ceres::CostFunction * cost_function,
+  const double threshold)
+: cost_function_(cost_function),
+  threshold_(threshold)
+{
+  set_num_residuals(cost_function_->num_residuals());
+  *mutable_parameter_block_sizes() = cost_function_->parameter_block_sizes();
+
+  linearizations_.resize(parameter_block_sizes().size());
+  for (size_t i = 0; i < linearizations_.size(); ++i) {
+    const auto block_size = static_cast<size_t>(parameter_block_sizes()[i]);
+    linearizations_[i].parameters.resize(block_size);
+    linearizations_[i].jacobian.resize(num_residuals() * block_size);
+  }
+}
+
+bool FirstEstimateCostFunction::Evaluate(
+  double const * const * parameters,
+  double * residuals,
+  double ** jacobians) const
+{
+  if (!jacobians) {
+    return cost_function_->Evaluate(parameters, residuals, nullptr);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // If every requested Jacobian was computed close enough to the current values, only the
+  // residuals need to be evaluated
+  bool linearized = true;
+  for (size_t i = 0; i < linearizations_.size() && linearized; ++i) {
+    linearized = !jacobians[i] || isLinearized(i, parameters[i]);
+  }
+
+  if (linearized) {
+    if (!cost_function_->Evaluate(parameters, residuals, nullptr)) {
+      return false;
+    }
+    for (size_t i = 0; i < linearizations_.size(); ++i) {
+      if (jacobians[i]) {
+        std::copy(
+          linearizations_[i].jacobian.begin(), linearizations_[i].jacobian.end(),
+          jacobians[i]);
+      }
+    }
+    return true;
+  }
+
+  // Otherwise relinearize every requested parameter block at the current values
+  if (!cost_function_->Evaluate(parameters, residuals, jacobians)) {
+    return false;
+  }
+  for (size_t i = 0; i < linearizations_.size(); ++i) {
+    auto & linearization = linearizations_[i];
+    if (jacobians[i]) {
+      std::copy(
+        parameters[i], parameters[i] + linearization.parameters.size(),
+        linearization.parameters.begin());
+      std::copy(
+        jacobians[i], jacobians[i] + linearization.jacobian.size(),
+        linearization.jacobian.begin());
+      linearization.valid = true;
+    }
+  }
+  return true;
+}
+
+bool FirstEstimateCostFunction::isLinearized(const size_t block, const double * parameters) const
+{
+  const auto & linearization = linearizations_[block];
+  if (!linearization.valid) {
+    return false;
+  }
+  for (size_t j = 0; j < linearization.parameters.size(); ++j) {
+    if (!(std::abs(parameters[j] - linearization.parameters[j]) <= threshold_)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace fuse_constraints
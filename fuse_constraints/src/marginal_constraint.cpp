@@ -36,6 +36,7 @@
 #include <ostream>
 
 #include <boost/serialization/export.hpp>
+#include <fuse_constraints/first_estimate_cost_function.hpp>
 #include <fuse_constraints/marginal_constraint.hpp>
 #include <fuse_constraints/marginal_cost_function.hpp>
 #include <fuse_core/constraint.hpp>
@@ -59,6 +60,9 @@ void MarginalConstraint::print(std::ostream & stream) const
            << "  x_bar[" << i << "]:\n" << x_bar()[i].format(indent) << "\n";
   }
   stream << "  b:\n" << b().format(indent) << "\n";
+  if (jacobianThreshold() >= 0.0) {
+    stream << "  jacobian_threshold: " << jacobianThreshold() << "\n";
+  }
 
   if (loss()) {
     stream << "  loss: ";
@@ -68,7 +72,11 @@ void MarginalConstraint::print(std::ostream & stream) const
 
 ceres::CostFunction * MarginalConstraint::costFunction() const
 {
-  return new MarginalCostFunction(A_, b_, x_bar_, local_parameterizations_);
+  auto cost_function = new MarginalCostFunction(A_, b_, x_bar_, local_parameterizations_);
+  if (jacobian_threshold_ >= 0.0) {
+    return new FirstEstimateCostFunction(cost_function, jacobian_threshold_);
+  }
+  return cost_function;
 }
 
 }  // namespace fuse_constraints
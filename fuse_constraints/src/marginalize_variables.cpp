@@ -37,6 +37,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <memory>
 #include <numeric>
 #include <string>
 #include <unordered_map>
@@ -159,20 +160,23 @@ UuidOrdering computeEliminationOrder(
 fuse_core::Transaction marginalizeVariables(
   const std::string & source,
   const std::vector<fuse_core::UUID> & marginalized_variables,
-  const fuse_core::Graph & graph)
+  const fuse_core::Graph & graph,
+  const double jacobian_threshold)
 {
   return marginalizeVariables(
     source,
     marginalized_variables,
     graph,
-    computeEliminationOrder(marginalized_variables, graph));
+    computeEliminationOrder(marginalized_variables, graph),
+    jacobian_threshold);
 }
 
 fuse_core::Transaction marginalizeVariables(
   const std::string & source,
   const std::vector<fuse_core::UUID> & marginalized_variables,
   const fuse_core::Graph & graph,
-  const fuse_constraints::UuidOrdering & elimination_order)
+  const fuse_constraints::UuidOrdering & elimination_order,
+  const double jacobian_threshold)
 {
   // TODO(swilliams) The method used to marginalize variables assumes that all variables are fully
   //                 constrained. However, with the introduction of "variables held constant", it is
@@ -242,7 +246,7 @@ fuse_core::Transaction marginalizeVariables(
     for (const auto & linear_term : linear_terms[i]) {
       auto marginal_constraint = detail::createMarginalConstraint(
         source, linear_term, graph,
-        variable_order);
+        variable_order, jacobian_threshold);
       transaction.addConstraint(std::move(marginal_constraint));
     }
   }
@@ -327,8 +331,30 @@ LinearTerm linearize(
   for (size_t index = 0ul; index < variable_count; ++index) {
     const auto & variable_uuid = variable_uuids[index];
     const auto & variable = graph.getVariable(variable_uuid);
-    auto local_parameterization = variable.localParameterization();
     auto & jacobian = result.A[index];
+#if CERES_SUPPORTS_MANIFOLDS
+    // Prefer the manifold, if the variable provides one
+    auto manifold = variable.manifold();
+    if (manifold) {
+      if (variable.holdConstant()) {
+        jacobian.resize(Eigen::NoChange, manifold->TangentSize());
+        jacobian.setZero();
+      } else {
+        fuse_core::MatrixXd J(manifold->AmbientSize(), manifold->TangentSize());
+        manifold->PlusJacobian(variable_values[index], J.data());
+        jacobian *= J;
+      }
+      continue;
+    }
+#endif
+    // Prefer the shared local parameterization. Only the object created by the deprecated
+    // localParameterization() is owned here.
+    std::unique_ptr<fuse_core::LocalParameterization> owned_local_parameterization;
+    auto local_parameterization = variable.sharedLocalParameterization();
+    if (!local_parameterization) {
+      owned_local_parameterization.reset(variable.localParameterization());
+      local_parameterization = owned_local_parameterization.get();
+    }
     if (variable.holdConstant()) {
       if (local_parameterization) {
         jacobian.resize(Eigen::NoChange, local_parameterization->LocalSize());
@@ -340,20 +366,20 @@ LinearTerm linearize(
       local_parameterization->ComputeJacobian(variable_values[index], J.data());
       jacobian *= J;
     }
-    if (local_parameterization) {
-      delete local_parameterization;
-    }
   }
 
-  // Correct A and b for the effects of the loss function
-  auto loss_function = constraint.lossFunction();
+  // Correct A and b for the effects of the loss function. Prefer the shared loss function. Only
+  // the object created by the deprecated Loss::lossFunction() is owned here.
+  std::unique_ptr<ceres::LossFunction> owned_loss_function;
+  auto loss_function = constraint.sharedLossFunction();
+  if (!loss_function) {
+    owned_loss_function.reset(constraint.lossFunction());
+    loss_function = owned_loss_function.get();
+  }
   if (loss_function) {
     double squared_norm = result.b.squaredNorm();
     double rho[3];
     loss_function->Evaluate(squared_norm, rho);
-    if (fuse_core::Loss::Ownership == ceres::Ownership::TAKE_OWNERSHIP) {
-      delete loss_function;
-    }
     double sqrt_rho1 = std::sqrt(rho[1]);
     double alpha = 0.0;
     if ((squared_norm > 0.0) && (rho[2] > 0.0)) {
@@ -514,7 +540,8 @@ MarginalConstraint::SharedPtr createMarginalConstraint(
   const std::string & source,
   const LinearTerm & linear_term,
   const fuse_core::Graph & graph,
-  const UuidOrdering & elimination_order)
+  const UuidOrdering & elimination_order,
+  const double jacobian_threshold)
 {
   auto index_to_variable =
     [&graph, &elimination_order](const unsigned int index) -> const fuse_core::Variable &
@@ -522,13 +549,15 @@ MarginalConstraint::SharedPtr createMarginalConstraint(
       return graph.getVariable(elimination_order.at(index));
     };
 
-  return MarginalConstraint::make_shared(
+  auto constraint = MarginalConstraint::make_shared(
     source,
     boost::make_transform_iterator(linear_term.variables.begin(), index_to_variable),
     boost::make_transform_iterator(linear_term.variables.end(), index_to_variable),
     linear_term.A.begin(),
     linear_term.A.end(),
     linear_term.b);
+  constraint->jacobianThreshold(jacobian_threshold);
+  return constraint;
 }
 
 }  // namespace detail
@@ -0,0 +1,101 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2020, Clearpath Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <Eigen/Core>
+
+#include <fuse_constraints/normal_delta_orientation_3d.hpp>
+#include <fuse_core/util.hpp>
+
+namespace fuse_constraints
+{
+
+NormalDeltaOrientation3D::NormalDeltaOrientation3D(
+  const fuse_core::Matrix3d & A,
+  const fuse_core::Vector4d & b)
+: A_(A)
+{
+  const fuse_core::Vector4d b_inverse(b(0), -b(1), -b(2), -b(3));
+  b_inverse_product_ = fuse_core::quaternionLeftProductMatrix(b_inverse.data());
+}
+
+bool NormalDeltaOrientation3D::Evaluate(
+  double const * const * parameters,
+  double * residuals,
+  double ** jacobians) const
+{
+  const double orientation1_inverse[4] =
+  {
+    parameters[0][0],
+    -parameters[0][1],
+    -parameters[0][2],
+    -parameters[0][3]
+  };
+  const Eigen::Map<const fuse_core::Vector4d> orientation2(parameters[1]);
+
+  // The orientation error is b^-1 * q1^-1 * q2
+  const fuse_core::Matrix4d error_product =
+    b_inverse_product_ * fuse_core::quaternionLeftProductMatrix(orientation1_inverse);
+  const fuse_core::Vector4d error = error_product * orientation2;
+
+  Eigen::Map<fuse_core::Vector3d> residuals_vector(residuals);
+  if (jacobians == nullptr) {
+    fuse_core::quaternionToAngleAxis(error.data(), residuals);
+    residuals_vector.applyOnTheLeft(A_);
+    return true;
+  }
+
+  fuse_core::Matrix<double, 3, 4> angle_axis_jacobian;
+  fuse_core::quaternionToAngleAxis(error.data(), residuals, angle_axis_jacobian.data());
+  const fuse_core::Matrix<double, 3, 4> weighted_jacobian = A_ * angle_axis_jacobian;
+
+  // Scale the residuals by the square root information matrix to account for the measurement
+  // uncertainty.
+  residuals_vector.applyOnTheLeft(A_);
+
+  // Jacobian wrt orientation1. Conjugating q1 negates the imaginary components.
+  if (jacobians[0] != nullptr) {
+    Eigen::Map<fuse_core::Matrix<double, 3, 4>> jacobian_map(jacobians[0]);
+    jacobian_map = weighted_jacobian * b_inverse_product_ *
+      fuse_core::quaternionRightProductMatrix(parameters[1]);
+    jacobian_map.rightCols<3>() *= -1.0;
+  }
+
+  // Jacobian wrt orientation2
+  if (jacobians[1] != nullptr) {
+    Eigen::Map<fuse_core::Matrix<double, 3, 4>> jacobian_map(jacobians[1]);
+    jacobian_map = weighted_jacobian * error_product;
+  }
+  return true;
+}
+
+}  // namespace fuse_constraints
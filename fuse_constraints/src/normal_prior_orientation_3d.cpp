@@ -0,0 +1,77 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2020, Clearpath Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <Eigen/Core>
+
+#include <fuse_constraints/normal_prior_orientation_3d.hpp>
+#include <fuse_core/util.hpp>
+
+namespace fuse_constraints
+{
+
+NormalPriorOrientation3D::NormalPriorOrientation3D(
+  const fuse_core::Matrix3d & A,
+  const fuse_core::Vector4d & b)
+: A_(A)
+{
+  const fuse_core::Vector4d b_inverse(b(0), -b(1), -b(2), -b(3));
+  b_inverse_product_ = fuse_core::quaternionLeftProductMatrix(b_inverse.data());
+}
+
+bool NormalPriorOrientation3D::Evaluate(
+  double const * const * parameters,
+  double * residuals,
+  double ** jacobians) const
+{
+  // The orientation error is b^-1 * q
+  const fuse_core::Vector4d error =
+    b_inverse_product_ * Eigen::Map<const fuse_core::Vector4d>(parameters[0]);
+
+  Eigen::Map<fuse_core::Vector3d> residuals_vector(residuals);
+  if (jacobians != nullptr && jacobians[0] != nullptr) {
+    fuse_core::Matrix<double, 3, 4> angle_axis_jacobian;
+    fuse_core::quaternionToAngleAxis(error.data(), residuals, angle_axis_jacobian.data());
+    Eigen::Map<fuse_core::Matrix<double, 3, 4>> jacobian_map(jacobians[0]);
+    jacobian_map =
+      A_ * angle_axis_jacobian * b_inverse_product_;
+  } else {
+    fuse_core::quaternionToAngleAxis(error.data(), residuals);
+  }
+
+  // Scale the residuals by the square root information matrix to account for the measurement
+  // uncertainty.
+  residuals_vector.applyOnTheLeft(A_);
+  return true;
+}
+
+}  // namespace fuse_constraints
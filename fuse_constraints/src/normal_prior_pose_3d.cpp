@@ -0,0 +1,91 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2020, Clearpath Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <Eigen/Core>
+
+#include <fuse_constraints/normal_prior_pose_3d.hpp>
+#include <fuse_core/util.hpp>
+
+namespace fuse_constraints
+{
+
+NormalPriorPose3D::NormalPriorPose3D(const fuse_core::Matrix6d & A, const fuse_core::Vector7d & b)
+: A_(A),
+  b_position_(b.head<3>())
+{
+  const fuse_core::Vector4d b_inverse(b(3), -b(4), -b(5), -b(6));
+  b_inverse_product_ = fuse_core::quaternionLeftProductMatrix(b_inverse.data());
+}
+
+bool NormalPriorPose3D::Evaluate(
+  double const * const * parameters,
+  double * residuals,
+  double ** jacobians) const
+{
+  // Compute the position error
+  fuse_core::Vector6d full_residuals_vector;
+  full_residuals_vector.head<3>() = Eigen::Map<const fuse_core::Vector3d>(parameters[0]) -
+    b_position_;
+
+  // The orientation error is b^-1 * q
+  const fuse_core::Vector4d error =
+    b_inverse_product_ * Eigen::Map<const fuse_core::Vector4d>(parameters[1]);
+  const bool orientation_jacobian = jacobians != nullptr && jacobians[1] != nullptr;
+  fuse_core::Matrix<double, 3, 4> angle_axis_jacobian;
+  fuse_core::quaternionToAngleAxis(
+    error.data(), full_residuals_vector.data() + 3,
+    orientation_jacobian ? angle_axis_jacobian.data() : nullptr);
+
+  // Scale the residuals by the square root information matrix to account for the measurement
+  // uncertainty.
+  Eigen::Map<fuse_core::Vector6d> residuals_vector(residuals);
+  residuals_vector = A_ * full_residuals_vector;
+
+  if (jacobians != nullptr) {
+    // Jacobian wrt position
+    if (jacobians[0] != nullptr) {
+      Eigen::Map<fuse_core::Matrix<double, 6, 3>> jacobian_map(jacobians[0]);
+      jacobian_map = A_.leftCols<3>();
+    }
+
+    // Jacobian wrt orientation
+    if (orientation_jacobian) {
+      Eigen::Map<fuse_core::Matrix<double, 6, 4>> jacobian_map(jacobians[1]);
+      jacobian_map =
+        A_.rightCols<3>() * angle_axis_jacobian * b_inverse_product_;
+    }
+  }
+  return true;
+}
+
+}  // namespace fuse_constraints
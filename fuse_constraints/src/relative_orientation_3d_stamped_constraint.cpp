@@ -31,13 +31,12 @@
  *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  *  POSSIBILITY OF SUCH DAMAGE.
  */
-#include <ceres/autodiff_cost_function.h>
 #include <Eigen/Geometry>
 
 #include <string>
 
 #include <boost/serialization/export.hpp>
-#include <fuse_constraints/normal_delta_orientation_3d_cost_functor.hpp>
+#include <fuse_constraints/normal_delta_orientation_3d.hpp>
 #include <fuse_constraints/relative_orientation_3d_stamped_constraint.hpp>
 #include <pluginlib/class_list_macros.hpp>
 
@@ -101,8 +100,7 @@ void RelativeOrientation3DStampedConstraint::print(std::ostream & stream) const
 
 ceres::CostFunction * RelativeOrientation3DStampedConstraint::costFunction() const
 {
-  return new ceres::AutoDiffCostFunction<NormalDeltaOrientation3DCostFunctor, 3, 4, 4>(
-    new NormalDeltaOrientation3DCostFunctor(sqrt_information_, delta_));
+  return new NormalDeltaOrientation3D(sqrt_information_, delta_);
 }
 
 fuse_core::Vector4d RelativeOrientation3DStampedConstraint::toEigen(
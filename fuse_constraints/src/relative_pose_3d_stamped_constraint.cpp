@@ -31,12 +31,10 @@
  *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  *  POSSIBILITY OF SUCH DAMAGE.
  */
-#include <ceres/autodiff_cost_function.h>
-
 #include <string>
 
 #include <boost/serialization/export.hpp>
-#include <fuse_constraints/normal_delta_pose_3d_cost_functor.hpp>
+#include <fuse_constraints/normal_delta_pose_3d.hpp>
 #include <fuse_constraints/relative_pose_3d_stamped_constraint.hpp>
 #include <pluginlib/class_list_macros.hpp>
 
@@ -74,8 +72,7 @@ void RelativePose3DStampedConstraint::print(std::ostream & stream) const
 
 ceres::CostFunction * RelativePose3DStampedConstraint::costFunction() const
 {
-  return new ceres::AutoDiffCostFunction<NormalDeltaPose3DCostFunctor, 6, 3, 4, 3, 4>(
-    new NormalDeltaPose3DCostFunctor(sqrt_information_, delta_));
+  return new NormalDeltaPose3D(sqrt_information_, delta_);
 }
 
 }  // namespace fuse_constraints
@@ -452,6 +452,7 @@ TEST(AbsoluteConstraint, Serialization)
   cov << 1.0;
   fuse_constraints::AbsoluteAccelerationAngular2DStampedConstraint expected("test", variable, mean,
     cov);
+  expected.jacobianThreshold(0.01);
 
   // Serialize the constraint into an archive
   std::stringstream stream;
@@ -472,4 +473,5 @@ TEST(AbsoluteConstraint, Serialization)
   EXPECT_EQ(expected.variables(), actual.variables());
   EXPECT_MATRIX_EQ(expected.mean(), actual.mean());
   EXPECT_MATRIX_EQ(expected.sqrtInformation(), actual.sqrtInformation());
+  EXPECT_EQ(expected.jacobianThreshold(), actual.jacobianThreshold());
 }
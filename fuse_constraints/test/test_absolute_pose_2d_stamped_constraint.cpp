@@ -315,6 +315,7 @@ TEST(AbsolutePose2DStampedConstraint, Serialization)
   cov << 1.0, 0.1, 0.2, 0.1, 2.0, 0.3, 0.2, 0.3, 3.0;
   AbsolutePose2DStampedConstraint expected("test", position_variable, orientation_variable, mean,
     cov);
+  expected.jacobianThreshold(0.01);
 
   // Serialize the constraint into an archive
   std::stringstream stream;
@@ -335,4 +336,5 @@ TEST(AbsolutePose2DStampedConstraint, Serialization)
   EXPECT_EQ(expected.variables(), actual.variables());
   EXPECT_MATRIX_EQ(expected.mean(), actual.mean());
   EXPECT_MATRIX_EQ(expected.sqrtInformation(), actual.sqrtInformation());
+  EXPECT_EQ(expected.jacobianThreshold(), actual.jacobianThreshold());
 }
@@ -262,6 +262,7 @@ TEST(AbsolutePose3DStampedConstraint, Serialization)
 
   AbsolutePose3DStampedConstraint expected("test", position_variable, orientation_variable, mean,
     cov);
+  expected.jacobianThreshold(0.01);
 
   // Serialize the constraint into an archive
   std::stringstream stream;
@@ -282,4 +283,5 @@ TEST(AbsolutePose3DStampedConstraint, Serialization)
   EXPECT_EQ(expected.variables(), actual.variables());
   EXPECT_MATRIX_EQ(expected.mean(), actual.mean());
   EXPECT_MATRIX_EQ(expected.sqrtInformation(), actual.sqrtInformation());
+  EXPECT_EQ(expected.jacobianThreshold(), actual.jacobianThreshold());
 }
@@ -0,0 +1,150 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2018, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <ceres/sized_cost_function.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+
+#include "cost_function_gtest.hpp"
+#include <fuse_constraints/first_estimate_cost_function.hpp>
+
+/**
+ * @brief A nonlinear cost function that counts how many times its Jacobians are computed
+ *
+ * residuals = [x0 * y0, x0^2 + y1]
+ */
+class CountingCostFunction : public ceres::SizedCostFunction<2, 1, 2>
+{
+public:
+  explicit CountingCostFunction(size_t * jacobian_count)
+  : jacobian_count_(jacobian_count)
+  {
+  }
+
+  bool Evaluate(
+    double const * const * parameters,
+    double * residuals,
+    double ** jacobians) const override
+  {
+    const double x0 = parameters[0][0];
+    const double y0 = parameters[1][0];
+    const double y1 = parameters[1][1];
+    residuals[0] = x0 * y0;
+    residuals[1] = x0 * x0 + y1;
+
+    if (jacobians) {
+      ++(*jacobian_count_);
+      if (jacobians[0]) {
+        jacobians[0][0] = y0;
+        jacobians[0][1] = 2.0 * x0;
+      }
+      if (jacobians[1]) {
+        jacobians[1][0] = x0;
+        jacobians[1][1] = 0.0;
+        jacobians[1][2] = 0.0;
+        jacobians[1][3] = 1.0;
+      }
+    }
+    return true;
+  }
+
+private:
+  size_t * jacobian_count_;
+};
+
+TEST(FirstEstimateCostFunction, EqualsWrappedCostFunction)
+{
+  size_t expected_count{0};
+  size_t count{0};
+  const CountingCostFunction expected_cost_function(&expected_count);
+  const fuse_constraints::FirstEstimateCostFunction cost_function(
+    new CountingCostFunction(&count), 0.0);
+
+  ExpectCostFunctionsAreEqual(expected_cost_function, cost_function);
+}
+
+TEST(FirstEstimateCostFunction, ReusesJacobiansWithinThreshold)
+{
+  size_t count{0};
+  const fuse_constraints::FirstEstimateCostFunction cost_function(
+    new CountingCostFunction(&count), 0.1);
+
+  double x[1] = {1.0};
+  double y[2] = {2.0, 3.0};
+  const double * parameters[2] = {x, y};
+  double residuals[2];
+  double jacobian_x[2];
+  double jacobian_y[4];
+  double * jacobians[2] = {jacobian_x, jacobian_y};
+
+  // The first evaluation computes the Jacobians
+  ASSERT_TRUE(cost_function.Evaluate(parameters, residuals, jacobians));
+  EXPECT_EQ(1u, count);
+  EXPECT_DOUBLE_EQ(2.0, jacobian_x[0]);
+  EXPECT_DOUBLE_EQ(2.0, jacobian_x[1]);
+
+  // Evaluating the residuals only does not compute any Jacobians
+  ASSERT_TRUE(cost_function.Evaluate(parameters, residuals, nullptr));
+  EXPECT_EQ(1u, count);
+
+  // Moving the parameters less than the threshold reuses the Jacobians, but updates the residuals
+  x[0] = 1.05;
+  y[0] = 1.95;
+  ASSERT_TRUE(cost_function.Evaluate(parameters, residuals, jacobians));
+  EXPECT_EQ(1u, count);
+  EXPECT_DOUBLE_EQ(1.05 * 1.95, residuals[0]);
+  EXPECT_DOUBLE_EQ(1.05 * 1.05 + 3.0, residuals[1]);
+  EXPECT_DOUBLE_EQ(2.0, jacobian_x[0]);
+  EXPECT_DOUBLE_EQ(2.0, jacobian_x[1]);
+  EXPECT_DOUBLE_EQ(1.0, jacobian_y[0]);
+
+  // Moving any parameter more than the threshold computes the Jacobians again
+  y[1] = 3.5;
+  ASSERT_TRUE(cost_function.Evaluate(parameters, residuals, jacobians));
+  EXPECT_EQ(2u, count);
+  EXPECT_DOUBLE_EQ(1.95, jacobian_x[0]);
+  EXPECT_DOUBLE_EQ(2.1, jacobian_x[1]);
+  EXPECT_DOUBLE_EQ(1.05, jacobian_y[0]);
+
+  // A Jacobian that was never requested is not cached, so requesting it computes it
+  fuse_constraints::FirstEstimateCostFunction partial_cost_function(
+    new CountingCostFunction(&count), 0.1);
+  double * x_jacobian_only[2] = {jacobian_x, nullptr};
+  ASSERT_TRUE(partial_cost_function.Evaluate(parameters, residuals, x_jacobian_only));
+  EXPECT_EQ(3u, count);
+  ASSERT_TRUE(partial_cost_function.Evaluate(parameters, residuals, x_jacobian_only));
+  EXPECT_EQ(3u, count);
+  ASSERT_TRUE(partial_cost_function.Evaluate(parameters, residuals, jacobians));
+  EXPECT_EQ(4u, count);
+}
@@ -0,0 +1,106 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2018, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <ceres/normal_prior.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "cost_function_gtest.hpp"
+#include <fuse_constraints/fixed_size_normal_prior.hpp>
+#include <fuse_core/eigen.hpp>
+
+TEST(FixedSizeNormalPrior, EqualsCeresNormalPriorForFullResiduals)
+{
+  fuse_core::Matrix3d covariance;
+  /* *INDENT-OFF* */
+  covariance << 1.0, 0.1, 0.2,
+                0.1, 2.0, 0.3,
+                0.2, 0.3, 3.0;
+  /* *INDENT-ON* */
+  const fuse_core::MatrixXd sqrt_information = covariance.inverse().llt().matrixU();
+  const fuse_core::VectorXd mean = fuse_core::Vector3d(1.0, -2.0, 3.0);
+
+  const ceres::NormalPrior expected_cost_function(sqrt_information, mean);
+  const fuse_constraints::FixedSizeNormalPrior<3, 3> cost_function(sqrt_information, mean);
+
+  ExpectCostFunctionsAreEqual(expected_cost_function, cost_function, 1e-15);
+}
+
+TEST(FixedSizeNormalPrior, EqualsCeresNormalPriorForPartialResiduals)
+{
+  fuse_core::MatrixXd sqrt_information(2, 3);
+  /* *INDENT-OFF* */
+  sqrt_information << 1.0, 0.0, 0.5,
+                      0.0, 0.0, 2.0;
+  /* *INDENT-ON* */
+  const fuse_core::VectorXd mean = fuse_core::Vector3d(1.0, 0.0, 3.0);
+
+  const ceres::NormalPrior expected_cost_function(sqrt_information, mean);
+  const fuse_constraints::FixedSizeNormalPrior<2, 3> cost_function(sqrt_information, mean);
+
+  ExpectCostFunctionsAreEqual(expected_cost_function, cost_function, 1e-15);
+}
+
+TEST(FixedSizeNormalPrior, EqualsCeresNormalPriorForScalars)
+{
+  const fuse_core::MatrixXd sqrt_information = fuse_core::Matrix1d(2.0);
+  const fuse_core::VectorXd mean = fuse_core::Vector1d(-1.0);
+
+  const ceres::NormalPrior expected_cost_function(sqrt_information, mean);
+  const fuse_constraints::FixedSizeNormalPrior<1, 1> cost_function(sqrt_information, mean);
+
+  ExpectCostFunctionsAreEqual(expected_cost_function, cost_function, 1e-15);
+}
+
+TEST(FixedSizeNormalPrior, CreateSelectsResidualCount)
+{
+  const fuse_core::VectorXd mean = fuse_core::Vector3d(1.0, 2.0, 3.0);
+
+  for (int rows = 1; rows <= 3; ++rows) {
+    const fuse_core::MatrixXd sqrt_information = fuse_core::MatrixXd::Identity(rows, 3);
+    std::unique_ptr<ceres::CostFunction> cost_function(
+      fuse_constraints::createNormalPrior<3>(sqrt_information, mean));
+    EXPECT_EQ(rows, cost_function->num_residuals());
+    EXPECT_EQ(nullptr, dynamic_cast<ceres::NormalPrior *>(cost_function.get()));
+
+    const ceres::NormalPrior expected_cost_function(sqrt_information, mean);
+    ExpectCostFunctionsAreEqual(expected_cost_function, *cost_function, 1e-15);
+  }
+
+  // More residuals than variable dimensions falls back to the dynamically sized cost function
+  const fuse_core::MatrixXd sqrt_information = fuse_core::MatrixXd::Identity(4, 3);
+  std::unique_ptr<ceres::CostFunction> cost_function(
+    fuse_constraints::createNormalPrior<3>(sqrt_information, mean));
+  EXPECT_NE(nullptr, dynamic_cast<ceres::NormalPrior *>(cost_function.get()));
+}
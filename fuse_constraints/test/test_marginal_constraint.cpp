@@ -246,6 +246,7 @@ TEST(MarginalConstraint, Serialization)
     A.begin(),
     A.end(),
     b);
+  expected.jacobianThreshold(0.01);
 
   // Serialize the constraint into an archive
   std::stringstream stream;
@@ -267,6 +268,7 @@ TEST(MarginalConstraint, Serialization)
   EXPECT_EQ(expected.A(), actual.A());
   EXPECT_EQ(expected.b(), actual.b());
   EXPECT_EQ(expected.x_bar(), actual.x_bar());
+  EXPECT_EQ(expected.jacobianThreshold(), actual.jacobianThreshold());
   // The shared ptrs will not be the same instances, but they should point to the same types
   using ExpectedLocalParam = fuse_variables::Orientation3DLocalParameterization;
   ASSERT_EQ(expected.localParameterizations().size(), actual.localParameterizations().size());
@@ -42,6 +42,7 @@
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/export.hpp>
 #include <fuse_constraints/absolute_orientation_3d_stamped_constraint.hpp>
+#include <fuse_constraints/marginal_constraint.hpp>
 #include <fuse_constraints/marginalize_variables.hpp>
 #include <fuse_constraints/relative_orientation_3d_stamped_constraint.hpp>
 #include <fuse_constraints/uuid_ordering.hpp>
@@ -588,6 +589,56 @@ TEST(MarginalizeVariables, MarginalizeVariables)
   }
 }
 
+TEST(MarginalizeVariables, MarginalizeVariablesJacobianThreshold)
+{
+  // Create variables
+  auto x1 = fuse_variables::Orientation3DStamped::make_shared(rclcpp::Time(1.0));
+  x1->w() = 0.927362;
+  x1->x() = 0.1;
+  x1->y() = 0.2;
+  x1->z() = 0.3;
+  auto x2 = fuse_variables::Orientation3DStamped::make_shared(rclcpp::Time(2.0));
+  x2->w() = 0.848625;
+  x2->x() = 0.13798;
+  x2->y() = 0.175959;
+  x2->z() = 0.479411;
+
+  // Create some constraints
+  fuse_core::Vector4d mean1;
+  mean1 << 0.92736185, 0.1, 0.2, 0.3;
+  fuse_core::Matrix3d cov1;
+  cov1 << 1.0, 0.0, 0.0, 0.0, 2.0, 0.0, 0.0, 0.0, 3.0;
+  auto prior_x1 = fuse_constraints::AbsoluteOrientation3DStampedConstraint::make_shared(
+    "test", *x1, mean1, cov1);
+
+  fuse_core::Vector4d delta2;
+  delta2 << 0.979795897, 0.0, 0.0, 0.2;
+  fuse_core::Matrix3d cov2;
+  cov2 << 1.0, 0.0, 0.0, 0.0, 2.0, 0.0, 0.0, 0.0, 3.0;
+  auto relative_x1_x2 = fuse_constraints::RelativeOrientation3DStampedConstraint::make_shared(
+    "test", *x1, *x2, delta2, cov2);
+
+  // Add to the graph
+  auto graph = fuse_graphs::HashGraph();
+  graph.addVariable(x1);
+  graph.addVariable(x2);
+  graph.addConstraint(prior_x1);
+  graph.addConstraint(relative_x1_x2);
+
+  // Marginalize out X1, requesting a Jacobian threshold on the marginal constraints
+  auto transaction =
+    fuse_constraints::marginalizeVariables("test", {x1->uuid()}, graph, 0.01);  // NOLINT
+
+  // Verify the threshold was passed to every marginal constraint
+  auto added_constraints = transaction.addedConstraints();
+  ASSERT_EQ(1u, std::distance(added_constraints.begin(), added_constraints.end()));
+  for (const auto & constraint : added_constraints) {
+    auto marginal = dynamic_cast<const fuse_constraints::MarginalConstraint *>(&constraint);
+    ASSERT_NE(nullptr, marginal);
+    EXPECT_EQ(0.01, marginal->jacobianThreshold());
+  }
+}
+
 TEST(MarginalizeVariables, MarginalizeFixedVariables)
 {
   // Create variables
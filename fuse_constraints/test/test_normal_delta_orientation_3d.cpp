@@ -0,0 +1,56 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2020, Clearpath Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <ceres/autodiff_cost_function.h>
+#include <Eigen/Dense>
+#include <gtest/gtest.h>
+
+#include "cost_function_gtest.hpp"
+#include <fuse_constraints/normal_delta_orientation_3d.hpp>
+#include <fuse_constraints/normal_delta_orientation_3d_cost_functor.hpp>
+#include <fuse_core/eigen.hpp>
+
+TEST(NormalDeltaOrientation3D, AnalyticAndAutoDiffCostFunctionsAreEqual)
+{
+  const fuse_core::Matrix3d covariance = fuse_core::Vector3d(2e-3, 1e-3, 1e-2).asDiagonal();
+  const fuse_core::Matrix3d sqrt_information = covariance.inverse().llt().matrixU();
+  const fuse_core::Vector4d delta{0.9, 0.1, -0.2, 0.3};
+
+  const fuse_constraints::NormalDeltaOrientation3D cost_function{sqrt_information, delta};
+
+  ceres::AutoDiffCostFunction<fuse_constraints::NormalDeltaOrientation3DCostFunctor, 3, 4, 4>
+  autodiff_cost_function(
+    new fuse_constraints::NormalDeltaOrientation3DCostFunctor(sqrt_information, delta));
+
+  ExpectCostFunctionsAreEqual(autodiff_cost_function, cost_function, 1e-12);
+}
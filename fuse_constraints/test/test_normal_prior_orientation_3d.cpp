@@ -0,0 +1,99 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2020, Clearpath Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <ceres/autodiff_cost_function.h>
+#include <Eigen/Dense>
+#include <gtest/gtest.h>
+
+#include "cost_function_gtest.hpp"
+#include <fuse_constraints/normal_prior_orientation_3d.hpp>
+#include <fuse_constraints/normal_prior_orientation_3d_cost_functor.hpp>
+#include <fuse_core/eigen.hpp>
+
+/**
+ * @brief Test fixture that initializes a 3D orientation mean and sqrt information matrix.
+ */
+class NormalPriorOrientation3DTestFixture : public ::testing::Test
+{
+public:
+  //!< The automatic differentiation cost function type for the orientation 3d cost functor
+  using AutoDiffNormalPriorOrientation3D =
+    ceres::AutoDiffCostFunction<fuse_constraints::NormalPriorOrientation3DCostFunctor, 3, 4>;
+
+  /**
+   * @brief Constructor
+   */
+  NormalPriorOrientation3DTestFixture()
+  {
+    sqrt_information = covariance.inverse().llt().matrixU();
+  }
+
+  const fuse_core::Matrix3d covariance =
+    fuse_core::Vector3d(2e-3, 1e-3, 1e-2).asDiagonal();  //!< The orientation covariance
+  fuse_core::Matrix3d sqrt_information;  //!< The orientation sqrt information matrix
+  const fuse_core::Vector4d mean{0.9, 0.1, -0.2, 0.3};  //!< The orientation mean: qw, qx, qy, qz
+};
+
+TEST_F(NormalPriorOrientation3DTestFixture, AnalyticAndAutoDiffCostFunctionsAreEqual)
+{
+  const fuse_constraints::NormalPriorOrientation3D cost_function{sqrt_information, mean};
+
+  AutoDiffNormalPriorOrientation3D autodiff_cost_function(
+    new fuse_constraints::NormalPriorOrientation3DCostFunctor(sqrt_information, mean));
+
+  ExpectCostFunctionsAreEqual(autodiff_cost_function, cost_function, 1e-12);
+}
+
+TEST_F(NormalPriorOrientation3DTestFixture, AnalyticAndAutoDiffJacobiansAreEqualAtTheMean)
+{
+  // The orientation error is exactly the identity, so both take the zero rotation branch
+  const fuse_constraints::NormalPriorOrientation3D cost_function{sqrt_information, mean};
+
+  AutoDiffNormalPriorOrientation3D autodiff_cost_function(
+    new fuse_constraints::NormalPriorOrientation3DCostFunctor(sqrt_information, mean));
+
+  const double * parameters[] = {mean.data()};
+  fuse_core::Vector3d residuals;
+  fuse_core::Vector3d autodiff_residuals;
+  fuse_core::Matrix<double, 3, 4> jacobian;
+  fuse_core::Matrix<double, 3, 4> autodiff_jacobian;
+  double * jacobians[] = {jacobian.data()};
+  double * autodiff_jacobians[] = {autodiff_jacobian.data()};
+  EXPECT_TRUE(cost_function.Evaluate(parameters, residuals.data(), jacobians));
+  EXPECT_TRUE(
+    autodiff_cost_function.Evaluate(parameters, autodiff_residuals.data(), autodiff_jacobians));
+
+  EXPECT_TRUE(residuals.isZero());
+  EXPECT_TRUE(autodiff_residuals.isZero());
+  EXPECT_TRUE(jacobian.isApprox(autodiff_jacobian, 1e-12));
+}
@@ -0,0 +1,67 @@
+# Copyright 2022 Open Source Robotics Foundation, Inc.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+#    * Redistributions of source code must retain the above copyright
+#      notice, this list of conditions and the following disclaimer.
+#
+#    * Redistributions in binary form must reproduce the above copyright
+#      notice, this list of conditions and the following disclaimer in the
+#      documentation and/or other materials provided with the distribution.
+#
+#    * Neither the name of the Open Source Robotics Foundation, Inc. nor the names of its
+#      contributors may be used to endorse or promote products derived from
+#      this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+
+# fuse_add_benchmarks(<name>... [LIBRARIES <library>...] [INCLUDE_DIRS <dir>...])
+#
+# Build a Google Benchmark executable for each <name> from <name>.cpp in the current source
+# directory, linked against benchmark::benchmark and LIBRARIES. Also add a run_benchmarks target
+# that runs every benchmark and writes the results as JSON files into the build directory, with:
+#   cmake --build <build directory> --target run_benchmarks
+#
+# Nothing is added if the benchmark package is not found.
+function(fuse_add_benchmarks)
+  cmake_parse_arguments(ARG "" "" "LIBRARIES;INCLUDE_DIRS" ${ARGN})
+
+  find_package(benchmark QUIET)
+  if(NOT benchmark_FOUND)
+    return()
+  endif()
+
+  set(results_dir "${CMAKE_CURRENT_BINARY_DIR}/results")
+  set(commands COMMAND ${CMAKE_COMMAND} -E make_directory "${results_dir}")
+  foreach(benchmark_name ${ARG_UNPARSED_ARGUMENTS})
+    add_executable("${benchmark_name}" "${benchmark_name}.cpp")
+    target_include_directories("${benchmark_name}" PRIVATE ${ARG_INCLUDE_DIRS})
+    target_link_libraries("${benchmark_name}"
+      benchmark::benchmark
+      ${ARG_LIBRARIES}
+    )
+    list(APPEND commands
+      COMMAND "$<TARGET_FILE:${benchmark_name}>"
+        "--benchmark_out=${results_dir}/${benchmark_name}.json"
+        --benchmark_out_format=json
+    )
+  endforeach()
+
+  add_custom_target(run_benchmarks
+    ${commands}
+    DEPENDS ${ARG_UNPARSED_ARGUMENTS}
+    COMMENT "Running the ${PROJECT_NAME} benchmarks"
+    VERBATIM
+  )
+endfunction()
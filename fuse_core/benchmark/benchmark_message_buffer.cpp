@@ -0,0 +1,143 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2018, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+
+#include <fuse_core/message_buffer.hpp>
+#include <fuse_core/ring_message_buffer.hpp>
+#include <rclcpp/duration.hpp>
+#include <rclcpp/time.hpp>
+
+namespace
+{
+
+// A message the size of a typical IMU sample
+using Message = std::array<double, 10>;
+
+// Messages are received at 1 kHz
+constexpr int64_t kMessagePeriod = 1000000;
+
+rclcpp::Time messageStamp(const int64_t index)
+{
+  return rclcpp::Time(index * kMessagePeriod);
+}
+
+rclcpp::Duration bufferLength(const int64_t history_size)
+{
+  return rclcpp::Duration::from_nanoseconds(history_size * kMessagePeriod);
+}
+
+// The ring buffer capacity holds the purged history with some margin
+size_t ringCapacity(const int64_t history_size)
+{
+  return 2 * history_size;
+}
+
+template<typename Buffer>
+void fill(Buffer & buffer, const int64_t history_size, int64_t & index)
+{
+  const Message message{};
+  for (const int64_t end = index + 2 * history_size; index < end; ++index) {
+    buffer.insert(messageStamp(index), message);
+  }
+}
+
+template<typename Buffer>
+void insertBenchmark(benchmark::State & state, Buffer & buffer)
+{
+  const auto history_size = state.range(0);
+  int64_t index = 0;
+  fill(buffer, history_size, index);
+
+  const Message message{};
+  for (auto _ : state) {
+    buffer.insert(messageStamp(index), message);
+    ++index;
+  }
+}
+
+template<typename Buffer>
+void queryBenchmark(benchmark::State & state, Buffer & buffer)
+{
+  const auto history_size = state.range(0);
+  int64_t index = 0;
+  fill(buffer, history_size, index);
+
+  // Query the middle half of the history, as a motion model generating a constraint would
+  const auto beginning_stamp = messageStamp(index - 3 * history_size / 4);
+  const auto ending_stamp = messageStamp(index - history_size / 4);
+  for (auto _ : state) {
+    double sum = 0.0;
+    for (const auto & element : buffer.query(beginning_stamp, ending_stamp)) {
+      sum += element.second[0];
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+}
+
+}  // namespace
+
+static void BM_MessageBufferInsert(benchmark::State & state)
+{
+  fuse_core::MessageBuffer<Message> buffer(bufferLength(state.range(0)));
+  insertBenchmark(state, buffer);
+}
+BENCHMARK(BM_MessageBufferInsert)->RangeMultiplier(8)->Range(8, 4096);
+
+static void BM_RingMessageBufferInsert(benchmark::State & state)
+{
+  fuse_core::RingMessageBuffer<Message> buffer(
+    ringCapacity(state.range(0)), bufferLength(state.range(0)));
+  insertBenchmark(state, buffer);
+}
+BENCHMARK(BM_RingMessageBufferInsert)->RangeMultiplier(8)->Range(8, 4096);
+
+static void BM_MessageBufferQuery(benchmark::State & state)
+{
+  fuse_core::MessageBuffer<Message> buffer(bufferLength(state.range(0)));
+  queryBenchmark(state, buffer);
+}
+BENCHMARK(BM_MessageBufferQuery)->RangeMultiplier(8)->Range(8, 4096);
+
+static void BM_RingMessageBufferQuery(benchmark::State & state)
+{
+  fuse_core::RingMessageBuffer<Message> buffer(
+    ringCapacity(state.range(0)), bufferLength(state.range(0)));
+  queryBenchmark(state, buffer);
+}
+BENCHMARK(BM_RingMessageBufferQuery)->RangeMultiplier(8)->Range(8, 4096);
+
+BENCHMARK_MAIN();
@@ -35,6 +35,7 @@
 #define FUSE_CORE__ASYNC_MOTION_MODEL_HPP_
 
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include <fuse_core/callback_wrapper.hpp>
@@ -125,6 +126,11 @@ public:
    * multi-threaded executor, then normal multithreading rules apply and data accessed in more
    * than one place should be guarded.
    *
+   * If the "latest_graph_only" parameter is enabled for this motion model, at most one call to
+   * onGraphUpdate() is pending at any time. A graph received while a previous one is still waiting
+   * in the callback queue replaces it, so a slow motion model only ever processes the most recent
+   * graph and outdated graph copies are released immediately.
+   *
    * @param[in] graph A read-only pointer to the graph object, allowing queries to be performed
    *                  whenever needed.
    */
@@ -205,6 +211,9 @@ protected:
   std::thread spinner_;  //!< Internal thread for spinning the executor
   std::atomic<bool> initialized_ = false;  //!< True if instance has been fully initialized
 
+  //! Replace pending graph updates with newer ones instead of queuing every graph
+  bool latest_graph_only_{false};
+
   /**
    * @brief Constructor
    *
@@ -280,6 +289,16 @@ protected:
   virtual void onStop() {}
 
 private:
+  std::mutex pending_graph_mutex_;  //!< Guards the pending graph update
+  Graph::ConstSharedPtr pending_graph_;  //!< The most recent graph not yet sent to onGraphUpdate()
+  bool graph_update_queued_{false};  //!< True if a pending graph callback is in the callback queue
+
+  /**
+   * @brief Callback fired in the local callback queue thread(s) to deliver the most recent graph
+   *        to onGraphUpdate() when the "latest_graph_only" mode is enabled
+   */
+  void pendingGraphCallback();
+
   //! Stop the internal executor thread (in order to use this class again it must be re-initialized)
   void internal_stop();
 };
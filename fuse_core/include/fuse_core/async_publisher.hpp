@@ -36,6 +36,7 @@
 
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 
@@ -106,6 +107,12 @@ public:
    * publisher will be executed from the same thread (or group of threads if a \p thread_count
    * > 1 is used in the constructor).
    *
+   * If the "latest_graph_only" parameter is enabled for this publisher, at most one call to
+   * notifyCallback() is pending at any time. A notification received while a previous one is still
+   * waiting in the callback queue replaces it: the pending graph is swapped for the new one, and
+   * the new transaction is merged into the pending transaction so that no variable or constraint
+   * changes are lost.
+   *
    * @param[in] transaction A Transaction object, describing the set of variables that have been
    *                        added and/or removed
    * @param[in] graph       A read-only pointer to the graph object, allowing queries to be
@@ -166,6 +173,9 @@ protected:
   std::thread spinner_;  //!< Internal thread for spinning the executor
   std::atomic<bool> initialized_ = false;  //!< True if instance has been fully initialized
 
+  //! Replace pending notifications with newer ones instead of queuing every graph
+  bool latest_graph_only_{false};
+
   /**
    * @brief Constructor
    *
@@ -221,10 +231,38 @@ protected:
   virtual void onStop() {}
 
 private:
+  std::mutex pending_notify_mutex_;  //!< Guards the pending notification
+  Transaction::ConstSharedPtr pending_transaction_;  //!< Changes not yet sent to notifyCallback()
+  Graph::ConstSharedPtr pending_graph_;  //!< The most recent graph not yet sent to notifyCallback()
+  bool notify_queued_{false};  //!< True if a pending notify callback is in the callback queue
+
+  /**
+   * @brief Callback fired in the local callback queue thread(s) to deliver the most recent
+   *        notification to notifyCallback() when the "latest_graph_only" mode is enabled
+   */
+  void pendingNotifyCallback();
+
   //! Stop the internal executor thread (in order to use this class again it must be re-initialized)
   void internal_stop();
 };
 
+/**
+ * @brief Coalesce an optimizer notification into one still waiting to be delivered
+ *
+ * The graph is simply swapped for the newer one, but the transactions are merged so the receiver
+ * still sees every change.
+ *
+ * @param[in,out] pending_transaction - The transaction of the waiting notification
+ * @param[in,out] pending_graph - The graph of the waiting notification
+ * @param[in] transaction - The transaction of the newer notification
+ * @param[in] graph - The graph of the newer notification
+ */
+void coalesceNotification(
+  Transaction::ConstSharedPtr & pending_transaction,
+  Graph::ConstSharedPtr & pending_graph,
+  Transaction::ConstSharedPtr transaction,
+  Graph::ConstSharedPtr graph);
+
 }  // namespace fuse_core
 
 #endif  // FUSE_CORE__ASYNC_PUBLISHER_HPP_
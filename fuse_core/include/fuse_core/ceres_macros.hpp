@@ -46,4 +46,10 @@
                                                                      CERES_VERSION_REVISION >= z))))
 /* *INDENT-ON* */
 
+/**
+ * The ceres::Manifold interface was introduced in Ceres Solver 2.1.0 to replace the deprecated
+ * ceres::LocalParameterization interface.
+ */
+#define CERES_SUPPORTS_MANIFOLDS CERES_VERSION_AT_LEAST(2, 1, 0)
+
 #endif  // FUSE_CORE__CERES_MACROS_HPP_
@@ -301,6 +301,19 @@ public:
     return loss_ ? loss_->lossFunction() : nullptr;
   }
 
+  /**
+   * @brief Read-only access to the shared Ceres loss function.
+   *
+   * See Loss::sharedLossFunction(). The caller does not take ownership of the returned object.
+   *
+   * @return A base pointer to the shared instance of a derived ceres::LossFunction, or nullptr if
+   *         there is no loss or it does not provide a shared instance.
+   */
+  ceres::LossFunction * sharedLossFunction() const
+  {
+    return loss_ ? loss_->sharedLossFunction() : nullptr;
+  }
+
   /**
    * @brief Perform a deep copy of the Constraint and return a unique pointer to the copy
    *
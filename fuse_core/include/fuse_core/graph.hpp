@@ -572,8 +572,14 @@ void Graph::getConstraintCosts(
       std::inner_product(
         cost.residuals.begin(), cost.residuals.end(),
         cost.residuals.begin(), 0.0));
-    // Apply the loss function, if one is configured
-    auto loss_function = std::unique_ptr<ceres::LossFunction>(constraint.lossFunction());
+    // Apply the loss function, if one is configured. Prefer the shared loss function, and only
+    // own the object created by the deprecated Loss::lossFunction().
+    std::unique_ptr<ceres::LossFunction> owned_loss_function;
+    auto loss_function = constraint.sharedLossFunction();
+    if (!loss_function) {
+      owned_loss_function.reset(constraint.lossFunction());
+      loss_function = owned_loss_function.get();
+    }
     if (loss_function) {
       double loss_result[3];  // The Loss function returns the loss-adjusted cost plus the first and
                               // second derivative
@@ -59,6 +59,11 @@ class LocalParameterization : public ceres::LocalParameterization
 public:
   FUSE_SMART_PTR_ALIASES_ONLY(LocalParameterization)
 
+  static constexpr ceres::Ownership Ownership =
+    ceres::Ownership::DO_NOT_TAKE_OWNERSHIP;  //!< The ownership of the LocalParameterization*
+                                              //!< returned by
+                                              //!< Variable::sharedLocalParameterization()
+
   /**
    * @brief Generalization of the subtraction operation
    *
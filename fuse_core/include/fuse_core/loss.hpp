@@ -36,8 +36,13 @@
 
 #include <ceres/loss_function.h>
 
+#include <cstddef>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <tuple>
 
 #include <boost/serialization/access.hpp>
 #include <boost/type_index/stl_type_index.hpp>
@@ -177,6 +182,10 @@ public:
     ceres::Ownership::TAKE_OWNERSHIP;    //!< The ownership of the ceres::LossFunction* returned by
                                          //!< lossFunction()
 
+  static constexpr ceres::Ownership SharedOwnership =
+    ceres::Ownership::DO_NOT_TAKE_OWNERSHIP;  //!< The ownership of the ceres::LossFunction*
+                                              //!< returned by sharedLossFunction()
+
   /**
    * @brief Default constructor
    */
@@ -228,10 +237,69 @@ public:
    * will be destroyed before the Loss Function objects). This guarantee may allow
    * optimizations for the creation of the loss function objects.
    *
+   * @deprecated Override \p sharedLossFunction() as well. fuse only calls this method for losses
+   * that do not provide a shared instance, and a future release will make the shared instance the
+   * only interface. Until then, losses that provide a shared instance should still return a new
+   * object here, for callers that have not migrated yet.
+   *
    * @return A base pointer to an instance of a derived ceres::LossFunction.
    */
   virtual ceres::LossFunction * lossFunction() const = 0;
 
+  /**
+   * @brief Access a shared ceres::LossFunction that implements the loss function
+   *
+   * Unlike \p lossFunction(), the caller does NOT take ownership of the returned object (see
+   * Loss::SharedOwnership), and it may be shared between any number of constraints, graphs, and
+   * threads. Stateless losses should return a single, immortal instance per loss configuration,
+   * e.g. through fuse_core::sharedLossFunctionInstance(), so a graph where most constraints share
+   * one loss configuration does not allocate a ceres::LossFunction per residual block.
+   *
+   * If a null pointer is returned (the default), the loss does not provide a shared instance and
+   * callers fall back to \p lossFunction().
+   *
+   * @return A base pointer to the shared instance of a derived ceres::LossFunction, or nullptr
+   */
+  virtual ceres::LossFunction * sharedLossFunction() const
+  {
+    return nullptr;
+  }
+
+  /**
+   * @brief The number of graduated non-convexity (GNC) stages of the loss function
+   *
+   * A loss function with a GNC schedule starts each optimization as a convex surrogate of itself
+   * and is tightened one stage at a time. The graph drives the schedule, running one solve per
+   * stage and warm-starting each from the previous one, so an optimization with a GNC loss costs
+   * gncStages() + 1 Ceres solves. The last stage, gncStages(), is the loss function itself. Loss
+   * functions without a schedule return 0.
+   *
+   * The stage is per-problem state, so losses with a schedule must not provide a
+   * sharedLossFunction(). The graph creates its own instance with lossFunction() for every problem
+   * instead, and moves it through the stages with gncStage().
+   *
+   * @return The index of the last GNC stage
+   */
+  virtual size_t gncStages() const
+  {
+    return 0;
+  }
+
+  /**
+   * @brief Move a loss function created by lossFunction() to a graduated non-convexity stage
+   *
+   * New loss functions start at the last stage, gncStages(), so they behave as the loss function
+   * itself unless an optimizer walks them through the schedule.
+   *
+   * @param[in] loss_function A loss function returned by lossFunction() on this Loss
+   * @param[in] stage         The GNC stage, in the range [0, gncStages()]
+   */
+  virtual void gncStage(
+    ceres::LossFunction * /* loss_function */,
+    const size_t /* stage */) const
+  {
+  }
+
   /**
    * @brief Perform a deep copy of the Loss and return a unique pointer to the copy
    *
@@ -314,6 +382,32 @@ private:
  */
 std::ostream & operator<<(std::ostream & stream, const Loss & loss);
 
+/**
+ * @brief Return the shared instance of a ceres::LossFunction for the provided constructor
+ *        arguments
+ *
+ * One instance is created per distinct set of arguments and it is never destroyed, which is what
+ * allows Loss::sharedLossFunction() to return it with Loss::SharedOwnership. The set of instances
+ * is bounded by the number of distinct loss configurations used by the process.
+ *
+ * @param[in] args The ceres::LossFunction constructor arguments
+ * @return A pointer to the shared LossFunctionType instance
+ */
+template<typename LossFunctionType, typename ... Args>
+LossFunctionType * sharedLossFunctionInstance(const Args... args)
+{
+  using Key = std::tuple<Args...>;
+  static std::mutex mutex;
+  static auto * const instances = new std::map<Key, std::unique_ptr<LossFunctionType>>();
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto & instance = (*instances)[Key(args ...)];
+  if (!instance) {
+    instance = std::make_unique<LossFunctionType>(args ...);
+  }
+  return instance.get();
+}
+
 }  // namespace fuse_core
 
 #endif  // FUSE_CORE__LOSS_HPP_
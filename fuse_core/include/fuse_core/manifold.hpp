@@ -0,0 +1,94 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2019, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef FUSE_CORE__MANIFOLD_HPP_
+#define FUSE_CORE__MANIFOLD_HPP_
+
+#include <fuse_core/ceres_macros.hpp>
+
+#if CERES_SUPPORTS_MANIFOLDS
+#include <ceres/manifold.h>
+#include <ceres/types.h>
+
+#include <boost/serialization/access.hpp>
+#include <fuse_core/fuse_macros.hpp>
+#include <fuse_core/serialization.hpp>
+
+namespace fuse_core
+{
+
+/**
+ * @brief The Manifold interface definition.
+ *
+ * This is the ceres::Manifold counterpart of fuse_core::LocalParameterization. Ceres Solver 2.1
+ * and later evaluate manifolds directly, without wrapping them in an adapter, and the Minus()
+ * operation and its Jacobian are already part of the Ceres interface.
+ *
+ * Note that the ceres::Manifold argument order for Minus() differs from
+ * fuse_core::LocalParameterization:
+ *
+ *  Manifold::Minus(y, x) -> delta  ==  LocalParameterization::Minus(x, y) -> delta
+ *
+ * See the Ceres documentation for more details. http://ceres-solver.org/nnls_modeling.html#manifold
+ */
+class Manifold : public ceres::Manifold
+{
+public:
+  FUSE_SMART_PTR_ALIASES_ONLY(Manifold)
+
+  static constexpr ceres::Ownership Ownership =
+    ceres::Ownership::DO_NOT_TAKE_OWNERSHIP;  //!< The ownership of the Manifold* returned by
+                                              //!< Variable::manifold()
+
+private:
+  // Allow Boost Serialization access to private methods
+  friend class boost::serialization::access;
+
+  /**
+   * @brief The Boost Serialize method that serializes all of the data members in to/out of the
+   *        archive
+   *
+   * @param[in/out] archive - The archive object that holds the serialized class members
+   * @param[in] version - The version of the archive being read/written. Generally unused.
+   */
+  template<class Archive>
+  void serialize(Archive & /* archive */, const unsigned int /* version */)
+  {
+  }
+};
+
+}  // namespace fuse_core
+
+#endif  // CERES_SUPPORTS_MANIFOLDS
+
+#endif  // FUSE_CORE__MANIFOLD_HPP_
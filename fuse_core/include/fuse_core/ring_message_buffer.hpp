@@ -0,0 +1,305 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2018, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef FUSE_CORE__RING_MESSAGE_BUFFER_HPP_
+#define FUSE_CORE__RING_MESSAGE_BUFFER_HPP_
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/iterator/transform_iterator.hpp>
+#include <boost/range/iterator_range.hpp>
+#include <fuse_core/fuse_macros.hpp>
+#include <rclcpp/duration.hpp>
+#include <rclcpp/time.hpp>
+
+namespace fuse_core
+{
+
+/**
+ * @brief A fixed-capacity variant of the MessageBuffer, for high-rate message histories
+ *
+ * The messages are stored in a ring buffer allocated once at construction, so inserting and
+ * purging messages never allocates memory. Once the buffer is full, inserting a message drops the
+ * oldest one. The queries return ranges of random access iterators directly into the buffer,
+ * instead of the type-erased ranges of the MessageBuffer, so they can be binary searched and
+ * traversed without virtual calls.
+ *
+ * The query semantics are otherwise the same as the MessageBuffer. It is assumed that all messages
+ * are received sequentially.
+ */
+template<typename Message>
+class RingMessageBuffer
+{
+public:
+  FUSE_SMART_PTR_DEFINITIONS(RingMessageBuffer<Message>)
+
+  /**
+   * @brief The type of the buffer elements, a message and its timestamp
+   */
+  using value_type = std::pair<rclcpp::Time, Message>;
+
+  /**
+   * @brief A random access iterator over the elements of the ring buffer, from oldest to newest
+   */
+  class const_iterator : public boost::iterator_facade<const_iterator, const value_type,
+      boost::random_access_traversal_tag>
+  {
+public:
+    const_iterator() = default;
+
+private:
+    friend class boost::iterator_core_access;
+    friend class RingMessageBuffer;
+
+    const_iterator(
+      const value_type * storage, const size_t capacity, const size_t head,
+      const size_t index)
+    : storage_(storage), capacity_(capacity), head_(head), index_(index)
+    {
+    }
+
+    const value_type & dereference() const
+    {
+      // The head is less than the capacity, so a single subtraction wraps the position around
+      const size_t position = head_ + index_;
+      return storage_[position < capacity_ ? position : position - capacity_];
+    }
+
+    bool equal(const const_iterator & other) const
+    {
+      return index_ == other.index_;
+    }
+
+    void increment()
+    {
+      ++index_;
+    }
+
+    void decrement()
+    {
+      --index_;
+    }
+
+    void advance(const std::ptrdiff_t n)
+    {
+      index_ += n;
+    }
+
+    std::ptrdiff_t distance_to(const const_iterator & other) const
+    {
+      return static_cast<std::ptrdiff_t>(other.index_) - static_cast<std::ptrdiff_t>(index_);
+    }
+
+    const value_type * storage_ {nullptr};  //!< The ring buffer storage
+    size_t capacity_ {0};  //!< The number of elements in the storage
+    size_t head_ {0};  //!< The storage position of the oldest element
+    size_t index_ {0};  //!< The position of the element, relative to the oldest one
+  };
+
+  /**
+   * @brief A range of messages
+   *
+   * An object representing a range defined by two random access iterators. It has begin() and
+   * end() methods (which means it can be used in range-based for loops), empty(), size(), front()
+   * and back() methods, and an operator[]. When dereferenced, an iterator returns a
+   * const std::pair<rclcpp::Time, MESSAGE>&.
+   */
+  using message_range = boost::iterator_range<const_iterator>;
+
+  /**
+   * @brief A range of timestamps
+   *
+   * An object representing a range defined by two random access iterators. When dereferenced, an
+   * iterator returns a const rclcpp::Time&.
+   */
+  using stamp_range = boost::iterator_range<boost::transform_iterator<
+        const rclcpp::Time & (*)(const value_type &), const_iterator>>;
+
+  /**
+   * Constructor
+   *
+   * @param[in] capacity      The maximum number of messages in the buffer. The storage for all of
+   *                          them is allocated here. Must be at least 2.
+   * @param[in] buffer_length The length of the message buffer history. If queries arrive involving
+   *                          timestamps that are older than the buffer length, an exception will be
+   *                          thrown.
+   */
+  explicit RingMessageBuffer(
+    const size_t capacity,
+    const rclcpp::Duration & buffer_length = rclcpp::Duration::max());
+
+  /**
+   * @brief Destructor
+   */
+  virtual ~RingMessageBuffer() = default;
+
+  /**
+   * @brief Read-only access to the buffer length
+   */
+  const rclcpp::Duration & bufferLength() const
+  {
+    return buffer_length_;
+  }
+
+  /**
+   * @brief Write access to the buffer length
+   */
+  void bufferLength(const rclcpp::Duration & buffer_length)
+  {
+    buffer_length_ = buffer_length;
+  }
+
+  /**
+   * @brief The maximum number of messages in the buffer
+   */
+  size_t capacity() const
+  {
+    return storage_.size();
+  }
+
+  /**
+   * @brief The current number of messages in the buffer
+   */
+  size_t size() const
+  {
+    return size_;
+  }
+
+  /**
+   * @brief Returns true if there are no messages in the buffer
+   */
+  bool empty() const
+  {
+    return size_ == 0;
+  }
+
+  /**
+   * @brief Insert a message to the buffer, using the provided timestamp
+   *
+   * The provided timestamp is assigned to the message and used to sort the messages in the
+   * buffer. The message is copy-assigned into preallocated storage. If the buffer is full, the
+   * oldest message is dropped.
+   *
+   * @param[in] stamp The stamp to assign to the message
+   * @param[in] msg   A message
+   */
+  void insert(const rclcpp::Time & stamp, const Message & msg);
+
+  /**
+   * @brief Query the buffer for the set of messages between two timestamps
+   *
+   * The "edge behavior" is controlled by the \p extended_range flag. The returned range is
+   * invalidated by the next insertion.
+   *
+   * @param[in] beginning_stamp The beginning timestamp of the constraint. \p beginning_stamp must
+   *                            be less than or equal to \p ending_stamp.
+   * @param[in] ending_stamp    The ending timestamp of the constraint. \p ending_stamp must be
+   *                            greater than or or equal to \p beginning_stamp.
+   * @param[in] extended_range  A flag indicating if the message range should be extended to include
+   *                            one message with a stamp less than or equal to the \p
+   *                            beginning_stamp and one message with a stamp greater than or equal
+   *                            to the \p ending_stamp. If false, the returned range only includes
+   *                            messages with stamps greater than \p beginning_stamp and less than
+   *                            \p ending_stamp.
+   * @return                    An iterator range containing all of the messages between the
+   *                            specified stamps.
+   */
+  message_range query(
+    const rclcpp::Time & beginning_stamp, const rclcpp::Time & ending_stamp,
+    bool extended_range = true) const;
+
+  /**
+   * @brief Read-only access to the current set of timestamps
+   *
+   * @return An iterator range containing all known timestamps in ascending order
+   */
+  stamp_range stamps() const;
+
+protected:
+  using Storage = std::vector<value_type>;
+  Storage storage_;  //!< The preallocated ring buffer of received messages
+  size_t head_ {0};  //!< The storage position of the oldest message
+  size_t size_ {0};  //!< The number of messages in the buffer
+  rclcpp::Duration buffer_length_;  //!< The length of the motion model history. Segments older than
+                                    //!< \p buffer_length_ will be removed from the motion model
+                                    //!< history
+
+  /**
+   * @brief Iterator to the oldest message
+   */
+  const_iterator begin() const
+  {
+    return const_iterator(storage_.data(), storage_.size(), head_, 0);
+  }
+
+  /**
+   * @brief Iterator past the newest message
+   */
+  const_iterator end() const
+  {
+    return const_iterator(storage_.data(), storage_.size(), head_, size_);
+  }
+
+  /**
+   * @brief Helper function used with boost::transform_iterators to convert the internal Buffer
+   *        value type into a const rclcpp::Time& iterator compatible with stamp_range
+   */
+  static const rclcpp::Time & extractStamp(const value_type & element)
+  {
+    return element.first;
+  }
+
+  /**
+   * @brief Drop the \p count oldest messages
+   *
+   * The dropped messages are not destroyed, their storage is reused by the next insertions.
+   */
+  void popFront(const size_t count);
+
+  /**
+   * @brief Remove any motion model segments that are older than \p buffer_length_
+   *
+   * The span of the buffer will be *at least* the requested buffer length, but it may be
+   * longer depending on the specific stamps of received messages.
+   */
+  void purgeHistory();
+};
+
+}  // namespace fuse_core
+
+#include <fuse_core/ring_message_buffer_impl.hpp>
+
+#endif  // FUSE_CORE__RING_MESSAGE_BUFFER_HPP_
@@ -0,0 +1,201 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2018, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef FUSE_CORE__RING_MESSAGE_BUFFER_IMPL_HPP_
+#define FUSE_CORE__RING_MESSAGE_BUFFER_IMPL_HPP_
+
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <boost/iterator/transform_iterator.hpp>
+#include <rclcpp/duration.hpp>
+#include <rclcpp/time.hpp>
+
+namespace fuse_core
+{
+
+template<class Message>
+RingMessageBuffer<Message>::RingMessageBuffer(
+  const size_t capacity,
+  const rclcpp::Duration & buffer_length)
+: buffer_length_(buffer_length)
+{
+  // At least two entries are kept in the buffer at all times
+  if (capacity < 2) {
+    throw std::invalid_argument(
+            "The capacity (" + std::to_string(capacity) + ") must be at least 2.");
+  }
+  storage_.resize(capacity);
+}
+
+template<class Message>
+void RingMessageBuffer<Message>::insert(const rclcpp::Time & stamp, const Message & msg)
+{
+  if (size_ == storage_.size()) {
+    popFront(1);
+  }
+
+  const size_t position = head_ + size_;
+  auto & element = storage_[position < storage_.size() ? position : position - storage_.size()];
+  element.first = stamp;
+  element.second = msg;
+  ++size_;
+
+  purgeHistory();
+}
+
+template<class Message>
+typename RingMessageBuffer<Message>::message_range RingMessageBuffer<Message>::query(
+  const rclcpp::Time & beginning_stamp,
+  const rclcpp::Time & ending_stamp,
+  bool extended_range) const
+{
+  // Verify the query is valid
+  if (ending_stamp < beginning_stamp) {
+    std::stringstream beginning_time_ss;
+    beginning_time_ss << beginning_stamp.seconds();
+    std::stringstream ending_time_ss;
+    ending_time_ss << ending_stamp.seconds();
+    throw std::invalid_argument(
+            "The beginning_stamp (" + beginning_time_ss.str() + ") must be less than or equal to "
+            "the ending_stamp (" + ending_time_ss.str() + ").");
+  }
+  // Verify the query is within the bounds of the buffer
+  const auto buffer_begin = begin();
+  const auto buffer_end = end();
+  if (empty() || (beginning_stamp < buffer_begin->first) ||
+    (ending_stamp > std::prev(buffer_end)->first))
+  {
+    std::stringstream requested_time_range_ss;
+    requested_time_range_ss << "(" << beginning_stamp.seconds() << ", " << ending_stamp.seconds() <<
+      ")";
+    std::stringstream available_time_range_ss;
+    if (empty()) {
+      available_time_range_ss << "(EMPTY)";
+    } else {
+      available_time_range_ss << "(" << buffer_begin->first.seconds() << ", "
+                              << std::prev(buffer_end)->first.seconds() << ")";
+    }
+    throw std::out_of_range(
+            "The requested time range " + requested_time_range_ss.str() +
+            " is outside the available time range " + available_time_range_ss.str() + ".");
+  }
+  // Find the entry that is strictly greater than the requested beginning stamp. If the extended
+  // range flag is true, we will then back up one entry.
+  auto upper_bound_comparison = [](const auto & stamp, const auto & element) -> bool
+    {
+      return element.first > stamp;
+    };
+  auto beginning_iter = std::upper_bound(
+    buffer_begin,
+    buffer_end, beginning_stamp, upper_bound_comparison);
+  if (extended_range) {
+    --beginning_iter;
+  }
+  // Find the entry that is greater than or equal to the ending stamp. If the extended range flag is
+  // false, we will back up one entry.
+  auto lower_bound_comparison = [](const auto & element, const auto & stamp) -> bool
+    {
+      return element.first < stamp;
+    };
+  auto ending_iter = std::lower_bound(
+    buffer_begin,
+    buffer_end, ending_stamp, lower_bound_comparison);
+  if (extended_range && (ending_iter != buffer_end)) {
+    ++ending_iter;
+  }
+  return message_range(beginning_iter, ending_iter);
+}
+
+template<class Message>
+typename RingMessageBuffer<Message>::stamp_range RingMessageBuffer<Message>::stamps() const
+{
+  return stamp_range(
+    boost::make_transform_iterator(begin(), &extractStamp),
+    boost::make_transform_iterator(end(), &extractStamp));
+}
+
+template<class Message>
+void RingMessageBuffer<Message>::popFront(const size_t count)
+{
+  head_ += count;
+  if (head_ >= storage_.size()) {
+    head_ -= storage_.size();
+  }
+  size_ -= count;
+}
+
+template<class Message>
+void RingMessageBuffer<Message>::purgeHistory()
+{
+  // Purge any messages that are more than buffer_length_ seconds older than the most recent entry
+  // A setting of rclcpp::Duration::max() means "keep everything"
+  // And we want to keep at least two entries in buffer at all times, regardless of the stamps.
+  if ((buffer_length_ == rclcpp::Duration::max()) || (size_ <= 2)) {
+    return;
+  }
+
+  // Compute the expiration time carefully, as ROS can't handle negative times
+  const auto & ending_stamp = std::prev(end())->first;
+
+  rclcpp::Time expiration_time;
+  if (ending_stamp.seconds() > buffer_length_.seconds()) {
+    expiration_time = ending_stamp - buffer_length_;
+  } else {
+    // Uninitialized. But okay because it's just used for comparison.
+    expiration_time = rclcpp::Time(0, 0, ending_stamp.get_clock_type());
+  }
+
+  // Remove buffer elements before the expiration time.
+  // Be careful to ensure that:
+  //  - at least two entries remains at all times
+  //  - the buffer covers *at least* until the expiration time. Longer is acceptable.
+  auto is_greater = [](const auto & stamp, const auto & element) -> bool
+    {
+      return element.first > stamp;
+    };
+  const auto buffer_begin = begin();
+  auto expiration_iter = std::upper_bound(buffer_begin, end(), expiration_time, is_greater);
+  if (expiration_iter != buffer_begin) {
+    // expiration_iter points to the first element > expiration_time.
+    // Back up one entry, to a point that is <= expiration_time
+    popFront(std::distance(buffer_begin, std::prev(expiration_iter)));
+  }
+}
+
+}  // namespace fuse_core
+
+#endif  // FUSE_CORE__RING_MESSAGE_BUFFER_IMPL_HPP_
@@ -36,6 +36,7 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
 #include <utility>
 
 #include <rclcpp/clock.hpp>
@@ -204,6 +205,196 @@ template<class M>
 using ThrottledMessageCallback =
   ThrottledCallback<std::function<void (const M &)>>;
 
+/**
+ * @brief Throttled callback for ROS messages that can aggregate the messages dropped because of the
+ *        throttling instead of discarding them
+ *
+ * Without an aggregate callback this behaves like a ThrottledMessageCallback without a drop
+ * callback. With an aggregate callback, every dropped message is combined into a pending message,
+ * and the next kept message is combined into it too before the keep callback is called with the
+ * result. The keep callback is therefore called at the same rate, but with messages that carry the
+ * information of all the messages received since the previous call.
+ *
+ * The aggregate callback receives the pending message and the newer message to combine into it. It
+ * is expected to update the pending message stamp to the one of the newer message.
+ *
+ * @tparam M The ROS message type
+ */
+template<class M>
+class AggregatingThrottledMessageCallback
+{
+public:
+  using Callback = std::function<void (const M &)>;
+  using AggregateCallback = std::function<void (M &, const M &)>;
+
+  /**
+   * @brief Constructor
+   *
+   * @param[in] keep_callback      The callback to call when kept, i.e. not dropped. Defaults to
+   *                               nullptr
+   * @param[in] aggregate_callback The callback to combine a message into the pending one. Defaults
+   *                               to nullptr, i.e. dropped messages are discarded
+   * @param[in] throttle_period    The throttling period duration in seconds. Defaults to 0.0, i.e.
+   *                               no throttling
+   * @param[in] clock              The clock to throttle against. Defaults to using RCL_SYSTEM_TIME
+   */
+  AggregatingThrottledMessageCallback(
+    Callback && keep_callback = nullptr,                 // NOLINT(whitespace/operators)
+    AggregateCallback && aggregate_callback = nullptr,   // NOLINT(whitespace/operators)
+    const rclcpp::Duration & throttle_period = rclcpp::Duration(0, 0),
+    rclcpp::Clock::SharedPtr clock = std::make_shared<rclcpp::Clock>())
+  : keep_callback_(keep_callback)
+    , aggregate_callback_(aggregate_callback)
+    , throttled_callback_(
+      std::bind(&AggregatingThrottledMessageCallback::keep, this, std::placeholders::_1),
+      std::bind(&AggregatingThrottledMessageCallback::drop, this, std::placeholders::_1),
+      throttle_period,
+      clock)
+  {}
+
+  // The throttled callback is bound to this instance, so it cannot be copied or moved
+  AggregatingThrottledMessageCallback(const AggregatingThrottledMessageCallback &) = delete;
+  AggregatingThrottledMessageCallback & operator=(const AggregatingThrottledMessageCallback &) =
+    delete;
+
+  /**
+   * @brief Throttle period getter
+   *
+   * @return The current throttle period duration in seconds being used
+   */
+  const rclcpp::Duration & getThrottlePeriod() const
+  {
+    return throttled_callback_.getThrottlePeriod();
+  }
+
+  /**
+   * @brief Set the clock to throttle against
+   *
+   * @param[in] clock The clock to set
+   */
+  void setClock(rclcpp::Clock::SharedPtr clock)
+  {
+    throttled_callback_.setClock(clock);
+    pending_.reset();
+  }
+
+  /**
+   * @brief Throttle period setter
+   *
+   * @param[in] throttle_period The new throttle period duration in seconds to use
+   */
+  void setThrottlePeriod(const rclcpp::Duration & throttle_period)
+  {
+    throttled_callback_.setThrottlePeriod(throttle_period);
+  }
+
+  /**
+   * @brief Keep callback setter
+   *
+   * @param[in] keep_callback The new keep callback to use
+   */
+  void setKeepCallback(const Callback & keep_callback)
+  {
+    keep_callback_ = keep_callback;
+  }
+
+  /**
+   * @brief Aggregate callback setter
+   *
+   * @param[in] aggregate_callback The new aggregate callback to use. Use nullptr to discard the
+   *                               dropped messages
+   */
+  void setAggregateCallback(const AggregateCallback & aggregate_callback)
+  {
+    aggregate_callback_ = aggregate_callback;
+    pending_.reset();
+  }
+
+  /**
+   * @brief Last called time
+   *
+   * @return The last time the keep callback was called
+   */
+  const rclcpp::Time & getLastCalledTime() const
+  {
+    return throttled_callback_.getLastCalledTime();
+  }
+
+  /**
+   * @brief Discard the pending aggregated message, if any
+   */
+  void reset()
+  {
+    pending_.reset();
+  }
+
+  /**
+   * @brief Callback that throttles the calls to the keep callback provided, aggregating the
+   *        dropped messages if an aggregate callback is provided
+   *
+   * @param[in] message The input message
+   */
+  void callback(const M & message)
+  {
+    throttled_callback_.callback(message);
+  }
+
+  /**
+   * @brief Operator() that simply calls the callback() method
+   *
+   * @param[in] message The input message
+   */
+  void operator()(const M & message)
+  {
+    callback(message);
+  }
+
+private:
+  /**
+   * @brief Call the keep callback with the message, combined into the pending message if any
+   *
+   * @param[in] message The kept message
+   */
+  void keep(const M & message)
+  {
+    if (!keep_callback_) {
+      pending_.reset();
+      return;
+    }
+
+    if (pending_) {
+      aggregate_callback_(*pending_, message);
+      keep_callback_(*pending_);
+      pending_.reset();
+    } else {
+      keep_callback_(message);
+    }
+  }
+
+  /**
+   * @brief Combine the message into the pending message, or discard it without aggregate callback
+   *
+   * @param[in] message The dropped message
+   */
+  void drop(const M & message)
+  {
+    if (!aggregate_callback_) {
+      return;
+    }
+
+    if (pending_) {
+      aggregate_callback_(*pending_, message);
+    } else {
+      pending_ = message;
+    }
+  }
+
+  Callback keep_callback_;  //!< The callback to call when kept, i.e. not dropped
+  AggregateCallback aggregate_callback_;  //!< Combines a message into the pending one
+  std::optional<M> pending_;  //!< The aggregation of the messages dropped since the last kept one
+  ThrottledMessageCallback<M> throttled_callback_;  //!< The throttling logic
+};
+
 }  // namespace fuse_core
 
 #endif  // FUSE_CORE__THROTTLED_CALLBACK_HPP_
@@ -36,12 +36,15 @@
 
 #include <functional>
 #include <map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include <boost/range/any_range.hpp>
 #include <fuse_core/constraint.hpp>
 #include <fuse_core/fuse_macros.hpp>
 #include <fuse_core/transaction.hpp>
+#include <fuse_core/uuid.hpp>
 #include <fuse_core/variable.hpp>
 #include <rclcpp/duration.hpp>
 
@@ -267,6 +270,13 @@ protected:
   MotionModelHistory motion_model_history_;  //!< Container that stores all previously generated
                                              //!< motion models
 
+  // Scratch containers used by query(), kept between calls so their storage is reused
+  std::vector<rclcpp::Time> augmented_stamps_;  //!< The sorted union of the requested and the
+                                                //!< existing timestamps
+  std::vector<std::pair<rclcpp::Time, rclcpp::Time>> stamp_pairs_;  //!< The segments to generate
+  std::unordered_set<UUID, uuid::hash> added_variable_uuids_;  //!< The UUIDs of the variables
+                                                               //!< added by the transaction
+
   /**
    * @brief Create a new MotionModelSegment, updating the provided transaction.
    *
@@ -150,6 +150,193 @@ Eigen::Matrix<T, 2, 2, Eigen::RowMajor> rotationMatrix2D(const T angle)
   return rotation;
 }
 
+/**
+ * @brief Create the matrix L(q) such that q * p = L(q) * p for any quaternion p
+ *
+ * @param[in] q The left-hand quaternion, in order (w, x, y, z)
+ * @return      The 4x4 left quaternion product matrix
+ */
+inline Eigen::Matrix<double, 4, 4, Eigen::RowMajor> quaternionLeftProductMatrix(const double * q)
+{
+  Eigen::Matrix<double, 4, 4, Eigen::RowMajor> product;
+  product <<
+    q[0], -q[1], -q[2], -q[3],
+    q[1], q[0], -q[3], q[2],
+    q[2], q[3], q[0], -q[1],
+    q[3], -q[2], q[1], q[0];
+  return product;
+}
+
+/**
+ * @brief Create the matrix R(p) such that q * p = R(p) * q for any quaternion q
+ *
+ * @param[in] p The right-hand quaternion, in order (w, x, y, z)
+ * @return      The 4x4 right quaternion product matrix
+ */
+inline Eigen::Matrix<double, 4, 4, Eigen::RowMajor> quaternionRightProductMatrix(const double * p)
+{
+  Eigen::Matrix<double, 4, 4, Eigen::RowMajor> product;
+  product <<
+    p[0], -p[1], -p[2], -p[3],
+    p[1], p[0], p[3], -p[2],
+    p[2], -p[3], p[0], p[1],
+    p[3], p[2], -p[1], p[0];
+  return product;
+}
+
+/**
+ * @brief Rotate a point by a quaternion, and optionally compute the Jacobian of the rotated point
+ *        with respect to the quaternion
+ *
+ * Like ceres::QuaternionRotatePoint(), the quaternion is normalized first, so the Jacobian matches
+ * the one computed by automatic differentiation.
+ *
+ * @param[in]  q        The quaternion, in order (w, x, y, z). It does not need to be normalized.
+ * @param[in]  point    The point to rotate
+ * @param[out] rotation The rotation matrix of the normalized quaternion
+ * @param[out] jacobian If not null, the Jacobian of the rotated point with respect to \p q
+ * @return              The rotated point
+ */
+inline Eigen::Vector3d quaternionRotatePoint(
+  const double * q,
+  const Eigen::Vector3d & point,
+  Eigen::Matrix<double, 3, 3, Eigen::RowMajor> & rotation,
+  Eigen::Matrix<double, 3, 4, Eigen::RowMajor> * jacobian = nullptr)
+{
+  const double scale = 1.0 / std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+  const Eigen::Vector4d unit = scale * Eigen::Map<const Eigen::Vector4d>(q);
+  const double w = unit[0];
+  const double x = unit[1];
+  const double y = unit[2];
+  const double z = unit[3];
+
+  rotation <<
+    1.0 - 2.0 * (y * y + z * z), 2.0 * (x * y - w * z), 2.0 * (w * y + x * z),
+    2.0 * (w * z + x * y), 1.0 - 2.0 * (x * x + z * z), 2.0 * (y * z - w * x),
+    2.0 * (x * z - w * y), 2.0 * (w * x + y * z), 1.0 - 2.0 * (x * x + y * y);
+
+  if (jacobian != nullptr) {
+    const double px = point[0];
+    const double py = point[1];
+    const double pz = point[2];
+    // Derivative of the rotated point with respect to the components of the unit quaternion
+    Eigen::Matrix<double, 3, 4, Eigen::RowMajor> unit_jacobian;
+    unit_jacobian <<
+      y * pz - z * py, y * py + z * pz, x * py + w * pz - 2.0 * y * px,
+      x * pz - w * py - 2.0 * z * px,
+      z * px - x * pz, y * px - w * pz - 2.0 * x * py, x * px + z * pz,
+      w * px + y * pz - 2.0 * z * py,
+      x * py - y * px, z * px + w * py - 2.0 * x * pz, z * py - w * px - 2.0 * y * pz,
+      x * px + y * py;
+    // Chain the derivative of the normalization
+    *jacobian = (2.0 * scale) * unit_jacobian *
+      (Eigen::Matrix4d::Identity() - unit * unit.transpose());
+  }
+  return rotation * point;
+}
+
+/**
+ * @brief Convert a quaternion into an angle-axis vector, and optionally compute the Jacobian of the
+ *        conversion
+ *
+ * The angle-axis vector is identical to the one computed by ceres::QuaternionToAngleAxis(), which
+ * also accepts non-unit quaternions. The Jacobian is the one automatic differentiation computes
+ * through ceres::QuaternionToAngleAxis(), so analytic cost functions built with it match their
+ * automatic differentiation counterparts.
+ *
+ * @param[in]  q          The quaternion, in order (w, x, y, z)
+ * @param[out] angle_axis The angle-axis vector
+ * @param[out] jacobian   If not null, the 3x4 row-major Jacobian of \p angle_axis with respect to
+ *                        \p q
+ */
+inline void quaternionToAngleAxis(
+  const double * q, double * angle_axis,
+  double * jacobian = nullptr)
+{
+  const Eigen::Map<const Eigen::Vector3d> imaginary(q + 1);
+  Eigen::Map<Eigen::Vector3d> angle_axis_map(angle_axis);
+  const double sin_squared_theta = imaginary.squaredNorm();
+  if (sin_squared_theta <= 0.0) {
+    // Same first order approximation used by ceres for the zero rotation
+    angle_axis_map = 2.0 * imaginary;
+    if (jacobian != nullptr) {
+      Eigen::Map<Eigen::Matrix<double, 3, 4, Eigen::RowMajor>> jacobian_map(jacobian);
+      jacobian_map.col(0).setZero();
+      jacobian_map.rightCols<3>() = 2.0 * Eigen::Matrix3d::Identity();
+    }
+    return;
+  }
+
+  const double sin_theta = std::sqrt(sin_squared_theta);
+  const double cos_theta = q[0];
+  const double two_theta = 2.0 * ((cos_theta < 0.0) ? std::atan2(-sin_theta, -cos_theta) :
+    std::atan2(sin_theta, cos_theta));
+  const double k = two_theta / sin_theta;
+  angle_axis_map = k * imaginary;
+
+  if (jacobian != nullptr) {
+    // d(two_theta) = 2 * (cos_theta * d(sin_theta) - sin_theta * d(cos_theta)) / |q|^2, for both
+    // branches, and d(sin_theta) = imaginary^T * d(imaginary) / sin_theta
+    const double squared_norm = sin_squared_theta + cos_theta * cos_theta;
+    Eigen::Map<Eigen::Matrix<double, 3, 4, Eigen::RowMajor>> jacobian_map(jacobian);
+    jacobian_map.col(0) = (-2.0 / squared_norm) * imaginary;
+    jacobian_map.rightCols<3>() =
+      ((2.0 * cos_theta / squared_norm - k) / sin_squared_theta) *
+      (imaginary * imaginary.transpose());
+    jacobian_map.rightCols<3>().diagonal().array() += k;
+  }
+}
+
+/**
+ * @brief Convert an angle-axis vector into a quaternion, and optionally compute the Jacobian of the
+ *        conversion
+ *
+ * The quaternion is identical to the one computed by ceres::AngleAxisToQuaternion(), and the
+ * Jacobian is the one automatic differentiation computes through it, including its first order
+ * approximation for the zero rotation.
+ *
+ * @param[in]  angle_axis The angle-axis vector
+ * @param[out] q          The unit quaternion, in order (w, x, y, z)
+ * @param[out] jacobian   If not null, the 4x3 row-major Jacobian of \p q with respect to
+ *                        \p angle_axis
+ */
+inline void angleAxisToQuaternion(
+  const double * angle_axis, double * q,
+  double * jacobian = nullptr)
+{
+  const Eigen::Map<const Eigen::Vector3d> angle_axis_map(angle_axis);
+  Eigen::Map<Eigen::Vector3d> imaginary(q + 1);
+  const double theta_squared = angle_axis_map.squaredNorm();
+  if (theta_squared <= 0.0) {
+    q[0] = 1.0;
+    imaginary = 0.5 * angle_axis_map;
+    if (jacobian != nullptr) {
+      Eigen::Map<Eigen::Matrix<double, 4, 3, Eigen::RowMajor>> jacobian_map(jacobian);
+      jacobian_map.row(0).setZero();
+      jacobian_map.bottomRows<3>() = 0.5 * Eigen::Matrix3d::Identity();
+    }
+    return;
+  }
+
+  const double theta = std::sqrt(theta_squared);
+  const double half_theta = 0.5 * theta;
+  const double cos_half_theta = std::cos(half_theta);
+  const double k = std::sin(half_theta) / theta;
+  q[0] = cos_half_theta;
+  imaginary = k * angle_axis_map;
+
+  if (jacobian != nullptr) {
+    // d(theta) = angle_axis^T * d(angle_axis) / theta, and
+    // d(k) = (cos(theta / 2) / 2 - k) * d(theta) / theta
+    Eigen::Map<Eigen::Matrix<double, 4, 3, Eigen::RowMajor>> jacobian_map(jacobian);
+    jacobian_map.row(0) = (-0.5 * k) * angle_axis_map.transpose();
+    jacobian_map.bottomRows<3>() =
+      ((0.5 * cos_half_theta - k) / theta_squared) *
+      (angle_axis_map * angle_axis_map.transpose());
+    jacobian_map.bottomRows<3>().diagonal().array() += k;
+  }
+}
+
 /**
  * @brief Create a compound ROS topic name from two components
  *
@@ -42,6 +42,7 @@
 #include <boost/type_index/stl_type_index.hpp>
 #include <fuse_core/fuse_macros.hpp>
 #include <fuse_core/local_parameterization.hpp>
+#include <fuse_core/manifold.hpp>
 #include <fuse_core/serialization.hpp>
 #include <fuse_core/uuid.hpp>
 
@@ -315,12 +316,17 @@ public:
    * parameterization is needed, remember to also override the \p localSize() method to return
    * the appropriate local parameterization size.
    *
-   * The Ceres interface requires a raw pointer. Ceres will take ownership of the pointer and
+   * The Ceres interface requires a raw pointer. The caller takes ownership of the pointer and
    * promises to properly delete the local parameterization when it is done. Additionally, fuse
    * promises that the Variable object will outlive any generated local parameterization (i.e.
    * the Ceres objects will be destroyed before the Variable objects). This guarantee may allow
    * optimizations for the creation of the local parameterization objects.
    *
+   * @deprecated Override \p sharedLocalParameterization() instead. fuse only calls this method
+   * for variables that do not provide a shared instance, and it will be removed in a future
+   * release. Until then, variables that provide a shared instance should still return a new
+   * object here, for callers that have not migrated yet.
+   *
    * @return A base pointer to an instance of a derived LocalParameterization
    */
   virtual fuse_core::LocalParameterization * localParameterization() const
@@ -328,6 +334,44 @@ public:
     return nullptr;
   }
 
+  /**
+   * @brief Access a shared Ceres local parameterization object to apply to updates of this variable
+   *
+   * Unlike \p localParameterization(), the caller does NOT take ownership of the returned object
+   * (see fuse_core::LocalParameterization::Ownership), and it may be shared between any number of
+   * variables, graphs, and threads. Local parameterizations are generally stateless, so derived
+   * classes should return a pointer to a single, immortal instance of the parameterization
+   * instead of allocating a new object for every variable in every optimization. The returned
+   * object must remain valid for the lifetime of the program.
+   *
+   * If a null pointer is returned (the default), the variable does not provide a shared instance
+   * and callers fall back to \p localParameterization().
+   *
+   * @return A base pointer to an instance of a derived LocalParameterization, or nullptr
+   */
+  virtual fuse_core::LocalParameterization * sharedLocalParameterization() const
+  {
+    return nullptr;
+  }
+
+#if CERES_SUPPORTS_MANIFOLDS
+  /**
+   * @brief Access the Ceres manifold object to apply to updates of this variable
+   *
+   * This is the ceres::Manifold equivalent of \p localParameterization(). When a manifold is
+   * provided, it is used in preference to the local parameterization, allowing Ceres to skip its
+   * internal LocalParameterization-to-Manifold adapter. If a null pointer is returned, the local
+   * parameterization (if any) is used instead. The ownership and lifetime rules are the same as
+   * for \p sharedLocalParameterization(); see fuse_core::Manifold::Ownership.
+   *
+   * @return A base pointer to an instance of a derived Manifold
+   */
+  virtual fuse_core::Manifold * manifold() const
+  {
+    return nullptr;
+  }
+#endif
+
   /**
    * @brief Specifies the lower bound value of each variable dimension
    *
@@ -33,12 +33,14 @@
  */
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 
 #include <fuse_core/async_motion_model.hpp>
 #include <fuse_core/callback_wrapper.hpp>
 #include <fuse_core/graph.hpp>
+#include <fuse_core/parameter.hpp>
 #include <fuse_core/transaction.hpp>
 #include <rclcpp/contexts/default_context.hpp>
 #include <rclcpp/rclcpp.hpp>
@@ -86,6 +88,8 @@ void AsyncMotionModel::initialize(
   // Initialize internal state
   name_ = name;
   interfaces_ = interfaces;
+  latest_graph_only_ = getParam(
+    interfaces, joinParameterName(name_, "latest_graph_only"), latest_graph_only_);
 
   auto context = interfaces_.get_node_base_interface()->get_context();
   auto executor_options = rclcpp::ExecutorOptions();
@@ -134,6 +138,23 @@ void AsyncMotionModel::initialize(
 
 void AsyncMotionModel::graphCallback(Graph::ConstSharedPtr graph)
 {
+  if (latest_graph_only_) {
+    // Replace any graph still waiting in the callback queue. Only a single callback is queued,
+    // and it will deliver whichever graph is the most recent one when it is executed.
+    {
+      std::lock_guard<std::mutex> lock(pending_graph_mutex_);
+      pending_graph_ = std::move(graph);
+      if (graph_update_queued_) {
+        return;
+      }
+      graph_update_queued_ = true;
+    }
+    auto callback = std::make_shared<CallbackWrapper<void>>(
+      std::bind(&AsyncMotionModel::pendingGraphCallback, this));
+    callback_queue_->addCallback(callback);
+    return;
+  }
+
   auto callback = std::make_shared<CallbackWrapper<void>>(
     std::bind(&AsyncMotionModel::onGraphUpdate, this, std::move(graph))
   );
@@ -170,6 +191,18 @@ void AsyncMotionModel::stop()
   }
 }
 
+void AsyncMotionModel::pendingGraphCallback()
+{
+  Graph::ConstSharedPtr graph;
+  {
+    std::lock_guard<std::mutex> lock(pending_graph_mutex_);
+    graph = std::move(pending_graph_);
+    pending_graph_.reset();
+    graph_update_queued_ = false;
+  }
+  onGraphUpdate(std::move(graph));
+}
+
 void AsyncMotionModel::internal_stop()
 {
   if (spinner_.joinable()) {
@@ -179,6 +212,11 @@ void AsyncMotionModel::internal_stop()
 
   // Reset callback queue
   callback_queue_->removeAllCallbacks();
+  {
+    std::lock_guard<std::mutex> lock(pending_graph_mutex_);
+    pending_graph_.reset();
+    graph_update_queued_ = false;
+  }
   initialized_ = false;
 }
 
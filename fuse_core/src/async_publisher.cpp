@@ -31,7 +31,13 @@
  *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  *  POSSIBILITY OF SUCH DAMAGE.
  */
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
 #include <fuse_core/async_publisher.hpp>
+#include <fuse_core/parameter.hpp>
 #include <rclcpp/contexts/default_context.hpp>
 
 namespace fuse_core
@@ -59,6 +65,8 @@ void AsyncPublisher::initialize(
   // Initialize internal state
   name_ = name;  // NOTE(methylDragon): Used in derived classes
   interfaces_ = interfaces;
+  latest_graph_only_ = getParam(
+    interfaces, joinParameterName(name_, "latest_graph_only"), latest_graph_only_);
 
   auto context = interfaces_.get_node_base_interface()->get_context();
   auto executor_options = rclcpp::ExecutorOptions();
@@ -107,6 +115,25 @@ void AsyncPublisher::initialize(
 
 void AsyncPublisher::notify(Transaction::ConstSharedPtr transaction, Graph::ConstSharedPtr graph)
 {
+  if (latest_graph_only_) {
+    // Coalesce with any notification still waiting in the callback queue
+    {
+      std::lock_guard<std::mutex> lock(pending_notify_mutex_);
+      if (notify_queued_) {
+        coalesceNotification(
+          pending_transaction_, pending_graph_, std::move(transaction), std::move(graph));
+        return;
+      }
+      pending_transaction_ = std::move(transaction);
+      pending_graph_ = std::move(graph);
+      notify_queued_ = true;
+    }
+    auto callback = std::make_shared<CallbackWrapper<void>>(
+      std::bind(&AsyncPublisher::pendingNotifyCallback, this));
+    callback_queue_->addCallback(callback);
+    return;
+  }
+
   // Insert a call to the `notifyCallback` method into the internal callback queue.
   // This minimizes the time spent by the optimizer's thread calling this function.
   auto callback = std::make_shared<CallbackWrapper<void>>(
@@ -143,6 +170,21 @@ void AsyncPublisher::stop()
   }
 }
 
+void AsyncPublisher::pendingNotifyCallback()
+{
+  Transaction::ConstSharedPtr transaction;
+  Graph::ConstSharedPtr graph;
+  {
+    std::lock_guard<std::mutex> lock(pending_notify_mutex_);
+    transaction = std::move(pending_transaction_);
+    graph = std::move(pending_graph_);
+    pending_transaction_.reset();
+    pending_graph_.reset();
+    notify_queued_ = false;
+  }
+  notifyCallback(std::move(transaction), std::move(graph));
+}
+
 void AsyncPublisher::internal_stop()
 {
   if (spinner_.joinable()) {
@@ -152,7 +194,29 @@ void AsyncPublisher::internal_stop()
 
   // Reset callback queue
   callback_queue_->removeAllCallbacks();
+  {
+    std::lock_guard<std::mutex> lock(pending_notify_mutex_);
+    pending_transaction_.reset();
+    pending_graph_.reset();
+    notify_queued_ = false;
+  }
   initialized_ = false;
 }
 
+void coalesceNotification(
+  Transaction::ConstSharedPtr & pending_transaction,
+  Graph::ConstSharedPtr & pending_graph,
+  Transaction::ConstSharedPtr transaction,
+  Graph::ConstSharedPtr graph)
+{
+  if (pending_transaction && transaction) {
+    auto merged_transaction = Transaction::make_shared(*pending_transaction);
+    merged_transaction->merge(*transaction, true);
+    pending_transaction = std::move(merged_transaction);
+  } else if (transaction) {
+    pending_transaction = std::move(transaction);
+  }
+  pending_graph = std::move(graph);
+}
+
 }  // namespace fuse_core
@@ -33,12 +33,14 @@
  */
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 
 #include <fuse_core/async_sensor_model.hpp>
 #include <fuse_core/callback_wrapper.hpp>
 #include <fuse_core/graph.hpp>
+#include <fuse_core/parameter.hpp>
 #include <fuse_core/transaction.hpp>
 #include <rclcpp/contexts/default_context.hpp>
 
@@ -68,6 +70,8 @@ void AsyncSensorModel::initialize(
   // Initialize internal state
   name_ = name;
   interfaces_ = interfaces;
+  latest_graph_only_ = getParam(
+    interfaces, joinParameterName(name_, "latest_graph_only"), latest_graph_only_);
 
   auto context = interfaces_.get_node_base_interface()->get_context();
   auto executor_options = rclcpp::ExecutorOptions();
@@ -118,6 +122,23 @@ void AsyncSensorModel::initialize(
 
 void AsyncSensorModel::graphCallback(Graph::ConstSharedPtr graph)
 {
+  if (latest_graph_only_) {
+    // Replace any graph still waiting in the callback queue. Only a single callback is queued,
+    // and it will deliver whichever graph is the most recent one when it is executed.
+    {
+      std::lock_guard<std::mutex> lock(pending_graph_mutex_);
+      pending_graph_ = std::move(graph);
+      if (graph_update_queued_) {
+        return;
+      }
+      graph_update_queued_ = true;
+    }
+    auto callback = std::make_shared<CallbackWrapper<void>>(
+      std::bind(&AsyncSensorModel::pendingGraphCallback, this));
+    callback_queue_->addCallback(callback);
+    return;
+  }
+
   auto callback = std::make_shared<CallbackWrapper<void>>(
     std::bind(&AsyncSensorModel::onGraphUpdate, this, std::move(graph))
   );
@@ -159,6 +180,18 @@ void AsyncSensorModel::stop()
   }
 }
 
+void AsyncSensorModel::pendingGraphCallback()
+{
+  Graph::ConstSharedPtr graph;
+  {
+    std::lock_guard<std::mutex> lock(pending_graph_mutex_);
+    graph = std::move(pending_graph_);
+    pending_graph_.reset();
+    graph_update_queued_ = false;
+  }
+  onGraphUpdate(std::move(graph));
+}
+
 void AsyncSensorModel::internal_stop()
 {
   if (spinner_.joinable()) {
@@ -168,6 +201,11 @@ void AsyncSensorModel::internal_stop()
 
   // Reset callback queue
   callback_queue_->removeAllCallbacks();
+  {
+    std::lock_guard<std::mutex> lock(pending_graph_mutex_);
+    pending_graph_.reset();
+    graph_update_queued_ = false;
+  }
   initialized_ = false;
 }
 
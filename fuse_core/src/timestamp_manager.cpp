@@ -33,7 +33,6 @@
  */
 #include <algorithm>
 #include <iterator>
-#include <set>
 #include <stdexcept>
 #include <utility>
 
@@ -70,30 +69,44 @@ void TimestampManager::query(
             "All timestamps must be within the defined buffer length of the motion model");
   }
   // Create a list of all the required timestamps involved in motion model segments that must be
-  // created Add all of the existing timestamps between the first and last input stamp
+  // created. Add all of the existing timestamps between the first and last input stamp. Both
+  // sequences are sorted, so they are merged in linear time into a reused vector.
   Transaction motion_model_transaction;
-  std::set<rclcpp::Time> augmented_stamps(stamps.begin(), stamps.end());
-  auto first_stamp = *augmented_stamps.begin();
-  auto last_stamp = *augmented_stamps.rbegin();
+  const rclcpp::Time first_stamp = *stamps.begin();
+  rclcpp::Time last_stamp = first_stamp;
+  for (const auto & stamp : stamps) {
+    last_stamp = stamp;
+  }
+  augmented_stamps_.clear();
   {
     auto begin = motion_model_history_.upper_bound(first_stamp);
     if (begin != motion_model_history_.begin()) {
       --begin;
     }
     auto end = motion_model_history_.upper_bound(last_stamp);
-    for (auto iter = begin; iter != end; ++iter) {
-      augmented_stamps.insert(iter->first);
-    }
     if (end != motion_model_history_.end()) {
-      augmented_stamps.insert(end->first);
+      ++end;
     }
+    auto extract_stamp = [](const MotionModelHistory::value_type & element) -> const rclcpp::Time &
+      {
+        return element.first;
+      };
+    std::set_union(
+      stamps.begin(), stamps.end(),
+      boost::make_transform_iterator(begin, extract_stamp),
+      boost::make_transform_iterator(end, extract_stamp),
+      std::back_inserter(augmented_stamps_));
   }
+  // Index the variables added by the transaction the first time a segment is reused, so checking
+  // which motion model variables must overwrite them is a hash lookup per variable
+  added_variable_uuids_.clear();
+  bool added_variables_indexed = false;
   // Convert the sequence of stamps into stamp pairs that must be generated
-  std::vector<std::pair<rclcpp::Time, rclcpp::Time>> stamp_pairs;
+  stamp_pairs_.clear();
   {
-    for (auto previous_iter = augmented_stamps.begin(),
-      current_iter = std::next(augmented_stamps.begin());
-      current_iter != augmented_stamps.end();
+    for (auto previous_iter = augmented_stamps_.begin(),
+      current_iter = std::next(augmented_stamps_.begin());
+      current_iter != augmented_stamps_.end();
       ++previous_iter, ++current_iter)
     {
       const rclcpp::Time & previous_stamp = *previous_iter;
@@ -105,19 +118,17 @@ void TimestampManager::query(
         (history_iter->second.ending_stamp == current_stamp))
       {
         if (update_variables) {
+          if (!added_variables_indexed) {
+            for (const auto & input_variable : transaction.addedVariables()) {
+              added_variable_uuids_.insert(input_variable.uuid());
+            }
+            added_variables_indexed = true;
+          }
           // Add the motion model version of the variables involved in this motion model segment
           // This ensures that the variables in the final transaction will be overwritten with the
           // motion model version
-          auto transaction_variables = transaction.addedVariables();
           for (const auto & variable : history_iter->second.variables) {
-            if (std::any_of(
-                transaction_variables.begin(),
-                transaction_variables.end(),
-                [variable_uuid = variable->uuid()](const auto & input_variable)
-                {
-                  return input_variable.uuid() == variable_uuid;
-                }))    // NOLINT
-            {
+            if (added_variable_uuids_.count(variable->uuid()) > 0) {
               motion_model_transaction.addVariable(variable, update_variables);
             }
           }
@@ -132,11 +143,11 @@ void TimestampManager::query(
         removeSegment(history_iter, motion_model_transaction);
       }
       // Add this pair
-      stamp_pairs.emplace_back(previous_stamp, current_stamp);
+      stamp_pairs_.emplace_back(previous_stamp, current_stamp);
     }
   }
   // Create the required segments
-  for (const auto & stamp_pair : stamp_pairs) {
+  for (const auto & stamp_pair : stamp_pairs_) {
     addSegment(stamp_pair.first, stamp_pair.second, motion_model_transaction);
   }
   // Add a dummy entry for the last stamp if one does not already exist
@@ -76,7 +76,7 @@ fuse_core::Transaction::UniquePtr TransactionDeserializer::deserialize(
 {
   // The Transaction object is not a plugin and has no derived types. That makes it much easier to
   // use.
-  auto transaction = fuse_core::Transaction::UniquePtr();
+  auto transaction = fuse_core::Transaction::make_unique();
   // Deserialize the msg.data field into the transaction.
   // This will throw if something goes wrong in the deserialization.
   boost::iostreams::stream<fuse_core::MessageBufferStreamSource> stream(msg.data);
@@ -33,6 +33,8 @@
  */
 #include <gtest/gtest.h>
 
+#include <atomic>
+
 #include <fuse_core/async_motion_model.hpp>
 #include <rclcpp/rclcpp.hpp>
 
@@ -73,6 +75,34 @@ public:
   bool transaction_received = false;
 };
 
+/**
+ * @brief Derived AsyncMotionModel that processes graphs slowly and counts everything it receives
+ */
+class MySlowGraphMotionModel : public fuse_core::AsyncMotionModel
+{
+public:
+  MySlowGraphMotionModel()
+  : fuse_core::AsyncMotionModel(1)
+  {
+  }
+
+  bool applyCallback(fuse_core::Transaction & transaction) override
+  {
+    involved_stamp_count += std::distance(
+      transaction.involvedStamps().begin(), transaction.involvedStamps().end());
+    return true;
+  }
+
+  void onGraphUpdate(fuse_core::Graph::ConstSharedPtr /*graph*/) override
+  {
+    rclcpp::sleep_for(std::chrono::milliseconds(10));
+    ++graph_count;
+  }
+
+  std::atomic<int> graph_count{0};
+  std::atomic<int> involved_stamp_count{0};
+};
+
 class TestAsyncMotionModel : public ::testing::Test
 {
 public:
@@ -151,3 +181,34 @@ TEST_F(TestAsyncMotionModel, ApplyCallback)
   EXPECT_TRUE(motion_model.transaction_received);
   EXPECT_LE(rclcpp::Duration::from_seconds(1.0), after_apply - before_apply);
 }
+
+TEST_F(TestAsyncMotionModel, LatestGraphOnly)
+{
+  auto options = rclcpp::NodeOptions();
+  options.parameter_overrides({{"my_motion_model.latest_graph_only", true}});
+  auto node = rclcpp::Node::make_shared("test_async_motion_model_node", options);
+  MySlowGraphMotionModel motion_model;
+  motion_model.initialize(*node, "my_motion_model");
+
+  // Send graphs much faster than the motion model can process them. Pending graphs should be
+  // dropped, so the motion model processes fewer graphs than it was sent.
+  fuse_core::Graph::ConstSharedPtr graph;  // nullptr is ok as we don't actually use it
+  const int graph_count = 20;
+  for (int i = 0; i < graph_count; i++) {
+    motion_model.graphCallback(graph);
+  }
+
+  // The transactions applied meanwhile are queued behind the pending graph, and none is dropped
+  const int transaction_count = 5;
+  for (int i = 0; i < transaction_count; i++) {
+    fuse_core::Transaction transaction;
+    transaction.addInvolvedStamp(rclcpp::Time(i + 1, 0, RCL_ROS_TIME));
+    transaction.addInvolvedStamp(rclcpp::Time(i + 1, 500, RCL_ROS_TIME));
+    motion_model.apply(transaction);
+  }
+
+  // The graph still pending when the transactions were applied has been processed by now
+  EXPECT_EQ(2 * transaction_count, motion_model.involved_stamp_count);
+  EXPECT_GE(motion_model.graph_count, 1);
+  EXPECT_LT(motion_model.graph_count, graph_count);
+}
@@ -33,6 +33,7 @@
  */
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <set>
 
 #include <fuse_core/async_publisher.hpp>
@@ -54,10 +55,15 @@ public:
   virtual ~MyPublisher() = default;
 
   void notifyCallback(
-    fuse_core::Transaction::ConstSharedPtr /*transaction*/,
+    fuse_core::Transaction::ConstSharedPtr transaction,
     fuse_core::Graph::ConstSharedPtr /*graph*/)
   {
     rclcpp::sleep_for(std::chrono::milliseconds(10));
+    if (transaction) {
+      involved_stamp_count += std::distance(
+        transaction->involvedStamps().begin(), transaction->involvedStamps().end());
+    }
+    ++callback_count;
     callback_processed = true;
   }
 
@@ -66,8 +72,10 @@ public:
     initialized = true;
   }
 
-  bool callback_processed;
+  std::atomic<bool> callback_processed;
   bool initialized;
+  std::atomic<int> callback_count{0};
+  std::atomic<int> involved_stamp_count{0};
 };
 
 class TestAsyncPublisher : public ::testing::Test
@@ -130,3 +138,30 @@ TEST_F(TestAsyncPublisher, notifyCallback)
     EXPECT_TRUE(publisher.callback_processed);
   }
 }
+
+TEST_F(TestAsyncPublisher, LatestGraphOnly)
+{
+  auto options = rclcpp::NodeOptions();
+  options.parameter_overrides({{"my_publisher.latest_graph_only", true}});
+  auto node = rclcpp::Node::make_shared("test_async_pub_node", options);
+  MyPublisher publisher;
+  publisher.initialize(*node, "my_publisher");
+
+  // Send notifications much faster than the publisher can process them. Pending notifications
+  // should be coalesced, but the involved stamps of every transaction must still be delivered.
+  fuse_core::Graph::ConstSharedPtr graph;  // nullptr is ok as we don't actually use it
+  const int notification_count = 20;
+  for (int i = 0; i < notification_count; i++) {
+    auto transaction = fuse_core::Transaction::make_shared();
+    transaction->addInvolvedStamp(rclcpp::Time(i + 1, 0, RCL_ROS_TIME));
+    publisher.notify(transaction, graph);
+  }
+
+  auto clock = rclcpp::Clock(RCL_SYSTEM_TIME);
+  rclcpp::Time wait_time_elapsed = clock.now() + rclcpp::Duration::from_seconds(10);
+  while (publisher.involved_stamp_count < notification_count && clock.now() < wait_time_elapsed) {
+    rclcpp::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(notification_count, publisher.involved_stamp_count);
+  EXPECT_LT(publisher.callback_count, notification_count);
+}
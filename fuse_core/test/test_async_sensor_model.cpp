@@ -33,6 +33,8 @@
  */
 #include <gtest/gtest.h>
 
+#include <atomic>
+
 #include <fuse_core/async_sensor_model.hpp>
 #include <rclcpp/rclcpp.hpp>
 
@@ -72,10 +74,12 @@ public:
   void onGraphUpdate(fuse_core::Graph::ConstSharedPtr /*graph*/) override
   {
     rclcpp::sleep_for(std::chrono::milliseconds(10));
+    ++graph_count;
     graph_received = true;
   }
 
-  bool graph_received = false;
+  std::atomic<bool> graph_received = false;
+  std::atomic<int> graph_count{0};
   bool initialized = false;
 };
 
@@ -138,6 +142,33 @@ TEST_F(TestAsyncSensorModel, OnGraphUpdate)
   }
 }
 
+TEST_F(TestAsyncSensorModel, LatestGraphOnly)
+{
+  auto options = rclcpp::NodeOptions();
+  options.parameter_overrides({{"my_sensor.latest_graph_only", true}});
+  auto node = rclcpp::Node::make_shared("test_async_sensor_model_node", options);
+  MySensor sensor;
+  sensor.initialize(*node, "my_sensor", &transactionCallback);
+
+  // Send graphs much faster than the sensor can process them. Pending graphs should be replaced,
+  // so the sensor processes fewer graphs than it was sent, but always processes the last one.
+  fuse_core::Graph::ConstSharedPtr graph;  // nullptr is ok as we don't actually use it
+  const int graph_count = 20;
+  for (int i = 0; i < graph_count; i++) {
+    sensor.graphCallback(graph);
+  }
+
+  auto clock = rclcpp::Clock(RCL_SYSTEM_TIME);
+  rclcpp::Time wait_time_elapsed = clock.now() + rclcpp::Duration::from_seconds(10);
+  while (!sensor.graph_received && clock.now() < wait_time_elapsed) {
+    rclcpp::sleep_for(std::chrono::milliseconds(10));
+  }
+  rclcpp::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_TRUE(sensor.graph_received);
+  EXPECT_GE(sensor.graph_count, 1);
+  EXPECT_LT(sensor.graph_count, graph_count);
+}
+
 TEST_F(TestAsyncSensorModel, SendTransaction)
 {
   MySensor sensor;
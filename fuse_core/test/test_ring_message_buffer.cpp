@@ -0,0 +1,217 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2018, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+
+#include <iterator>
+
+#include <fuse_core/ring_message_buffer.hpp>
+#include <rclcpp/duration.hpp>
+
+/**
+ * Test fixture that adds a known set of entries to the ring message buffer. Used to test the
+ * interactions with existing entries.
+ */
+class RingMessageBufferTestFixture : public ::testing::Test
+{
+public:
+  RingMessageBufferTestFixture()
+  : buffer(5, rclcpp::Duration::max())
+  {
+  }
+
+  void populate()
+  {
+    // Add a standard set of entries into the motion model
+    buffer.insert(rclcpp::Time(10, 0), 1);
+    buffer.insert(rclcpp::Time(20, 0), 2);
+    buffer.insert(rclcpp::Time(30, 0), 3);
+    buffer.insert(rclcpp::Time(40, 0), 4);
+  }
+
+  fuse_core::RingMessageBuffer<int> buffer;
+};
+
+TEST_F(RingMessageBufferTestFixture, Exceptions)
+{
+  // A buffer must be able to hold at least two entries
+  EXPECT_THROW(fuse_core::RingMessageBuffer<int>(1), std::invalid_argument);
+
+  // Call the query with the parameters in the wrong order. This should throw.
+  EXPECT_THROW(
+    buffer.query(rclcpp::Time(20, 0), rclcpp::Time(10, 0), false),
+    std::invalid_argument);
+
+  // Call the query when the buffer is empty. This should throw.
+  EXPECT_THROW(buffer.query(rclcpp::Time(10, 0), rclcpp::Time(25, 0), false), std::out_of_range);
+
+  populate();
+
+  // Call the query with a beginning stamp that is too early
+  EXPECT_THROW(buffer.query(rclcpp::Time(1, 0), rclcpp::Time(25, 0), false), std::out_of_range);
+
+  // Call the query function with a timestamp within the range. This should not throw.
+  EXPECT_NO_THROW(buffer.query(rclcpp::Time(20, 0), rclcpp::Time(30, 0)));
+}
+
+TEST_F(RingMessageBufferTestFixture, StandardRange)
+{
+  populate();
+
+  // Query boundaries that line up exactly with existing elements
+  auto msg_range = buffer.query(rclcpp::Time(10, 0), rclcpp::Time(30, 0), false);
+  ASSERT_EQ(1, msg_range.size());
+  EXPECT_EQ(rclcpp::Time(20, 0), msg_range.front().first);
+  EXPECT_EQ(2, msg_range.front().second);
+
+  // Query boundaries that do not line up with existing elements
+  msg_range = buffer.query(rclcpp::Time(15, 0), rclcpp::Time(25, 0), false);
+  ASSERT_EQ(1, msg_range.size());
+  EXPECT_EQ(rclcpp::Time(20, 0), msg_range.front().first);
+  EXPECT_EQ(2, msg_range.front().second);
+}
+
+TEST_F(RingMessageBufferTestFixture, ExtendedRange)
+{
+  populate();
+
+  // Query boundaries that line up exactly with existing elements
+  auto msg_range = buffer.query(rclcpp::Time(10, 0), rclcpp::Time(30, 0), true);
+  ASSERT_EQ(3, msg_range.size());
+  EXPECT_EQ(rclcpp::Time(10, 0), msg_range[0].first);
+  EXPECT_EQ(1, msg_range[0].second);
+  EXPECT_EQ(rclcpp::Time(20, 0), msg_range[1].first);
+  EXPECT_EQ(2, msg_range[1].second);
+  EXPECT_EQ(rclcpp::Time(30, 0), msg_range[2].first);
+  EXPECT_EQ(3, msg_range[2].second);
+
+  // Query boundaries that do not line up with existing elements
+  msg_range = buffer.query(rclcpp::Time(15, 0), rclcpp::Time(25, 0), true);
+  ASSERT_EQ(3, msg_range.size());
+  EXPECT_EQ(rclcpp::Time(10, 0), msg_range.front().first);
+  EXPECT_EQ(rclcpp::Time(30, 0), msg_range.back().first);
+}
+
+TEST_F(RingMessageBufferTestFixture, Capacity)
+{
+  populate();
+  EXPECT_EQ(5u, buffer.capacity());
+  EXPECT_EQ(4u, buffer.size());
+
+  // Fill the buffer, and then overwrite the oldest entries, wrapping around the storage
+  buffer.insert(rclcpp::Time(50, 0), 5);
+  buffer.insert(rclcpp::Time(60, 0), 6);
+  buffer.insert(rclcpp::Time(70, 0), 7);
+  EXPECT_EQ(5u, buffer.size());
+
+  auto stamps_range = buffer.stamps();
+  ASSERT_EQ(5, std::distance(stamps_range.begin(), stamps_range.end()));
+  auto stamps_range_iter = stamps_range.begin();
+  for (int32_t seconds = 30; seconds <= 70; seconds += 10) {
+    EXPECT_EQ(rclcpp::Time(seconds, 0), *stamps_range_iter);
+    ++stamps_range_iter;
+  }
+
+  // The oldest entries are no longer available
+  EXPECT_THROW(buffer.query(rclcpp::Time(20, 0), rclcpp::Time(40, 0)), std::out_of_range);
+
+  // Query a range that wraps around the end of the storage
+  auto msg_range = buffer.query(rclcpp::Time(45, 0), rclcpp::Time(65, 0), true);
+  ASSERT_EQ(4, msg_range.size());
+  EXPECT_EQ(4, msg_range[0].second);
+  EXPECT_EQ(5, msg_range[1].second);
+  EXPECT_EQ(6, msg_range[2].second);
+  EXPECT_EQ(7, msg_range[3].second);
+}
+
+TEST_F(RingMessageBufferTestFixture, Purge)
+{
+  // Verify the finite buffer length purges old data correctly
+
+  // Set a finite buffer length and populate it with some queries
+  buffer.bufferLength(rclcpp::Duration::from_seconds(30.0));
+  populate();
+
+  // Verify the buffer contains the expected data.
+  {
+    auto stamps_range = buffer.stamps();
+    ASSERT_EQ(4, std::distance(stamps_range.begin(), stamps_range.end()));
+    auto stamps_range_iter = stamps_range.begin();
+    EXPECT_EQ(rclcpp::Time(10, 0), *stamps_range_iter);
+    ++stamps_range_iter;
+    EXPECT_EQ(rclcpp::Time(20, 0), *stamps_range_iter);
+    ++stamps_range_iter;
+    EXPECT_EQ(rclcpp::Time(30, 0), *stamps_range_iter);
+    ++stamps_range_iter;
+    EXPECT_EQ(rclcpp::Time(40, 0), *stamps_range_iter);
+  }
+
+  // Add a new entry in the future. Verify the oldest entry is removed.
+  {
+    buffer.insert(rclcpp::Time(50, 0), 5);
+    auto stamps_range = buffer.stamps();
+    ASSERT_EQ(4, std::distance(stamps_range.begin(), stamps_range.end()));
+    auto stamps_range_iter = stamps_range.begin();
+    EXPECT_EQ(rclcpp::Time(20, 0), *stamps_range_iter);
+    ++stamps_range_iter;
+    EXPECT_EQ(rclcpp::Time(30, 0), *stamps_range_iter);
+    ++stamps_range_iter;
+    EXPECT_EQ(rclcpp::Time(40, 0), *stamps_range_iter);
+    ++stamps_range_iter;
+    EXPECT_EQ(rclcpp::Time(50, 0), *stamps_range_iter);
+  }
+
+  // Add a longer entry. This should cause multiple entries to get purged.
+  {
+    buffer.insert(rclcpp::Time(70, 0), 6);
+    auto stamps_range = buffer.stamps();
+    ASSERT_EQ(3, std::distance(stamps_range.begin(), stamps_range.end()));
+    auto stamps_range_iter = stamps_range.begin();
+    EXPECT_EQ(rclcpp::Time(40, 0), *stamps_range_iter);
+    ++stamps_range_iter;
+    EXPECT_EQ(rclcpp::Time(50, 0), *stamps_range_iter);
+    ++stamps_range_iter;
+    EXPECT_EQ(rclcpp::Time(70, 0), *stamps_range_iter);
+  }
+
+  // Add a very long entry. This should cause all but two entry to get purged.
+  {
+    buffer.insert(rclcpp::Time(1000, 0), 7);
+    auto stamps_range = buffer.stamps();
+    ASSERT_EQ(2, std::distance(stamps_range.begin(), stamps_range.end()));
+    auto stamps_range_iter = stamps_range.begin();
+    EXPECT_EQ(rclcpp::Time(70, 0), *stamps_range_iter);
+    ++stamps_range_iter;
+    EXPECT_EQ(rclcpp::Time(1000, 0), *stamps_range_iter);
+  }
+}
@@ -32,6 +32,9 @@
  *  POSSIBILITY OF SUCH DAMAGE.
  */
 #include <gtest/gtest.h>
+#include <rcl/time.h>
+
+#include <vector>
 
 #include <fuse_core/throttled_callback.hpp>
 #include <geometry_msgs/msg/point.hpp>
@@ -322,3 +325,62 @@ TEST_F(TestThrottledCallback, AlwaysKeepFirstMessageEvenIfThrottlePeriodIsTooLar
   ASSERT_NE(nullptr, last_kept_message);
   EXPECT_EQ(0.0, last_kept_message->x);
 }
+
+TEST(AggregatingThrottledMessageCallback, AggregateDroppedMessages)
+{
+  // Throttle against a clock we control
+  auto clock = std::make_shared<rclcpp::Clock>(RCL_ROS_TIME);
+  ASSERT_EQ(RCL_RET_OK, rcl_enable_ros_time_override(clock->get_clock_handle()));
+  const auto set_time = [&clock](const double seconds)
+    {
+      rcl_set_ros_time_override(clock->get_clock_handle(), RCUTILS_S_TO_NS(seconds));
+    };
+
+  // The aggregation adds up the 'x' fields and counts the messages in the 'y' field
+  std::vector<geometry_msgs::msg::Point> kept_messages;
+  fuse_core::AggregatingThrottledMessageCallback<geometry_msgs::msg::Point> throttled_callback(
+    [&kept_messages](const geometry_msgs::msg::Point & message) {
+      kept_messages.push_back(message);
+    },
+    nullptr,
+    rclcpp::Duration::from_seconds(0.2),
+    clock);
+
+  const auto publish = [&throttled_callback, &set_time](const double seconds, const double x)
+    {
+      set_time(seconds);
+      geometry_msgs::msg::Point message;
+      message.x = x;
+      message.y = 1.0;
+      throttled_callback(message);
+    };
+
+  // Without an aggregate callback the dropped messages are discarded
+  publish(1.0, 0.0);
+  publish(1.1, 1.0);
+  publish(1.25, 2.0);
+  ASSERT_EQ(2u, kept_messages.size());
+  EXPECT_EQ(0.0, kept_messages[0].x);
+  EXPECT_EQ(2.0, kept_messages[1].x);
+  EXPECT_EQ(1.0, kept_messages[1].y);
+
+  // With an aggregate callback the dropped messages are combined into the next kept one
+  throttled_callback.setAggregateCallback(
+    [](geometry_msgs::msg::Point & pending, const geometry_msgs::msg::Point & message) {
+      pending.x += message.x;
+      pending.y += message.y;
+    });
+
+  publish(1.3, 3.0);
+  publish(1.35, 4.0);
+  publish(1.45, 5.0);
+  ASSERT_EQ(3u, kept_messages.size());
+  EXPECT_EQ(12.0, kept_messages[2].x);
+  EXPECT_EQ(3.0, kept_messages[2].y);
+
+  // A kept message without any dropped message before it is not modified
+  publish(1.7, 6.0);
+  ASSERT_EQ(4u, kept_messages.size());
+  EXPECT_EQ(6.0, kept_messages[3].x);
+  EXPECT_EQ(1.0, kept_messages[3].y);
+}
@@ -34,6 +34,7 @@
 #include <gtest/gtest.h>
 
 #include <functional>
+#include <map>
 #include <set>
 #include <utility>
 #include <vector>
@@ -44,6 +45,8 @@
 #include <fuse_core/variable.hpp>
 #include <rclcpp/duration.hpp>
 
+#include "example_variable.hpp"
+
 /**
  * Test fixture that adds a known set of entries to the timestamp manager. Used to test the
  * interactions with existing entries.
@@ -853,3 +856,67 @@ TEST_F(TimestampManagerTestFixture, SplitSameMultiple)
   EXPECT_EQ(rclcpp::Time(29, 0), generated_time_spans[4].first);
   EXPECT_EQ(rclcpp::Time(30, 0), generated_time_spans[4].second);
 }
+
+TEST(TimestampManager, UpdateVariables)
+{
+  // Generate one variable per timestamp, as a motion model creating stamped variables would
+  std::map<rclcpp::Time, fuse_core::Variable::SharedPtr> stamp_variables;
+  auto stamp_variable = [&stamp_variables](const rclcpp::Time & stamp)
+    {
+      auto & variable = stamp_variables[stamp];
+      if (!variable) {
+        variable = ExampleVariable::make_shared();
+      }
+      return variable;
+    };
+  fuse_core::TimestampManager manager(
+    [&stamp_variable](
+      const rclcpp::Time & beginning_stamp,
+      const rclcpp::Time & ending_stamp,
+      std::vector<fuse_core::Constraint::SharedPtr> & /*constraints*/,
+      std::vector<fuse_core::Variable::SharedPtr> & variables)
+    {
+      variables.push_back(stamp_variable(beginning_stamp));
+      variables.push_back(stamp_variable(ending_stamp));
+    });
+
+  {
+    fuse_core::Transaction transaction;
+    transaction.addInvolvedStamp(rclcpp::Time(10, 0));
+    transaction.addInvolvedStamp(rclcpp::Time(20, 0));
+    transaction.addInvolvedStamp(rclcpp::Time(30, 0));
+    manager.query(transaction);
+  }
+
+  // Query the existing segments with a transaction that adds different values for some of the
+  // motion model variables, and an unrelated variable
+  auto variable10 = ExampleVariable::make_shared(
+    static_cast<const ExampleVariable &>(*stamp_variables[rclcpp::Time(10, 0)]));
+  variable10->data()[0] = 5.0;
+  auto variable30 = ExampleVariable::make_shared(
+    static_cast<const ExampleVariable &>(*stamp_variables[rclcpp::Time(30, 0)]));
+  variable30->data()[0] = 5.0;
+  auto other_variable = ExampleVariable::make_shared();
+  other_variable->data()[0] = 5.0;
+
+  fuse_core::Transaction transaction;
+  transaction.addInvolvedStamp(rclcpp::Time(10, 0));
+  transaction.addInvolvedStamp(rclcpp::Time(20, 0));
+  transaction.addInvolvedStamp(rclcpp::Time(30, 0));
+  transaction.addVariable(variable10);
+  transaction.addVariable(variable30);
+  transaction.addVariable(other_variable);
+  manager.query(transaction, true);
+
+  // Verify the motion model values replaced the transaction ones, and the motion model variable not
+  // in the transaction was not added
+  std::map<fuse_core::UUID, double> added_values;
+  for (const auto & variable : transaction.addedVariables()) {
+    added_values[variable.uuid()] = variable.data()[0];
+  }
+  ASSERT_EQ(3ul, added_values.size());
+  EXPECT_EQ(0.0, added_values[variable10->uuid()]);
+  EXPECT_EQ(0.0, added_values[variable30->uuid()]);
+  EXPECT_EQ(5.0, added_values[other_variable->uuid()]);
+  EXPECT_EQ(0ul, added_values.count(stamp_variables[rclcpp::Time(20, 0)]->uuid()));
+}
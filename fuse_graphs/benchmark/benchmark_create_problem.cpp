@@ -55,6 +55,7 @@ class TestableHashGraph : public fuse_graphs::HashGraph
 {
 public:
   using fuse_graphs::HashGraph::createProblem;
+  using fuse_graphs::HashGraph::ProblemResources;
 };
 
 /**
@@ -184,10 +185,11 @@ static void BM_createProblem(benchmark::State & state)
 {
   const auto graph = makeTestableHashGraph(state.range(0), state.range(1));
 
+  TestableHashGraph::ProblemResources resources;
   ceres::Problem problem;
 
   for (auto _ : state) {
-    graph.createProblem(problem);
+    graph.createProblem(problem, resources);
   }
 }
 
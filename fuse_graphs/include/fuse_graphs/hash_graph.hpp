@@ -38,6 +38,7 @@
 #include <ceres/problem.h>
 #include <ceres/solver.h>
 
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -45,6 +46,8 @@
 
 #include <fuse_core/constraint.hpp>
 #include <fuse_core/graph.hpp>
+#include <fuse_core/local_parameterization.hpp>
+#include <fuse_core/manifold.hpp>
 #include <fuse_core/fuse_macros.hpp>
 #include <fuse_core/serialization.hpp>
 #include <fuse_core/uuid.hpp>
@@ -407,15 +410,58 @@ protected:
   Variables variables_;  //!< The set of all variables
   VariableSet variables_on_hold_;  //!< The set of variables that should be held constant
 
+  /**
+   * @brief Objects referenced by a ceres::Problem populated by createProblem(), but not owned by it
+   *
+   * The problem options never let Ceres take ownership of the local parameterizations or the loss
+   * functions, because shared instances (see fuse_core::Variable::sharedLocalParameterization()
+   * and fuse_core::Loss::sharedLossFunction()) are used whenever one is provided. Anything created
+   * for a single problem is kept here instead, so it must outlive the ceres::Problem.
+   */
+  struct ProblemResources
+  {
+    //! Created by the deprecated fuse_core::Variable::localParameterization()
+    std::vector<std::unique_ptr<ceres::LocalParameterization>> local_parameterizations;
+    //! Created by fuse_core::Loss::lossFunction(), for losses without a shared instance
+    std::vector<std::unique_ptr<ceres::LossFunction>> loss_functions;
+    //! The loss functions with a graduated non-convexity schedule, one per fuse_core::Loss. They
+    //! are also held by \p loss_functions.
+    std::unordered_map<const fuse_core::Loss *, ceres::LossFunction *> gnc_loss_functions;
+  };
+
   /**
    * @brief Populate a ceres::Problem object using the current set of variables and constraints
    *
    * This function assumes the provided variables and constraints are consistent. No checks are
    * performed for missing variables or constraints.
    *
-   * @param[out] problem The ceres::Problem object to modify
+   * @param[out] problem   The ceres::Problem object to modify
+   * @param[out] resources The objects created for \p problem, which must outlive it
+   */
+  void createProblem(ceres::Problem & problem, ProblemResources & resources) const;
+
+  /**
+   * @brief Run the solver on a ceres::Problem populated by createProblem()
+   *
+   * Loss functions with a graduated non-convexity schedule (see fuse_core::Loss::gncStages()) are
+   * walked through their stages, with one solve per stage warm-started from the previous one, so a
+   * problem with such a loss costs up to gncStages() + 1 Ceres solves instead of one. The stage is
+   * only applied to the loss function instances of this problem, held by \p resources, so other
+   * graphs and clones using the same fuse_core::Loss are not affected. The iteration and time
+   * budgets of the options are split among the stages, each one getting an equal share of what is
+   * left, so the last stage always runs even when an earlier one stops on its budget. The summary
+   * is the one of the last stage, with the iterations, steps and time of all the stages.
+   *
+   * @param[in]  options   The Ceres Solver::Options object that controls the optimizer
+   * @param[in]  problem   The ceres::Problem object to solve
+   * @param[in]  resources The objects created by createProblem() for \p problem
+   * @param[out] summary   The Ceres Solver Summary structure of the optimization
    */
-  void createProblem(ceres::Problem & problem) const;
+  void solve(
+    const ceres::Solver::Options & options,
+    ceres::Problem & problem,
+    const ProblemResources & resources,
+    ceres::Solver::Summary & summary);
 
 private:
   // Allow Boost Serialization access to private methods
@@ -435,6 +481,13 @@ private:
     archive & constraints_;
     archive & constraints_by_variable_uuid_;
     archive & problem_options_;
+    // Older archives may carry a different ownership policy; the shared loss function and local
+    // parameterization instances must never be handed to Ceres for deletion
+    problem_options_.loss_function_ownership = fuse_core::Loss::SharedOwnership;
+    problem_options_.local_parameterization_ownership = fuse_core::LocalParameterization::Ownership;
+#if CERES_SUPPORTS_MANIFOLDS
+    problem_options_.manifold_ownership = fuse_core::Manifold::Ownership;
+#endif
     archive & variables_;
     archive & variables_on_hold_;
   }
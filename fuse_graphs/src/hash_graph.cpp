@@ -52,8 +52,13 @@ namespace fuse_graphs
 HashGraph::HashGraph(const HashGraphParams & params)
 : problem_options_(params.problem_options)
 {
-  // Set Ceres loss function ownership according to the fuse_core::Loss specification
-  problem_options_.loss_function_ownership = fuse_core::Loss::Ownership;
+  // Constraints hand out shared loss function instances that Ceres must not delete
+  problem_options_.loss_function_ownership = fuse_core::Loss::SharedOwnership;
+  // Variables hand out shared local parameterization instances that Ceres must not delete
+  problem_options_.local_parameterization_ownership = fuse_core::LocalParameterization::Ownership;
+#if CERES_SUPPORTS_MANIFOLDS
+  problem_options_.manifold_ownership = fuse_core::Manifold::Ownership;
+#endif
 }
 
 HashGraph::HashGraph(const HashGraph & other)
@@ -313,8 +318,9 @@ void HashGraph::getCovariance(
     return;
   }
   // Construct the ceres::Problem object from scratch
+  ProblemResources resources;
   ceres::Problem problem(problem_options_);
-  createProblem(problem);
+  createProblem(problem, resources);
   // The Ceres interface requires that the variable pairs not contain duplicates. Since the
   // covariance matrix is symmetric, requesting Cov(A,B) and Cov(B,A) counts as a duplicate. Create
   // an expression to test a pair of data pointers such that (A,B) == (A,B) OR (B,A)
@@ -417,11 +423,12 @@ void HashGraph::getCovariance(
 ceres::Solver::Summary HashGraph::optimize(const ceres::Solver::Options & options)
 {
   // Construct the ceres::Problem object from scratch
+  ProblemResources resources;
   ceres::Problem problem(problem_options_);
-  createProblem(problem);
+  createProblem(problem, resources);
   // Run the solver. This will update the variables in place.
   ceres::Solver::Summary summary;
-  ceres::Solve(options, &problem, &summary);
+  solve(options, problem, resources, summary);
   // Return the optimization summary
   return summary;
 }
@@ -434,8 +441,9 @@ ceres::Solver::Summary HashGraph::optimizeFor(
   auto start = clock.now();
 
   // Construct the ceres::Problem object from scratch
+  ProblemResources resources;
   ceres::Problem problem(problem_options_);
-  createProblem(problem);
+  createProblem(problem, resources);
   auto created_problem = clock.now();
 
   // Modify the options to enforce the maximum time
@@ -445,7 +453,7 @@ ceres::Solver::Summary HashGraph::optimizeFor(
 
   // Run the solver. This will update the variables in place.
   ceres::Solver::Summary summary;
-  ceres::Solve(time_constrained_options, &problem, &summary);
+  solve(time_constrained_options, problem, resources, summary);
 
   // Return the optimization summary
   return summary;
@@ -455,8 +463,9 @@ bool HashGraph::evaluate(
   double * cost, std::vector<double> * residuals, std::vector<double> * gradient,
   const ceres::Problem::EvaluateOptions & options) const
 {
+  ProblemResources resources;
   ceres::Problem problem(problem_options_);
-  createProblem(problem);
+  createProblem(problem, resources);
 
   return problem.Evaluate(options, cost, residuals, gradient, nullptr);
 }
@@ -477,15 +486,41 @@ void HashGraph::print(std::ostream & stream) const
   }
 }
 
-void HashGraph::createProblem(ceres::Problem & problem) const
+void HashGraph::createProblem(ceres::Problem & problem, ProblemResources & resources) const
 {
+  // Prefer the shared local parameterizations. Variables that only implement the deprecated
+  // localParameterization() hand over a new object, which is kept alive with the problem.
+  auto local_parameterization = [&resources](const fuse_core::Variable & variable)
+    {
+      auto shared = variable.sharedLocalParameterization();
+      if (shared) {
+        return shared;
+      }
+      auto owned = variable.localParameterization();
+      if (owned) {
+        resources.local_parameterizations.emplace_back(owned);
+      }
+      return owned;
+    };
   // Add all the variables to the problem
   for (auto & uuid__variable : variables_) {
     fuse_core::Variable & variable = *(uuid__variable.second);
+#if CERES_SUPPORTS_MANIFOLDS
+    auto manifold = variable.manifold();
+    if (manifold) {
+      problem.AddParameterBlock(variable.data(), variable.size(), manifold);
+    } else {
+      problem.AddParameterBlock(
+        variable.data(),
+        variable.size(),
+        local_parameterization(variable));
+    }
+#else
     problem.AddParameterBlock(
       variable.data(),
       variable.size(),
-      variable.localParameterization());
+      local_parameterization(variable));
+#endif
     // Handle optimization bounds
     for (size_t index = 0; index < variable.size(); ++index) {
       auto lower_bound = variable.lowerBound(index);
@@ -502,6 +537,34 @@ void HashGraph::createProblem(ceres::Problem & problem) const
       problem.SetParameterBlockConstant(variable.data());
     }
   }
+  // Prefer the shared loss functions. Losses without a shared instance hand over a new object,
+  // which is kept alive with the problem. Losses with a graduated non-convexity schedule get one
+  // new object per problem, so solve() can change its stage without affecting other problems.
+  auto loss_function = [&resources](const fuse_core::Constraint & constraint)
+    -> ceres::LossFunction *
+    {
+      const auto loss = constraint.loss();
+      if (!loss) {
+        return nullptr;
+      }
+      if (loss->gncStages() > 0) {
+        auto & gnc_loss_function = resources.gnc_loss_functions[loss.get()];
+        if (!gnc_loss_function) {
+          gnc_loss_function = loss->lossFunction();
+          resources.loss_functions.emplace_back(gnc_loss_function);
+        }
+        return gnc_loss_function;
+      }
+      auto shared = loss->sharedLossFunction();
+      if (shared) {
+        return shared;
+      }
+      auto owned = loss->lossFunction();
+      if (owned) {
+        resources.loss_functions.emplace_back(owned);
+      }
+      return owned;
+    };
   // Add the constraints
   std::vector<double *> parameter_blocks;
   for (auto & uuid__constraint : constraints_) {
@@ -514,11 +577,68 @@ void HashGraph::createProblem(ceres::Problem & problem) const
     }
     problem.AddResidualBlock(
       constraint.costFunction(),
-      constraint.lossFunction(),
+      loss_function(constraint),
       parameter_blocks);
   }
 }
 
+void HashGraph::solve(
+  const ceres::Solver::Options & options,
+  ceres::Problem & problem,
+  const ProblemResources & resources,
+  ceres::Solver::Summary & summary)
+{
+  // Find the longest graduated non-convexity schedule
+  size_t stages = 0;
+  for (const auto & loss__loss_function : resources.gnc_loss_functions) {
+    stages = std::max(stages, loss__loss_function.first->gncStages());
+  }
+
+  if (stages == 0) {
+    ceres::Solve(options, &problem, &summary);
+    return;
+  }
+
+  // Walk the schedule, aligning the last stage of every loss with the last solve
+  auto stage_options = options;
+  std::vector<ceres::IterationSummary> iterations;
+  int num_successful_steps = 0;
+  int num_unsuccessful_steps = 0;
+  double total_time_in_seconds = 0.0;
+  for (size_t stage = 0; stage <= stages; ++stage) {
+    for (const auto & loss__loss_function : resources.gnc_loss_functions) {
+      const auto loss = loss__loss_function.first;
+      const auto loss_stages = loss->gncStages();
+      loss->gncStage(
+        loss__loss_function.second,
+        stage + loss_stages >= stages ? stage + loss_stages - stages : 0);
+    }
+
+    // Share the remaining iteration and time budgets equally among the remaining stages. The last
+    // stage, the only one with the actual losses, always runs with whatever is left, so the final
+    // solution and cost are never those of an intermediate surrogate loss.
+    const auto remaining_stages = static_cast<int>(stages - stage + 1);
+    const int remaining_iterations = std::max(
+      0, options.max_num_iterations - num_successful_steps - num_unsuccessful_steps);
+    const double remaining_time =
+      std::max(0.0, options.max_solver_time_in_seconds - total_time_in_seconds);
+    stage_options.max_num_iterations = remaining_iterations / remaining_stages;
+    stage_options.max_solver_time_in_seconds = remaining_time / remaining_stages;
+
+    ceres::Solve(stage_options, &problem, &summary);
+
+    iterations.insert(iterations.end(), summary.iterations.begin(), summary.iterations.end());
+    num_successful_steps += summary.num_successful_steps;
+    num_unsuccessful_steps += summary.num_unsuccessful_steps;
+    total_time_in_seconds += summary.total_time_in_seconds;
+  }
+
+  summary.iterations = std::move(iterations);
+  summary.num_successful_steps = num_successful_steps;
+  summary.num_unsuccessful_steps = num_unsuccessful_steps;
+  summary.total_time_in_seconds = total_time_in_seconds;
+}
+
 }  // namespace fuse_graphs
 
 BOOST_CLASS_EXPORT_IMPLEMENT(fuse_graphs::HashGraph)
@@ -34,8 +34,11 @@
 #ifndef FUSE_GRAPHS__TEST_EXAMPLE_LOSS_HPP_  // NOLINT{build/header_guard}
 #define FUSE_GRAPHS__TEST_EXAMPLE_LOSS_HPP_  // NOLINT{build/header_guard}
 
+#include <cmath>
+#include <cstddef>
 #include <ostream>
 #include <string>
+#include <vector>
 
 #include <fuse_core/loss.hpp>
 #include <fuse_core/fuse_macros.hpp>
@@ -97,4 +100,90 @@ private:
 
 BOOST_CLASS_EXPORT(ExampleLoss);
 
+/**
+ * @brief Geman-McClure loss, rho(s) = s / (1 + s), with the scale continuation
+ *        rho_mu(s) = mu * rho(s / mu) used for graduated non-convexity
+ */
+class ExampleGNCLossFunction : public ceres::LossFunction
+{
+public:
+  void Evaluate(double s, double rho[3]) const override
+  {
+    const double inv = 1.0 / (1.0 + s / scale);
+    rho[0] = s * inv;
+    rho[1] = inv * inv;
+    rho[2] = -2.0 * inv * inv * inv / scale;
+  }
+
+  double scale{1.0};    //!< The GNC control parameter 'mu'
+};
+
+/**
+ * @brief Dummy loss with a graduated non-convexity schedule for testing
+ *
+ * The control parameter is halved on every stage, starting at 100.
+ */
+class ExampleGNCLoss : public fuse_core::Loss
+{
+public:
+  FUSE_LOSS_DEFINITIONS(ExampleGNCLoss)
+
+  explicit ExampleGNCLoss(const size_t stages = 7)
+  : stages(stages)
+  {
+  }
+
+  void initialize(
+    fuse_core::node_interfaces::NodeInterfaces<
+      fuse_core::node_interfaces::Base,
+      fuse_core::node_interfaces::Logging,
+      fuse_core::node_interfaces::Parameters
+    >/*interfaces*/,
+    const std::string & /*name*/) override {}
+
+  void print(std::ostream & /*stream = std::cout*/) const override {}
+
+  ceres::LossFunction * lossFunction() const override
+  {
+    ++loss_function_count;
+    return new ExampleGNCLossFunction();
+  }
+
+  size_t gncStages() const override
+  {
+    return stages;
+  }
+
+  void gncStage(ceres::LossFunction * loss_function, const size_t stage) const override
+  {
+    static_cast<ExampleGNCLossFunction *>(loss_function)->scale =
+      stage >= stages ? 1.0 : 100.0 / std::pow(2.0, stage);
+    stage_history.push_back(stage);
+  }
+
+  size_t stages{7};    //!< Public member variable just for testing
+  mutable std::vector<size_t> stage_history;    //!< Public member variable just for testing
+  mutable size_t loss_function_count{0};    //!< Public member variable just for testing
+
+private:
+  // Allow Boost Serialization access to private methods
+  friend class boost::serialization::access;
+
+  /**
+   * @brief The Boost Serialize method that serializes all of the data members in to/out of the
+   *        archive
+   *
+   * @param[in/out] archive - The archive object that holds the serialized class members
+   * @param[in] version - The version of the archive being read/written. Generally unused.
+   */
+  template<class Archive>
+  void serialize(Archive & archive, const unsigned int /* version */)
+  {
+    archive & boost::serialization::base_object<fuse_core::Loss>(*this);
+    archive & stages;
+  }
+};
+
+BOOST_CLASS_EXPORT(ExampleGNCLoss);
+
 #endif  // FUSE_GRAPHS__TEST_EXAMPLE_LOSS_HPP_  // NOLINT{build/header_guard}
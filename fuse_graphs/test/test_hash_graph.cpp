@@ -676,6 +676,82 @@ TEST_F(HashGraphTestFixture, Optimize)
   EXPECT_NEAR(-3.0, variable2->data()[0], 1.0e-7);
 }
 
+TEST_F(HashGraphTestFixture, OptimizeGraduatedNonConvexity)
+{
+  // Test that the graph walks losses with a GNC schedule through all their stages, which moves a
+  // variable initialized at a cluster of outliers out of that local minimum of the robust loss
+  auto optimize = [](const ExampleGNCLoss::SharedPtr & loss)
+    {
+      fuse_graphs::HashGraph graph;
+
+      auto variable = ExampleVariable::make_shared();
+      variable->data()[0] = 10.0;
+      graph.addVariable(variable);
+
+      for (size_t i = 0; i < 20; ++i) {
+        auto inlier = ExampleConstraint::make_shared("test", variable->uuid());
+        inlier->data = 1.0;
+        inlier->loss(loss);
+        graph.addConstraint(inlier);
+      }
+      for (size_t i = 0; i < 8; ++i) {
+        auto outlier = ExampleConstraint::make_shared("test", variable->uuid());
+        outlier->data = 10.0;
+        outlier->loss(loss);
+        graph.addConstraint(outlier);
+      }
+
+      graph.optimize();
+      return variable->data()[0];
+    };
+
+  // Without a schedule the solver stays at the outliers
+  auto robust_loss = ExampleGNCLoss::make_shared(0);
+  EXPECT_NEAR(10.0, optimize(robust_loss), 1.0e-1);
+  EXPECT_TRUE(robust_loss->stage_history.empty());
+
+  // With a schedule the solver converges to the inliers
+  auto gnc_loss = ExampleGNCLoss::make_shared(7);
+  EXPECT_NEAR(1.0, optimize(gnc_loss), 1.0e-3);
+  const std::vector<size_t> expected_stages{0, 1, 2, 3, 4, 5, 6, 7};
+  EXPECT_EQ(expected_stages, gnc_loss->stage_history);
+
+  // The stage is kept in one loss function per problem, shared by all of its constraints
+  EXPECT_EQ(1u, gnc_loss->loss_function_count);
+}
+
+TEST_F(HashGraphTestFixture, OptimizeGraduatedNonConvexityBudget)
+{
+  // Test that the last stage still runs when the first one would use up the whole iteration
+  // budget, so the final cost is the one of the actual loss and not of a surrogate
+  fuse_graphs::HashGraph graph;
+
+  auto variable = ExampleVariable::make_shared();
+  variable->data()[0] = 10.0;
+  graph.addVariable(variable);
+
+  auto loss = ExampleGNCLoss::make_shared(7);
+  for (size_t i = 0; i < 20; ++i) {
+    auto constraint = ExampleConstraint::make_shared("test", variable->uuid());
+    constraint->data = 1.0;
+    constraint->loss(loss);
+    graph.addConstraint(constraint);
+  }
+
+  ceres::Solver::Options options;
+  options.max_num_iterations = 2;
+  const auto summary = graph.optimize(options);
+
+  const std::vector<size_t> expected_stages{0, 1, 2, 3, 4, 5, 6, 7};
+  EXPECT_EQ(expected_stages, loss->stage_history);
+  EXPECT_LE(summary.num_successful_steps + summary.num_unsuccessful_steps, 2);
+
+  // A new problem uses the loss function as created, i.e. the actual loss
+  double cost = 0.0;
+  ASSERT_TRUE(graph.evaluate(&cost));
+  EXPECT_NEAR(cost, summary.final_cost, 1.0e-9);
+}
+
 TEST_F(HashGraphTestFixture, HoldVariable)
 {
   // Test placing a variable on hold. The value of the variable should remain constant even after
@@ -119,6 +119,18 @@ public:
    */
   ceres::LossFunction * lossFunction() const override;
 
+  /**
+   * @brief Access the shared ceres::LossFunction that implements the loss function
+   *
+   * The returned object is shared by every composed loss with the same shared f_loss and g_loss
+   * functions, and is never destroyed, so the caller must not delete it. See
+   * fuse_core::Loss::SharedOwnership.
+   *
+   * @return A base pointer to the shared instance of a derived ceres::LossFunction, or nullptr if
+   *         either loss does not provide a shared instance.
+   */
+  ceres::LossFunction * sharedLossFunction() const override;
+
   /**
    * @brief Parameter 'f_loss' accessor.
    *
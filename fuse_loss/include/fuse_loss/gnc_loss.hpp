@@ -0,0 +1,233 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2020, Clearpath Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef FUSE_LOSS__GNC_LOSS_HPP_
+#define FUSE_LOSS__GNC_LOSS_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <string>
+
+#include <fuse_core/loss.hpp>
+#include <fuse_loss/loss_function.hpp>
+
+#include <boost/serialization/access.hpp>
+#include <boost/serialization/base_object.hpp>
+#include <boost/serialization/export.hpp>
+
+
+namespace fuse_loss
+{
+
+/**
+ * @brief The GNCLoss loss function.
+ *
+ * This class encapsulates the ceres::GNCLoss class, adding the ability to serialize it and load
+ * it dynamically. It wraps a robust loss function, such as the GemanMcClureLoss, TukeyLoss or
+ * WelschLoss, with a graduated non-convexity (GNC) schedule. The graph walks the schedule on every
+ * optimization, starting from a convex surrogate of the wrapped loss, so many outliers entering
+ * the problem at once do not trap the solver in a poor local minimum.
+ *
+ * Walking the schedule costs one Ceres solve per stage, i.e. up to gncStages() + 1 solves per
+ * optimization, sharing the iteration and time budgets of the solver options. Only use this loss
+ * where that cost pays off. Every problem gets its own ceres::GNCLoss, so there is no shared
+ * instance, and the stage never leaks into other graphs, graph clones or publishers.
+ *
+ * See ceres::GNCLoss in fuse_loss/loss_function.hpp for more details.
+ */
+class GNCLoss : public fuse_core::Loss
+{
+public:
+  FUSE_LOSS_DEFINITIONS(GNCLoss)
+
+  /**
+   * @brief Constructor
+   *
+   * @param[in] initial_scale GNCLoss parameter 'initial_scale', the control parameter 'mu' of the
+   *                          first stage
+   * @param[in] annealing_factor GNCLoss parameter 'annealing_factor', the factor 'mu' is divided by
+   *                             from one stage to the next
+   * @param[in] loss The robust loss function to anneal
+   */
+  explicit GNCLoss(
+    const double initial_scale = 100.0,
+    const double annealing_factor = 2.0,
+    const std::shared_ptr<fuse_core::Loss> & loss = nullptr);
+
+  /**
+   * @brief Destructor
+   */
+  ~GNCLoss() override = default;
+
+  /**
+   * @brief Perform any required post-construction initialization, such as reading from the
+   *        parameter server.
+   *
+   * This will be called on each plugin after construction.
+   *
+   * @param[in] interfaces - The node interfaces used to load the parameter
+   * @param[in] name A unique name to initialize this plugin instance, such as from the parameter
+   *                 server.
+   */
+  void initialize(
+    fuse_core::node_interfaces::NodeInterfaces<
+      fuse_core::node_interfaces::Base,
+      fuse_core::node_interfaces::Logging,
+      fuse_core::node_interfaces::Parameters
+    > interfaces,
+    const std::string & name) override;
+
+  /**
+   * @brief Print a human-readable description of the loss function to the provided stream.
+   *
+   * @param[out] stream The stream to write to. Defaults to stdout.
+   */
+  void print(std::ostream & stream = std::cout) const override;
+
+  /**
+   * @brief Return a raw pointer to a ceres::LossFunction that implements the loss function.
+   *
+   * The Ceres interface requires a raw pointer. Ceres will take ownership of the pointer and
+   * promises to properly delete the loss function when it is done. The returned object starts at
+   * the last stage of the schedule, i.e. it behaves as the wrapped loss.
+   *
+   * @return A base pointer to an instance of a derived ceres::LossFunction.
+   */
+  ceres::LossFunction * lossFunction() const override;
+
+  /**
+   * @brief The number of graduated non-convexity stages of the schedule
+   *
+   * @return The index of the last GNC stage, which is the wrapped loss function itself
+   */
+  size_t gncStages() const override;
+
+  /**
+   * @brief Move a loss function created by lossFunction() to a graduated non-convexity stage
+   *
+   * @param[in] loss_function A loss function returned by lossFunction()
+   * @param[in] stage         The GNC stage, in the range [0, gncStages()]
+   */
+  void gncStage(ceres::LossFunction * loss_function, const size_t stage) const override;
+
+  /**
+   * @brief Parameter 'initial_scale' accessor.
+   *
+   * @return Parameter 'initial_scale'.
+   */
+  double initialScale() const
+  {
+    return initial_scale_;
+  }
+
+  /**
+   * @brief Parameter 'annealing_factor' accessor.
+   *
+   * @return Parameter 'annealing_factor'.
+   */
+  double annealingFactor() const
+  {
+    return annealing_factor_;
+  }
+
+  /**
+   * @brief Parameter 'loss' accessor.
+   *
+   * @return Parameter 'loss'.
+   */
+  std::shared_ptr<fuse_core::Loss> loss() const
+  {
+    return loss_;
+  }
+
+  /**
+   * @brief Parameter 'initial_scale' mutator.
+   *
+   * @param[in] initial_scale Parameter 'initial_scale'.
+   */
+  void initialScale(const double initial_scale)
+  {
+    initial_scale_ = initial_scale;
+  }
+
+  /**
+   * @brief Parameter 'annealing_factor' mutator.
+   *
+   * @param[in] annealing_factor Parameter 'annealing_factor'.
+   */
+  void annealingFactor(const double annealing_factor)
+  {
+    annealing_factor_ = annealing_factor;
+  }
+
+  /**
+   * @brief Parameter 'loss' mutator.
+   *
+   * @param[in] loss Parameter 'loss'.
+   */
+  void loss(const std::shared_ptr<fuse_core::Loss> & loss)
+  {
+    loss_ = loss;
+  }
+
+private:
+  double initial_scale_{100.0};    //!< GNCLoss parameter 'initial_scale'
+  double annealing_factor_{2.0};    //!< GNCLoss parameter 'annealing_factor'
+  std::shared_ptr<fuse_core::Loss> loss_{nullptr};    //!< The robust loss function to anneal
+
+  // Allow Boost Serialization access to private methods
+  friend class boost::serialization::access;
+
+  /**
+   * @brief The Boost Serialize method that serializes all of the data members in to/out of the
+   *        archive
+   *
+   * @param[in/out] archive - The archive object that holds the serialized class members
+   * @param[in] version - The version of the archive being read/written. Generally unused.
+   */
+  template<class Archive>
+  void serialize(Archive & archive, const unsigned int /* version */)
+  {
+    archive & boost::serialization::base_object<fuse_core::Loss>(*this);
+    archive & initial_scale_;
+    archive & annealing_factor_;
+    archive & loss_;
+  }
+};
+
+}  // namespace fuse_loss
+
+BOOST_CLASS_EXPORT_KEY(fuse_loss::GNCLoss);
+
+#endif  // FUSE_LOSS__GNC_LOSS_HPP_
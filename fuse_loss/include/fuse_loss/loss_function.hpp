@@ -36,6 +36,8 @@
 
 #include <ceres/loss_function.h>
 
+#include <cstddef>
+
 // This provides additional loss functions that are not available in:
 // https://github.com/ceres-solver/ceres-solver/blob/master/include/ceres/loss_function.h
 //
@@ -233,6 +235,61 @@ private:
   const double b_;
 };
 
+// Graduated Non-Convexity (GNC) wrapper for a robust loss function 'rho', using the scale
+// continuation of the control parameter 'mu' described in:
+//
+//   https://arxiv.org/abs/1909.08605
+//
+// The term is computed as:
+//
+//   rho_mu(s) = mu * rho(s / mu)
+//
+// so for a large 'mu' every squared residual 's' falls in the quadratic region of rho(s), where
+// rho(s) ~ s, and the loss is a convex surrogate. When 'mu' reaches 1 the original loss is
+// recovered. The control parameter follows the schedule:
+//
+//   mu_k = max { 1, initial_scale / annealing_factor^k }    for k = 0, ..., stages()
+//
+// where stages() is the first 'k' with mu_k = 1. Stage stages() is used until stage() is called,
+// so the loss behaves as 'rho' unless an optimizer is walking it through the schedule. The stage
+// must not be changed while the loss is being evaluated, so each problem needs its own instance.
+//
+// At s = 0: rho = [0, rho'(0), rho''(0) / mu].
+class GNCLoss : public ceres::LossFunction
+{
+public:
+  GNCLoss(
+    const LossFunction * rho, const double initial_scale, const double annealing_factor,
+    const Ownership ownership);
+
+  GNCLoss(const GNCLoss &) = delete;
+  GNCLoss & operator=(const GNCLoss &) = delete;
+
+  ~GNCLoss() override;
+
+  void Evaluate(double, double *) const override;
+
+  size_t stages() const
+  {
+    return stages_;
+  }
+
+  void stage(const size_t stage);
+
+  double scale() const
+  {
+    return scale_;
+  }
+
+private:
+  const LossFunction * rho_;
+  const double initial_scale_;
+  const double annealing_factor_;
+  const Ownership ownership_;
+  size_t stages_{0};
+  double scale_{1.0};
+};
+
 // Welsch, similar to Tukey loss, it tries to reduce the effect of large errors, but it does not
 // suppress outliers as Tukey might do.
 //
@@ -115,6 +115,18 @@ public:
    */
   ceres::LossFunction * lossFunction() const override;
 
+  /**
+   * @brief Access the shared ceres::LossFunction that implements the loss function
+   *
+   * The returned object is shared by every scaled loss with the same shared loss function and
+   * parameter 'a', and is never destroyed, so the caller must not delete it. See
+   * fuse_core::Loss::SharedOwnership.
+   *
+   * @return A base pointer to the shared instance of a derived ceres::LossFunction, or nullptr if
+   *         the scaled loss does not provide a shared instance.
+   */
+  ceres::LossFunction * sharedLossFunction() const override;
+
   /**
    * @brief Parameter 'a' accessor.
    *
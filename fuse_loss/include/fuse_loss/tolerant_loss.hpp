@@ -112,6 +112,16 @@ public:
    */
   ceres::LossFunction * lossFunction() const override;
 
+  /**
+   * @brief Access the shared ceres::LossFunction that implements the loss function
+   *
+   * The returned object is shared by every loss with the same parameters and is never destroyed, so
+   * the caller must not delete it. See fuse_core::Loss::SharedOwnership.
+   *
+   * @return A base pointer to the shared instance of a derived ceres::LossFunction.
+   */
+  ceres::LossFunction * sharedLossFunction() const override;
+
   /**
    * @brief Parameter 'a' accessor.
    *
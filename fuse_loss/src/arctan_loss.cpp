@@ -69,6 +69,11 @@ ceres::LossFunction * ArctanLoss::lossFunction() const
   return new ceres::ArctanLoss(a_);
 }
 
+ceres::LossFunction * ArctanLoss::sharedLossFunction() const
+{
+  return fuse_core::sharedLossFunctionInstance<ceres::ArctanLoss>(a_);
+}
+
 }  // namespace fuse_loss
 
 BOOST_CLASS_EXPORT_IMPLEMENT(fuse_loss::ArctanLoss);
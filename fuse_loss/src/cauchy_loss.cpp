@@ -69,6 +69,11 @@ ceres::LossFunction * CauchyLoss::lossFunction() const
   return new ceres::CauchyLoss(a_);
 }
 
+ceres::LossFunction * CauchyLoss::sharedLossFunction() const
+{
+  return fuse_core::sharedLossFunctionInstance<ceres::CauchyLoss>(a_);
+}
+
 }  // namespace fuse_loss
 
 BOOST_CLASS_EXPORT_IMPLEMENT(fuse_loss::CauchyLoss);
@@ -83,6 +83,21 @@ ceres::LossFunction * ComposedLoss::lossFunction() const
     g_loss_ ? g_loss_->lossFunction() : TrivialLoss().lossFunction(), Ownership);
 }
 
+ceres::LossFunction * ComposedLoss::sharedLossFunction() const
+{
+  // The composed loss can only be shared if both losses it wraps are shared as well
+  const auto f_loss_function =
+    f_loss_ ? f_loss_->sharedLossFunction() : TrivialLoss().sharedLossFunction();
+  const auto g_loss_function =
+    g_loss_ ? g_loss_->sharedLossFunction() : TrivialLoss().sharedLossFunction();
+  if (!f_loss_function || !g_loss_function) {
+    return nullptr;
+  }
+
+  return fuse_core::sharedLossFunctionInstance<ceres::ComposedLoss>(
+    f_loss_function, SharedOwnership, g_loss_function, SharedOwnership);
+}
+
 }  // namespace fuse_loss
 
 BOOST_CLASS_EXPORT_IMPLEMENT(fuse_loss::ComposedLoss);
@@ -70,6 +70,11 @@ ceres::LossFunction * DCSLoss::lossFunction() const
   return new ceres::DCSLoss(a_);
 }
 
+ceres::LossFunction * DCSLoss::sharedLossFunction() const
+{
+  return fuse_core::sharedLossFunctionInstance<ceres::DCSLoss>(a_);
+}
+
 }  // namespace fuse_loss
 
 BOOST_CLASS_EXPORT_IMPLEMENT(fuse_loss::DCSLoss);
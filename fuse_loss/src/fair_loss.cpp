@@ -70,6 +70,11 @@ ceres::LossFunction * FairLoss::lossFunction() const
   return new ceres::FairLoss(a_);
 }
 
+ceres::LossFunction * FairLoss::sharedLossFunction() const
+{
+  return fuse_core::sharedLossFunctionInstance<ceres::FairLoss>(a_);
+}
+
 }  // namespace fuse_loss
 
 BOOST_CLASS_EXPORT_IMPLEMENT(fuse_loss::FairLoss);
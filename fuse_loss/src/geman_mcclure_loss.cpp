@@ -70,6 +70,11 @@ ceres::LossFunction * GemanMcClureLoss::lossFunction() const
   return new ceres::GemanMcClureLoss(a_);
 }
 
+ceres::LossFunction * GemanMcClureLoss::sharedLossFunction() const
+{
+  return fuse_core::sharedLossFunctionInstance<ceres::GemanMcClureLoss>(a_);
+}
+
 }  // namespace fuse_loss
 
 BOOST_CLASS_EXPORT_IMPLEMENT(fuse_loss::GemanMcClureLoss);
@@ -0,0 +1,102 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2020, Clearpath Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <memory>
+#include <ostream>
+#include <string>
+
+#include <boost/serialization/export.hpp>
+#include <fuse_core/parameter.hpp>
+#include <fuse_loss/gnc_loss.hpp>
+#include <pluginlib/class_list_macros.hpp>
+
+namespace fuse_loss
+{
+
+GNCLoss::GNCLoss(
+  const double initial_scale, const double annealing_factor,
+  const std::shared_ptr<fuse_core::Loss> & loss)
+: initial_scale_(initial_scale), annealing_factor_(annealing_factor), loss_(loss)
+{
+}
+
+void GNCLoss::initialize(
+  fuse_core::node_interfaces::NodeInterfaces<
+    fuse_core::node_interfaces::Base,
+    fuse_core::node_interfaces::Logging,
+    fuse_core::node_interfaces::Parameters
+  > interfaces,
+  const std::string & name)
+{
+  initial_scale_ = fuse_core::getParam(interfaces, name + ".initial_scale", initial_scale_);
+  annealing_factor_ =
+    fuse_core::getParam(interfaces, name + ".annealing_factor", annealing_factor_);
+  loss_ = fuse_core::loadLossConfig(interfaces, name + ".loss");
+}
+
+void GNCLoss::print(std::ostream & stream) const
+{
+  stream << type() << "\n"
+         << "  initial_scale: " << initial_scale_ << "\n"
+         << "  annealing_factor: " << annealing_factor_ << "\n";
+
+  if (loss_) {
+    stream << "  loss: " << loss_ << "\n";
+  }
+}
+
+ceres::LossFunction * GNCLoss::lossFunction() const
+{
+  return new ceres::GNCLoss(
+    loss_ ? loss_->lossFunction() : nullptr, initial_scale_, annealing_factor_, Ownership);
+}
+
+size_t GNCLoss::gncStages() const
+{
+  // The number of stages only depends on the schedule
+  return ceres::GNCLoss(
+    nullptr, initial_scale_, annealing_factor_, ceres::DO_NOT_TAKE_OWNERSHIP).stages();
+}
+
+void GNCLoss::gncStage(ceres::LossFunction * loss_function, const size_t stage) const
+{
+  auto gnc_loss_function = dynamic_cast<ceres::GNCLoss *>(loss_function);
+  if (gnc_loss_function) {
+    gnc_loss_function->stage(stage);
+  }
+}
+
+}  // namespace fuse_loss
+
+BOOST_CLASS_EXPORT_IMPLEMENT(fuse_loss::GNCLoss);
+PLUGINLIB_EXPORT_CLASS(fuse_loss::GNCLoss, fuse_core::Loss);
@@ -69,6 +69,11 @@ ceres::LossFunction * HuberLoss::lossFunction() const
   return new ceres::HuberLoss(a_);
 }
 
+ceres::LossFunction * HuberLoss::sharedLossFunction() const
+{
+  return fuse_core::sharedLossFunctionInstance<ceres::HuberLoss>(a_);
+}
+
 }  // namespace fuse_loss
 
 BOOST_CLASS_EXPORT_IMPLEMENT(fuse_loss::HuberLoss);
@@ -31,7 +31,9 @@
  *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  *  POSSIBILITY OF SUCH DAMAGE.
  */
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <limits>
 
 #include <fuse_loss/loss_function.hpp>
@@ -79,6 +81,48 @@ void GemanMcClureLoss::Evaluate(double s, double rho[3]) const
   rho[2] = -2.0 * inv * rho[1];
 }
 
+GNCLoss::GNCLoss(
+  const LossFunction * rho, const double initial_scale,
+  const double annealing_factor, const Ownership ownership)
+: rho_(rho), initial_scale_(initial_scale), annealing_factor_(annealing_factor),
+  ownership_(ownership)
+{
+  if (initial_scale_ > 1.0 && annealing_factor_ > 1.0) {
+    stages_ =
+      static_cast<size_t>(std::ceil(std::log(initial_scale_) / std::log(annealing_factor_)));
+  }
+}
+
+GNCLoss::~GNCLoss()
+{
+  if (ownership_ == TAKE_OWNERSHIP) {
+    delete rho_;
+  }
+}
+
+void GNCLoss::Evaluate(double s, double rho[3]) const
+{
+  if (!rho_) {
+    // The trivial loss is invariant to the scale
+    rho[0] = s;
+    rho[1] = 1.0;
+    rho[2] = 0.0;
+    return;
+  }
+
+  const double mu = scale_;
+  rho_->Evaluate(s / mu, rho);
+  rho[0] *= mu;
+  rho[2] /= mu;
+}
+
+void GNCLoss::stage(const size_t stage)
+{
+  scale_ = stage >= stages_ ?
+    1.0 :
+    std::max(1.0, initial_scale_ / std::pow(annealing_factor_, static_cast<double>(stage)));
+}
+
 void WelschLoss::Evaluate(double s, double rho[3]) const
 {
   const double exp = std::exp(s * c_);
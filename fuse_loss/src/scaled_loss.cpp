@@ -75,6 +75,21 @@ ceres::LossFunction * ScaledLoss::lossFunction() const
   return new ceres::ScaledLoss(loss_ ? loss_->lossFunction() : nullptr, a_, Ownership);
 }
 
+ceres::LossFunction * ScaledLoss::sharedLossFunction() const
+{
+  // The scaled loss can only be shared if the loss it wraps is shared as well
+  ceres::LossFunction * loss_function = nullptr;
+  if (loss_) {
+    loss_function = loss_->sharedLossFunction();
+    if (!loss_function) {
+      return nullptr;
+    }
+  }
+
+  return fuse_core::sharedLossFunctionInstance<ceres::ScaledLoss>(
+    loss_function, a_, SharedOwnership);
+}
+
 }  // namespace fuse_loss
 
 BOOST_CLASS_EXPORT_IMPLEMENT(fuse_loss::ScaledLoss);
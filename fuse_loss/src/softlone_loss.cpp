@@ -69,6 +69,11 @@ ceres::LossFunction * SoftLOneLoss::lossFunction() const
   return new ceres::SoftLOneLoss(a_);
 }
 
+ceres::LossFunction * SoftLOneLoss::sharedLossFunction() const
+{
+  return fuse_core::sharedLossFunctionInstance<ceres::SoftLOneLoss>(a_);
+}
+
 }  // namespace fuse_loss
 
 BOOST_CLASS_EXPORT_IMPLEMENT(fuse_loss::SoftLOneLoss);
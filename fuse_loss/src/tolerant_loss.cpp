@@ -71,6 +71,11 @@ ceres::LossFunction * TolerantLoss::lossFunction() const
   return new ceres::TolerantLoss(a_, b_);
 }
 
+ceres::LossFunction * TolerantLoss::sharedLossFunction() const
+{
+  return fuse_core::sharedLossFunctionInstance<ceres::TolerantLoss>(a_, b_);
+}
+
 }  // namespace fuse_loss
 
 BOOST_CLASS_EXPORT_IMPLEMENT(fuse_loss::TolerantLoss);
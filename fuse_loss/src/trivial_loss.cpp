@@ -51,6 +51,11 @@ ceres::LossFunction * TrivialLoss::lossFunction() const
   return new ceres::TrivialLoss();
 }
 
+ceres::LossFunction * TrivialLoss::sharedLossFunction() const
+{
+  return fuse_core::sharedLossFunctionInstance<ceres::TrivialLoss>();
+}
+
 }  // namespace fuse_loss
 
 BOOST_CLASS_EXPORT_IMPLEMENT(fuse_loss::TrivialLoss);
@@ -91,6 +91,17 @@ ceres::LossFunction * TukeyLoss::lossFunction() const
 #endif
 }
 
+ceres::LossFunction * TukeyLoss::sharedLossFunction() const
+{
+#if CERES_VERSION_AT_LEAST(2, 0, 0)
+  return fuse_core::sharedLossFunctionInstance<ceres::TukeyLoss>(a_);
+#else
+  // See lossFunction() for the scaling workaround
+  return fuse_core::sharedLossFunctionInstance<ceres::ScaledLoss>(
+    fuse_core::sharedLossFunctionInstance<ceres::TukeyLoss>(a_), 2.0, SharedOwnership);
+#endif
+}
+
 }  // namespace fuse_loss
 
 BOOST_CLASS_EXPORT_IMPLEMENT(fuse_loss::TukeyLoss);
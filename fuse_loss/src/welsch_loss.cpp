@@ -70,6 +70,11 @@ ceres::LossFunction * WelschLoss::lossFunction() const
   return new ceres::WelschLoss(a_);
 }
 
+ceres::LossFunction * WelschLoss::sharedLossFunction() const
+{
+  return fuse_core::sharedLossFunctionInstance<ceres::WelschLoss>(a_);
+}
+
 }  // namespace fuse_loss
 
 BOOST_CLASS_EXPORT_IMPLEMENT(fuse_loss::WelschLoss);
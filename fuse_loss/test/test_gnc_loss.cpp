@@ -0,0 +1,226 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2019, Clearpath Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <ceres/autodiff_cost_function.h>
+#include <ceres/problem.h>
+#include <ceres/solver.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+
+#include <fuse_core/serialization.hpp>
+#include <fuse_loss/geman_mcclure_loss.hpp>
+#include <fuse_loss/gnc_loss.hpp>
+
+TEST(GNCLoss, Constructor)
+{
+  // Create a default loss
+  {
+    fuse_loss::GNCLoss loss;
+    ASSERT_EQ(100.0, loss.initialScale());
+    ASSERT_EQ(2.0, loss.annealingFactor());
+    ASSERT_EQ(nullptr, loss.loss());
+  }
+
+  // Create a loss with parameters
+  {
+    const double initial_scale{1000.0};
+    const double annealing_factor{1.4};
+    auto geman_mcclure = std::make_shared<fuse_loss::GemanMcClureLoss>(0.5);
+    fuse_loss::GNCLoss loss(initial_scale, annealing_factor, geman_mcclure);
+    ASSERT_EQ(initial_scale, loss.initialScale());
+    ASSERT_EQ(annealing_factor, loss.annealingFactor());
+    ASSERT_EQ(geman_mcclure, loss.loss());
+  }
+}
+
+TEST(GNCLoss, Schedule)
+{
+  const double a{0.5};
+  auto geman_mcclure = std::make_shared<fuse_loss::GemanMcClureLoss>(a);
+  fuse_loss::GNCLoss loss(100.0, 2.0, geman_mcclure);
+
+  // The control parameter goes 100, 50, ..., 1.5625, 1
+  ASSERT_EQ(7u, loss.gncStages());
+
+  // Every loss function instance holds its own stage
+  const std::unique_ptr<ceres::LossFunction> loss_function(loss.lossFunction());
+  const std::unique_ptr<ceres::LossFunction> other_loss_function(loss.lossFunction());
+  ASSERT_NE(nullptr, loss_function);
+  ASSERT_NE(nullptr, other_loss_function);
+
+  const double s{4.0};
+  double expected_rho[3] = {0.0};
+  double rho[3] = {0.0};
+  double other_rho[3] = {0.0};
+  for (size_t stage = 0; stage <= loss.gncStages(); ++stage) {
+    loss.gncStage(loss_function.get(), stage);
+
+    const double mu = stage < loss.gncStages() ? 100.0 / std::pow(2.0, stage) : 1.0;
+    geman_mcclure->sharedLossFunction()->Evaluate(s / mu, expected_rho);
+    loss_function->Evaluate(s, rho);
+
+    EXPECT_DOUBLE_EQ(mu * expected_rho[0], rho[0]);
+    EXPECT_DOUBLE_EQ(expected_rho[1], rho[1]);
+    EXPECT_DOUBLE_EQ(expected_rho[2] / mu, rho[2]);
+
+    // The other instance stays at the last stage, which is the wrapped loss itself
+    geman_mcclure->sharedLossFunction()->Evaluate(s, expected_rho);
+    other_loss_function->Evaluate(s, other_rho);
+    EXPECT_EQ(expected_rho[0], other_rho[0]);
+    EXPECT_EQ(expected_rho[1], other_rho[1]);
+    EXPECT_EQ(expected_rho[2], other_rho[2]);
+  }
+
+  // The stage is not shared, so there is no shared instance
+  EXPECT_EQ(nullptr, loss.sharedLossFunction());
+
+  // A scale that is already 1 has no stages
+  EXPECT_EQ(0u, fuse_loss::GNCLoss(1.0, 2.0, geman_mcclure).gncStages());
+}
+
+struct CostFunctor
+{
+  explicit CostFunctor(const double data)
+  : data(data)
+  {}
+
+  template<typename T> bool operator()(const T * const x, T * residual) const
+  {
+    residual[0] = x[0] - T(data);
+    return true;
+  }
+
+  double data{0.0};
+};
+
+TEST(GNCLoss, Optimization)
+{
+  // Start the parameter at a cluster of outliers, which is a local minimum of the robust loss
+  const double inlier{1.0};
+  const double outlier{10.0};
+  double x{outlier};
+
+  // Create loss
+  fuse_loss::GNCLoss loss(100.0, 2.0, std::make_shared<fuse_loss::GemanMcClureLoss>(1.0));
+
+  // Build the problem. All the residuals use one loss function, so they share its stage.
+  const std::unique_ptr<ceres::LossFunction> loss_function(loss.lossFunction());
+
+  ceres::Problem::Options problem_options;
+  problem_options.loss_function_ownership = ceres::DO_NOT_TAKE_OWNERSHIP;
+
+  ceres::Problem problem(problem_options);
+
+  const size_t num_inliers{20};
+  for (size_t i = 0; i < num_inliers; ++i) {
+    problem.AddResidualBlock(
+      new ceres::AutoDiffCostFunction<CostFunctor, 1, 1>(new CostFunctor(inlier)),
+      loss_function.get(),
+      &x);
+  }
+
+  const size_t num_outliers{8};
+  for (size_t i = 0; i < num_outliers; ++i) {
+    problem.AddResidualBlock(
+      new ceres::AutoDiffCostFunction<CostFunctor, 1, 1>(new CostFunctor(outlier)),
+      loss_function.get(),
+      &x);
+  }
+
+  // Run the solver with the robust loss only
+  ceres::Solver::Options options;
+  ceres::Solver::Summary summary;
+  ceres::Solve(options, &problem, &summary);
+
+  // Check it stays at the outliers
+  EXPECT_NEAR(outlier, x, 1.0e-1);
+
+  // Run the solver once per stage, warm-starting each one from the previous solution
+  x = outlier;
+  for (size_t stage = 0; stage <= loss.gncStages(); ++stage) {
+    loss.gncStage(loss_function.get(), stage);
+    ceres::Solve(options, &problem, &summary);
+  }
+
+  // Check it converges to the inliers
+  EXPECT_NEAR(inlier, x, 1.0e-3);
+}
+
+TEST(GNCLoss, Serialization)
+{
+  // Construct a loss
+  const double initial_scale{1000.0};
+  const double annealing_factor{1.4};
+  const double a{0.5};
+  fuse_loss::GNCLoss expected(
+    initial_scale, annealing_factor,
+    std::make_shared<fuse_loss::GemanMcClureLoss>(a));
+
+  // Serialize the loss into an archive
+  std::stringstream stream;
+  {
+    fuse_core::TextOutputArchive archive(stream);
+    expected.serialize(archive);
+  }
+
+  // Deserialize a new loss from that same stream
+  fuse_loss::GNCLoss actual;
+  {
+    fuse_core::TextInputArchive archive(stream);
+    actual.deserialize(archive);
+  }
+
+  // Compare
+  EXPECT_EQ(expected.initialScale(), actual.initialScale());
+  EXPECT_EQ(expected.annealingFactor(), actual.annealingFactor());
+  ASSERT_NE(nullptr, actual.loss());
+  EXPECT_EQ(expected.loss()->type(), actual.loss()->type());
+  EXPECT_EQ(expected.gncStages(), actual.gncStages());
+
+  // The deserialized loss computes the same loss as the original one
+  const std::unique_ptr<ceres::LossFunction> expected_loss_function(expected.lossFunction());
+  const std::unique_ptr<ceres::LossFunction> actual_loss_function(actual.lossFunction());
+  expected.gncStage(expected_loss_function.get(), 0);
+  actual.gncStage(actual_loss_function.get(), 0);
+
+  const double s{4.0};
+  double expected_rho[3] = {0.0};
+  double actual_rho[3] = {0.0};
+  expected_loss_function->Evaluate(s, expected_rho);
+  actual_loss_function->Evaluate(s, actual_rho);
+  EXPECT_EQ(expected_rho[0], actual_rho[0]);
+  EXPECT_EQ(expected_rho[1], actual_rho[1]);
+  EXPECT_EQ(expected_rho[2], actual_rho[2]);
+}
@@ -36,6 +36,8 @@
 #include <ceres/solver.h>
 #include <gtest/gtest.h>
 
+#include <memory>
+
 #include <fuse_core/serialization.hpp>
 #include <fuse_loss/huber_loss.hpp>
 
@@ -132,6 +134,35 @@ TEST(HuberLoss, Optimization)
   EXPECT_LT(cost, raw_cost);
 }
 
+TEST(HuberLoss, SharedLossFunction)
+{
+  const double a{0.3};
+  fuse_loss::HuberLoss loss(a);
+
+  // Losses with the same parameters share one instance, which is not owned by the caller
+  const auto shared_loss_function = loss.sharedLossFunction();
+  ASSERT_NE(nullptr, shared_loss_function);
+  EXPECT_EQ(shared_loss_function, fuse_loss::HuberLoss(a).sharedLossFunction());
+  EXPECT_NE(shared_loss_function, fuse_loss::HuberLoss(2.0 * a).sharedLossFunction());
+
+  // The shared instance computes the same loss as the owned one
+  const std::unique_ptr<ceres::LossFunction> loss_function(loss.lossFunction());
+  ASSERT_NE(nullptr, loss_function);
+  EXPECT_NE(shared_loss_function, loss_function.get());
+
+  for (const double s : {0.5 * a * a, 2.0 * a * a}) {
+    double expected_rho[3] = {0.0};
+    loss_function->Evaluate(s, expected_rho);
+
+    double rho[3] = {0.0};
+    shared_loss_function->Evaluate(s, rho);
+
+    EXPECT_EQ(expected_rho[0], rho[0]);
+    EXPECT_EQ(expected_rho[1], rho[1]);
+    EXPECT_EQ(expected_rho[2], rho[2]);
+  }
+}
+
 TEST(HuberLoss, Serialization)
 {
   // Construct a loss
@@ -153,6 +153,40 @@ TEST(ScaledLoss, Optimization)
   EXPECT_LT(cost, raw_cost);
 }
 
+TEST(ScaledLoss, SharedLossFunction)
+{
+  const double a{0.7};
+  const double loss_a{0.3};
+
+  // Scaled losses with the same parameters and shared inner loss share one instance
+  fuse_loss::ScaledLoss scaled_loss(a, std::make_shared<fuse_loss::HuberLoss>(loss_a));
+  const auto shared_loss_function = scaled_loss.sharedLossFunction();
+  ASSERT_NE(nullptr, shared_loss_function);
+  EXPECT_EQ(
+    shared_loss_function,
+    fuse_loss::ScaledLoss(a, std::make_shared<fuse_loss::HuberLoss>(loss_a)).sharedLossFunction());
+  EXPECT_NE(
+    shared_loss_function,
+    fuse_loss::ScaledLoss(a, std::make_shared<fuse_loss::HuberLoss>(2.0 * loss_a))
+    .sharedLossFunction());
+
+  // The shared instance computes the same loss as the owned one
+  const std::unique_ptr<ceres::LossFunction> loss_function(scaled_loss.lossFunction());
+  ASSERT_NE(nullptr, loss_function);
+
+  for (const double s : {0.5 * loss_a * loss_a, 2.0 * loss_a * loss_a}) {
+    double expected_rho[3] = {0.0};
+    loss_function->Evaluate(s, expected_rho);
+
+    double rho[3] = {0.0};
+    shared_loss_function->Evaluate(s, rho);
+
+    EXPECT_EQ(expected_rho[0], rho[0]);
+    EXPECT_EQ(expected_rho[1], rho[1]);
+    EXPECT_EQ(expected_rho[2], rho[2]);
+  }
+}
+
 TEST(ScaledLoss, Serialization)
 {
   // Construct a loss
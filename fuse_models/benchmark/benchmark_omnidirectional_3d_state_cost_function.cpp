@@ -0,0 +1,146 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2018, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <benchmark/benchmark.h>
+#include <ceres/autodiff_cost_function.h>
+#include <Eigen/Dense>
+
+#include <vector>
+
+#include <fuse_core/eigen.hpp>
+#include <fuse_core/util.hpp>
+#include <fuse_models/omnidirectional_3d_predict.hpp>
+#include <fuse_models/omnidirectional_3d_state_cost_function.hpp>
+#include <fuse_models/omnidirectional_3d_state_cost_functor.hpp>
+
+class Omnidirectional3DStateCostFunction : public benchmark::Fixture
+{
+public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  using Matrix15d = fuse_core::Matrix<double, 15, 15>;
+  using Vector15d = Eigen::Matrix<double, 15, 1>;
+
+  Omnidirectional3DStateCostFunction()
+  : jacobians(num_parameter_blocks),
+    J(num_parameter_blocks)
+  {
+    const double process_noise_diagonal[] =
+    {1e-3, 1e-3, 1e-3, 1e-2, 1e-2, 1e-2, 1e-6, 1e-6, 1e-6, 1e-4, 1e-4, 1e-4, 1e-9, 1e-9, 1e-9};
+    const Matrix15d covariance = Vector15d(process_noise_diagonal).asDiagonal();
+    sqrt_information = covariance.inverse().llt().matrixU();
+
+    const double angle_axis[] = {0.1, -0.2, 0.7};
+    fuse_core::angleAxisToQuaternion(angle_axis, orientation1);
+
+    // Evaluate the cost function on the predicted state, like the motion model initializes it
+    fuse_models::predictOmnidirectional3D(
+      position1, orientation1, vel_linear1, vel_angular1, acc_linear1, dt, position2, orientation2,
+      vel_linear2, vel_angular2, acc_linear2);
+
+    for (size_t i = 0; i < num_parameter_blocks; ++i) {
+      J[i].resize(num_residuals, block_sizes[i]);
+      jacobians[i] = J[i].data();
+    }
+  }
+
+  static constexpr double dt{0.1};
+  static constexpr size_t num_parameter_blocks{10};
+  static constexpr size_t num_residuals{15};
+  static constexpr int block_sizes[] = {3, 4, 3, 3, 3, 3, 4, 3, 3, 3};
+
+  Matrix15d sqrt_information;
+
+  // Parameter blocks
+  double position1[3] = {1.0, 2.0, -0.5};
+  double orientation1[4];
+  double vel_linear1[3] = {1.0, 0.3, -0.1};
+  double vel_angular1[3] = {0.2, -0.1, 1.570796327};
+  double acc_linear1[3] = {1.0, -0.5, 0.2};
+
+  double position2[3];
+  double orientation2[4];
+  double vel_linear2[3];
+  double vel_angular2[3];
+  double acc_linear2[3];
+
+  const double * parameters[10] =
+  {
+    position1, orientation1, vel_linear1, vel_angular1, acc_linear1,
+    position2, orientation2, vel_linear2, vel_angular2, acc_linear2
+  };
+
+  // Residuals
+  Vector15d residuals;
+
+  // Jacobians
+  std::vector<double *> jacobians;
+
+private:
+  // Jacobian matrices
+  std::vector<fuse_core::MatrixXd> J;
+};
+
+BENCHMARK_F(
+  Omnidirectional3DStateCostFunction,
+  AnalyticOmnidirectional3DStateCostFunction)(benchmark::State & state)
+{
+  const fuse_models::Omnidirectional3DStateCostFunction cost_function{dt, sqrt_information};
+
+  for (auto _ : state) {
+    cost_function.Evaluate(parameters, residuals.data(), jacobians.data());
+  }
+  // Each iteration evaluates the full Jacobian of one residual block on a single core
+  state.counters["jacobians_per_second_per_core"] =
+    benchmark::Counter(state.iterations(), benchmark::Counter::kIsRate);
+}
+
+BENCHMARK_F(
+  Omnidirectional3DStateCostFunction,
+  AutoDiffOmnidirectional3DStateCostFunction)(benchmark::State & state)
+{
+  // Create cost function using automatic differentiation on the cost functor
+  ceres::AutoDiffCostFunction<
+    fuse_models::Omnidirectional3DStateCostFunctor, 15, 3, 4, 3, 3, 3, 3, 4, 3, 3, 3
+  >
+  cost_function_autodiff(
+    new fuse_models::Omnidirectional3DStateCostFunctor(dt, sqrt_information));
+
+  for (auto _ : state) {
+    cost_function_autodiff.Evaluate(parameters, residuals.data(), jacobians.data());
+  }
+  state.counters["jacobians_per_second_per_core"] =
+    benchmark::Counter(state.iterations(), benchmark::Counter::kIsRate);
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,176 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2019, Clearpath Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <benchmark/benchmark.h>
+#include <tf2_ros/buffer.h>
+
+#include <memory>
+#include <vector>
+
+#include <fuse_core/eigen.hpp>
+#include <fuse_core/transaction.hpp>
+#include <fuse_core/uuid.hpp>
+#include <fuse_models/common/sensor_proc.hpp>
+#include <geometry_msgs/msg/accel_with_covariance_stamped.hpp>
+#include <geometry_msgs/msg/pose_with_covariance_stamped.hpp>
+#include <geometry_msgs/msg/twist_with_covariance_stamped.hpp>
+#include <rclcpp/clock.hpp>
+
+namespace fm_common = fuse_models::common;
+
+// The full pose measurement and the configured dimensions: x position and yaw
+static const fuse_core::Vector3d pose_mean{1.0, 2.0, 0.3};
+static const fuse_core::Matrix3d pose_covariance = (fuse_core::Matrix3d() <<
+  0.1, 0.01, 0.001, 0.01, 0.2, 0.002, 0.001, 0.002, 0.3).finished();
+static const std::vector<size_t> position_indices{0};
+static const std::vector<size_t> orientation_indices{0};
+
+static void DynamicPartialMeasurement(benchmark::State & state)
+{
+  // Previous per-message path: merged index list and dynamically sized partial measurement
+  for (auto _ : state) {
+    fuse_core::VectorXd mean_partial(position_indices.size() + orientation_indices.size());
+    fuse_core::MatrixXd covariance_partial(mean_partial.rows(), mean_partial.rows());
+
+    const auto indices = fm_common::mergeIndices(position_indices, orientation_indices, 2);
+    fm_common::populatePartialMeasurement(
+      pose_mean, pose_covariance, indices, mean_partial,
+      covariance_partial);
+    fm_common::validatePartialMeasurement(mean_partial, covariance_partial);
+
+    benchmark::DoNotOptimize(mean_partial.data());
+    benchmark::DoNotOptimize(covariance_partial.data());
+  }
+}
+
+BENCHMARK(DynamicPartialMeasurement);
+
+static void FixedCapacityPartialMeasurement(benchmark::State & state)
+{
+  // Current per-message path: no index list and a partial measurement with fixed storage
+  for (auto _ : state) {
+    fm_common::PartialVector<3> mean_partial(
+      position_indices.size() + orientation_indices.size());
+    fm_common::PartialMatrix<3> covariance_partial(mean_partial.rows(), mean_partial.rows());
+
+    fm_common::populatePartialMeasurement(
+      pose_mean, pose_covariance, position_indices, orientation_indices, 2, mean_partial,
+      covariance_partial);
+    fm_common::validatePartialMeasurement(mean_partial, covariance_partial);
+
+    benchmark::DoNotOptimize(mean_partial.data());
+    benchmark::DoNotOptimize(covariance_partial.data());
+  }
+}
+
+BENCHMARK(FixedCapacityPartialMeasurement);
+
+/**
+ * @brief Benchmark fixture to process whole sensor messages into a transaction, as the sensor
+ *        models do for every message received. No target frame is used, so there is no transform
+ *        lookup.
+ */
+class SensorProc : public benchmark::Fixture
+{
+public:
+  SensorProc()
+  : device_id(fuse_core::uuid::generate("robot")),
+    tf_buffer(std::make_shared<rclcpp::Clock>())
+  {
+    pose.header.stamp.sec = 1;
+    pose.header.frame_id = "odom";
+    pose.pose.pose.position.x = 1.0;
+    pose.pose.pose.position.y = 2.0;
+    pose.pose.pose.orientation.w = 1.0;
+    pose.pose.covariance[0] = 0.1;
+    pose.pose.covariance[7] = 0.2;
+    pose.pose.covariance[35] = 0.3;
+
+    twist.header = pose.header;
+    twist.twist.twist.linear.x = 1.0;
+    twist.twist.twist.angular.z = 0.1;
+    twist.twist.covariance[0] = 0.1;
+    twist.twist.covariance[7] = 0.2;
+    twist.twist.covariance[35] = 0.3;
+
+    accel.header = pose.header;
+    accel.accel.accel.linear.x = 0.5;
+    accel.accel.covariance[0] = 0.1;
+    accel.accel.covariance[7] = 0.2;
+  }
+
+  fuse_core::UUID device_id;
+  tf2_ros::Buffer tf_buffer;
+  const std::vector<size_t> xy_indices{0, 1};
+  const std::vector<size_t> yaw_indices{0};
+  geometry_msgs::msg::PoseWithCovarianceStamped pose;
+  geometry_msgs::msg::TwistWithCovarianceStamped twist;
+  geometry_msgs::msg::AccelWithCovarianceStamped accel;
+};
+
+BENCHMARK_F(SensorProc, ProcessAbsolutePoseWithCovariance)(benchmark::State & state)
+{
+  for (auto _ : state) {
+    fuse_core::Transaction transaction;
+    fm_common::processAbsolutePoseWithCovariance(
+      "benchmark", device_id, pose, nullptr, "", xy_indices, yaw_indices, tf_buffer, true,
+      transaction);
+    benchmark::DoNotOptimize(transaction);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_F(SensorProc, ProcessTwistWithCovariance)(benchmark::State & state)
+{
+  for (auto _ : state) {
+    fuse_core::Transaction transaction;
+    fm_common::processTwistWithCovariance(
+      "benchmark", device_id, twist, nullptr, nullptr, "", xy_indices, yaw_indices, tf_buffer,
+      true, transaction);
+    benchmark::DoNotOptimize(transaction);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_F(SensorProc, ProcessAccelWithCovariance)(benchmark::State & state)
+{
+  for (auto _ : state) {
+    fuse_core::Transaction transaction;
+    fm_common::processAccelWithCovariance(
+      "benchmark", device_id, accel, nullptr, "", xy_indices, tf_buffer, true, transaction);
+    benchmark::DoNotOptimize(transaction);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_MAIN();
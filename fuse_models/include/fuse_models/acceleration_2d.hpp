@@ -40,6 +40,7 @@
 #include <memory>
 #include <string>
 
+#include <fuse_models/common/static_transform_cache.hpp>
 #include <fuse_models/parameters/acceleration_2d_params.hpp>
 
 #include <fuse_core/async_sensor_model.hpp>
@@ -142,11 +143,13 @@ protected:
   // NOTE(CH3): Unique ptr to defer till we have the node interfaces from initialize()
   std::unique_ptr<tf2_ros::Buffer> tf_buffer_;
   std::unique_ptr<tf2_ros::TransformListener> tf_listener_;
+  std::unique_ptr<common::StaticTransformCache> static_transform_cache_;
+  std::unique_ptr<common::StaticTransformCache::FramePair> static_transform_;
 
   rclcpp::Subscription<geometry_msgs::msg::AccelWithCovarianceStamped>::SharedPtr sub_;
 
   using AccelerationThrottledCallback =
-    fuse_core::ThrottledMessageCallback<geometry_msgs::msg::AccelWithCovarianceStamped>;
+    fuse_core::AggregatingThrottledMessageCallback<geometry_msgs::msg::AccelWithCovarianceStamped>;
   AccelerationThrottledCallback throttled_callback_;
 };
 
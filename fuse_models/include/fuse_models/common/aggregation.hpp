@@ -0,0 +1,285 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2018, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef FUSE_MODELS__COMMON__AGGREGATION_HPP_
+#define FUSE_MODELS__COMMON__AGGREGATION_HPP_
+
+#include <Eigen/Dense>
+
+#include <array>
+#include <cstddef>
+
+#include <fuse_core/eigen.hpp>
+
+#include <geometry_msgs/msg/accel_with_covariance_stamped.hpp>
+#include <geometry_msgs/msg/twist_with_covariance_stamped.hpp>
+#include <geometry_msgs/msg/vector3.hpp>
+#include <nav_msgs/msg/odometry.hpp>
+#include <sensor_msgs/msg/imu.hpp>
+
+
+namespace fuse_models
+{
+
+namespace common
+{
+
+/**
+ * @brief Combine a measurement into another one, weighting them by their information
+ *
+ * This treats both measurements as observations of the same quantity, which only holds for rates
+ * that are roughly constant over a throttle period: twists, accelerations, and the IMU angular
+ * velocity and linear acceleration. Poses and orientations change between two stamps, so averaging
+ * them would fuse a value that the robot never had. The aggregate() overloads below therefore only
+ * combine the rate parts of a message and pass the newest pose or orientation through, and there is
+ * no overload for pose-only messages.
+ *
+ * The combined measurement has the information of both measurements, and its mean is the
+ * information-weighted mean of both means. A dimension with a non-positive variance carries no
+ * information, as per the ROS message conventions for unknown or unused dimensions. The dimensions
+ * without information in either measurement take the mean and variance of the newer measurement.
+ *
+ * @param[in,out] mean - The mean of the older measurement, replaced by the combined mean
+ * @param[in,out] covariance - The row-major covariance of the older measurement, replaced by the
+ *                             combined covariance
+ * @param[in] other_mean - The mean of the newer measurement
+ * @param[in] other_covariance - The row-major covariance of the newer measurement
+ */
+template<int N>
+inline void aggregateInformationWeighted(
+  Eigen::Matrix<double, N, 1> & mean,
+  std::array<double, N * N> & covariance,
+  const Eigen::Matrix<double, N, 1> & other_mean,
+  const std::array<double, N * N> & other_covariance)
+{
+  using Matrix = fuse_core::Matrix<double, N, N>;
+  using Mask = Eigen::Array<bool, N, 1>;
+
+  // Invert a covariance restricted to the dimensions in the mask, with the rest set to zero. The
+  // common case of a positive definite covariance only needs a Cholesky decomposition.
+  const auto invert = [](Matrix matrix, const Mask & mask)
+    {
+      for (int i = 0; i < N; ++i) {
+        if (!mask[i]) {
+          matrix.row(i).setZero();
+          matrix.col(i).setZero();
+          matrix(i, i) = 1.0;
+        }
+      }
+
+      Matrix inverse;
+      Eigen::LLT<Matrix> llt(matrix);
+      if (llt.info() == Eigen::Success) {
+        inverse = llt.solve(Matrix::Identity());
+      } else {
+        inverse = matrix.completeOrthogonalDecomposition().pseudoInverse();
+      }
+
+      for (int i = 0; i < N; ++i) {
+        if (!mask[i]) {
+          inverse.row(i).setZero();
+          inverse.col(i).setZero();
+        }
+      }
+      return inverse;
+    };
+
+  Eigen::Map<Matrix> covariance_map(covariance.data());
+  const Eigen::Map<const Matrix> other_covariance_map(other_covariance.data());
+
+  const Mask mask = covariance_map.diagonal().array() > 0.0;
+  const Mask other_mask = other_covariance_map.diagonal().array() > 0.0;
+  const Mask combined_mask = mask || other_mask;
+
+  const Matrix information = invert(covariance_map, mask);
+  const Matrix other_information = invert(other_covariance_map, other_mask);
+
+  const Matrix combined_covariance = invert(information + other_information, combined_mask);
+  const Eigen::Matrix<double, N, 1> combined_mean =
+    combined_covariance * (information * mean + other_information * other_mean);
+
+  for (int i = 0; i < N; ++i) {
+    if (combined_mask[i]) {
+      mean[i] = combined_mean[i];
+    } else {
+      mean[i] = other_mean[i];
+    }
+
+    for (int j = 0; j < N; ++j) {
+      covariance_map(i, j) = combined_mask[i] && combined_mask[j] ? combined_covariance(i, j) :
+        other_covariance_map(i, j);
+    }
+  }
+}
+
+/**
+ * @brief Convert a vector message to an Eigen vector
+ */
+inline fuse_core::Vector3d toEigen(const geometry_msgs::msg::Vector3 & vector)
+{
+  return {vector.x, vector.y, vector.z};
+}
+
+/**
+ * @brief Convert an Eigen vector to a vector message
+ */
+inline geometry_msgs::msg::Vector3 toVector3Msg(const fuse_core::Vector3d & vector)
+{
+  geometry_msgs::msg::Vector3 message;
+  message.x = vector.x();
+  message.y = vector.y();
+  message.z = vector.z();
+  return message;
+}
+
+/**
+ * @brief Combine a 3D vector measurement into another one
+ *
+ * @param[in,out] vector - The older vector, replaced by the combined one
+ * @param[in,out] covariance - The older vector covariance, replaced by the combined one
+ * @param[in] other_vector - The newer vector
+ * @param[in] other_covariance - The newer vector covariance
+ */
+inline void aggregateVector3(
+  geometry_msgs::msg::Vector3 & vector,
+  std::array<double, 9> & covariance,
+  const geometry_msgs::msg::Vector3 & other_vector,
+  const std::array<double, 9> & other_covariance)
+{
+  fuse_core::Vector3d mean = toEigen(vector);
+  aggregateInformationWeighted<3>(mean, covariance, toEigen(other_vector), other_covariance);
+  vector = toVector3Msg(mean);
+}
+
+/**
+ * @brief Combine a twist measurement into another one
+ *
+ * @param[in,out] twist - The older twist, replaced by the combined one
+ * @param[in] other - The newer twist
+ */
+inline void aggregate(
+  geometry_msgs::msg::TwistWithCovariance & twist,
+  const geometry_msgs::msg::TwistWithCovariance & other)
+{
+  fuse_core::Vector6d mean;
+  mean << toEigen(twist.twist.linear), toEigen(twist.twist.angular);
+  fuse_core::Vector6d other_mean;
+  other_mean << toEigen(other.twist.linear), toEigen(other.twist.angular);
+
+  aggregateInformationWeighted<6>(mean, twist.covariance, other_mean, other.covariance);
+
+  twist.twist.linear = toVector3Msg(mean.head<3>());
+  twist.twist.angular = toVector3Msg(mean.tail<3>());
+}
+
+/**
+ * @brief Combine a twist measurement into another one. The result has the newer header.
+ *
+ * @param[in,out] twist - The older twist, replaced by the combined one
+ * @param[in] other - The newer twist
+ */
+inline void aggregate(
+  geometry_msgs::msg::TwistWithCovarianceStamped & twist,
+  const geometry_msgs::msg::TwistWithCovarianceStamped & other)
+{
+  aggregate(twist.twist, other.twist);
+  twist.header = other.header;
+}
+
+/**
+ * @brief Combine an acceleration measurement into another one. The result has the newer header.
+ *
+ * @param[in,out] accel - The older acceleration, replaced by the combined one
+ * @param[in] other - The newer acceleration
+ */
+inline void aggregate(
+  geometry_msgs::msg::AccelWithCovarianceStamped & accel,
+  const geometry_msgs::msg::AccelWithCovarianceStamped & other)
+{
+  fuse_core::Vector6d mean;
+  mean << toEigen(accel.accel.accel.linear), toEigen(accel.accel.accel.angular);
+  fuse_core::Vector6d other_mean;
+  other_mean << toEigen(other.accel.accel.linear), toEigen(other.accel.accel.angular);
+
+  aggregateInformationWeighted<6>(mean, accel.accel.covariance, other_mean, other.accel.covariance);
+
+  accel.accel.accel.linear = toVector3Msg(mean.head<3>());
+  accel.accel.accel.angular = toVector3Msg(mean.tail<3>());
+  accel.header = other.header;
+}
+
+/**
+ * @brief Combine an odometry measurement into another one. The result has the newer header.
+ *
+ * Only the twist is combined. The result has the newer pose, since poses taken at different times
+ * are not measurements of the same quantity.
+ *
+ * @param[in,out] odometry - The older odometry, replaced by the combined one
+ * @param[in] other - The newer odometry
+ */
+inline void aggregate(nav_msgs::msg::Odometry & odometry, const nav_msgs::msg::Odometry & other)
+{
+  aggregate(odometry.twist, other.twist);
+  odometry.pose = other.pose;
+  odometry.header = other.header;
+  odometry.child_frame_id = other.child_frame_id;
+}
+
+/**
+ * @brief Combine an IMU measurement into another one. The result has the newer header.
+ *
+ * The angular velocity and linear acceleration are combined independently, since the message has
+ * no cross-covariance between them. The result has the newer orientation, since orientations taken
+ * at different times are not measurements of the same quantity.
+ *
+ * @param[in,out] imu - The older IMU measurement, replaced by the combined one
+ * @param[in] other - The newer IMU measurement
+ */
+inline void aggregate(sensor_msgs::msg::Imu & imu, const sensor_msgs::msg::Imu & other)
+{
+  imu.orientation = other.orientation;
+  imu.orientation_covariance = other.orientation_covariance;
+  aggregateVector3(
+    imu.angular_velocity, imu.angular_velocity_covariance, other.angular_velocity,
+    other.angular_velocity_covariance);
+  aggregateVector3(
+    imu.linear_acceleration, imu.linear_acceleration_covariance, other.linear_acceleration,
+    other.linear_acceleration_covariance);
+  imu.header = other.header;
+}
+
+}  // namespace common
+
+}  // namespace fuse_models
+
+#endif  // FUSE_MODELS__COMMON__AGGREGATION_HPP_
@@ -0,0 +1,457 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2018, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef FUSE_MODELS__COMMON__MAHALANOBIS_GATE_HPP_
+#define FUSE_MODELS__COMMON__MAHALANOBIS_GATE_HPP_
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <exception>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <fuse_core/eigen.hpp>
+#include <fuse_core/graph.hpp>
+#include <fuse_core/util.hpp>
+#include <fuse_core/uuid.hpp>
+#include <fuse_variables/acceleration_linear_2d_stamped.hpp>
+#include <fuse_variables/orientation_2d_stamped.hpp>
+#include <fuse_variables/position_2d_stamped.hpp>
+#include <fuse_variables/velocity_angular_2d_stamped.hpp>
+#include <fuse_variables/velocity_linear_2d_stamped.hpp>
+#include <rclcpp/time.hpp>
+
+
+namespace fuse_models
+{
+
+namespace common
+{
+
+/**
+ * @brief A chi-square test of new 2D pose and twist measurements against the latest graph estimate
+ *
+ * Gross outliers added to the graph are only down-weighted by the robust losses, and cost extra
+ * residual blocks and solver iterations until they are marginalized. This class keeps the latest
+ * graph received by a sensor model, so measurements can be tested before they are added to a
+ * transaction. A measurement is rejected if the squared Mahalanobis distance between it and the
+ * estimate of the device in the graph is larger than the threshold, using the sum of the
+ * measurement and the estimate marginal covariances.
+ *
+ * The estimate is the one at the stamp of the newest accepted measurement still in the graph, so
+ * its variables are found by UUID. It is predicted to the measurement stamp with the rates of
+ * change at the same stamp, when the graph has them, as the Unicycle2D motion model does: a pose
+ * moves with a constant twist and a twist changes with a constant linear acceleration. Its
+ * marginal covariance is inflated by a process noise rate times the time elapsed until the
+ * measurement stamp, to account for the prediction error. Only the covariance blocks of the tested
+ * dimensions are computed, and only the first time they are needed after each graph update, since
+ * computing the covariance is expensive. Measurements are accepted while there is no estimate, or
+ * if its covariance cannot be computed. After too many consecutive rejections the next measurement
+ * is accepted anyway, so a gate that lost track of the device cannot reject it forever.
+ *
+ * This class is not thread-safe. It is meant to be updated and used from the callback queue of a
+ * single sensor model.
+ */
+class MahalanobisGate
+{
+public:
+  /**
+   * @brief Constructor
+   *
+   * @param[in] threshold - The maximum squared Mahalanobis distance of an accepted measurement,
+   *                        i.e. the chi-square quantile for the chosen confidence
+   * @param[in] device_id - The UUID of the device whose estimates the measurements are tested
+   *                        against
+   * @param[in] pose_noise_rate - The covariance added to the pose estimate per second elapsed
+   *                              until the measurement stamp
+   * @param[in] twist_noise_rate - The covariance added to the twist estimate per second elapsed
+   *                               until the measurement stamp
+   * @param[in] max_rejections - The number of consecutive rejections after which the next
+   *                             measurement is accepted anyway, or zero to never force it
+   */
+  MahalanobisGate(
+    const double threshold,
+    const fuse_core::UUID & device_id,
+    const fuse_core::Matrix3d & pose_noise_rate = fuse_core::Matrix3d::Zero(),
+    const fuse_core::Matrix3d & twist_noise_rate = fuse_core::Matrix3d::Zero(),
+    const int max_rejections = 0)
+  : threshold_(threshold),
+    device_id_(device_id),
+    max_rejections_(max_rejections)
+  {
+    pose_.noise_rate = pose_noise_rate;
+    twist_.noise_rate = twist_noise_rate;
+  }
+
+  /**
+   * @brief The maximum squared Mahalanobis distance of an accepted measurement
+   */
+  double threshold() const {return threshold_;}
+
+  /**
+   * @brief Use a new graph for the following tests, discarding the estimates of the previous one
+   *
+   * @param[in] graph - The latest graph, as received by the sensor model onGraphUpdate() method
+   */
+  void update(fuse_core::Graph::ConstSharedPtr graph)
+  {
+    graph_ = std::move(graph);
+    pose_.estimate = Estimate();
+    twist_.estimate = Estimate();
+  }
+
+  /**
+   * @brief Test a 2D pose measurement against the pose estimate in the graph
+   *
+   * @param[in] stamp - The measurement stamp
+   * @param[in] mean - The measured pose, as x, y and yaw
+   * @param[in] covariance - The full 3x3 covariance of the measured pose
+   * @param[in] position_indices - The indices of the measured position dimensions to test
+   * @param[in] orientation_indices - The indices of the measured orientation dimensions to test
+   * @param[out] squared_distance - The squared Mahalanobis distance, or zero without an estimate
+   * @return false if the measurement is rejected, true otherwise. A measurement accepted after too
+   *         many consecutive rejections has a squared distance greater than the threshold.
+   */
+  bool acceptPose(
+    const rclcpp::Time & stamp,
+    const fuse_core::Vector3d & mean,
+    const fuse_core::Matrix3d & covariance,
+    const std::vector<size_t> & position_indices,
+    const std::vector<size_t> & orientation_indices,
+    double & squared_distance)
+  {
+    return accept<fuse_variables::Position2DStamped, fuse_variables::Orientation2DStamped>(
+      pose_, stamp, mean, covariance, position_indices, orientation_indices, true,
+      squared_distance);
+  }
+
+  /**
+   * @brief Test a 2D twist measurement against the twist estimate in the graph
+   *
+   * @param[in] stamp - The measurement stamp
+   * @param[in] mean - The measured twist, as linear x, linear y and angular velocity
+   * @param[in] covariance - The full 3x3 covariance of the measured twist
+   * @param[in] linear_indices - The indices of the measured linear velocity dimensions to test
+   * @param[in] angular_indices - The indices of the measured angular velocity dimensions to test
+   * @param[out] squared_distance - The squared Mahalanobis distance, or zero without an estimate
+   * @return false if the measurement is rejected, true otherwise. A measurement accepted after too
+   *         many consecutive rejections has a squared distance greater than the threshold.
+   */
+  bool acceptTwist(
+    const rclcpp::Time & stamp,
+    const fuse_core::Vector3d & mean,
+    const fuse_core::Matrix3d & covariance,
+    const std::vector<size_t> & linear_indices,
+    const std::vector<size_t> & angular_indices,
+    double & squared_distance)
+  {
+    return accept<fuse_variables::VelocityLinear2DStamped,
+             fuse_variables::VelocityAngular2DStamped>(
+      twist_, stamp, mean, covariance, linear_indices, angular_indices, false, squared_distance);
+  }
+
+private:
+  /**
+   * @brief The maximum number of accepted measurement stamps kept to find the estimate
+   */
+  static constexpr size_t max_stamps_ = 16;
+
+  /**
+   * @brief The estimate of a 2D linear and angular variable pair, computed lazily
+   */
+  struct Estimate
+  {
+    bool computed {false};  //!< Whether the estimate was already looked up in the current graph
+    bool valid {false};  //!< Whether the current graph has an estimate with a covariance
+    bool linear {false};  //!< Whether the linear covariance block was requested
+    bool angular {false};  //!< Whether the angular covariance block was requested
+    rclcpp::Time stamp;
+    fuse_core::Vector3d mean;
+    fuse_core::Vector3d rate;  //!< The rate of change of the mean, or zero if not in the graph
+    fuse_core::Matrix3d covariance;
+  };
+
+  /**
+   * @brief The state of the test of one kind of measurement
+   */
+  struct Channel
+  {
+    Estimate estimate;  //!< The estimate in the latest graph
+    std::deque<rclcpp::Time> stamps;  //!< The stamps of the newest accepted measurements, sorted
+    fuse_core::Matrix3d noise_rate;  //!< The covariance added to the estimate per second
+    int rejections {0};  //!< The number of consecutive rejected measurements
+    std::vector<size_t> indices;  //!< The tested dimensions, kept to reuse its memory
+  };
+
+  /**
+   * @brief Test a measurement of a 2D linear and angular variable pair
+   */
+  template<typename LinearVariable, typename AngularVariable>
+  bool accept(
+    Channel & channel,
+    const rclcpp::Time & stamp,
+    const fuse_core::Vector3d & mean,
+    const fuse_core::Matrix3d & covariance,
+    const std::vector<size_t> & linear_indices,
+    const std::vector<size_t> & angular_indices,
+    const bool wrap_angle,
+    double & squared_distance)
+  {
+    squared_distance = 0.0;
+    if (getEstimate<LinearVariable, AngularVariable>(
+        channel, !linear_indices.empty(), !angular_indices.empty(), wrap_angle))
+    {
+      const auto & estimate = channel.estimate;
+
+      // Predict the estimate to the measurement stamp. Only a pose has an angle to wrap.
+      const double dt = (stamp - estimate.stamp).seconds();
+      fuse_core::Vector3d innovation;
+      if (wrap_angle) {
+        innovation = mean - predictPose(estimate, dt);
+        fuse_core::wrapAngle2D(innovation(2));
+      } else {
+        innovation = mean - (estimate.mean + dt * estimate.rate);
+      }
+
+      channel.indices.assign(linear_indices.begin(), linear_indices.end());
+      for (const auto index : angular_indices) {
+        channel.indices.push_back(LinearVariable::SIZE + index);
+      }
+
+      squared_distance = squaredDistance(
+        innovation, covariance + estimate.covariance + std::abs(dt) * channel.noise_rate,
+        channel.indices);
+
+      if (squared_distance > threshold_ &&
+        (max_rejections_ <= 0 || channel.rejections < max_rejections_))
+      {
+        ++channel.rejections;
+        return false;
+      }
+    }
+
+    channel.rejections = 0;
+    addStamp(channel.stamps, stamp);
+    return true;
+  }
+
+  /**
+   * @brief Keep the stamp of an accepted measurement, dropping the oldest ones
+   */
+  static void addStamp(std::deque<rclcpp::Time> & stamps, const rclcpp::Time & stamp)
+  {
+    const auto position = std::upper_bound(stamps.begin(), stamps.end(), stamp);
+    if (position != stamps.begin() && *std::prev(position) == stamp) {
+      return;
+    }
+
+    stamps.insert(position, stamp);
+    if (stamps.size() > max_stamps_) {
+      stamps.pop_front();
+    }
+  }
+
+  /**
+   * @brief Predict a pose estimate \p dt seconds ahead, holding its body frame twist constant
+   */
+  static fuse_core::Vector3d predictPose(const Estimate & estimate, const double dt)
+  {
+    const auto & twist = estimate.rate;
+    const double yaw = estimate.mean(2) + 0.5 * twist(2) * dt;
+    const double cos_yaw = std::cos(yaw);
+    const double sin_yaw = std::sin(yaw);
+
+    fuse_core::Vector3d predicted;
+    predicted <<
+      estimate.mean(0) + (cos_yaw * twist(0) - sin_yaw * twist(1)) * dt,
+      estimate.mean(1) + (sin_yaw * twist(0) + cos_yaw * twist(1)) * dt,
+      estimate.mean(2) + twist(2) * dt;
+    return predicted;
+  }
+
+  /**
+   * @brief Compute the squared Mahalanobis distance of the requested dimensions of an innovation
+   */
+  static double squaredDistance(
+    const fuse_core::Vector3d & innovation,
+    const fuse_core::Matrix3d & covariance,
+    const std::vector<size_t> & indices)
+  {
+    Eigen::Matrix<double, Eigen::Dynamic, 1, Eigen::ColMajor, 3, 1> innovation_partial(
+      indices.size());
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor, 3, 3>
+    covariance_partial(indices.size(), indices.size());
+
+    for (size_t r = 0; r < indices.size(); ++r) {
+      innovation_partial(r) = innovation(indices[r]);
+      for (size_t c = 0; c < indices.size(); ++c) {
+        covariance_partial(r, c) = covariance(indices[r], indices[c]);
+      }
+    }
+
+    return innovation_partial.dot(covariance_partial.ldlt().solve(innovation_partial));
+  }
+
+  /**
+   * @brief Look up the linear and angular variable pair of the device at the newest accepted
+   *        stamp in the graph, and the requested blocks of their joint marginal covariance, unless
+   *        already done for the current graph
+   *
+   * The rate of change of the estimate at the same stamp is looked up too: the twist of a pose, or
+   * the linear acceleration of a twist.
+   *
+   * @return true if the graph has an estimate with a covariance, false otherwise
+   */
+  template<typename LinearVariable, typename AngularVariable>
+  bool getEstimate(Channel & channel, const bool linear, const bool angular, const bool pose)
+  {
+    auto & estimate = channel.estimate;
+    if (estimate.computed && (!linear || estimate.linear) && (!angular || estimate.angular)) {
+      return estimate.valid;
+    }
+
+    // Compute the blocks already computed too, since the estimate is replaced as a whole
+    const bool compute_linear = linear || estimate.linear;
+    const bool compute_angular = angular || estimate.angular;
+    estimate = Estimate();
+    estimate.computed = true;
+    estimate.linear = compute_linear;
+    estimate.angular = compute_angular;
+
+    if (!graph_) {
+      return false;
+    }
+
+    // Find the newest accepted stamp with both variables still in the graph, by UUID
+    auto & stamps = channel.stamps;
+    auto stamp = stamps.rbegin();
+    fuse_core::UUID linear_uuid;
+    fuse_core::UUID angular_uuid;
+    for (; stamp != stamps.rend(); ++stamp) {
+      linear_uuid = LinearVariable(*stamp, device_id_).uuid();
+      angular_uuid = AngularVariable(*stamp, device_id_).uuid();
+      if (graph_->variableExists(linear_uuid) && graph_->variableExists(angular_uuid)) {
+        break;
+      }
+    }
+
+    if (stamp == stamps.rend()) {
+      return false;
+    }
+
+    // The older stamps are not needed anymore
+    estimate.stamp = *stamp;
+    stamps.erase(stamps.begin(), std::prev(stamp.base()));
+
+    std::vector<std::pair<fuse_core::UUID, fuse_core::UUID>> requests;
+    if (compute_linear) {
+      requests.emplace_back(linear_uuid, linear_uuid);
+    }
+    if (compute_angular) {
+      requests.emplace_back(angular_uuid, angular_uuid);
+    }
+    if (compute_linear && compute_angular) {
+      requests.emplace_back(linear_uuid, angular_uuid);
+    }
+
+    std::vector<std::vector<double>> covariances;
+    try {
+      graph_->getCovariance(requests, covariances);
+    } catch (const std::exception &) {
+      return false;
+    }
+
+    const double * linear_data = graph_->getVariable(linear_uuid).data();
+    estimate.mean << linear_data[0], linear_data[1], graph_->getVariable(angular_uuid).data()[0];
+
+    estimate.rate.setZero();
+    if (pose) {
+      const auto velocity_linear_uuid =
+        fuse_variables::VelocityLinear2DStamped(estimate.stamp, device_id_).uuid();
+      const auto velocity_angular_uuid =
+        fuse_variables::VelocityAngular2DStamped(estimate.stamp, device_id_).uuid();
+      if (graph_->variableExists(velocity_linear_uuid) &&
+        graph_->variableExists(velocity_angular_uuid))
+      {
+        const double * velocity_linear = graph_->getVariable(velocity_linear_uuid).data();
+        estimate.rate << velocity_linear[0], velocity_linear[1],
+          graph_->getVariable(velocity_angular_uuid).data()[0];
+      }
+    } else {
+      const auto acceleration_linear_uuid =
+        fuse_variables::AccelerationLinear2DStamped(estimate.stamp, device_id_).uuid();
+      if (graph_->variableExists(acceleration_linear_uuid)) {
+        const double * acceleration_linear = graph_->getVariable(acceleration_linear_uuid).data();
+        estimate.rate << acceleration_linear[0], acceleration_linear[1], 0.0;
+      }
+    }
+
+    estimate.covariance.setZero();
+    auto covariance = covariances.begin();
+    if (compute_linear) {
+      const auto & linear_linear = *covariance++;
+      estimate.covariance.topLeftCorner<2, 2>() <<
+        linear_linear[0], linear_linear[1],
+        linear_linear[2], linear_linear[3];
+    }
+    if (compute_angular) {
+      estimate.covariance(2, 2) = (*covariance++)[0];
+    }
+    if (compute_linear && compute_angular) {
+      const auto & linear_angular = *covariance;
+      estimate.covariance(0, 2) = estimate.covariance(2, 0) = linear_angular[0];
+      estimate.covariance(1, 2) = estimate.covariance(2, 1) = linear_angular[1];
+    }
+
+    estimate.valid = true;
+
+    return true;
+  }
+
+  double threshold_;  //!< The maximum squared Mahalanobis distance of an accepted measurement
+  fuse_core::UUID device_id_;  //!< The UUID of the device whose estimates are used
+  int max_rejections_;  //!< The consecutive rejections after which a measurement is forced
+  fuse_core::Graph::ConstSharedPtr graph_;  //!< The latest graph
+  Channel pose_;  //!< The test of the pose measurements
+  Channel twist_;  //!< The test of the twist measurements
+};
+
+}  // namespace common
+
+}  // namespace fuse_models
+
+#endif  // FUSE_MODELS__COMMON__MAHALANOBIS_GATE_HPP_
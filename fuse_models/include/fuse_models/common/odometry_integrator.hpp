@@ -0,0 +1,224 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2018, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef FUSE_MODELS__COMMON__ODOMETRY_INTEGRATOR_HPP_
+#define FUSE_MODELS__COMMON__ODOMETRY_INTEGRATOR_HPP_
+
+#include <algorithm>
+#include <cstddef>
+
+#include <fuse_core/ring_message_buffer.hpp>
+#include <fuse_models/unicycle_2d_predict.hpp>
+#include <rclcpp/time.hpp>
+#include <tf2_2d/tf2_2d.hpp>
+
+
+namespace fuse_models
+{
+
+namespace common
+{
+
+/**
+ * @brief Dead-reckons a 2D pose forward from the latest optimized state using raw velocity
+ *        measurements
+ *
+ * The optimizer publishes a new state only every few tens of milliseconds, and its stamp lags
+ * behind the latest sensor data. This class integrates the raw velocities received in between,
+ * e.g. from wheel odometry or a gyro, with the 2D unicycle model, so the pose can be output at the
+ * sensor rate. Each velocity is held constant until the next one is received.
+ *
+ * The raw velocities are kept in a fixed-capacity buffer. When a new optimized state is set, the
+ * velocities newer than it are integrated again from it, so the integrated pose always starts from
+ * the latest optimized state.
+ *
+ * This class is not thread-safe.
+ */
+class OdometryIntegrator
+{
+public:
+  /**
+   * @brief Constructor
+   *
+   * @param[in] capacity - The maximum number of raw velocities kept to integrate again when a new
+   *                       optimized state is set. Must be at least 2.
+   */
+  explicit OdometryIntegrator(const size_t capacity)
+  : velocities_(capacity)
+  {
+  }
+
+  /**
+   * @brief Discard the state and all the raw velocities
+   */
+  void reset()
+  {
+    has_state_ = false;
+    velocities_ = Buffer(velocities_.capacity());
+  }
+
+  /**
+   * @brief Whether an optimized state has been set since construction or the last reset
+   */
+  bool hasState() const {return has_state_;}
+
+  /**
+   * @brief The stamp of the integrated state
+   */
+  const rclcpp::Time & stamp() const {return stamp_;}
+
+  /**
+   * @brief The integrated pose
+   */
+  const tf2_2d::Transform & pose() const {return pose_;}
+
+  /**
+   * @brief The linear velocity at the stamp of the integrated state
+   */
+  const tf2_2d::Vector2 & velocityLinear() const {return velocity_.linear;}
+
+  /**
+   * @brief The angular velocity at the stamp of the integrated state
+   */
+  double velocityAngular() const {return velocity_.angular;}
+
+  /**
+   * @brief Restart the integration from an optimized state, integrating again the raw velocities
+   *        newer than it
+   *
+   * @param[in] stamp - The stamp of the optimized state
+   * @param[in] pose - The optimized pose
+   * @param[in] velocity_linear - The optimized linear velocity
+   * @param[in] velocity_angular - The optimized angular velocity
+   */
+  void setState(
+    const rclcpp::Time & stamp,
+    const tf2_2d::Transform & pose,
+    const tf2_2d::Vector2 & velocity_linear,
+    const double velocity_angular)
+  {
+    has_state_ = true;
+    stamp_ = stamp;
+    pose_ = pose;
+    velocity_ = Velocity{velocity_linear, velocity_angular};
+
+    if (velocities_.empty()) {
+      return;
+    }
+
+    const auto stamps = velocities_.stamps();
+    if (stamps.back() <= stamp) {
+      return;
+    }
+
+    const auto beginning_stamp = std::max(stamp, stamps.front());
+    for (const auto & velocity : velocities_.query(beginning_stamp, stamps.back())) {
+      if (velocity.first > stamp_) {
+        integrate(velocity.first, velocity.second);
+      }
+    }
+  }
+
+  /**
+   * @brief Record a raw velocity, and integrate the state up to its stamp
+   *
+   * @param[in] stamp - The stamp of the raw velocity
+   * @param[in] velocity_linear - The raw linear velocity, in the body frame
+   * @param[in] velocity_angular - The raw angular velocity
+   * @return true if the state was integrated up to the \p stamp, false if there is no state yet,
+   *         or it is newer than the \p stamp, or the raw velocity is older than the previous one
+   */
+  bool addVelocity(
+    const rclcpp::Time & stamp,
+    const tf2_2d::Vector2 & velocity_linear,
+    const double velocity_angular)
+  {
+    // The buffer requires the velocities to be received in order
+    if (!velocities_.empty() && stamp < velocities_.stamps().back()) {
+      return false;
+    }
+
+    const Velocity velocity{velocity_linear, velocity_angular};
+    velocities_.insert(stamp, velocity);
+
+    if (!has_state_ || stamp < stamp_) {
+      return false;
+    }
+
+    integrate(stamp, velocity);
+    return true;
+  }
+
+private:
+  /**
+   * @brief A 2D linear and angular velocity
+   */
+  struct Velocity
+  {
+    tf2_2d::Vector2 linear;
+    double angular {0.0};
+  };
+
+  using Buffer = fuse_core::RingMessageBuffer<Velocity>;
+
+  /**
+   * @brief Integrate the state up to the \p stamp, holding the current velocity, and then switch to
+   *        the new \p velocity
+   */
+  void integrate(const rclcpp::Time & stamp, const Velocity & velocity)
+  {
+    const double dt = (stamp - stamp_).seconds();
+
+    tf2_2d::Vector2 velocity_linear;
+    double velocity_angular;
+    tf2_2d::Vector2 acceleration_linear;
+    predict(
+      pose_, velocity_.linear, velocity_.angular, tf2_2d::Vector2(), dt, pose_, velocity_linear,
+      velocity_angular, acceleration_linear);
+
+    stamp_ = stamp;
+    velocity_ = velocity;
+  }
+
+  bool has_state_ {false};  //!< Whether an optimized state has been set
+  rclcpp::Time stamp_;  //!< The stamp of the integrated state
+  tf2_2d::Transform pose_;  //!< The integrated pose
+  Velocity velocity_;  //!< The velocity held from the stamp of the integrated state
+  Buffer velocities_;  //!< The latest raw velocities
+};
+
+}  // namespace common
+
+}  // namespace fuse_models
+
+#endif  // FUSE_MODELS__COMMON__ODOMETRY_INTEGRATOR_HPP_
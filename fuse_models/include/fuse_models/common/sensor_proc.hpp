@@ -52,6 +52,8 @@
 #include <fuse_core/loss.hpp>
 #include <fuse_core/transaction.hpp>
 #include <fuse_core/uuid.hpp>
+#include <fuse_models/common/mahalanobis_gate.hpp>
+#include <fuse_models/common/static_transform_cache.hpp>
 #include <fuse_variables/acceleration_linear_2d_stamped.hpp>
 #include <fuse_variables/orientation_2d_stamped.hpp>
 #include <fuse_variables/position_2d_stamped.hpp>
@@ -167,6 +169,26 @@ inline std::vector<size_t> mergeIndices(
   return merged_indices;
 }
 
+/**
+ * @brief Partial measurement mean with at most \p MaxSize dimensions
+ *
+ * The size is set at runtime from the indices of the sensor configuration, but the storage is
+ * fixed, so no heap allocation happens when processing a message.
+ *
+ * @tparam MaxSize The maximum number of dimensions of the partial measurement
+ */
+template<int MaxSize>
+using PartialVector = Eigen::Matrix<double, Eigen::Dynamic, 1, Eigen::ColMajor, MaxSize, 1>;
+
+/**
+ * @brief Partial measurement covariance with at most \p MaxSize dimensions
+ *
+ * @tparam MaxSize The maximum number of dimensions of the partial measurement
+ */
+template<int MaxSize>
+using PartialMatrix =
+  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor, MaxSize, MaxSize>;
+
 /**
  * @brief Method to create sub-measurements from full measurements and append them to existing
  *        partial measurements
@@ -178,12 +200,14 @@ inline std::vector<size_t> mergeIndices(
  * @param[in,out] mean_partial - The partial measurement mean to which we want to append
  * @param[in,out] covariance_partial - The partial measurement covariance to which we want to append
  */
+template<typename MeanFull, typename CovarianceFull, typename MeanPartial,
+  typename CovariancePartial>
 inline void populatePartialMeasurement(
-  const fuse_core::VectorXd & mean_full,
-  const fuse_core::MatrixXd & covariance_full,
+  const Eigen::MatrixBase<MeanFull> & mean_full,
+  const Eigen::MatrixBase<CovarianceFull> & covariance_full,
   const std::vector<size_t> & indices,
-  fuse_core::VectorXd & mean_partial,
-  fuse_core::MatrixXd & covariance_partial)
+  Eigen::MatrixBase<MeanPartial> & mean_partial,
+  Eigen::MatrixBase<CovariancePartial> & covariance_partial)
 {
   for (size_t r = 0; r < indices.size(); ++r) {
     mean_partial(r) = mean_full(indices[r]);
@@ -194,6 +218,47 @@ inline void populatePartialMeasurement(
   }
 }
 
+/**
+ * @brief Method to create sub-measurements from full measurements using the indices of two
+ *        variables, as if they were merged with mergeIndices(), but without allocating the merged
+ *        indices
+ *
+ * @param[in] mean_full - The full mean vector from which we will generate the sub-measurement
+ * @param[in] covariance_full - The full covariance matrix from which we will generate the sub-
+ *                              measurement
+ * @param[in] lhs_indices - The indices of the first variable we want to include
+ * @param[in] rhs_indices - The indices of the second variable we want to include
+ * @param[in] rhs_offset - The offset of the second variable in the full measurement
+ * @param[in,out] mean_partial - The partial measurement mean to which we want to append
+ * @param[in,out] covariance_partial - The partial measurement covariance to which we want to append
+ */
+template<typename MeanFull, typename CovarianceFull, typename MeanPartial,
+  typename CovariancePartial>
+inline void populatePartialMeasurement(
+  const Eigen::MatrixBase<MeanFull> & mean_full,
+  const Eigen::MatrixBase<CovarianceFull> & covariance_full,
+  const std::vector<size_t> & lhs_indices,
+  const std::vector<size_t> & rhs_indices,
+  const size_t rhs_offset,
+  Eigen::MatrixBase<MeanPartial> & mean_partial,
+  Eigen::MatrixBase<CovariancePartial> & covariance_partial)
+{
+  const size_t size = lhs_indices.size() + rhs_indices.size();
+  const auto index = [&lhs_indices, &rhs_indices, rhs_offset](const size_t i)
+    {
+      return i < lhs_indices.size() ? lhs_indices[i] :
+             rhs_indices[i - lhs_indices.size()] + rhs_offset;
+    };
+
+  for (size_t r = 0; r < size; ++r) {
+    mean_partial(r) = mean_full(index(r));
+
+    for (size_t c = 0; c < size; ++c) {
+      covariance_partial(r, c) = covariance_full(index(r), index(c));
+    }
+  }
+}
+
 /**
  * @brief Method to validate partial measurements, that checks for finite values and covariance
  *        properties
@@ -202,9 +267,10 @@ inline void populatePartialMeasurement(
  * @param[in] covariance_partial - The partial measurement covariance we want to validate
  * @param[in] precision - The precision to validate the partial measurements covariance is symmetric
  */
+template<typename MeanPartial, typename CovariancePartial>
 inline void validatePartialMeasurement(
-  const fuse_core::VectorXd & mean_partial,
-  const fuse_core::MatrixXd & covariance_partial,
+  const Eigen::MatrixBase<MeanPartial> & mean_partial,
+  const Eigen::MatrixBase<CovariancePartial> & covariance_partial,
   const double precision = Eigen::NumTraits<double>::dummy_precision())
 {
   if (!mean_partial.allFinite()) {
@@ -217,7 +283,7 @@ inline void validatePartialMeasurement(
             fuse_core::to_string(covariance_partial, Eigen::FullPrecision));
   }
 
-  if (!fuse_core::isPositiveDefinite(covariance_partial)) {
+  if (!fuse_core::isPositiveDefinite(covariance_partial.eval())) {
     throw std::runtime_error(
             "Non-positive-definite partial covariance matrix\n" +
             fuse_core::to_string(covariance_partial, Eigen::FullPrecision));
@@ -231,6 +297,10 @@ inline void validatePartialMeasurement(
  * @param[in] input - The message to transform. Source frame and stamp are dictated by its header.
  * @param[in,out] output - The transformed message. Target frame is dictated by its header.
  * @param [in] timeout - Optional. The maximum time to wait for a transform to become available.
+ * @param[in] static_transform - Optional. If provided and its target frame is the one of the output
+ *                               message, a transform between frames only connected by static
+ *                               transforms is taken from it instead of being looked up in the
+ *                               \p tf_buffer every time
  * @return true if the transform succeeded, false otherwise
  */
 template<typename T>
@@ -238,11 +308,17 @@ bool transformMessage(
   const tf2_ros::Buffer & tf_buffer,
   const T & input,
   T & output,
-  const rclcpp::Duration & tf_timeout = rclcpp::Duration(0, 0))
+  const rclcpp::Duration & tf_timeout = rclcpp::Duration(0, 0),
+  StaticTransformCache::FramePair * static_transform = nullptr)
 {
   try {
     auto trans = geometry_msgs::msg::TransformStamped();
-    if (tf_timeout.nanoseconds() == 0) {
+    if (static_transform && static_transform->targetFrame() == output.header.frame_id &&
+      static_transform->lookupTransform(tf_buffer, input.header.frame_id, trans))
+    {
+      // A static transform is valid at any time
+      trans.header.stamp = input.header.stamp;
+    } else if (tf_timeout.nanoseconds() == 0) {
       trans = tf_buffer.lookupTransform(
         output.header.frame_id, input.header.frame_id,
         input.header.stamp);
@@ -282,6 +358,11 @@ bool transformMessage(
  * @param[in] validate - Whether to validate the measurements or not. If the validation fails no
  *                       constraint is added
  * @param[out] transaction - The generated variables and constraints are added to this transaction
+ * @param[in] tf_timeout - The maximum time to wait for a transform to become available
+ * @param[in] static_transform - Optional cached static transform into \p target_frame to use
+ *                               instead of looking it up in the \p tf_buffer for every message
+ * @param[in] gate - Optional gate against the latest graph estimate. If the measurement is rejected
+ *                   no constraint is added
  * @return true if any constraints were added, false otherwise
  */
 inline bool processAbsolutePoseWithCovariance(
@@ -295,7 +376,9 @@ inline bool processAbsolutePoseWithCovariance(
   const tf2_ros::Buffer & tf_buffer,
   const bool validate,
   fuse_core::Transaction & transaction,
-  const rclcpp::Duration & tf_timeout = rclcpp::Duration(0, 0))
+  const rclcpp::Duration & tf_timeout = rclcpp::Duration(0, 0),
+  StaticTransformCache::FramePair * static_transform = nullptr,
+  MahalanobisGate * gate = nullptr)
 {
   if (position_indices.empty() && orientation_indices.empty()) {
     return false;
@@ -307,7 +390,10 @@ inline bool processAbsolutePoseWithCovariance(
   } else {
     transformed_message.header.frame_id = target_frame;
 
-    if (!transformMessage(tf_buffer, pose, transformed_message, tf_timeout)) {
+    if (!transformMessage(
+        tf_buffer, pose, transformed_message, tf_timeout,
+        static_transform))
+    {
       RCLCPP_WARN_STREAM_SKIPFIRST_THROTTLE(
         rclcpp::get_logger("fuse"), sensor_proc_clock, 10.0 * 1000,
         "Failed to transform pose message with stamp " << rclcpp::Time(
@@ -346,14 +432,12 @@ inline bool processAbsolutePoseWithCovariance(
     transformed_message.pose.covariance[35];
 
   // Build the sub-vector and sub-matrices based on the requested indices
-  fuse_core::VectorXd pose_mean_partial(position_indices.size() + orientation_indices.size());
-  fuse_core::MatrixXd pose_covariance_partial(pose_mean_partial.rows(), pose_mean_partial.rows());
-
-  const auto indices = mergeIndices(position_indices, orientation_indices, position->size());
+  PartialVector<3> pose_mean_partial(position_indices.size() + orientation_indices.size());
+  PartialMatrix<3> pose_covariance_partial(pose_mean_partial.rows(), pose_mean_partial.rows());
 
   populatePartialMeasurement(
-    pose_mean, pose_covariance, indices, pose_mean_partial,
-    pose_covariance_partial);
+    pose_mean, pose_covariance, position_indices, orientation_indices, position->size(),
+    pose_mean_partial, pose_covariance_partial);
 
   if (validate) {
     try {
@@ -367,6 +451,29 @@ inline bool processAbsolutePoseWithCovariance(
     }
   }
 
+  if (gate) {
+    double squared_distance;
+    if (!gate->acceptPose(
+        pose.header.stamp, pose_mean, pose_covariance, position_indices, orientation_indices,
+        squared_distance))
+    {
+      RCLCPP_WARN_STREAM_THROTTLE(
+        rclcpp::get_logger("fuse"), sensor_proc_clock, 10.0 * 1000,
+        "Rejected absolute pose measurement from '"
+          << source << "' source with squared Mahalanobis distance " << squared_distance
+          << " greater than " << gate->threshold());
+      return false;
+    }
+
+    if (squared_distance > gate->threshold()) {
+      RCLCPP_WARN_STREAM_THROTTLE(
+        rclcpp::get_logger("fuse"), sensor_proc_clock, 10.0 * 1000,
+        "Accepted absolute pose measurement from '"
+          << source << "' source with squared Mahalanobis distance " << squared_distance
+          << " after too many consecutive rejections");
+    }
+  }
+
   // Create an absolute pose constraint
   auto constraint = fuse_constraints::AbsolutePose2DStampedConstraint::make_shared(
     source,
@@ -697,17 +804,17 @@ inline bool processDifferentialPoseWithCovariance(
   }
 
   // Build the sub-vector and sub-matrices based on the requested indices
-  fuse_core::VectorXd pose_relative_mean_partial(
+  PartialVector<3> pose_relative_mean_partial(
     position_indices.size() + orientation_indices.size());
-  fuse_core::MatrixXd pose_relative_covariance_partial(pose_relative_mean_partial.rows(),
+  PartialMatrix<3> pose_relative_covariance_partial(pose_relative_mean_partial.rows(),
     pose_relative_mean_partial.rows());
 
-  const auto indices = mergeIndices(position_indices, orientation_indices, position1->size());
-
   populatePartialMeasurement(
     pose_relative_mean,
     pose_relative_covariance,
-    indices,
+    position_indices,
+    orientation_indices,
+    position1->size(),
     pose_relative_mean_partial,
     pose_relative_covariance_partial);
 
@@ -894,17 +1001,17 @@ inline bool processDifferentialPoseWithTwistCovariance(
     minimum_pose_relative_covariance;
 
   // Build the sub-vector and sub-matrices based on the requested indices
-  fuse_core::VectorXd pose_relative_mean_partial(
+  PartialVector<3> pose_relative_mean_partial(
     position_indices.size() + orientation_indices.size());
-  fuse_core::MatrixXd pose_relative_covariance_partial(pose_relative_mean_partial.rows(),
+  PartialMatrix<3> pose_relative_covariance_partial(pose_relative_mean_partial.rows(),
     pose_relative_mean_partial.rows());
 
-  const auto indices = mergeIndices(position_indices, orientation_indices, position1->size());
-
   populatePartialMeasurement(
     pose_relative_mean,
     pose_relative_covariance,
-    indices,
+    position_indices,
+    orientation_indices,
+    position1->size(),
     pose_relative_mean_partial,
     pose_relative_covariance_partial);
 
@@ -970,6 +1077,11 @@ inline bool processDifferentialPoseWithTwistCovariance(
  * @param[in] validate - Whether to validate the measurements or not. If the validation fails no
  *                       constraint is added
  * @param[out] transaction - The generated variables and constraints are added to this transaction
+ * @param[in] tf_timeout - The maximum time to wait for a transform to become available
+ * @param[in] static_transform - Optional cached static transform into \p target_frame to use
+ *                               instead of looking it up in the \p tf_buffer for every message
+ * @param[in] gate - Optional gate against the latest graph estimate. If the measurement is rejected
+ *                   no constraint is added
  * @return true if any constraints were added, false otherwise
  */
 inline bool processTwistWithCovariance(
@@ -984,7 +1096,9 @@ inline bool processTwistWithCovariance(
   const tf2_ros::Buffer & tf_buffer,
   const bool validate,
   fuse_core::Transaction & transaction,
-  const rclcpp::Duration & tf_timeout = rclcpp::Duration(0, 0))
+  const rclcpp::Duration & tf_timeout = rclcpp::Duration(0, 0),
+  StaticTransformCache::FramePair * static_transform = nullptr,
+  MahalanobisGate * gate = nullptr)
 {
   // Make sure we actually have work to do
   if (linear_indices.empty() && angular_indices.empty()) {
@@ -997,7 +1111,10 @@ inline bool processTwistWithCovariance(
   } else {
     transformed_message.header.frame_id = target_frame;
 
-    if (!transformMessage(tf_buffer, twist, transformed_message, tf_timeout)) {
+    if (!transformMessage(
+        tf_buffer, twist, transformed_message, tf_timeout,
+        static_transform))
+    {
       RCLCPP_WARN_STREAM_SKIPFIRST_THROTTLE(
         rclcpp::get_logger("fuse"), sensor_proc_clock, 10.0 * 1000,
         "Failed to transform twist message with stamp " << rclcpp::Time(
@@ -1006,6 +1123,45 @@ inline bool processTwistWithCovariance(
     }
   }
 
+  if (gate) {
+    fuse_core::Vector3d twist_mean;
+    twist_mean << transformed_message.twist.twist.linear.x,
+      transformed_message.twist.twist.linear.y, transformed_message.twist.twist.angular.z;
+
+    fuse_core::Matrix3d twist_covariance;
+    twist_covariance <<
+      transformed_message.twist.covariance[0],
+      transformed_message.twist.covariance[1],
+      transformed_message.twist.covariance[5],
+      transformed_message.twist.covariance[6],
+      transformed_message.twist.covariance[7],
+      transformed_message.twist.covariance[11],
+      transformed_message.twist.covariance[30],
+      transformed_message.twist.covariance[31],
+      transformed_message.twist.covariance[35];
+
+    double squared_distance;
+    if (!gate->acceptTwist(
+        twist.header.stamp, twist_mean, twist_covariance, linear_indices, angular_indices,
+        squared_distance))
+    {
+      RCLCPP_WARN_STREAM_THROTTLE(
+        rclcpp::get_logger("fuse"), sensor_proc_clock, 10.0 * 1000,
+        "Rejected twist measurement from '"
+          << source << "' source with squared Mahalanobis distance " << squared_distance
+          << " greater than " << gate->threshold());
+      return false;
+    }
+
+    if (squared_distance > gate->threshold()) {
+      RCLCPP_WARN_STREAM_THROTTLE(
+        rclcpp::get_logger("fuse"), sensor_proc_clock, 10.0 * 1000,
+        "Accepted twist measurement from '"
+          << source << "' source with squared Mahalanobis distance " << squared_distance
+          << " after too many consecutive rejections");
+    }
+  }
+
   bool constraints_added = false;
 
   // Create two absolute constraints
@@ -1029,8 +1185,8 @@ inline bool processTwistWithCovariance(
       transformed_message.twist.covariance[7];
 
     // Build the sub-vector and sub-matrices based on the requested indices
-    fuse_core::VectorXd linear_vel_mean_partial(linear_indices.size());
-    fuse_core::MatrixXd linear_vel_covariance_partial(linear_vel_mean_partial.rows(),
+    PartialVector<2> linear_vel_mean_partial(linear_indices.size());
+    PartialMatrix<2> linear_vel_covariance_partial(linear_vel_mean_partial.rows(),
       linear_vel_mean_partial.rows());
 
     populatePartialMeasurement(
@@ -1134,6 +1290,9 @@ inline bool processTwistWithCovariance(
  * @param[in] validate - Whether to validate the measurements or not. If the validation fails no
  *                       constraint is added
  * @param[out] transaction - The generated variables and constraints are added to this transaction
+ * @param[in] tf_timeout - The maximum time to wait for a transform to become available
+ * @param[in] static_transform - Optional cached static transform into \p target_frame to use
+ *                               instead of looking it up in the \p tf_buffer for every message
  * @return true if any constraints were added, false otherwise
  */
 inline bool processAccelWithCovariance(
@@ -1146,7 +1305,8 @@ inline bool processAccelWithCovariance(
   const tf2_ros::Buffer & tf_buffer,
   const bool validate,
   fuse_core::Transaction & transaction,
-  const rclcpp::Duration & tf_timeout = rclcpp::Duration(0, 0))
+  const rclcpp::Duration & tf_timeout = rclcpp::Duration(0, 0),
+  StaticTransformCache::FramePair * static_transform = nullptr)
 {
   // Make sure we actually have work to do
   if (indices.empty()) {
@@ -1159,7 +1319,10 @@ inline bool processAccelWithCovariance(
   } else {
     transformed_message.header.frame_id = target_frame;
 
-    if (!transformMessage(tf_buffer, acceleration, transformed_message, tf_timeout)) {
+    if (!transformMessage(
+        tf_buffer, acceleration, transformed_message, tf_timeout,
+        static_transform))
+    {
       RCLCPP_WARN_STREAM_SKIPFIRST_THROTTLE(
         rclcpp::get_logger("fuse"), sensor_proc_clock, 10.0,
         "Failed to transform acceleration message with stamp " <<
@@ -1187,8 +1350,8 @@ inline bool processAccelWithCovariance(
     transformed_message.accel.covariance[7];
 
   // Build the sub-vector and sub-matrices based on the requested indices
-  fuse_core::VectorXd accel_mean_partial(indices.size());
-  fuse_core::MatrixXd accel_covariance_partial(accel_mean_partial.rows(),
+  PartialVector<2> accel_mean_partial(indices.size());
+  PartialMatrix<2> accel_covariance_partial(accel_mean_partial.rows(),
     accel_mean_partial.rows());
 
   populatePartialMeasurement(
@@ -0,0 +1,284 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2018, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef FUSE_MODELS__COMMON__STATIC_TRANSFORM_CACHE_HPP_
+#define FUSE_MODELS__COMMON__STATIC_TRANSFORM_CACHE_HPP_
+
+#include <tf2/time.h>
+#include <tf2_ros/buffer.h>
+#include <tf2_ros/qos.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include <utility>
+
+#include <geometry_msgs/msg/transform_stamped.hpp>
+#include <rclcpp/rclcpp.hpp>
+#include <tf2_msgs/msg/tf_message.hpp>
+
+
+namespace fuse_models
+{
+
+namespace common
+{
+
+/**
+ * @brief A record of the frames only connected by static transforms, and of the transforms between
+ *        them
+ *
+ * Looking up a transform in a tf2_ros::Buffer resolves the frame names and locks the buffer for
+ * every message, which is wasteful for the static extrinsics of a sensor, that never change. This
+ * class records the static transforms published on /tf_static, so it knows which frames are only
+ * connected through them. A sensor model creates a FramePair for each of its target frames when it
+ * is configured. The transform between such frames is looked up in the buffer once, and then reused
+ * for every message. The transforms between frames connected by any dynamic transform are never
+ * cached, and must be looked up in the buffer as usual.
+ *
+ * All the cached lookups are invalidated when a new static transform is received, so they are
+ * re-validated only when the static transform tree changes.
+ */
+class StaticTransformCache
+{
+public:
+  /**
+   * @brief The cached transform into a target frame fixed at configuration time
+   *
+   * The source frame is the one of the first message, and is expected to stay the same. A message
+   * with any other source frame replaces the cached transform. The cached transform is shared
+   * through an atomic pointer, so the per-message cost is a pointer load and a frame name
+   * comparison, without locking the StaticTransformCache.
+   */
+  class FramePair
+  {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param[in] cache - The cache that records the static transforms. It must outlive this object.
+     * @param[in] target_frame - The frame to transform into. If empty, no transform is ever cached.
+     */
+    FramePair(const StaticTransformCache & cache, std::string target_frame)
+    : cache_(cache),
+      target_frame_(std::move(target_frame))
+    {
+    }
+
+    /**
+     * @brief The frame to transform into
+     */
+    const std::string & targetFrame() const {return target_frame_;}
+
+    /**
+     * @brief Get the transform from the source frame to the target frame if they are only
+     *        connected by static transforms
+     *
+     * The first time a source frame is requested, or after the static transform tree changed, the
+     * transform is looked up in \p tf_buffer, which may throw a tf2::TransformException.
+     *
+     * @param[in] tf_buffer - The transform buffer with which to look up the transform
+     * @param[in] source_frame - The frame to transform from
+     * @param[out] transform - The transform, if static. Its stamp is the one of the lookup.
+     * @return true if the frames are only connected by static transforms, false otherwise
+     */
+    bool lookupTransform(
+      const tf2_ros::Buffer & tf_buffer,
+      const std::string & source_frame,
+      geometry_msgs::msg::TransformStamped & transform)
+    {
+      if (target_frame_.empty()) {
+        return false;
+      }
+
+      const auto generation = cache_.generation_.load();
+      auto entry = std::atomic_load(&entry_);
+      if (!entry || entry->generation != generation || entry->source_frame != source_frame) {
+        auto new_entry = std::make_shared<Entry>();
+        new_entry->generation = generation;
+        new_entry->source_frame = source_frame;
+        new_entry->transform = cache_.lookupStaticTransform(tf_buffer, target_frame_, source_frame);
+        entry = std::move(new_entry);
+        std::atomic_store(&entry_, entry);
+      }
+
+      if (!entry->transform) {
+        return false;
+      }
+
+      transform = *entry->transform;
+      return true;
+    }
+
+private:
+    /**
+     * @brief A cached lookup, replaced as a whole so it can be shared between threads
+     */
+    struct Entry
+    {
+      uint64_t generation;  //!< The static transform tree generation of the lookup
+      std::string source_frame;  //!< The frame transformed from
+      std::optional<geometry_msgs::msg::TransformStamped> transform;  //!< The transform, empty if
+                                                                      //!< not static
+    };
+
+    const StaticTransformCache & cache_;  //!< The record of the static transforms
+    std::string target_frame_;  //!< The frame to transform into
+    std::shared_ptr<const Entry> entry_;  //!< The latest lookup, accessed atomically
+  };
+
+  /**
+   * @brief Subscribe to the static transforms
+   *
+   * @param[in] interfaces - The node interfaces used to create the subscription
+   * @param[in] callback_group - The callback group of the subscription
+   */
+  template<typename NodeInterfacesT>
+  void subscribe(
+    NodeInterfacesT interfaces,
+    rclcpp::CallbackGroup::SharedPtr callback_group = nullptr)
+  {
+    rclcpp::SubscriptionOptions sub_options;
+    sub_options.callback_group = callback_group;
+
+    sub_ = rclcpp::create_subscription<tf2_msgs::msg::TFMessage>(
+      interfaces,
+      "/tf_static",
+      tf2_ros::StaticListenerQoS(),
+      std::bind(&StaticTransformCache::addStaticTransforms, this, std::placeholders::_1),
+      sub_options
+    );
+  }
+
+  /**
+   * @brief Stop receiving static transforms and invalidate all the cached ones
+   */
+  void unsubscribe()
+  {
+    sub_.reset();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    static_parents_.clear();
+    ++generation_;
+  }
+
+  /**
+   * @brief Record static transforms, invalidating all the cached lookups
+   *
+   * @param[in] message - The static transforms
+   */
+  void addStaticTransforms(const tf2_msgs::msg::TFMessage & message)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto & transform : message.transforms) {
+      static_parents_[transform.child_frame_id] = transform.header.frame_id;
+    }
+    ++generation_;
+  }
+
+private:
+  using OptionalTransform = std::optional<geometry_msgs::msg::TransformStamped>;
+
+  /**
+   * @brief Look up the transform from the source frame to the target frame in \p tf_buffer, if
+   *        they are only connected by static transforms
+   */
+  OptionalTransform lookupStaticTransform(
+    const tf2_ros::Buffer & tf_buffer,
+    const std::string & target_frame,
+    const std::string & source_frame) const
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!isStatic(target_frame, source_frame)) {
+        return std::nullopt;
+      }
+    }
+    return tf_buffer.lookupTransform(target_frame, source_frame, tf2::TimePointZero);
+  }
+
+  /**
+   * @brief Check if two frames are only connected by static transforms, i.e. if they have a common
+   *        ancestor reached through static transforms only
+   */
+  bool isStatic(const std::string & target_frame, const std::string & source_frame) const
+  {
+    // Since each frame has a single parent, a frame with a static parent transform has no dynamic
+    // parent transform
+    std::unordered_set<std::string> source_ancestors{source_frame};
+    const std::string * frame = &source_frame;
+    for (size_t i = 0; i < static_parents_.size(); ++i) {
+      const auto it = static_parents_.find(*frame);
+      if (it == static_parents_.end()) {
+        break;
+      }
+      frame = &it->second;
+      source_ancestors.insert(*frame);
+    }
+
+    frame = &target_frame;
+    for (size_t i = 0; i <= static_parents_.size(); ++i) {
+      if (source_ancestors.count(*frame) > 0) {
+        return true;
+      }
+
+      const auto it = static_parents_.find(*frame);
+      if (it == static_parents_.end()) {
+        break;
+      }
+      frame = &it->second;
+    }
+
+    return false;
+  }
+
+  mutable std::mutex mutex_;  //!< Guards the static transforms
+  std::map<std::string, std::string> static_parents_;  //!< The parent of each frame with a static
+                                                       //!< parent transform
+  std::atomic<uint64_t> generation_{0};  //!< Incremented whenever the static transforms change,
+                                         //!< to invalidate the FramePair lookups
+  rclcpp::Subscription<tf2_msgs::msg::TFMessage>::SharedPtr sub_;  //!< The static transforms
+                                                                   //!< subscription
+};
+
+}  // namespace common
+
+}  // namespace fuse_models
+
+#endif  // FUSE_MODELS__COMMON__STATIC_TRANSFORM_CACHE_HPP_
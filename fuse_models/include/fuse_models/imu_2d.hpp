@@ -40,6 +40,7 @@
 #include <memory>
 #include <string>
 
+#include <fuse_models/common/static_transform_cache.hpp>
 #include <fuse_models/parameters/imu_2d_params.hpp>
 #include <fuse_core/throttled_callback.hpp>
 
@@ -182,10 +183,15 @@ protected:
   // NOTE(CH3): Unique ptr to defer till we have the node interfaces from initialize()
   std::unique_ptr<tf2_ros::Buffer> tf_buffer_;
   std::unique_ptr<tf2_ros::TransformListener> tf_listener_;
+  std::unique_ptr<common::StaticTransformCache> static_transform_cache_;
+  std::unique_ptr<common::StaticTransformCache::FramePair> orientation_static_transform_;
+  std::unique_ptr<common::StaticTransformCache::FramePair> twist_static_transform_;
+  std::unique_ptr<common::StaticTransformCache::FramePair> acceleration_static_transform_;
 
   rclcpp::Subscription<sensor_msgs::msg::Imu>::SharedPtr sub_;
 
-  using ImuThrottledCallback = fuse_core::ThrottledMessageCallback<sensor_msgs::msg::Imu>;
+  using ImuThrottledCallback =
+    fuse_core::AggregatingThrottledMessageCallback<sensor_msgs::msg::Imu>;
   ImuThrottledCallback throttled_callback_;
 };
 
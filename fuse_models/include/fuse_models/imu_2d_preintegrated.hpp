@@ -0,0 +1,195 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2019, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef FUSE_MODELS__IMU_2D_PREINTEGRATED_HPP_
+#define FUSE_MODELS__IMU_2D_PREINTEGRATED_HPP_
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <fuse_models/imu_2d_preintegration.hpp>
+#include <fuse_models/parameters/imu_2d_preintegrated_params.hpp>
+
+#include <fuse_core/async_sensor_model.hpp>
+#include <fuse_core/eigen.hpp>
+#include <fuse_core/graph.hpp>
+#include <fuse_core/transaction.hpp>
+#include <fuse_core/uuid.hpp>
+
+#include <rclcpp/rclcpp.hpp>
+#include <sensor_msgs/msg/imu.hpp>
+
+
+namespace fuse_models
+{
+
+/**
+ * @brief A sensor that preintegrates planar IMU data published by another node into one constraint
+ *        per preintegration period
+ *
+ * Unlike Imu2D, which creates variables and constraints for every IMU message, this sensor
+ * accumulates the yaw velocity and the x and y linear accelerations of all the messages received
+ * during a preintegration period, and creates a single Imu2DPreintegratedConstraint between the 2D
+ * states at the beginning and the end of the period. The graph size is therefore proportional to
+ * the state rate rather than the IMU rate. The IMU biases are estimated as ImuBias2DStamped
+ * variables at each state, linked by a random walk, with a prior on the first ones. The most recent
+ * bias estimate from the graph is removed from the measurements before integrating them.
+ *
+ * The IMU is assumed to be mounted level and aligned with the robot base frame, so no transform is
+ * applied to the data and the gravity does not affect the x and y linear accelerations. The sensor
+ * creates the bias variables only, so a motion model such as Unicycle2D must be configured for it
+ * to create the 2D position, orientation and linear velocity variables at the involved stamps.
+ *
+ * Parameters:
+ *  - device_id (uuid string, default: 00000000-0000-0000-0000-000000000000) The device/robot ID to
+ *                                                                           publish
+ *  - device_name (string) Used to generate the device/robot ID if the device_id is not provided
+ *  - queue_size (int, default: 10) The subscriber queue size for the IMU messages
+ *  - topic (string) The topic to which to subscribe for the IMU messages
+ *  - preintegration_period (double, default: 0.1) The time between two consecutive states, in
+ *                                                 seconds
+ *  - gyroscope_noise_density (double, default: 1.0e-3) The gyroscope white noise, in
+ *                                                      rad/s/sqrt(Hz)
+ *  - accelerometer_noise_density (double, default: 1.0e-2) The accelerometer white noise, in
+ *                                                          m/s^2/sqrt(Hz)
+ *  - gyroscope_bias_random_walk (double, default: 1.0e-4) The gyroscope bias random walk, in
+ *                                                         rad/s^2/sqrt(Hz)
+ *  - accelerometer_bias_random_walk (double, default: 1.0e-3) The accelerometer bias random walk,
+ *                                                             in m/s^3/sqrt(Hz)
+ *  - initial_bias_covariance_diagonal (vector of 3 doubles, default: 1.0e-2) The covariance of the
+ *                                                                            prior on the first
+ *                                                                            biases
+ *  - loss (loss config) The loss function of the preintegrated constraints
+ *
+ * Subscribes:
+ *  - \p topic (sensor_msgs::msg::Imu) IMU data at a given timestep
+ */
+class Imu2DPreintegrated : public fuse_core::AsyncSensorModel
+{
+public:
+  FUSE_SMART_PTR_DEFINITIONS(Imu2DPreintegrated)
+  using ParameterType = parameters::Imu2DPreintegratedParams;
+
+  /**
+   * @brief Default constructor
+   */
+  Imu2DPreintegrated();
+
+  /**
+   * @brief Destructor
+   */
+  virtual ~Imu2DPreintegrated() = default;
+
+  /**
+   * @brief Shadowing extension to the AsyncSensorModel::initialize call
+   */
+  void initialize(
+    fuse_core::node_interfaces::NodeInterfaces<ALL_FUSE_CORE_NODE_INTERFACES> interfaces,
+    const std::string & name,
+    fuse_core::TransactionCallback transaction_callback) override;
+
+  /**
+   * @brief Callback for IMU messages
+   * @param[in] msg - The IMU message to process
+   */
+  void process(const sensor_msgs::msg::Imu & msg);
+
+protected:
+  fuse_core::UUID device_id_;  //!< The UUID of this device
+
+  /**
+   * @brief Perform any required initialization for the sensor model
+   *
+   * This could include things like reading from the parameter server or subscribing to topics. The
+   * class's node handles will be properly initialized before SensorModel::onInit() is called.
+   * Spinning of the callback queue will not begin until after the call to SensorModel::onInit()
+   * completes.
+   */
+  void onInit() override;
+
+  /**
+   * @brief Subscribe to the input topic to start sending transactions to the optimizer
+   */
+  void onStart() override;
+
+  /**
+   * @brief Unsubscribe from the input topic to stop sending transactions to the optimizer
+   */
+  void onStop() override;
+
+  /**
+   * @brief Read the latest estimate of the IMU biases from the graph
+   *
+   * @param[in] graph A read-only pointer to the graph object
+   */
+  void onGraphUpdate(fuse_core::Graph::ConstSharedPtr graph) override;
+
+  /**
+   * @brief Create the transaction with the preintegrated constraint of the current preintegration
+   *        period
+   *
+   * @param[in] stamp The end of the preintegration period
+   * @return The transaction with the preintegrated constraint and the bias variables
+   */
+  fuse_core::Transaction::SharedPtr createTransaction(const rclcpp::Time & stamp);
+
+  fuse_core::node_interfaces::NodeInterfaces<
+    fuse_core::node_interfaces::Base,
+    fuse_core::node_interfaces::Clock,
+    fuse_core::node_interfaces::Logging,
+    fuse_core::node_interfaces::Parameters,
+    fuse_core::node_interfaces::Topics,
+    fuse_core::node_interfaces::Waitables
+  > interfaces_;  //!< Shadows AsyncSensorModel interfaces_
+
+  rclcpp::Clock::SharedPtr clock_;  //!< The sensor model's clock, for timestamping and logging
+  rclcpp::Logger logger_;  //!< The sensor model's logger
+
+  ParameterType params_;
+
+  Imu2DPreintegration preintegration_;  //!< The measurements of the current preintegration period
+  fuse_core::Vector3d bias_;  //!< The latest estimate of the IMU biases
+  bool first_period_{true};  //!< Whether the prior on the first biases has to be created
+  rclcpp::Time period_start_;  //!< The beginning of the current preintegration period
+
+  std::optional<rclcpp::Time> previous_stamp_;  //!< The stamp of the previous IMU message
+  double previous_yaw_velocity_{0.0};  //!< The yaw velocity of the previous IMU message
+  fuse_core::Vector2d previous_acceleration_;  //!< The acceleration of the previous IMU message
+
+  rclcpp::Subscription<sensor_msgs::msg::Imu>::SharedPtr sub_;
+};
+
+}  // namespace fuse_models
+
+#endif  // FUSE_MODELS__IMU_2D_PREINTEGRATED_HPP_
@@ -0,0 +1,207 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2018, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef FUSE_MODELS__IMU_2D_PREINTEGRATED_CONSTRAINT_HPP_
+#define FUSE_MODELS__IMU_2D_PREINTEGRATED_CONSTRAINT_HPP_
+
+#include <ostream>
+#include <string>
+
+#include <fuse_core/constraint.hpp>
+#include <fuse_core/eigen.hpp>
+#include <fuse_core/fuse_macros.hpp>
+#include <fuse_core/serialization.hpp>
+#include <fuse_core/uuid.hpp>
+#include <fuse_models/imu_2d_preintegration.hpp>
+#include <fuse_variables/imu_bias_2d_stamped.hpp>
+#include <fuse_variables/orientation_2d_stamped.hpp>
+#include <fuse_variables/position_2d_stamped.hpp>
+#include <fuse_variables/velocity_linear_2d_stamped.hpp>
+
+#include <boost/serialization/access.hpp>
+#include <boost/serialization/base_object.hpp>
+#include <boost/serialization/export.hpp>
+
+
+namespace fuse_models
+{
+
+/**
+ * @brief A class that represents a preintegrated planar IMU measurement between 2D states at two
+ *        different times
+ *
+ * A single constraint replaces all the IMU measurements received between the two states. Each state
+ * is made of the 2D position, 2D orientation, 2D linear velocity and the IMU biases. The biases are
+ * modelled as a random walk between the two states. See Imu2DPreintegratedCostFunction.
+ */
+class Imu2DPreintegratedConstraint : public fuse_core::Constraint
+{
+public:
+  FUSE_CONSTRAINT_DEFINITIONS_WITH_EIGEN(Imu2DPreintegratedConstraint)
+
+  /**
+   * @brief Default constructor
+   */
+  Imu2DPreintegratedConstraint() = default;
+
+  /**
+   * @brief Create a constraint from a preintegrated IMU measurement
+   *
+   * @param[in] source The name of the sensor or motion model that generated this constraint
+   * @param[in] position1 Position component variable of the first state
+   * @param[in] yaw1 Yaw component variable of the first state
+   * @param[in] linear_velocity1 Linear velocity component variable of the first state
+   * @param[in] bias1 IMU biases variable of the first state
+   * @param[in] position2 Position component variable of the second state
+   * @param[in] yaw2 Yaw component variable of the second state
+   * @param[in] linear_velocity2 Linear velocity component variable of the second state
+   * @param[in] bias2 IMU biases variable of the second state
+   * @param[in] preintegration The IMU measurements integrated between the two states. At least
+   *                           two steps are needed for a positive definite covariance.
+   * @param[in] bias_covariance The covariance of the change of the biases between the two states.
+   *                            Order is (yaw_vel, x_acc, y_acc)
+   * @throws std::invalid_argument if the combined covariance is not positive definite
+   */
+  Imu2DPreintegratedConstraint(
+    const std::string & source,
+    const fuse_variables::Position2DStamped & position1,
+    const fuse_variables::Orientation2DStamped & yaw1,
+    const fuse_variables::VelocityLinear2DStamped & linear_velocity1,
+    const fuse_variables::ImuBias2DStamped & bias1,
+    const fuse_variables::Position2DStamped & position2,
+    const fuse_variables::Orientation2DStamped & yaw2,
+    const fuse_variables::VelocityLinear2DStamped & linear_velocity2,
+    const fuse_variables::ImuBias2DStamped & bias2,
+    const Imu2DPreintegration & preintegration,
+    const fuse_core::Matrix3d & bias_covariance);
+
+  /**
+   * @brief Destructor
+   */
+  virtual ~Imu2DPreintegratedConstraint() = default;
+
+  /**
+   * @brief Read-only access to the time delta of the preintegrated measurement
+   */
+  double dt() const {return dt_;}
+
+  /**
+   * @brief Read-only access to the preintegrated measurement
+   *
+   * Order is (x, y, yaw, x_vel, y_vel)
+   */
+  const fuse_core::Vector5d & delta() const {return delta_;}
+
+  /**
+   * @brief Read-only access to the Jacobian of the preintegrated measurement wrt the biases
+   */
+  const fuse_core::Matrix<double, 5, 3> & biasJacobian() const {return bias_jacobian_;}
+
+  /**
+   * @brief Read-only access to the nominal biases used to integrate the measurement
+   *
+   * Order is (yaw_vel, x_acc, y_acc)
+   */
+  const fuse_core::Vector3d & bias() const {return bias_;}
+
+  /**
+   * @brief Read-only access to the square root information matrix.
+   *
+   * Order is (x, y, yaw, x_vel, y_vel, bias_yaw_vel, bias_x_acc, bias_y_acc)
+   */
+  const fuse_core::Matrix8d & sqrtInformation() const {return sqrt_information_;}
+
+  /**
+   * @brief Compute the measurement covariance matrix.
+   *
+   * Order is (x, y, yaw, x_vel, y_vel, bias_yaw_vel, bias_x_acc, bias_y_acc)
+   */
+  fuse_core::Matrix8d covariance() const
+  {
+    return (sqrt_information_.transpose() * sqrt_information_).inverse();
+  }
+
+  /**
+   * @brief Print a human-readable description of the constraint to the provided stream.
+   *
+   * @param[out] stream The stream to write to. Defaults to stdout.
+   */
+  void print(std::ostream & stream = std::cout) const override;
+
+  /**
+   * @brief Construct an instance of this constraint's cost function
+   *
+   * The function caller will own the new cost function instance. It is the responsibility of the
+   * caller to delete the cost function object when it is no longer needed. If the pointer is
+   * provided to a Ceres::Problem object, the Ceres::Problem object will takes ownership of the
+   * pointer and delete it during destruction.
+   *
+   * @return A base pointer to an instance of a derived CostFunction.
+   */
+  ceres::CostFunction * costFunction() const override;
+
+protected:
+  double dt_;  //!< The time delta of the preintegrated measurement
+  fuse_core::Vector5d delta_;  //!< The preintegrated measurement
+  fuse_core::Matrix<double, 5, 3> bias_jacobian_;  //!< The preintegrated measurement bias Jacobian
+  fuse_core::Vector3d bias_;  //!< The nominal biases used to integrate the measurement
+  fuse_core::Matrix8d sqrt_information_;  //!< The square root information matrix
+
+private:
+  // Allow Boost Serialization access to private methods
+  friend class boost::serialization::access;
+
+  /**
+   * @brief The Boost Serialize method that serializes all of the data members in to/out of the
+   *        archive
+   *
+   * @param[in/out] archive - The archive object that holds the serialized class members
+   * @param[in] version - The version of the archive being read/written. Generally unused.
+   */
+  template<class Archive>
+  void serialize(Archive & archive, const unsigned int /* version */)
+  {
+    archive & boost::serialization::base_object<fuse_core::Constraint>(*this);
+    archive & dt_;
+    archive & delta_;
+    archive & bias_jacobian_;
+    archive & bias_;
+    archive & sqrt_information_;
+  }
+};
+
+}  // namespace fuse_models
+
+BOOST_CLASS_EXPORT_KEY(fuse_models::Imu2DPreintegratedConstraint);
+
+#endif  // FUSE_MODELS__IMU_2D_PREINTEGRATED_CONSTRAINT_HPP_
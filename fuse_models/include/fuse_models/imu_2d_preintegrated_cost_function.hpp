@@ -0,0 +1,237 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2018, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef FUSE_MODELS__IMU_2D_PREINTEGRATED_COST_FUNCTION_HPP_
+#define FUSE_MODELS__IMU_2D_PREINTEGRATED_COST_FUNCTION_HPP_
+
+#include <ceres/sized_cost_function.h>
+
+#include <cmath>
+
+#include <fuse_core/eigen.hpp>
+#include <fuse_core/fuse_macros.hpp>
+#include <fuse_core/util.hpp>
+
+
+namespace fuse_models
+{
+
+/**
+ * @brief Create a cost function for a preintegrated planar IMU measurement between two 2D states
+ *
+ * Each state is made of the position, yaw, body frame linear velocity and IMU biases. The
+ * preintegrated measurement (see Imu2DPreintegration) is corrected to first order for the change of
+ * the first state biases from the nominal biases used to integrate it:
+ *
+ *   delta(b1) = delta + J_b * (b1 - b_bar)
+ *
+ * The cost function is of the form:
+ *
+ *             ||    [ R(yaw1)^T * (p2 - p1) - v1 * dt - delta_p(b1) ] ||^2
+ *   cost(x) = ||A * [        yaw2 - yaw1 - delta_yaw(b1)          ] ||
+ *             ||    [   R(yaw2 - yaw1) * v2 - v1 - delta_v(b1)    ] ||
+ *             ||    [                  b2 - b1                    ] ||
+ *
+ * where the last rows model the biases as a random walk, and the matrix A is fixed, most likely the
+ * square root information matrix in order (x, y, yaw, x_vel, y_vel, bias_yaw_vel, bias_x_acc,
+ * bias_y_acc). All Jacobians are computed analytically.
+ */
+class Imu2DPreintegratedCostFunction : public ceres::SizedCostFunction<8, 2, 1, 2, 3, 2, 1, 2, 3>
+{
+public:
+  FUSE_MAKE_ALIGNED_OPERATOR_NEW()
+
+  /**
+   * @brief Construct a cost function instance
+   *
+   * @param[in] dt The time delta of the preintegrated measurement
+   * @param[in] delta The preintegrated measurement, in order (x, y, yaw, x_vel, y_vel)
+   * @param[in] bias_jacobian The Jacobian of the preintegrated measurement wrt the biases
+   * @param[in] bias The nominal biases used to integrate the measurement, in order (yaw_vel,
+   *                 x_acc, y_acc)
+   * @param[in] A The residual weighting matrix, most likely the square root information matrix in
+   *              order (x, y, yaw, x_vel, y_vel, bias_yaw_vel, bias_x_acc, bias_y_acc)
+   */
+  Imu2DPreintegratedCostFunction(
+    const double dt,
+    const fuse_core::Vector5d & delta,
+    const fuse_core::Matrix<double, 5, 3> & bias_jacobian,
+    const fuse_core::Vector3d & bias,
+    const fuse_core::Matrix8d & A)
+  : dt_(dt),
+    delta_(delta),
+    bias_jacobian_(bias_jacobian),
+    bias_(bias),
+    A_(A)
+  {
+  }
+
+  /**
+   * @brief Evaluate the cost function. Used by the Ceres optimization engine.
+   *
+   * @param[in] parameters - Parameter blocks:
+   *                         0 : position1 - First position (array with x at index 0, y at index 1)
+   *                         1 : yaw1 - First yaw
+   *                         2 : vel_linear1 - First linear velocity (array with x at index 0, y at
+   *                             index 1)
+   *                         3 : bias1 - First IMU biases (array with yaw_vel, x_acc, y_acc)
+   *                         4 : position2 - Second position (array with x at index 0, y at index 1)
+   *                         5 : yaw2 - Second yaw
+   *                         6 : vel_linear2 - Second linear velocity (array with x at index 0, y at
+   *                             index 1)
+   *                         7 : bias2 - Second IMU biases (array with yaw_vel, x_acc, y_acc)
+   * @param[out] residual - The computed residual (error)
+   * @param[out] jacobians - Jacobians of the residuals wrt the parameters. Only computed if not
+   *                         NULL, and only computed for the parameters where jacobians[i] is not
+   *                         NULL.
+   * @return The return value indicates whether the computation of the residuals and/or jacobians
+   *         was successful or not.
+   */
+  bool Evaluate(
+    double const * const * parameters,
+    double * residuals,
+    double ** jacobians) const override
+  {
+    const Eigen::Map<const fuse_core::Vector2d> position1(parameters[0]);
+    const double yaw1 = parameters[1][0];
+    const Eigen::Map<const fuse_core::Vector2d> vel_linear1(parameters[2]);
+    const Eigen::Map<const fuse_core::Vector3d> bias1(parameters[3]);
+    const Eigen::Map<const fuse_core::Vector2d> position2(parameters[4]);
+    const double yaw2 = parameters[5][0];
+    const Eigen::Map<const fuse_core::Vector2d> vel_linear2(parameters[6]);
+    const Eigen::Map<const fuse_core::Vector3d> bias2(parameters[7]);
+
+    // Correct the preintegrated measurement for the change of the biases
+    const fuse_core::Vector5d delta = delta_ + bias_jacobian_ * (bias1 - bias_);
+
+    // Rotations from the world frame to the first state frame, and from the second state frame to
+    // the first state frame
+    const double cos_yaw1 = std::cos(yaw1);
+    const double sin_yaw1 = std::sin(yaw1);
+    fuse_core::Matrix2d rotation1_transpose;
+    rotation1_transpose << cos_yaw1, sin_yaw1, -sin_yaw1, cos_yaw1;
+
+    const double cos_yaw12 = std::cos(yaw2 - yaw1);
+    const double sin_yaw12 = std::sin(yaw2 - yaw1);
+    fuse_core::Matrix2d rotation12;
+    rotation12 << cos_yaw12, -sin_yaw12, sin_yaw12, cos_yaw12;
+
+    const fuse_core::Vector2d position_delta = rotation1_transpose * (position2 - position1);
+    const fuse_core::Vector2d vel_linear2_rotated = rotation12 * vel_linear2;
+
+    Eigen::Map<fuse_core::Vector8d> residuals_map(residuals);
+    residuals_map.head<2>() = position_delta - vel_linear1 * dt_ - delta.head<2>();
+    residuals_map[2] = yaw2 - yaw1 - delta[2];
+    fuse_core::wrapAngle2D(residuals_map[2]);
+    residuals_map.segment<2>(3) = vel_linear2_rotated - vel_linear1 - delta.tail<2>();
+    residuals_map.tail<3>() = bias2 - bias1;
+
+    // Scale the residuals by the square root information matrix to account for the measurement
+    // uncertainty.
+    residuals_map.applyOnTheLeft(A_);
+
+    if (jacobians) {
+      // Derivatives of the rotated position delta and second velocity wrt the yaws. The derivative
+      // of a 2D rotation R(yaw) is R(yaw) * S, with S = [0, -1; 1, 0].
+      const fuse_core::Vector2d position_delta_yaw1(position_delta.y(), -position_delta.x());
+      const fuse_core::Vector2d vel_linear2_rotated_yaw2(
+        -vel_linear2_rotated.y(), vel_linear2_rotated.x());
+
+      // Jacobian wrt position1
+      if (jacobians[0]) {
+        Eigen::Map<fuse_core::Matrix<double, 8, 2>> jacobian(jacobians[0]);
+        jacobian = -A_.leftCols<2>() * rotation1_transpose;
+      }
+
+      // Jacobian wrt yaw1
+      if (jacobians[1]) {
+        fuse_core::Vector8d d_residuals = fuse_core::Vector8d::Zero();
+        d_residuals.head<2>() = position_delta_yaw1;
+        d_residuals[2] = -1.0;
+        d_residuals.segment<2>(3) = -vel_linear2_rotated_yaw2;
+        Eigen::Map<fuse_core::Vector8d> jacobian(jacobians[1]);
+        jacobian = A_ * d_residuals;
+      }
+
+      // Jacobian wrt vel_linear1
+      if (jacobians[2]) {
+        Eigen::Map<fuse_core::Matrix<double, 8, 2>> jacobian(jacobians[2]);
+        jacobian = -A_.leftCols<2>() * dt_ - A_.block<8, 2>(0, 3);
+      }
+
+      // Jacobian wrt bias1
+      if (jacobians[3]) {
+        Eigen::Map<fuse_core::Matrix<double, 8, 3>> jacobian(jacobians[3]);
+        jacobian = -A_.leftCols<5>() * bias_jacobian_ - A_.rightCols<3>();
+      }
+
+      // Jacobian wrt position2
+      if (jacobians[4]) {
+        Eigen::Map<fuse_core::Matrix<double, 8, 2>> jacobian(jacobians[4]);
+        jacobian = A_.leftCols<2>() * rotation1_transpose;
+      }
+
+      // Jacobian wrt yaw2
+      if (jacobians[5]) {
+        Eigen::Map<fuse_core::Vector8d> jacobian(jacobians[5]);
+        jacobian = A_.col(2) + A_.block<8, 2>(0, 3) * vel_linear2_rotated_yaw2;
+      }
+
+      // Jacobian wrt vel_linear2
+      if (jacobians[6]) {
+        Eigen::Map<fuse_core::Matrix<double, 8, 2>> jacobian(jacobians[6]);
+        jacobian = A_.block<8, 2>(0, 3) * rotation12;
+      }
+
+      // Jacobian wrt bias2
+      if (jacobians[7]) {
+        Eigen::Map<fuse_core::Matrix<double, 8, 3>> jacobian(jacobians[7]);
+        jacobian = A_.rightCols<3>();
+      }
+    }
+
+    return true;
+  }
+
+private:
+  double dt_;  //!< The time delta of the preintegrated measurement
+  fuse_core::Vector5d delta_;  //!< The preintegrated measurement
+  fuse_core::Matrix<double, 5, 3> bias_jacobian_;  //!< The preintegrated measurement bias Jacobian
+  fuse_core::Vector3d bias_;  //!< The nominal biases used to integrate the measurement
+  fuse_core::Matrix8d A_;  //!< The residual weighting matrix, most likely the square root
+                           //!< information matrix
+};
+
+}  // namespace fuse_models
+
+#endif  // FUSE_MODELS__IMU_2D_PREINTEGRATED_COST_FUNCTION_HPP_
@@ -0,0 +1,152 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2018, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef FUSE_MODELS__IMU_2D_PREINTEGRATION_HPP_
+#define FUSE_MODELS__IMU_2D_PREINTEGRATION_HPP_
+
+#include <fuse_core/eigen.hpp>
+#include <fuse_core/fuse_macros.hpp>
+
+
+namespace fuse_models
+{
+
+/**
+ * @brief Accumulates planar IMU measurements between two robot states into a single relative motion
+ *        measurement
+ *
+ * The IMU is assumed to be mounted level and aligned with the robot base frame, so the gyroscope
+ * measures the yaw velocity and the accelerometer measures the x and y linear accelerations of the
+ * robot body, without any gravity component. The biases are removed before integrating, using the
+ * nominal biases provided to reset().
+ *
+ * The preintegrated measurement is expressed in the frame of the first state, in the order
+ * (x, y, yaw, x_vel, y_vel):
+ *
+ *   delta_yaw      = sum (w_k - bw) * dt_k
+ *   delta_velocity = sum R(delta_yaw_k) * (a_k - ba) * dt_k
+ *   delta_position = sum delta_velocity_k * dt_k + 0.5 * R(delta_yaw_k) * (a_k - ba) * dt_k^2
+ *
+ * Alongside it, the first-order Jacobian of the measurement wrt the biases is accumulated, so the
+ * measurement can be corrected for a change of the bias estimates without integrating again, and
+ * the measurement covariance is propagated from the IMU noise densities. See Forster et al.,
+ * "On-Manifold Preintegration for Real-Time Visual-Inertial Odometry", for the 3D derivation.
+ */
+class Imu2DPreintegration
+{
+public:
+  FUSE_MAKE_ALIGNED_OPERATOR_NEW()
+
+  using Vector5d = fuse_core::Vector5d;
+  using Matrix5d = fuse_core::Matrix5d;
+  using Matrix53d = fuse_core::Matrix<double, 5, 3>;
+
+  /**
+   * @brief Constructor
+   *
+   * @param[in] gyroscope_noise_density     The gyroscope white noise density, in rad/s/sqrt(Hz)
+   * @param[in] accelerometer_noise_density The accelerometer white noise density, in
+   *                                        m/s^2/sqrt(Hz)
+   * @param[in] bias                        The nominal biases, in order (yaw_vel, x_acc, y_acc)
+   */
+  explicit Imu2DPreintegration(
+    const double gyroscope_noise_density = 0.0,
+    const double accelerometer_noise_density = 0.0,
+    const fuse_core::Vector3d & bias = fuse_core::Vector3d::Zero());
+
+  /**
+   * @brief Discard all integrated measurements and start again with new nominal biases
+   *
+   * @param[in] bias The nominal biases, in order (yaw_vel, x_acc, y_acc)
+   */
+  void reset(const fuse_core::Vector3d & bias);
+
+  /**
+   * @brief Integrate one IMU measurement, held constant over a time step
+   *
+   * @param[in] yaw_velocity The measured yaw velocity, in rad/s
+   * @param[in] acceleration The measured x and y linear accelerations, in m/s^2
+   * @param[in] dt           The time step, in seconds
+   */
+  void integrate(
+    const double yaw_velocity,
+    const fuse_core::Vector2d & acceleration,
+    const double dt);
+
+  /**
+   * @brief The nominal biases removed from the measurements, in order (yaw_vel, x_acc, y_acc)
+   */
+  const fuse_core::Vector3d & bias() const {return bias_;}
+
+  /**
+   * @brief The total integrated time, in seconds
+   */
+  double dt() const {return dt_;}
+
+  /**
+   * @brief The number of integrated time steps
+   *
+   * A single step propagates the three IMU noise inputs into the five measurement dimensions, so
+   * the covariance is rank deficient until at least two steps are integrated.
+   */
+  size_t steps() const {return steps_;}
+
+  /**
+   * @brief The preintegrated measurement, in order (x, y, yaw, x_vel, y_vel)
+   */
+  const Vector5d & delta() const {return delta_;}
+
+  /**
+   * @brief The Jacobian of the preintegrated measurement wrt the biases
+   */
+  const Matrix53d & biasJacobian() const {return bias_jacobian_;}
+
+  /**
+   * @brief The covariance of the preintegrated measurement, in order (x, y, yaw, x_vel, y_vel)
+   */
+  const Matrix5d & covariance() const {return covariance_;}
+
+private:
+  double gyroscope_variance_;  //!< The squared gyroscope noise density
+  double accelerometer_variance_;  //!< The squared accelerometer noise density
+  fuse_core::Vector3d bias_;  //!< The nominal biases
+  double dt_;  //!< The total integrated time
+  size_t steps_;  //!< The number of integrated time steps
+  Vector5d delta_;  //!< The preintegrated measurement
+  Matrix53d bias_jacobian_;  //!< The Jacobian of the preintegrated measurement wrt the biases
+  Matrix5d covariance_;  //!< The covariance of the preintegrated measurement
+};
+
+}  // namespace fuse_models
+
+#endif  // FUSE_MODELS__IMU_2D_PREINTEGRATION_HPP_
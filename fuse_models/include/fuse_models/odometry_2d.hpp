@@ -40,10 +40,13 @@
 #include <memory>
 #include <string>
 
+#include <fuse_models/common/mahalanobis_gate.hpp>
+#include <fuse_models/common/static_transform_cache.hpp>
 #include <fuse_models/parameters/odometry_2d_params.hpp>
 #include <fuse_core/throttled_callback.hpp>
 
 #include <fuse_core/async_sensor_model.hpp>
+#include <fuse_core/graph.hpp>
 #include <fuse_core/uuid.hpp>
 
 #include <geometry_msgs/msg/pose_with_covariance_stamped.hpp>
@@ -83,6 +86,20 @@ namespace fuse_models
  *  - twist_target_frame (string) Twist/velocity data will be transformed into this frame before it
  *                                is fused. This frame should be a body-relative frame, typically
  *                                'base_link'.
+ *  - mahalanobis_threshold (double, default: 0.0) Absolute measurements with a squared Mahalanobis
+ *                                                 distance to the latest graph estimate greater
+ *                                                 than this are rejected before they are added to
+ *                                                 the graph, e.g. 11.34 for a 99% confidence with
+ *                                                 3 dimensions. Disabled if zero.
+ *  - mahalanobis_pose_noise_rate_diagonal (vector of doubles, default: [0, 0, 0]) The variances
+ *                                                 added to the pose estimate per second elapsed
+ *                                                 from its stamp to the measurement stamp.
+ *  - mahalanobis_twist_noise_rate_diagonal (vector of doubles, default: [0, 0, 0]) The variances
+ *                                                 added to the twist estimate per second elapsed
+ *                                                 from its stamp to the measurement stamp.
+ *  - mahalanobis_max_rejections (int, default: 10) After this many consecutive rejections the
+ *                                                 next measurement is accepted anyway, so the gate
+ *                                                 cannot lock the sensor out. Never if zero.
  *
  * Subscribes:
  *  - \p topic (nav_msgs::msg::Odometry) Odometry information at a given timestep
@@ -140,6 +157,13 @@ protected:
    */
   void onStop() override;
 
+  /**
+   * @brief Keep the latest graph to gate the absolute measurements, if enabled
+   *
+   * @param[in] graph - The latest graph
+   */
+  void onGraphUpdate(fuse_core::Graph::ConstSharedPtr graph) override;
+
   /**
    * @brief Process a pose message in differential mode
    *
@@ -173,10 +197,15 @@ protected:
   // NOTE(CH3): Unique ptr to defer till we have the node interfaces from initialize()
   std::unique_ptr<tf2_ros::Buffer> tf_buffer_;
   std::unique_ptr<tf2_ros::TransformListener> tf_listener_;
+  std::unique_ptr<common::StaticTransformCache> static_transform_cache_;
+  std::unique_ptr<common::StaticTransformCache::FramePair> pose_static_transform_;
+  std::unique_ptr<common::StaticTransformCache::FramePair> twist_static_transform_;
+  std::unique_ptr<common::MahalanobisGate> gate_;  //!< The optional outlier gate
 
   rclcpp::Subscription<nav_msgs::msg::Odometry>::SharedPtr sub_;
 
-  using OdometryThrottledCallback = fuse_core::ThrottledMessageCallback<nav_msgs::msg::Odometry>;
+  using OdometryThrottledCallback =
+    fuse_core::AggregatingThrottledMessageCallback<nav_msgs::msg::Odometry>;
   OdometryThrottledCallback throttled_callback_;
 };
 
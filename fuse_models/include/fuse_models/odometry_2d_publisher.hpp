@@ -41,7 +41,9 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 
+#include <fuse_models/common/odometry_integrator.hpp>
 #include <fuse_models/parameters/odometry_2d_publisher_params.hpp>
 
 #include <fuse_core/async_publisher.hpp>
@@ -55,6 +57,7 @@
 #include <geometry_msgs/msg/accel_with_covariance_stamped.hpp>
 #include <nav_msgs/msg/odometry.hpp>
 #include <rclcpp/rclcpp.hpp>
+#include <sensor_msgs/msg/imu.hpp>
 
 
 namespace fuse_models
@@ -92,6 +95,16 @@ namespace fuse_models
  *                                              map_frame_id or the odom_frame_id.
  *  - topic (string, default: "odometry/filtered")  The ROS topic to which we will publish the
  *                                                  filtered state data
+ *  - high_rate_odometry_topic (string, default: "")  If set, the raw odometry velocities received
+ *                                                    on this topic are integrated from the latest
+ *                                                    optimized state, and the result is published
+ *                                                    for every message, instead of at the
+ *                                                    publish_frequency
+ *  - high_rate_imu_topic (string, default: "")  If set, the raw IMU angular velocities received on
+ *                                               this topic are integrated like the raw odometry
+ *                                               ones, replacing its angular velocity
+ *  - high_rate_buffer_size (int, default: 1000)  The number of raw velocities kept to integrate
+ *                                                again when a new optimized state is received
  *
  * Publishes:
  *  - odometry/filtered (nav_msgs::msg::Odometry)  The most recent optimized state, gives as an
@@ -103,6 +116,16 @@ namespace fuse_models
  *                                              odom->base_link transform, but only if the
  *                                              world_frame_id is set to the value of the
  *                                              map_frame_id.
+ *  - \p high_rate_odometry_topic (nav_msgs::msg::Odometry)  Raw odometry, whose twist is expected
+ *                                                           in the base_link_frame_id
+ *  - \p high_rate_imu_topic (sensor_msgs::msg::Imu)  Raw IMU data, whose z axis is expected to be
+ *                                                    aligned with the one of the
+ *                                                    base_link_frame_id
+ *
+ * The high-rate output is decoupled from the optimizer cycle: the raw messages are processed in a
+ * dedicated thread, which only takes the latest optimized state from a shared pointer swapped
+ * atomically on every notifyCallback, so it never waits for the covariance computation. The
+ * covariance published is the one of the latest optimized state.
  */
 class Odometry2DPublisher : public fuse_core::AsyncPublisher
 {
@@ -118,7 +141,7 @@ public:
   /**
    * @brief Destructor
    */
-  virtual ~Odometry2DPublisher() = default;
+  virtual ~Odometry2DPublisher();
 
   /**
    * @brief Shadowing extension to the AsyncPublisher::initialize call
@@ -194,6 +217,34 @@ protected:
    */
   void publishTimerCallback();
 
+  /**
+   * @brief Publish the odometry and acceleration, and broadcast the odometry pose as a tf transform
+   * @param[in] odom_output The odometry to publish
+   * @param[in] acceleration_output The acceleration to publish
+   */
+  void publishState(
+    const nav_msgs::msg::Odometry & odom_output,
+    const geometry_msgs::msg::AccelWithCovarianceStamped & acceleration_output);
+
+  /**
+   * @brief Callback for the raw odometry messages of the high-rate output
+   * @param[in] msg The raw odometry message
+   */
+  void highRateOdometryCallback(const nav_msgs::msg::Odometry & msg);
+
+  /**
+   * @brief Callback for the raw IMU messages of the high-rate output
+   * @param[in] msg The raw IMU message
+   */
+  void highRateImuCallback(const sensor_msgs::msg::Imu & msg);
+
+  /**
+   * @brief Integrate the latest raw velocities from the latest optimized state up to the given
+   *        stamp, and publish the result
+   * @param[in] stamp The stamp of the latest raw velocities
+   */
+  void integrateAndPublish(const rclcpp::Time & stamp);
+
   /**
    * @brief Object that searches for the most recent common timestamp for a set of variables
    */
@@ -248,6 +299,31 @@ protected:
                       //!< notifyCallback and publishTimerCallback methods:
                       //!<   latest_stamp_, latest_covariance_stamp_, odom_output_ and
                       //!<   acceleration_output_
+
+  /**
+   * @brief An optimized state, as published
+   */
+  struct OptimizedState
+  {
+    nav_msgs::msg::Odometry odometry;
+    geometry_msgs::msg::AccelWithCovarianceStamped acceleration;
+  };
+
+  //!< The latest optimized state, only accessed with std::atomic_load and std::atomic_store
+  std::shared_ptr<const OptimizedState> latest_state_;
+
+  //!< The optimized state the high-rate output is integrated from
+  std::shared_ptr<const OptimizedState> integrated_state_;
+  std::unique_ptr<common::OdometryIntegrator> integrator_;  //!< The high-rate output integrator
+  tf2_2d::Vector2 velocity_linear_;  //!< The latest raw linear velocity
+  double velocity_angular_ {0.0};  //!< The latest raw angular velocity
+
+  rclcpp::CallbackGroup::SharedPtr high_rate_cb_group_;  //!< The high-rate output callback group
+  rclcpp::Executor::SharedPtr high_rate_executor_;  //!< The high-rate output executor
+  std::thread high_rate_spinner_;  //!< The thread spinning the high-rate output executor
+
+  rclcpp::Subscription<nav_msgs::msg::Odometry>::SharedPtr high_rate_odom_sub_;
+  rclcpp::Subscription<sensor_msgs::msg::Imu>::SharedPtr high_rate_imu_sub_;
 };
 
 }  // namespace fuse_models
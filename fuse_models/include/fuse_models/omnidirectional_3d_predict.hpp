@@ -0,0 +1,246 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2018, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef FUSE_MODELS__OMNIDIRECTIONAL_3D_PREDICT_HPP_
+#define FUSE_MODELS__OMNIDIRECTIONAL_3D_PREDICT_HPP_
+
+#include <ceres/rotation.h>
+#include <Eigen/Core>
+
+#include <fuse_core/eigen.hpp>
+#include <fuse_core/util.hpp>
+
+
+namespace fuse_models
+{
+
+/**
+ * @brief Given a 3D state and time delta, predicts a new 3D state
+ *
+ * The linear velocity, angular velocity and linear acceleration are expressed in the body frame,
+ * and they are constant across \p dt, so the predicted position is:
+ *
+ *   position2 = position1 + orientation1 * (vel_linear1 * dt + 0.5 * acc_linear1 * dt^2)
+ *
+ * and the predicted orientation is orientation1 * AngleAxis(vel_angular1 * dt).
+ *
+ * @param[in] position1 - First position (array with x at index 0, y at index 1, z at index 2)
+ * @param[in] orientation1 - First orientation (quaternion array with w at index 0, x at index 1, y
+ *                           at index 2, z at index 3)
+ * @param[in] vel_linear1 - First linear velocity (array with x at index 0, y at index 1, z at
+ *                          index 2)
+ * @param[in] vel_angular1 - First angular velocity (array with roll rate at index 0, pitch rate at
+ *                           index 1, yaw rate at index 2)
+ * @param[in] acc_linear1 - First linear acceleration (array with x at index 0, y at index 1, z at
+ *                          index 2)
+ * @param[in] dt - The time delta across which to predict the state
+ * @param[out] position2 - Second position (array with x at index 0, y at index 1, z at index 2)
+ * @param[out] orientation2 - Second orientation (quaternion array with w at index 0, x at index 1,
+ *                            y at index 2, z at index 3)
+ * @param[out] vel_linear2 - Second linear velocity (array with x at index 0, y at index 1, z at
+ *                           index 2)
+ * @param[out] vel_angular2 - Second angular velocity (array with roll rate at index 0, pitch rate
+ *                            at index 1, yaw rate at index 2)
+ * @param[out] acc_linear2 - Second linear acceleration (array with x at index 0, y at index 1, z at
+ *                           index 2)
+ */
+template<typename T>
+inline void predictOmnidirectional3D(
+  const T * const position1,
+  const T * const orientation1,
+  const T * const vel_linear1,
+  const T * const vel_angular1,
+  const T * const acc_linear1,
+  const T dt,
+  T * const position2,
+  T * const orientation2,
+  T * const vel_linear2,
+  T * const vel_angular2,
+  T * const acc_linear2)
+{
+  const T half_dt2 = T(0.5) * dt * dt;
+  const T delta_position[3] =
+  {
+    vel_linear1[0] * dt + acc_linear1[0] * half_dt2,
+    vel_linear1[1] * dt + acc_linear1[1] * half_dt2,
+    vel_linear1[2] * dt + acc_linear1[2] * half_dt2
+  };
+  T delta_position_rotated[3];
+  ceres::QuaternionRotatePoint(orientation1, delta_position, delta_position_rotated);
+
+  const T delta_angle_axis[3] = {vel_angular1[0] * dt, vel_angular1[1] * dt, vel_angular1[2] * dt};
+  T delta_orientation[4];
+  ceres::AngleAxisToQuaternion(delta_angle_axis, delta_orientation);
+
+  // Use a temporary, so the orientation can be updated in place
+  T orientation_pred[4];
+  ceres::QuaternionProduct(orientation1, delta_orientation, orientation_pred);
+  for (size_t i = 0; i < 4; ++i) {
+    orientation2[i] = orientation_pred[i];
+  }
+  for (size_t i = 0; i < 3; ++i) {
+    position2[i] = position1[i] + delta_position_rotated[i];
+    vel_linear2[i] = vel_linear1[i] + acc_linear1[i] * dt;
+    vel_angular2[i] = vel_angular1[i];
+    acc_linear2[i] = acc_linear1[i];
+  }
+}
+
+/**
+ * @brief Given a 3D state and time delta, predicts a new 3D state, and optionally computes the
+ *        Jacobians of the new state with respect to the first state
+ *
+ * The Jacobians have 16 rows, one per predicted state component in order (position: 3,
+ * orientation: 4, vel_linear: 3, vel_angular: 3, acc_linear: 3), and one column per component of
+ * the first state parameter block they are computed for. The orientation derivatives are taken with
+ * respect to the raw quaternion components.
+ *
+ * @param[in] position1 - First position (array with x at index 0, y at index 1, z at index 2)
+ * @param[in] orientation1 - First orientation (quaternion array with w at index 0, x at index 1, y
+ *                           at index 2, z at index 3)
+ * @param[in] vel_linear1 - First linear velocity (array with x at index 0, y at index 1, z at
+ *                          index 2)
+ * @param[in] vel_angular1 - First angular velocity (array with roll rate at index 0, pitch rate at
+ *                           index 1, yaw rate at index 2)
+ * @param[in] acc_linear1 - First linear acceleration (array with x at index 0, y at index 1, z at
+ *                          index 2)
+ * @param[in] dt - The time delta across which to predict the state
+ * @param[out] position2 - Second position (array with x at index 0, y at index 1, z at index 2)
+ * @param[out] orientation2 - Second orientation (quaternion array with w at index 0, x at index 1,
+ *                            y at index 2, z at index 3)
+ * @param[out] vel_linear2 - Second linear velocity (array with x at index 0, y at index 1, z at
+ *                           index 2)
+ * @param[out] vel_angular2 - Second angular velocity (array with roll rate at index 0, pitch rate
+ *                            at index 1, yaw rate at index 2)
+ * @param[out] acc_linear2 - Second linear acceleration (array with x at index 0, y at index 1, z at
+ *                           index 2)
+ * @param[out] jacobians - Row-major jacobians wrt the first state (position1, orientation1,
+ *                         vel_linear1, vel_angular1, acc_linear1). Only computed if not NULL, and
+ *                         only computed for the parameters where jacobians[i] is not NULL.
+ */
+inline void predictOmnidirectional3D(
+  const double * const position1,
+  const double * const orientation1,
+  const double * const vel_linear1,
+  const double * const vel_angular1,
+  const double * const acc_linear1,
+  const double dt,
+  double * const position2,
+  double * const orientation2,
+  double * const vel_linear2,
+  double * const vel_angular2,
+  double * const acc_linear2,
+  double ** jacobians)
+{
+  const Eigen::Map<const fuse_core::Vector3d> vel_linear1_map(vel_linear1);
+  const Eigen::Map<const fuse_core::Vector3d> vel_angular1_map(vel_angular1);
+  const Eigen::Map<const fuse_core::Vector3d> acc_linear1_map(acc_linear1);
+
+  const bool orientation1_jacobian = jacobians && jacobians[1];
+  const bool vel_angular1_jacobian = jacobians && jacobians[3];
+
+  const double half_dt2 = 0.5 * dt * dt;
+  const fuse_core::Vector3d delta_position = vel_linear1_map * dt + acc_linear1_map * half_dt2;
+  fuse_core::Matrix3d rotation;
+  fuse_core::Matrix<double, 3, 4> rotation_jacobian;
+  Eigen::Map<fuse_core::Vector3d> position2_map(position2);
+  position2_map = Eigen::Map<const fuse_core::Vector3d>(position1) +
+    fuse_core::quaternionRotatePoint(
+    orientation1, delta_position, rotation,
+    orientation1_jacobian ? &rotation_jacobian : nullptr);
+
+  const fuse_core::Vector3d delta_angle_axis = vel_angular1_map * dt;
+  fuse_core::Vector4d delta_orientation;
+  fuse_core::Matrix<double, 4, 3> delta_orientation_jacobian;
+  fuse_core::angleAxisToQuaternion(
+    delta_angle_axis.data(), delta_orientation.data(),
+    vel_angular1_jacobian ? delta_orientation_jacobian.data() : nullptr);
+
+  const fuse_core::Matrix4d orientation1_product =
+    fuse_core::quaternionLeftProductMatrix(orientation1);
+  Eigen::Map<fuse_core::Vector4d> orientation2_map(orientation2);
+  orientation2_map = orientation1_product * delta_orientation;
+
+  Eigen::Map<fuse_core::Vector3d> vel_linear2_map(vel_linear2);
+  Eigen::Map<fuse_core::Vector3d> vel_angular2_map(vel_angular2);
+  Eigen::Map<fuse_core::Vector3d> acc_linear2_map(acc_linear2);
+  vel_linear2_map = vel_linear1_map + acc_linear1_map * dt;
+  vel_angular2_map = vel_angular1_map;
+  acc_linear2_map = acc_linear1_map;
+
+  if (jacobians) {
+    // Jacobian wrt position1
+    if (jacobians[0]) {
+      Eigen::Map<fuse_core::Matrix<double, 16, 3>> jacobian(jacobians[0]);
+      jacobian.setZero();
+      jacobian.topRows<3>().setIdentity();
+    }
+
+    // Jacobian wrt orientation1
+    if (orientation1_jacobian) {
+      Eigen::Map<fuse_core::Matrix<double, 16, 4>> jacobian(jacobians[1]);
+      jacobian.setZero();
+      jacobian.topRows<3>() = rotation_jacobian;
+      jacobian.middleRows<4>(3) = fuse_core::quaternionRightProductMatrix(delta_orientation.data());
+    }
+
+    // Jacobian wrt vel_linear1
+    if (jacobians[2]) {
+      Eigen::Map<fuse_core::Matrix<double, 16, 3>> jacobian(jacobians[2]);
+      jacobian.setZero();
+      jacobian.topRows<3>() = rotation * dt;
+      jacobian.middleRows<3>(7).setIdentity();
+    }
+
+    // Jacobian wrt vel_angular1
+    if (vel_angular1_jacobian) {
+      Eigen::Map<fuse_core::Matrix<double, 16, 3>> jacobian(jacobians[3]);
+      jacobian.setZero();
+      jacobian.middleRows<4>(3) = (orientation1_product * delta_orientation_jacobian) * dt;
+      jacobian.middleRows<3>(10).setIdentity();
+    }
+
+    // Jacobian wrt acc_linear1
+    if (jacobians[4]) {
+      Eigen::Map<fuse_core::Matrix<double, 16, 3>> jacobian(jacobians[4]);
+      jacobian.setZero();
+      jacobian.topRows<3>() = rotation * half_dt2;
+      jacobian.middleRows<3>(7) = fuse_core::Matrix3d::Identity() * dt;
+      jacobian.bottomRows<3>().setIdentity();
+    }
+  }
+}
+
+}  // namespace fuse_models
+
+#endif  // FUSE_MODELS__OMNIDIRECTIONAL_3D_PREDICT_HPP_
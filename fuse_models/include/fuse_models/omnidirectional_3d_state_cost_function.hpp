@@ -0,0 +1,287 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2018, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef FUSE_MODELS__OMNIDIRECTIONAL_3D_STATE_COST_FUNCTION_HPP_
+#define FUSE_MODELS__OMNIDIRECTIONAL_3D_STATE_COST_FUNCTION_HPP_
+
+#include <ceres/sized_cost_function.h>
+
+#include <fuse_models/omnidirectional_3d_predict.hpp>
+
+#include <fuse_core/eigen.hpp>
+#include <fuse_core/fuse_macros.hpp>
+#include <fuse_core/util.hpp>
+
+
+namespace fuse_models
+{
+
+/**
+ * @brief Create a cost function for a 3D state vector
+ *
+ * The state vector includes the following quantities, given in this order:
+ *   x, y and z position
+ *   orientation quaternion (w, x, y, z)
+ *   x, y and z linear velocity
+ *   roll, pitch and yaw velocity
+ *   x, y and z linear acceleration
+ *
+ * The cost function is of the form:
+ *
+ *             ||    [         position_t2 - proj(position_t1)          ] ||^2
+ *   cost(x) = ||    [ AngleAxis(proj(orientation_t1)^-1 * orientation_t2) ] ||
+ *             ||A * [       vel_linear_t2 - proj(vel_linear_t1)        ] ||
+ *             ||    [      vel_angular_t2 - proj(vel_angular_t1)       ] ||
+ *             ||    [       acc_linear_t2 - proj(acc_linear_t1)        ] ||
+ *
+ * where, the matrix A is fixed, the state variables are provided at two discrete time steps, and
+ * proj is the predictOmnidirectional3D() function that projects the state variables from time t1
+ * to time t2. In case the user is interested in implementing a cost function of the form
+ *
+ *   cost(X) = (X - mu)^T S^{-1} (X - mu)
+ *
+ * where, mu is a vector and S is a covariance matrix, then, A = S^{-1/2}, i.e the matrix A is the
+ * square root information matrix (the inverse of the covariance).
+ *
+ * The Jacobians are computed analytically, with respect to the raw quaternion components, and they
+ * are equal to the ones automatic differentiation computes for the
+ * Omnidirectional3DStateCostFunctor.
+ */
+class Omnidirectional3DStateCostFunction
+  : public ceres::SizedCostFunction<15, 3, 4, 3, 3, 3, 3, 4, 3, 3, 3>
+{
+public:
+  FUSE_MAKE_ALIGNED_OPERATOR_NEW()
+
+  /**
+   * @brief Construct a cost function instance
+   *
+   * @param[in] dt The time delta across which to generate the kinematic model cost
+   * @param[in] A The residual weighting matrix, most likely the square root information matrix in
+   *              order (x, y, z, roll, pitch, yaw, x_vel, y_vel, z_vel, roll_vel, pitch_vel,
+   *              yaw_vel, x_acc, y_acc, z_acc)
+   */
+  Omnidirectional3DStateCostFunction(const double dt, const fuse_core::Matrix<double, 15, 15> & A);
+
+  /**
+   * @brief Evaluate the cost function. Used by the Ceres optimization engine.
+   *
+   * @param[in] parameters - Parameter blocks:
+   *                         0 : position1 - First position (x, y, z)
+   *                         1 : orientation1 - First orientation (w, x, y, z)
+   *                         2 : vel_linear1 - First linear velocity (x, y, z)
+   *                         3 : vel_angular1 - First angular velocity (roll, pitch, yaw)
+   *                         4 : acc_linear1 - First linear acceleration (x, y, z)
+   *                         5 : position2 - Second position (x, y, z)
+   *                         6 : orientation2 - Second orientation (w, x, y, z)
+   *                         7 : vel_linear2 - Second linear velocity (x, y, z)
+   *                         8 : vel_angular2 - Second angular velocity (roll, pitch, yaw)
+   *                         9 : acc_linear2 - Second linear acceleration (x, y, z)
+   * @param[out] residual - The computed residual (error)
+   * @param[out] jacobians - Jacobians of the residuals wrt the parameters. Only computed if not
+   *                         NULL, and only computed for the parameters where jacobians[i] is not
+   *                         NULL.
+   * @return The return value indicates whether the computation of the residuals and/or jacobians
+   *         was successful or not.
+   */
+  bool Evaluate(
+    double const * const * parameters,
+    double * residuals,
+    double ** jacobians) const override
+  {
+    const bool state1_jacobians = jacobians &&
+      (jacobians[0] || jacobians[1] || jacobians[2] || jacobians[3] || jacobians[4]);
+
+    // The Jacobians of the predicted state, with 16 rows because the predicted orientation is a
+    // quaternion. Fixed-size blocks keep this free of heap allocations.
+    fuse_core::Matrix<double, 16, 3> J_position1;
+    fuse_core::Matrix<double, 16, 4> J_orientation1;
+    fuse_core::Matrix<double, 16, 3> J_vel_linear1;
+    fuse_core::Matrix<double, 16, 3> J_vel_angular1;
+    fuse_core::Matrix<double, 16, 3> J_acc_linear1;
+    double * predict_jacobians[] =
+    {
+      (jacobians && jacobians[0]) ? J_position1.data() : nullptr,
+      (jacobians && jacobians[1]) ? J_orientation1.data() : nullptr,
+      (jacobians && jacobians[2]) ? J_vel_linear1.data() : nullptr,
+      (jacobians && jacobians[3]) ? J_vel_angular1.data() : nullptr,
+      (jacobians && jacobians[4]) ? J_acc_linear1.data() : nullptr
+    };
+
+    double position_pred[3];
+    double orientation_pred[4];
+    double vel_linear_pred[3];
+    double vel_angular_pred[3];
+    double acc_linear_pred[3];
+    predictOmnidirectional3D(
+      parameters[0],  // position1
+      parameters[1],  // orientation1
+      parameters[2],  // vel_linear1
+      parameters[3],  // vel_angular1
+      parameters[4],  // acc_linear1
+      dt_,
+      position_pred,
+      orientation_pred,
+      vel_linear_pred,
+      vel_angular_pred,
+      acc_linear_pred,
+      state1_jacobians ? predict_jacobians : nullptr);
+
+    // The orientation error is orientation_pred^-1 * orientation2
+    const double orientation_pred_inverse[4] =
+    {
+      orientation_pred[0],
+      -orientation_pred[1],
+      -orientation_pred[2],
+      -orientation_pred[3]
+    };
+    const fuse_core::Matrix4d orientation_pred_inverse_product =
+      fuse_core::quaternionLeftProductMatrix(orientation_pred_inverse);
+    const fuse_core::Vector4d orientation_error =
+      orientation_pred_inverse_product * Eigen::Map<const fuse_core::Vector4d>(parameters[6]);
+
+    Eigen::Matrix<double, 15, 1> full_residuals;
+    fuse_core::Matrix<double, 3, 4> angle_axis_jacobian;
+    for (size_t i = 0; i < 3; ++i) {
+      full_residuals(i) = parameters[5][i] - position_pred[i];
+      full_residuals(6 + i) = parameters[7][i] - vel_linear_pred[i];
+      full_residuals(9 + i) = parameters[8][i] - vel_angular_pred[i];
+      full_residuals(12 + i) = parameters[9][i] - acc_linear_pred[i];
+    }
+    fuse_core::quaternionToAngleAxis(
+      orientation_error.data(), full_residuals.data() + 3,
+      (state1_jacobians || (jacobians && jacobians[6])) ? angle_axis_jacobian.data() : nullptr);
+
+    // Scale the residuals by the square root information matrix to account for
+    // the measurement uncertainty.
+    Eigen::Map<Eigen::Matrix<double, 15, 1>> residuals_map(residuals);
+    residuals_map = A_ * full_residuals;
+
+    if (!jacobians) {
+      return true;
+    }
+
+    if (state1_jacobians) {
+      // Chain the Jacobians of the predicted state with the derivative of the weighted residuals
+      // wrt the predicted state. Inverting the predicted orientation negates its imaginary
+      // components.
+      fuse_core::Matrix<double, 3, 4> J_orientation_pred =
+        angle_axis_jacobian * fuse_core::quaternionRightProductMatrix(parameters[6]);
+      J_orientation_pred.rightCols<3>() *= -1.0;
+
+      fuse_core::Matrix<double, 15, 16> J_pred;
+      J_pred.leftCols<3>() = -A_.leftCols<3>();
+      J_pred.middleCols<4>(3) = A_.middleCols<3>(3) * J_orientation_pred;
+      J_pred.rightCols<9>() = -A_.rightCols<9>();
+
+      // Update jacobian wrt position1
+      if (jacobians[0]) {
+        Eigen::Map<fuse_core::Matrix<double, 15, 3>> jacobian(jacobians[0]);
+        jacobian = J_pred * J_position1;
+      }
+
+      // Update jacobian wrt orientation1
+      if (jacobians[1]) {
+        Eigen::Map<fuse_core::Matrix<double, 15, 4>> jacobian(jacobians[1]);
+        jacobian = J_pred * J_orientation1;
+      }
+
+      // Update jacobian wrt vel_linear1
+      if (jacobians[2]) {
+        Eigen::Map<fuse_core::Matrix<double, 15, 3>> jacobian(jacobians[2]);
+        jacobian = J_pred * J_vel_linear1;
+      }
+
+      // Update jacobian wrt vel_angular1
+      if (jacobians[3]) {
+        Eigen::Map<fuse_core::Matrix<double, 15, 3>> jacobian(jacobians[3]);
+        jacobian = J_pred * J_vel_angular1;
+      }
+
+      // Update jacobian wrt acc_linear1
+      if (jacobians[4]) {
+        Eigen::Map<fuse_core::Matrix<double, 15, 3>> jacobian(jacobians[4]);
+        jacobian = J_pred * J_acc_linear1;
+      }
+    }
+
+    // Jacobian wrt position2
+    if (jacobians[5]) {
+      Eigen::Map<fuse_core::Matrix<double, 15, 3>> jacobian(jacobians[5]);
+      jacobian = A_.leftCols<3>();
+    }
+
+    // Jacobian wrt orientation2
+    if (jacobians[6]) {
+      Eigen::Map<fuse_core::Matrix<double, 15, 4>> jacobian(jacobians[6]);
+      jacobian = A_.middleCols<3>(3) * angle_axis_jacobian * orientation_pred_inverse_product;
+    }
+
+    // Jacobian wrt vel_linear2
+    if (jacobians[7]) {
+      Eigen::Map<fuse_core::Matrix<double, 15, 3>> jacobian(jacobians[7]);
+      jacobian = A_.middleCols<3>(6);
+    }
+
+    // Jacobian wrt vel_angular2
+    if (jacobians[8]) {
+      Eigen::Map<fuse_core::Matrix<double, 15, 3>> jacobian(jacobians[8]);
+      jacobian = A_.middleCols<3>(9);
+    }
+
+    // Jacobian wrt acc_linear2
+    if (jacobians[9]) {
+      Eigen::Map<fuse_core::Matrix<double, 15, 3>> jacobian(jacobians[9]);
+      jacobian = A_.rightCols<3>();
+    }
+
+    return true;
+  }
+
+private:
+  double dt_;
+  fuse_core::Matrix<double, 15, 15> A_;  //!< The residual weighting matrix, most likely the square
+                                         //!< root information matrix
+};
+
+inline Omnidirectional3DStateCostFunction::Omnidirectional3DStateCostFunction(
+  const double dt,
+  const fuse_core::Matrix<double, 15, 15> & A)
+: dt_(dt),
+  A_(A)
+{
+}
+
+}  // namespace fuse_models
+
+#endif  // FUSE_MODELS__OMNIDIRECTIONAL_3D_STATE_COST_FUNCTION_HPP_
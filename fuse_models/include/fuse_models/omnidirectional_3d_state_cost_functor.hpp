@@ -0,0 +1,191 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2018, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef FUSE_MODELS__OMNIDIRECTIONAL_3D_STATE_COST_FUNCTOR_HPP_
+#define FUSE_MODELS__OMNIDIRECTIONAL_3D_STATE_COST_FUNCTOR_HPP_
+
+#include <ceres/rotation.h>
+
+#include <fuse_models/omnidirectional_3d_predict.hpp>
+
+#include <fuse_core/eigen.hpp>
+#include <fuse_core/fuse_macros.hpp>
+
+
+namespace fuse_models
+{
+
+/**
+ * @brief Create a cost function for a 3D state vector
+ *
+ * This computes the same residuals as the Omnidirectional3DStateCostFunction, but it is meant to be
+ * used with automatic differentiation, mostly to validate the analytic Jacobians of the cost
+ * function.
+ *
+ * The state vector includes the following quantities, given in this order:
+ *   x, y and z position
+ *   orientation quaternion (w, x, y, z)
+ *   x, y and z linear velocity
+ *   roll, pitch and yaw velocity
+ *   x, y and z linear acceleration
+ *
+ * The cost function is of the form:
+ *
+ *             ||    [         position_t2 - proj(position_t1)          ] ||^2
+ *   cost(x) = ||    [ AngleAxis(proj(orientation_t1)^-1 * orientation_t2) ] ||
+ *             ||A * [       vel_linear_t2 - proj(vel_linear_t1)        ] ||
+ *             ||    [      vel_angular_t2 - proj(vel_angular_t1)       ] ||
+ *             ||    [       acc_linear_t2 - proj(acc_linear_t1)        ] ||
+ *
+ * where, the matrix A is fixed, the state variables are provided at two discrete time steps, and
+ * proj is the predictOmnidirectional3D() function that projects the state variables from time t1
+ * to time t2.
+ */
+class Omnidirectional3DStateCostFunctor
+{
+public:
+  FUSE_MAKE_ALIGNED_OPERATOR_NEW()
+
+  /**
+   * @brief Construct a cost function instance
+   *
+   * @param[in] dt The time delta across which to generate the kinematic model cost
+   * @param[in] A The residual weighting matrix, most likely the square root information matrix in
+   *              order (x, y, z, roll, pitch, yaw, x_vel, y_vel, z_vel, roll_vel, pitch_vel,
+   *              yaw_vel, x_acc, y_acc, z_acc)
+   */
+  Omnidirectional3DStateCostFunctor(const double dt, const fuse_core::Matrix<double, 15, 15> & A);
+
+  /**
+   * @brief Evaluate the cost function. Used by the Ceres optimization engine.
+   * @param[in] position1 - First position (x, y, z)
+   * @param[in] orientation1 - First orientation (w, x, y, z)
+   * @param[in] vel_linear1 - First linear velocity (x, y, z)
+   * @param[in] vel_angular1 - First angular velocity (roll, pitch, yaw)
+   * @param[in] acc_linear1 - First linear acceleration (x, y, z)
+   * @param[in] position2 - Second position (x, y, z)
+   * @param[in] orientation2 - Second orientation (w, x, y, z)
+   * @param[in] vel_linear2 - Second linear velocity (x, y, z)
+   * @param[in] vel_angular2 - Second angular velocity (roll, pitch, yaw)
+   * @param[in] acc_linear2 - Second linear acceleration (x, y, z)
+   * @param[out] residual - The computed residual (error)
+   */
+  template<typename T>
+  bool operator()(
+    const T * const position1,
+    const T * const orientation1,
+    const T * const vel_linear1,
+    const T * const vel_angular1,
+    const T * const acc_linear1,
+    const T * const position2,
+    const T * const orientation2,
+    const T * const vel_linear2,
+    const T * const vel_angular2,
+    const T * const acc_linear2,
+    T * residual) const;
+
+private:
+  double dt_;
+  fuse_core::Matrix<double, 15, 15> A_;  //!< The residual weighting matrix, most likely the square
+                                         //!< root information matrix
+};
+
+inline Omnidirectional3DStateCostFunctor::Omnidirectional3DStateCostFunctor(
+  const double dt,
+  const fuse_core::Matrix<double, 15, 15> & A)
+: dt_(dt),
+  A_(A)
+{
+}
+
+template<typename T>
+bool Omnidirectional3DStateCostFunctor::operator()(
+  const T * const position1,
+  const T * const orientation1,
+  const T * const vel_linear1,
+  const T * const vel_angular1,
+  const T * const acc_linear1,
+  const T * const position2,
+  const T * const orientation2,
+  const T * const vel_linear2,
+  const T * const vel_angular2,
+  const T * const acc_linear2,
+  T * residual) const
+{
+  T position_pred[3];
+  T orientation_pred[4];
+  T vel_linear_pred[3];
+  T vel_angular_pred[3];
+  T acc_linear_pred[3];
+  predictOmnidirectional3D(
+    position1,
+    orientation1,
+    vel_linear1,
+    vel_angular1,
+    acc_linear1,
+    T(dt_),
+    position_pred,
+    orientation_pred,
+    vel_linear_pred,
+    vel_angular_pred,
+    acc_linear_pred);
+
+  const T orientation_pred_inverse[4] =
+  {
+    orientation_pred[0],
+    -orientation_pred[1],
+    -orientation_pred[2],
+    -orientation_pred[3]
+  };
+  T orientation_error[4];
+  ceres::QuaternionProduct(orientation_pred_inverse, orientation2, orientation_error);
+
+  Eigen::Map<Eigen::Matrix<T, 15, 1>> residuals_map(residual);
+  ceres::QuaternionToAngleAxis(orientation_error, residual + 3);
+  for (size_t i = 0; i < 3; ++i) {
+    residuals_map(i) = position2[i] - position_pred[i];
+    residuals_map(6 + i) = vel_linear2[i] - vel_linear_pred[i];
+    residuals_map(9 + i) = vel_angular2[i] - vel_angular_pred[i];
+    residuals_map(12 + i) = acc_linear2[i] - acc_linear_pred[i];
+  }
+
+  // Scale the residuals by the square root information matrix to account for
+  // the measurement uncertainty.
+  residuals_map.applyOnTheLeft(A_.template cast<T>());
+
+  return true;
+}
+
+}  // namespace fuse_models
+
+#endif  // FUSE_MODELS__OMNIDIRECTIONAL_3D_STATE_COST_FUNCTOR_HPP_
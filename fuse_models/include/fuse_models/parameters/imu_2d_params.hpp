@@ -112,6 +112,18 @@ public:
         ns,
         "throttle_use_wall_time"),
       throttle_use_wall_time);
+    throttle_aggregate =
+      fuse_core::getParam(
+      interfaces, fuse_core::joinParameterName(
+        ns,
+        "throttle_aggregate"),
+      throttle_aggregate);
+    cache_static_transforms =
+      fuse_core::getParam(
+      interfaces, fuse_core::joinParameterName(
+        ns,
+        "cache_static_transforms"),
+      cache_static_transforms);
 
     remove_gravitational_acceleration = fuse_core::getParam(
       interfaces, fuse_core::joinParameterName(
@@ -194,6 +206,12 @@ public:
                                        //!< available
   rclcpp::Duration throttle_period {0, 0};  //!< The throttle period duration in seconds
   bool throttle_use_wall_time {false};      //!< Whether to throttle using ros::WallTime or not
+  bool throttle_aggregate {false};  //!< Whether to combine the angular velocities and linear
+                                    //!< accelerations of the throttled messages into the kept ones
+                                    //!< instead of dropping them. The orientation of the newest
+                                    //!< message is used as is.
+  bool cache_static_transforms {false};  //!< Whether to cache the transforms between frames only
+                                        //!< connected by static transforms
   double gravitational_acceleration {9.80665};
   std::string acceleration_target_frame {};
   std::string orientation_target_frame {};
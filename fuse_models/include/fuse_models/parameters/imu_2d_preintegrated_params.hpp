@@ -0,0 +1,124 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2019, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef FUSE_MODELS__PARAMETERS__IMU_2D_PREINTEGRATED_PARAMS_HPP_
+#define FUSE_MODELS__PARAMETERS__IMU_2D_PREINTEGRATED_PARAMS_HPP_
+
+#include <string>
+
+#include <fuse_models/parameters/parameter_base.hpp>
+
+#include <fuse_core/eigen.hpp>
+#include <fuse_core/loss.hpp>
+#include <fuse_core/parameter.hpp>
+
+
+namespace fuse_models
+{
+
+namespace parameters
+{
+
+/**
+ * @brief Defines the set of parameters required by the Imu2DPreintegrated class
+ */
+struct Imu2DPreintegratedParams : public ParameterBase
+{
+public:
+  /**
+   * @brief Method for loading parameter values from ROS.
+   *
+   * @param[in] interfaces - The node interfaces with which to load parameters
+   * @param[in] ns - The parameter namespace to use
+   */
+  void loadFromROS(
+    fuse_core::node_interfaces::NodeInterfaces<
+      fuse_core::node_interfaces::Base,
+      fuse_core::node_interfaces::Logging,
+      fuse_core::node_interfaces::Parameters
+    > interfaces,
+    const std::string & ns)
+  {
+    queue_size = fuse_core::getParam(
+      interfaces, fuse_core::joinParameterName(
+        ns,
+        "queue_size"),
+      queue_size);
+    fuse_core::getParamRequired(interfaces, fuse_core::joinParameterName(ns, "topic"), topic);
+
+    fuse_core::getPositiveParam(
+      interfaces, fuse_core::joinParameterName(ns, "preintegration_period"),
+      preintegration_period);
+
+    fuse_core::getPositiveParam(
+      interfaces, fuse_core::joinParameterName(ns, "gyroscope_noise_density"),
+      gyroscope_noise_density);
+    fuse_core::getPositiveParam(
+      interfaces, fuse_core::joinParameterName(ns, "accelerometer_noise_density"),
+      accelerometer_noise_density);
+    fuse_core::getPositiveParam(
+      interfaces, fuse_core::joinParameterName(ns, "gyroscope_bias_random_walk"),
+      gyroscope_bias_random_walk);
+    fuse_core::getPositiveParam(
+      interfaces, fuse_core::joinParameterName(ns, "accelerometer_bias_random_walk"),
+      accelerometer_bias_random_walk);
+
+    initial_bias_covariance =
+      fuse_core::getCovarianceDiagonalParam<3>(
+      interfaces,
+      fuse_core::joinParameterName(ns, "initial_bias_covariance_diagonal"), 1.0e-2);
+
+    loss = fuse_core::loadLossConfig(interfaces, fuse_core::joinParameterName(ns, "loss"));
+  }
+
+  int queue_size {10};
+  std::string topic {};
+  rclcpp::Duration preintegration_period {0, 100000000};  //!< The time between two consecutive
+                                                          //!< preintegrated constraints
+  double gyroscope_noise_density {1.0e-3};  //!< The gyroscope white noise, in rad/s/sqrt(Hz)
+  double accelerometer_noise_density {1.0e-2};  //!< The accelerometer white noise, in
+                                                //!< m/s^2/sqrt(Hz)
+  double gyroscope_bias_random_walk {1.0e-4};  //!< The gyroscope bias random walk, in
+                                               //!< rad/s^2/sqrt(Hz)
+  double accelerometer_bias_random_walk {1.0e-3};  //!< The accelerometer bias random walk, in
+                                                   //!< m/s^3/sqrt(Hz)
+  fuse_core::Matrix3d initial_bias_covariance;  //!< The covariance of the prior on the first
+                                                //!< biases, in order (yaw_vel, x_acc, y_acc)
+  fuse_core::Loss::SharedPtr loss;
+};
+
+}  // namespace parameters
+
+}  // namespace fuse_models
+
+#endif  // FUSE_MODELS__PARAMETERS__IMU_2D_PREINTEGRATED_PARAMS_HPP_
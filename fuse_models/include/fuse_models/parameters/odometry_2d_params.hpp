@@ -39,6 +39,7 @@
 
 #include <fuse_models/parameters/parameter_base.hpp>
 
+#include <fuse_core/eigen.hpp>
 #include <fuse_core/loss.hpp>
 #include <fuse_core/parameter.hpp>
 #include <fuse_variables/orientation_2d_stamped.hpp>
@@ -125,6 +126,35 @@ public:
         ns,
         "throttle_use_wall_time"),
       throttle_use_wall_time);
+    throttle_aggregate =
+      fuse_core::getParam(
+      interfaces, fuse_core::joinParameterName(
+        ns,
+        "throttle_aggregate"),
+      throttle_aggregate);
+    cache_static_transforms =
+      fuse_core::getParam(
+      interfaces, fuse_core::joinParameterName(
+        ns,
+        "cache_static_transforms"),
+      cache_static_transforms);
+    fuse_core::getPositiveParam(
+      interfaces, fuse_core::joinParameterName(
+        ns,
+        "mahalanobis_threshold"), mahalanobis_threshold,
+      false);
+    mahalanobis_pose_noise_rate = fuse_core::getCovarianceDiagonalParam<3>(
+      interfaces, fuse_core::joinParameterName(ns, "mahalanobis_pose_noise_rate_diagonal"),
+      1.0e-2);
+    mahalanobis_twist_noise_rate = fuse_core::getCovarianceDiagonalParam<3>(
+      interfaces, fuse_core::joinParameterName(ns, "mahalanobis_twist_noise_rate_diagonal"),
+      1.0e-2);
+    mahalanobis_max_rejections =
+      fuse_core::getParam(
+      interfaces, fuse_core::joinParameterName(
+        ns,
+        "mahalanobis_max_rejections"),
+      mahalanobis_max_rejections);
 
     fuse_core::getParamRequired(interfaces, fuse_core::joinParameterName(ns, "topic"), topic);
 
@@ -192,6 +222,25 @@ public:
                                        //!< available
   rclcpp::Duration throttle_period {0, 0};  //!< The throttle period duration in seconds
   bool throttle_use_wall_time {false};      //!< Whether to throttle using ros::WallTime or not
+  bool throttle_aggregate {false};  //!< Whether to combine the twists of the throttled messages
+                                    //!< into the kept ones instead of dropping them. The pose of
+                                    //!< the newest message is used as is.
+  bool cache_static_transforms {false};  //!< Whether to cache the transforms between frames only
+                                        //!< connected by static transforms
+  double mahalanobis_threshold {0.0};  //!< The maximum squared Mahalanobis distance between an
+                                       //!< absolute measurement and the latest graph estimate, or
+                                       //!< zero to disable the gate
+  fuse_core::Matrix3d mahalanobis_pose_noise_rate;  //!< The covariance added to the pose
+                                                    //!< estimate per second until the
+                                                    //!< measurement stamp, for the error of
+                                                    //!< its prediction. Defaults to 0.01.
+  fuse_core::Matrix3d mahalanobis_twist_noise_rate;  //!< The covariance added to the twist
+                                                     //!< estimate per second until the
+                                                     //!< measurement stamp, for the error of
+                                                     //!< its prediction. Defaults to 0.01.
+  int mahalanobis_max_rejections {10};  //!< The consecutive rejections after which the gate
+                                        //!< accepts a measurement anyway, or zero to never
+                                        //!< force it
   std::string topic {};
   std::string pose_target_frame {};
   std::string twist_target_frame {};
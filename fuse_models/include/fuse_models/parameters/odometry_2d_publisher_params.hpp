@@ -206,6 +206,23 @@ public:
         "acceleration_topic"),
       acceleration_topic);
 
+    high_rate_odometry_topic =
+      fuse_core::getParam(
+      interfaces, fuse_core::joinParameterName(
+        ns,
+        "high_rate_odometry_topic"),
+      high_rate_odometry_topic);
+    high_rate_imu_topic =
+      fuse_core::getParam(
+      interfaces, fuse_core::joinParameterName(
+        ns,
+        "high_rate_imu_topic"),
+      high_rate_imu_topic);
+    fuse_core::getPositiveParam(
+      interfaces, fuse_core::joinParameterName(
+        ns,
+        "high_rate_buffer_size"), high_rate_buffer_size);
+
     fuse_core::loadCovarianceOptionsFromROS(interfaces, covariance_options, "covariance_options");
   }
 
@@ -233,6 +250,9 @@ public:
   std::string world_frame_id {odom_frame_id};
   std::string topic {"odometry/filtered"};
   std::string acceleration_topic {"acceleration/filtered"};
+  std::string high_rate_odometry_topic {};  //!< The raw odometry topic of the high-rate output
+  std::string high_rate_imu_topic {};  //!< The raw IMU topic of the high-rate output
+  int high_rate_buffer_size {1000};  //!< The number of raw velocities kept by the high-rate output
   ceres::Covariance::Options covariance_options;
 };
 
@@ -39,6 +39,7 @@
 
 #include <fuse_models/parameters/parameter_base.hpp>
 
+#include <fuse_core/eigen.hpp>
 #include <fuse_core/loss.hpp>
 #include <fuse_core/parameter.hpp>
 #include <fuse_variables/orientation_2d_stamped.hpp>
@@ -113,6 +114,26 @@ public:
         ns,
         "throttle_use_wall_time"),
       throttle_use_wall_time);
+    cache_static_transforms =
+      fuse_core::getParam(
+      interfaces, fuse_core::joinParameterName(
+        ns,
+        "cache_static_transforms"),
+      cache_static_transforms);
+    fuse_core::getPositiveParam(
+      interfaces, fuse_core::joinParameterName(
+        ns,
+        "mahalanobis_threshold"), mahalanobis_threshold,
+      false);
+    mahalanobis_pose_noise_rate = fuse_core::getCovarianceDiagonalParam<3>(
+      interfaces, fuse_core::joinParameterName(ns, "mahalanobis_pose_noise_rate_diagonal"),
+      1.0e-2);
+    mahalanobis_max_rejections =
+      fuse_core::getParam(
+      interfaces, fuse_core::joinParameterName(
+        ns,
+        "mahalanobis_max_rejections"),
+      mahalanobis_max_rejections);
 
     fuse_core::getParamRequired(interfaces, fuse_core::joinParameterName(ns, "topic"), topic);
     target_frame = fuse_core::getParam(
@@ -149,6 +170,18 @@ public:
                                        //!< available
   rclcpp::Duration throttle_period {0, 0};  //!< The throttle period duration in seconds
   bool throttle_use_wall_time {false};      //!< Whether to throttle using ros::WallTime or not
+  bool cache_static_transforms {false};  //!< Whether to cache the transforms between frames only
+                                        //!< connected by static transforms
+  double mahalanobis_threshold {0.0};  //!< The maximum squared Mahalanobis distance between an
+                                       //!< absolute measurement and the latest graph estimate, or
+                                       //!< zero to disable the gate
+  fuse_core::Matrix3d mahalanobis_pose_noise_rate;  //!< The covariance added to the pose
+                                                    //!< estimate per second until the
+                                                    //!< measurement stamp, for the error of
+                                                    //!< its prediction. Defaults to 0.01.
+  int mahalanobis_max_rejections {10};  //!< The consecutive rejections after which the gate
+                                        //!< accepts a measurement anyway, or zero to never
+                                        //!< force it
   std::string topic {};
   std::string target_frame {};
   std::vector<size_t> position_indices;
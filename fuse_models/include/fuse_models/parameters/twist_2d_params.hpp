@@ -108,6 +108,18 @@ public:
         ns,
         "throttle_use_wall_time"),
       throttle_use_wall_time);
+    throttle_aggregate =
+      fuse_core::getParam(
+      interfaces, fuse_core::joinParameterName(
+        ns,
+        "throttle_aggregate"),
+      throttle_aggregate);
+    cache_static_transforms =
+      fuse_core::getParam(
+      interfaces, fuse_core::joinParameterName(
+        ns,
+        "cache_static_transforms"),
+      cache_static_transforms);
 
     fuse_core::getParamRequired(interfaces, fuse_core::joinParameterName(ns, "topic"), topic);
     fuse_core::getParamRequired(
@@ -128,6 +140,10 @@ public:
                                        //!< available
   rclcpp::Duration throttle_period {0, 0};  //!< The throttle period duration in seconds
   bool throttle_use_wall_time {false};      //!< Whether to throttle using ros::WallTime or not
+  bool throttle_aggregate {false};  //!< Whether to combine the throttled messages into the kept
+                                    //!< ones instead of dropping them
+  bool cache_static_transforms {false};  //!< Whether to cache the transforms between frames only
+                                        //!< connected by static transforms
   std::string topic {};
   std::string target_frame {};
   std::vector<size_t> linear_indices;
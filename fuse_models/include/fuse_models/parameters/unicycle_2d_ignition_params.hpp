@@ -150,6 +150,10 @@ public:
       initial_state.swap(state_vector);
     }
 
+    jacobian_threshold = fuse_core::getParam(
+      interfaces, fuse_core::joinParameterName(ns, "jacobian_threshold"),
+      jacobian_threshold);
+
     loss = fuse_core::loadLossConfig(interfaces, fuse_core::joinParameterName(ns, "loss"));
   }
 
@@ -202,6 +206,14 @@ public:
    */
   std::vector<double> initial_state {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
 
+  /**
+   * @brief The Jacobian threshold assigned to the initial state prior constraints
+   *
+   * See fuse_constraints::AbsoluteConstraint::jacobianThreshold(). A negative value disables the
+   * Jacobian reuse.
+   */
+  double jacobian_threshold {-1.0};
+
   /**
    * @brief Loss function
    */
@@ -40,9 +40,12 @@
 #include <memory>
 #include <string>
 
+#include <fuse_models/common/mahalanobis_gate.hpp>
+#include <fuse_models/common/static_transform_cache.hpp>
 #include <fuse_models/parameters/pose_2d_params.hpp>
 
 #include <fuse_core/async_sensor_model.hpp>
+#include <fuse_core/graph.hpp>
 #include <fuse_core/throttled_callback.hpp>
 #include <fuse_core/uuid.hpp>
 
@@ -72,6 +75,17 @@ namespace fuse_models
  *  - differential (bool, default: false) Whether we should fuse measurements absolutely, or to
  *                                        create relative pose constraints using consecutive
  *                                        measurements.
+ *  - mahalanobis_threshold (double, default: 0.0) Absolute measurements with a squared Mahalanobis
+ *                                                 distance to the latest graph estimate greater
+ *                                                 than this are rejected before they are added to
+ *                                                 the graph, e.g. 11.34 for a 99% confidence with
+ *                                                 3 dimensions. Disabled if zero.
+ *  - mahalanobis_pose_noise_rate_diagonal (vector of doubles, default: [0, 0, 0]) The variances
+ *                                                 added to the pose estimate per second elapsed
+ *                                                 from its stamp to the measurement stamp.
+ *  - mahalanobis_max_rejections (int, default: 10) After this many consecutive rejections the
+ *                                                 next measurement is accepted anyway, so the gate
+ *                                                 cannot lock the sensor out. Never if zero.
  *
  * Subscribes:
  *  - \p topic (geometry_msgs::msg::PoseWithCovarianceStamped) Absolute pose information at a given
@@ -130,6 +144,13 @@ protected:
    */
   void onStop() override;
 
+  /**
+   * @brief Keep the latest graph to gate the absolute measurements, if enabled
+   *
+   * @param[in] graph - The latest graph
+   */
+  void onGraphUpdate(fuse_core::Graph::ConstSharedPtr graph) override;
+
   /**
    * @brief Process a pose message in differential mode
    *
@@ -160,6 +181,9 @@ protected:
   // NOTE(CH3): Unique ptr to defer till we have the node interfaces from initialize()
   std::unique_ptr<tf2_ros::Buffer> tf_buffer_;
   std::unique_ptr<tf2_ros::TransformListener> tf_listener_;
+  std::unique_ptr<common::StaticTransformCache> static_transform_cache_;
+  std::unique_ptr<common::StaticTransformCache::FramePair> static_transform_;
+  std::unique_ptr<common::MahalanobisGate> gate_;  //!< The optional outlier gate
 
   rclcpp::Subscription<geometry_msgs::msg::PoseWithCovarianceStamped>::SharedPtr sub_;
 
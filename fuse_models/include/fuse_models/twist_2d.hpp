@@ -40,6 +40,7 @@
 #include <memory>
 #include <string>
 
+#include <fuse_models/common/static_transform_cache.hpp>
 #include <fuse_models/parameters/twist_2d_params.hpp>
 #include <fuse_core/throttled_callback.hpp>
 
@@ -137,11 +138,13 @@ protected:
   // NOTE(CH3): Unique ptr to defer till we have the node interfaces from initialize()
   std::unique_ptr<tf2_ros::Buffer> tf_buffer_;
   std::unique_ptr<tf2_ros::TransformListener> tf_listener_;
+  std::unique_ptr<common::StaticTransformCache> static_transform_cache_;
+  std::unique_ptr<common::StaticTransformCache::FramePair> static_transform_;
 
   rclcpp::Subscription<geometry_msgs::msg::TwistWithCovarianceStamped>::SharedPtr sub_;
 
   using TwistThrottledCallback =
-    fuse_core::ThrottledMessageCallback<geometry_msgs::msg::TwistWithCovarianceStamped>;
+    fuse_core::AggregatingThrottledMessageCallback<geometry_msgs::msg::TwistWithCovarianceStamped>;
   TwistThrottledCallback throttled_callback_;
 };
 
@@ -34,6 +34,7 @@
 #ifndef FUSE_MODELS__UNICYCLE_2D_HPP_
 #define FUSE_MODELS__UNICYCLE_2D_HPP_
 
+#include <cstdint>
 #include <map>
 #include <string>
 #include <utility>
@@ -116,6 +117,8 @@ protected:
     double velocity_yaw{0.0};             //!< Body-frame yaw velocity
     tf2_2d::Vector2 acceleration_linear;  //!< Body-frame linear acceleration
 
+    uint64_t graph_update{0};             //!< The graph update the estimates are up to date with
+
     void print(std::ostream & stream = std::cout) const;
 
     /**
@@ -183,16 +186,35 @@ protected:
   void onStart() override;
 
   /**
-   * @brief Update all of the estimated states in the state history container using the optimized
+   * @brief Remove the states older than the buffer length from the state history
+   *
+   * At least one state remains, and the history covers *at least* the buffer length.
+   *
+   * @param[in] state_history The state history object to be pruned
+   * @param[in] buffer_length States older than this in the history will be pruned
+   */
+  static void purgeStateHistory(
+    StateHistory & state_history,
+    const rclcpp::Duration & buffer_length);
+
+  /**
+   * @brief Update a single estimated state in the state history container using the optimized
    *        values from the graph
+   *
+   * If the state is not in the graph yet, it is predicted from the closest previous state, that is
+   * updated first. The walk back stops at the newest previous state that is in the graph or already
+   * up to date with \p graph_update, so only the states after it are re-predicted.
+   *
    * @param[in] graph         The graph object containing updated variable values
    * @param[in] state_history The state history object to be updated
-   * @param[in] buffer_length States older than this in the history will be pruned
+   * @param[in] state_iter    The state to update
+   * @param[in] graph_update  A number identifying \p graph, different for every graph update
    */
-  static void updateStateHistoryEstimates(
+  static void updateStateHistoryEstimate(
     const fuse_core::Graph & graph,
     StateHistory & state_history,
-    const rclcpp::Duration & buffer_length);
+    StateHistory::iterator state_iter,
+    const uint64_t graph_update);
 
   /**
    * @brief Validate the motion model state #1, state #2 and process noise covariance
@@ -234,7 +256,10 @@ protected:
   bool disable_checks_{false};    //!< Whether to disable the validation checks for the current and
                                   //!< predicted state, including the process noise covariance after
                                   //!< it is scaled and multiplied by dt
-  StateHistory state_history_;    //!< History of optimized graph pose estimates
+  StateHistory state_history_;    //!< History of optimized graph pose estimates, updated lazily
+                                  //!< with the values in graph_
+  fuse_core::Graph::ConstSharedPtr graph_;  //!< The latest graph received from the optimizer
+  uint64_t graph_update_{0};      //!< The number of graphs received from the optimizer
 };
 
 std::ostream & operator<<(std::ostream & stream, const Unicycle2D & unicycle_2d);
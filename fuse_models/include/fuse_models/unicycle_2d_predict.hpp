@@ -310,21 +310,17 @@ inline void predict(
   double acc_linear_y_pred {};
 
   // fuse_core::Matrix8d is Eigen::RowMajor, so we cannot use pointers to the columns where each
-  // parameter block starts. Instead, we need to create a vector of Eigen::RowMajor matrices per
-  // parameter block and later reconstruct the fuse_core::Matrix8d with the full jacobian. The
-  // parameter blocks have the following sizes: {position1: 2, yaw1: 1, vel_linear1: 2, vel_yaw1: 1,
-  // acc_linear1: 2}
-  static constexpr size_t num_residuals{8};
-  static constexpr size_t num_parameter_blocks{5};
-  static const std::array<size_t, num_parameter_blocks> block_sizes = {2, 1, 2, 1, 2};
-
-  std::array<fuse_core::MatrixXd, num_parameter_blocks> J;
-  std::array<double *, num_parameter_blocks> jacobians;
-
-  for (size_t i = 0; i < num_parameter_blocks; ++i) {
-    J[i].resize(num_residuals, block_sizes[i]);
-    jacobians[i] = J[i].data();
-  }
+  // parameter block starts. Instead, we need to create an Eigen::RowMajor matrix per parameter
+  // block and later reconstruct the fuse_core::Matrix8d with the full jacobian. The parameter
+  // blocks have the following sizes: {position1: 2, yaw1: 1, vel_linear1: 2, vel_yaw1: 1,
+  // acc_linear1: 2}. Fixed-size blocks keep this free of heap allocations.
+  fuse_core::Matrix<double, 8, 2> J_position1;
+  fuse_core::Vector8d J_yaw1;
+  fuse_core::Matrix<double, 8, 2> J_vel_linear1;
+  fuse_core::Vector8d J_vel_yaw1;
+  fuse_core::Matrix<double, 8, 2> J_acc_linear1;
+  std::array<double *, 5> jacobians = {J_position1.data(), J_yaw1.data(), J_vel_linear1.data(),
+    J_vel_yaw1.data(), J_acc_linear1.data()};
 
   predict(
     pose1.x(),
@@ -346,7 +342,7 @@ inline void predict(
     acc_linear_y_pred,
     jacobians.data());
 
-  jacobian << J[0], J[1], J[2], J[3], J[4];
+  jacobian << J_position1, J_yaw1, J_vel_linear1, J_vel_yaw1, J_acc_linear1;
 
   pose2.setX(x_pred);
   pose2.setY(y_pred);
@@ -34,6 +34,7 @@
 #include <fuse_core/transaction.hpp>
 #include <fuse_core/uuid.hpp>
 #include <fuse_models/acceleration_2d.hpp>
+#include <fuse_models/common/aggregation.hpp>
 #include <fuse_models/common/sensor_proc.hpp>
 #include <geometry_msgs/msg/accel_with_covariance_stamped.hpp>
 #include <pluginlib/class_list_macros.hpp>
@@ -78,6 +79,13 @@ void Acceleration2D::onInit()
     throttled_callback_.setClock(clock_);
   }
 
+  if (params_.throttle_aggregate) {
+    throttled_callback_.setAggregateCallback(
+      [](auto & pending, const auto & message) {
+        common::aggregate(pending, message);
+      });
+  }
+
   if (params_.indices.empty()) {
     RCLCPP_WARN_STREAM(
       logger_,
@@ -93,10 +101,20 @@ void Acceleration2D::onInit()
     interfaces_.get_node_parameters_interface(),
     interfaces_.get_node_topics_interface()
   );
+
+  if (params_.cache_static_transforms) {
+    static_transform_cache_ = std::make_unique<common::StaticTransformCache>();
+    static_transform_ = std::make_unique<common::StaticTransformCache::FramePair>(
+      *static_transform_cache_, params_.target_frame);
+  }
 }
 
 void Acceleration2D::onStart()
 {
+  if (static_transform_cache_) {
+    static_transform_cache_->subscribe(interfaces_, cb_group_);
+  }
+
   if (!params_.indices.empty()) {
     rclcpp::SubscriptionOptions sub_options;
     sub_options.callback_group = cb_group_;
@@ -106,8 +124,7 @@ void Acceleration2D::onStart()
       params_.topic,
       params_.queue_size,
       std::bind(
-        &AccelerationThrottledCallback::callback<
-          const geometry_msgs::msg::AccelWithCovarianceStamped &>,
+        &AccelerationThrottledCallback::callback,
         &throttled_callback_,
         std::placeholders::_1
       ),
@@ -119,6 +136,11 @@ void Acceleration2D::onStart()
 void Acceleration2D::onStop()
 {
   sub_.reset();
+  throttled_callback_.reset();
+
+  if (static_transform_cache_) {
+    static_transform_cache_->unsubscribe();
+  }
 }
 
 void Acceleration2D::process(const geometry_msgs::msg::AccelWithCovarianceStamped & msg)
@@ -137,7 +159,8 @@ void Acceleration2D::process(const geometry_msgs::msg::AccelWithCovarianceStampe
     *tf_buffer_,
     !params_.disable_checks,
     *transaction,
-    params_.tf_timeout);
+    params_.tf_timeout,
+    static_transform_.get());
 
   // Send the transaction object to the plugin's parent
   sendTransaction(transaction);
@@ -36,6 +36,7 @@
 
 #include <fuse_core/transaction.hpp>
 #include <fuse_core/uuid.hpp>
+#include <fuse_models/common/aggregation.hpp>
 #include <fuse_models/common/sensor_proc.hpp>
 #include <fuse_models/imu_2d.hpp>
 #include <geometry_msgs/msg/accel_with_covariance_stamped.hpp>
@@ -85,6 +86,13 @@ void Imu2D::onInit()
     throttled_callback_.setClock(clock_);
   }
 
+  if (params_.throttle_aggregate) {
+    throttled_callback_.setAggregateCallback(
+      [](auto & pending, const auto & message) {
+        common::aggregate(pending, message);
+      });
+  }
+
   if (params_.orientation_indices.empty() &&
     params_.linear_acceleration_indices.empty() &&
     params_.angular_velocity_indices.empty())
@@ -103,10 +111,24 @@ void Imu2D::onInit()
     interfaces_.get_node_parameters_interface(),
     interfaces_.get_node_topics_interface()
   );
+
+  if (params_.cache_static_transforms) {
+    static_transform_cache_ = std::make_unique<common::StaticTransformCache>();
+    orientation_static_transform_ = std::make_unique<common::StaticTransformCache::FramePair>(
+      *static_transform_cache_, params_.orientation_target_frame);
+    twist_static_transform_ = std::make_unique<common::StaticTransformCache::FramePair>(
+      *static_transform_cache_, params_.twist_target_frame);
+    acceleration_static_transform_ = std::make_unique<common::StaticTransformCache::FramePair>(
+      *static_transform_cache_, params_.acceleration_target_frame);
+  }
 }
 
 void Imu2D::onStart()
 {
+  if (static_transform_cache_) {
+    static_transform_cache_->subscribe(interfaces_, cb_group_);
+  }
+
   if (!params_.orientation_indices.empty() ||
     !params_.linear_acceleration_indices.empty() ||
     !params_.angular_velocity_indices.empty())
@@ -121,7 +143,7 @@ void Imu2D::onStart()
       params_.topic,
       rclcpp::SensorDataQoS().keep_last(params_.queue_size),
       std::bind(
-        &ImuThrottledCallback::callback<const sensor_msgs::msg::Imu &>,
+        &ImuThrottledCallback::callback,
         &throttled_callback_,
         std::placeholders::_1
       ),
@@ -133,6 +155,11 @@ void Imu2D::onStart()
 void Imu2D::onStop()
 {
   sub_.reset();
+  throttled_callback_.reset();
+
+  if (static_transform_cache_) {
+    static_transform_cache_->unsubscribe();
+  }
 }
 
 void Imu2D::process(const sensor_msgs::msg::Imu & msg)
@@ -184,7 +211,8 @@ void Imu2D::process(const sensor_msgs::msg::Imu & msg)
       *tf_buffer_,
       validate,
       *transaction,
-      params_.tf_timeout);
+      params_.tf_timeout,
+      orientation_static_transform_.get());
   }
 
   // Handle the twist data (only include indices for angular velocity)
@@ -200,7 +228,8 @@ void Imu2D::process(const sensor_msgs::msg::Imu & msg)
     *tf_buffer_,
     validate,
     *transaction,
-    params_.tf_timeout);
+    params_.tf_timeout,
+    twist_static_transform_.get());
 
   // Handle the acceleration data
   geometry_msgs::msg::AccelWithCovarianceStamped accel;
@@ -240,7 +269,8 @@ void Imu2D::process(const sensor_msgs::msg::Imu & msg)
     *tf_buffer_,
     validate,
     *transaction,
-    params_.tf_timeout);
+    params_.tf_timeout,
+    acceleration_static_transform_.get());
 
   // Send the transaction object to the plugin's parent
   sendTransaction(transaction);
@@ -256,7 +286,10 @@ void Imu2D::processDifferential(
     params_.orientation_target_frame.empty() ? pose.header.frame_id : params_.
     orientation_target_frame;
 
-  if (!common::transformMessage(*tf_buffer_, pose, *transformed_pose)) {
+  if (!common::transformMessage(
+      *tf_buffer_, pose, *transformed_pose, rclcpp::Duration(0, 0),
+      orientation_static_transform_.get()))
+  {
     RCLCPP_WARN_STREAM_THROTTLE(
       logger_, *clock_, 5.0 * 1000,
       "Cannot transform pose message with stamp " << rclcpp::Time(
@@ -276,7 +309,10 @@ void Imu2D::processDifferential(
     transformed_twist.header.frame_id =
       params_.twist_target_frame.empty() ? twist.header.frame_id : params_.twist_target_frame;
 
-    if (!common::transformMessage(*tf_buffer_, twist, transformed_twist)) {
+    if (!common::transformMessage(
+        *tf_buffer_, twist, transformed_twist, rclcpp::Duration(0, 0),
+        twist_static_transform_.get()))
+    {
       RCLCPP_WARN_STREAM_THROTTLE(
         logger_, *clock_, 5.0 * 1000,
         "Cannot transform twist message with stamp " << rclcpp::Time(
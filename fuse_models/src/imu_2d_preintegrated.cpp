@@ -0,0 +1,242 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2019, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <memory>
+#include <string>
+
+#include <fuse_constraints/absolute_constraint.hpp>
+#include <fuse_core/transaction.hpp>
+#include <fuse_core/uuid.hpp>
+#include <fuse_models/imu_2d_preintegrated.hpp>
+#include <fuse_models/imu_2d_preintegrated_constraint.hpp>
+#include <fuse_variables/imu_bias_2d_stamped.hpp>
+#include <fuse_variables/orientation_2d_stamped.hpp>
+#include <fuse_variables/position_2d_stamped.hpp>
+#include <fuse_variables/stamped.hpp>
+#include <fuse_variables/velocity_linear_2d_stamped.hpp>
+#include <pluginlib/class_list_macros.hpp>
+#include <rclcpp/rclcpp.hpp>
+#include <sensor_msgs/msg/imu.hpp>
+
+
+// Register this sensor model with ROS as a plugin.
+PLUGINLIB_EXPORT_CLASS(fuse_models::Imu2DPreintegrated, fuse_core::SensorModel)
+
+namespace fuse_models
+{
+
+Imu2DPreintegrated::Imu2DPreintegrated()
+: fuse_core::AsyncSensorModel(1),
+  device_id_(fuse_core::uuid::NIL),
+  logger_(rclcpp::get_logger("uninitialized")),
+  bias_(fuse_core::Vector3d::Zero()),
+  previous_acceleration_(fuse_core::Vector2d::Zero())
+{
+}
+
+void Imu2DPreintegrated::initialize(
+  fuse_core::node_interfaces::NodeInterfaces<ALL_FUSE_CORE_NODE_INTERFACES> interfaces,
+  const std::string & name,
+  fuse_core::TransactionCallback transaction_callback)
+{
+  interfaces_ = interfaces;
+  fuse_core::AsyncSensorModel::initialize(interfaces, name, transaction_callback);
+}
+
+void Imu2DPreintegrated::onInit()
+{
+  logger_ = interfaces_.get_node_logging_interface()->get_logger();
+  clock_ = interfaces_.get_node_clock_interface()->get_clock();
+
+  // Read settings from the parameter sever
+  device_id_ = fuse_variables::loadDeviceId(interfaces_);
+
+  params_.loadFromROS(interfaces_, name_);
+
+  preintegration_ = Imu2DPreintegration(
+    params_.gyroscope_noise_density,
+    params_.accelerometer_noise_density,
+    bias_);
+}
+
+void Imu2DPreintegrated::onStart()
+{
+  bias_.setZero();
+  first_period_ = true;
+  previous_stamp_.reset();
+  preintegration_.reset(bias_);
+
+  rclcpp::SubscriptionOptions sub_options;
+  sub_options.callback_group = cb_group_;
+
+  sub_ = rclcpp::create_subscription<sensor_msgs::msg::Imu>(
+    interfaces_,
+    params_.topic,
+    rclcpp::SensorDataQoS().keep_last(params_.queue_size),
+    std::bind(&Imu2DPreintegrated::process, this, std::placeholders::_1),
+    sub_options
+  );
+}
+
+void Imu2DPreintegrated::onStop()
+{
+  sub_.reset();
+}
+
+void Imu2DPreintegrated::onGraphUpdate(fuse_core::Graph::ConstSharedPtr graph)
+{
+  // The latest biases are the ones at the beginning of the current preintegration period
+  if (first_period_) {
+    return;
+  }
+
+  const auto bias_uuid =
+    fuse_variables::ImuBias2DStamped(period_start_, device_id_).uuid();
+  if (!graph->variableExists(bias_uuid)) {
+    return;
+  }
+
+  const auto & bias_variable = graph->getVariable(bias_uuid);
+  bias_ = Eigen::Map<const fuse_core::Vector3d>(bias_variable.data());
+}
+
+void Imu2DPreintegrated::process(const sensor_msgs::msg::Imu & msg)
+{
+  const rclcpp::Time stamp(msg.header.stamp);
+  const double yaw_velocity = msg.angular_velocity.z;
+  const fuse_core::Vector2d acceleration(msg.linear_acceleration.x, msg.linear_acceleration.y);
+
+  if (!previous_stamp_) {
+    period_start_ = stamp;
+    previous_stamp_ = stamp;
+    previous_yaw_velocity_ = yaw_velocity;
+    previous_acceleration_ = acceleration;
+    return;
+  }
+
+  const double dt = (stamp - *previous_stamp_).seconds();
+  if (dt <= 0.0) {
+    RCLCPP_WARN_STREAM_THROTTLE(
+      logger_, *clock_, 5.0 * 1000,
+      "Ignoring IMU message with stamp " << stamp.nanoseconds()
+                                         << " not newer than the previous one.");
+    return;
+  }
+
+  // Integrate the midpoint of the two consecutive samples over the sampling interval
+  preintegration_.integrate(
+    0.5 * (previous_yaw_velocity_ + yaw_velocity),
+    0.5 * (previous_acceleration_ + acceleration),
+    dt);
+
+  previous_stamp_ = stamp;
+  previous_yaw_velocity_ = yaw_velocity;
+  previous_acceleration_ = acceleration;
+
+  // The covariance of a single step is singular, so a period spans at least two IMU steps
+  if (stamp - period_start_ < params_.preintegration_period || preintegration_.steps() < 2) {
+    return;
+  }
+
+  // Send the transaction object to the plugin's parent
+  sendTransaction(createTransaction(stamp));
+
+  period_start_ = stamp;
+  first_period_ = false;
+  preintegration_.reset(bias_);
+}
+
+fuse_core::Transaction::SharedPtr Imu2DPreintegrated::createTransaction(
+  const rclcpp::Time & stamp)
+{
+  auto transaction = fuse_core::Transaction::make_shared();
+  transaction->stamp(stamp);
+  transaction->addInvolvedStamp(period_start_);
+  transaction->addInvolvedStamp(stamp);
+
+  // The 2D state variables are created by the motion model at the involved stamps, so only the
+  // identity of these variables is needed here
+  const fuse_variables::Position2DStamped position1(period_start_, device_id_);
+  const fuse_variables::Orientation2DStamped yaw1(period_start_, device_id_);
+  const fuse_variables::VelocityLinear2DStamped linear_velocity1(period_start_, device_id_);
+  const fuse_variables::Position2DStamped position2(stamp, device_id_);
+  const fuse_variables::Orientation2DStamped yaw2(stamp, device_id_);
+  const fuse_variables::VelocityLinear2DStamped linear_velocity2(stamp, device_id_);
+
+  // The biases are initialized with the latest estimate
+  auto bias1 = fuse_variables::ImuBias2DStamped::make_shared(period_start_, device_id_);
+  auto bias2 = fuse_variables::ImuBias2DStamped::make_shared(stamp, device_id_);
+  Eigen::Map<fuse_core::Vector3d>(bias1->data()) = preintegration_.bias();
+  Eigen::Map<fuse_core::Vector3d>(bias2->data()) = preintegration_.bias();
+
+  // The biases follow a random walk, so the covariance of their change grows with the time delta
+  fuse_core::Vector3d bias_variance;
+  bias_variance <<
+    params_.gyroscope_bias_random_walk * params_.gyroscope_bias_random_walk,
+    params_.accelerometer_bias_random_walk * params_.accelerometer_bias_random_walk,
+    params_.accelerometer_bias_random_walk * params_.accelerometer_bias_random_walk;
+  const fuse_core::Matrix3d bias_covariance =
+    (bias_variance * preintegration_.dt()).asDiagonal();
+
+  auto constraint = Imu2DPreintegratedConstraint::make_shared(
+    name(),
+    position1,
+    yaw1,
+    linear_velocity1,
+    *bias1,
+    position2,
+    yaw2,
+    linear_velocity2,
+    *bias2,
+    preintegration_,
+    bias_covariance);
+  constraint->loss(params_.loss);
+
+  transaction->addVariable(bias1);
+  transaction->addVariable(bias2);
+  transaction->addConstraint(constraint);
+
+  // Anchor the first biases, which are otherwise only constrained relative to the following ones
+  if (first_period_) {
+    auto prior = fuse_constraints::AbsoluteImuBias2DStampedConstraint::make_shared(
+      name(),
+      *bias1,
+      preintegration_.bias(),
+      params_.initial_bias_covariance);
+    transaction->addConstraint(prior);
+  }
+
+  return transaction;
+}
+
+}  // namespace fuse_models
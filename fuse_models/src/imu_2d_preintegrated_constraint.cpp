@@ -0,0 +1,121 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2018, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <Eigen/Dense>
+
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+#include <boost/serialization/export.hpp>
+#include <fuse_models/imu_2d_preintegrated_constraint.hpp>
+#include <fuse_models/imu_2d_preintegrated_cost_function.hpp>
+#include <fuse_models/imu_2d_preintegration.hpp>
+#include <fuse_variables/imu_bias_2d_stamped.hpp>
+#include <fuse_variables/orientation_2d_stamped.hpp>
+#include <fuse_variables/position_2d_stamped.hpp>
+#include <fuse_variables/velocity_linear_2d_stamped.hpp>
+#include <pluginlib/class_list_macros.hpp>
+
+namespace fuse_models
+{
+
+Imu2DPreintegratedConstraint::Imu2DPreintegratedConstraint(
+  const std::string & source,
+  const fuse_variables::Position2DStamped & position1,
+  const fuse_variables::Orientation2DStamped & yaw1,
+  const fuse_variables::VelocityLinear2DStamped & linear_velocity1,
+  const fuse_variables::ImuBias2DStamped & bias1,
+  const fuse_variables::Position2DStamped & position2,
+  const fuse_variables::Orientation2DStamped & yaw2,
+  const fuse_variables::VelocityLinear2DStamped & linear_velocity2,
+  const fuse_variables::ImuBias2DStamped & bias2,
+  const Imu2DPreintegration & preintegration,
+  const fuse_core::Matrix3d & bias_covariance)
+: fuse_core::Constraint(
+    source,
+    {position1.uuid(),
+      yaw1.uuid(),
+      linear_velocity1.uuid(),
+      bias1.uuid(),
+      position2.uuid(),
+      yaw2.uuid(),
+      linear_velocity2.uuid(),
+      bias2.uuid()}),   // NOLINT
+  dt_(preintegration.dt()),
+  delta_(preintegration.delta()),
+  bias_jacobian_(preintegration.biasJacobian()),
+  bias_(preintegration.bias())
+{
+  fuse_core::Matrix8d covariance = fuse_core::Matrix8d::Zero();
+  covariance.topLeftCorner<5, 5>() = preintegration.covariance();
+  covariance.bottomRightCorner<3, 3>() = bias_covariance;
+  const Eigen::LLT<fuse_core::Matrix8d> covariance_llt(covariance);
+  if (preintegration.steps() < 2 || covariance_llt.info() != Eigen::Success) {
+    throw std::invalid_argument(
+            "The covariance of the preintegrated IMU measurement over " +
+            std::to_string(preintegration.steps()) + " steps is not positive definite. At least "
+            "two steps are required.");
+  }
+  sqrt_information_ = covariance.inverse().llt().matrixU();
+}
+
+void Imu2DPreintegratedConstraint::print(std::ostream & stream) const
+{
+  stream << type() << "\n"
+         << "  source: " << source() << "\n"
+         << "  uuid: " << uuid() << "\n"
+         << "  position variable 1: " << variables().at(0) << "\n"
+         << "  yaw variable 1: " << variables().at(1) << "\n"
+         << "  linear velocity variable 1: " << variables().at(2) << "\n"
+         << "  bias variable 1: " << variables().at(3) << "\n"
+         << "  position variable 2: " << variables().at(4) << "\n"
+         << "  yaw variable 2: " << variables().at(5) << "\n"
+         << "  linear velocity variable 2: " << variables().at(6) << "\n"
+         << "  bias variable 2: " << variables().at(7) << "\n"
+         << "  dt: " << dt() << "\n"
+         << "  delta: " << delta().transpose() << "\n"
+         << "  bias: " << bias().transpose() << "\n"
+         << "  bias_jacobian: " << biasJacobian() << "\n"
+         << "  sqrt_info: " << sqrtInformation() << "\n";
+}
+
+ceres::CostFunction * Imu2DPreintegratedConstraint::costFunction() const
+{
+  return new Imu2DPreintegratedCostFunction(dt_, delta_, bias_jacobian_, bias_, sqrt_information_);
+}
+
+}  // namespace fuse_models
+
+BOOST_CLASS_EXPORT_IMPLEMENT(fuse_models::Imu2DPreintegratedConstraint);
+PLUGINLIB_EXPORT_CLASS(fuse_models::Imu2DPreintegratedConstraint, fuse_core::Constraint);
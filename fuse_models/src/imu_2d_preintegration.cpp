@@ -0,0 +1,115 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2018, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <Eigen/Core>
+
+#include <cmath>
+
+#include <fuse_core/eigen.hpp>
+#include <fuse_models/imu_2d_preintegration.hpp>
+
+namespace fuse_models
+{
+
+Imu2DPreintegration::Imu2DPreintegration(
+  const double gyroscope_noise_density,
+  const double accelerometer_noise_density,
+  const fuse_core::Vector3d & bias)
+: gyroscope_variance_(gyroscope_noise_density * gyroscope_noise_density),
+  accelerometer_variance_(accelerometer_noise_density * accelerometer_noise_density)
+{
+  reset(bias);
+}
+
+void Imu2DPreintegration::reset(const fuse_core::Vector3d & bias)
+{
+  bias_ = bias;
+  dt_ = 0.0;
+  steps_ = 0;
+  delta_.setZero();
+  bias_jacobian_.setZero();
+  covariance_.setZero();
+}
+
+void Imu2DPreintegration::integrate(
+  const double yaw_velocity,
+  const fuse_core::Vector2d & acceleration,
+  const double dt)
+{
+  if (dt <= 0.0) {
+    return;
+  }
+
+  // Rotate the bias-free acceleration into the frame of the first state
+  const double cos_yaw = std::cos(delta_[2]);
+  const double sin_yaw = std::sin(delta_[2]);
+  fuse_core::Matrix2d rotation;
+  rotation << cos_yaw, -sin_yaw, sin_yaw, cos_yaw;
+  const fuse_core::Vector2d acceleration_rotated = rotation * (acceleration - bias_.tail<2>());
+
+  // Derivative of the rotated acceleration wrt the integrated yaw
+  const fuse_core::Vector2d acceleration_rotated_yaw(
+    -acceleration_rotated.y(), acceleration_rotated.x());
+
+  const double half_dt2 = 0.5 * dt * dt;
+
+  // Jacobian of the preintegrated measurement after this step wrt the one before it...
+  Matrix5d A = Matrix5d::Identity();
+  A.block<2, 1>(0, 2) = acceleration_rotated_yaw * half_dt2;
+  A.block<2, 2>(0, 3) = fuse_core::Matrix2d::Identity() * dt;
+  A.block<2, 1>(3, 2) = acceleration_rotated_yaw * dt;
+
+  // ...and wrt the IMU measurement noise, which enters the same way as the biases
+  Matrix53d B = Matrix53d::Zero();
+  B.block<2, 2>(0, 1) = -rotation * half_dt2;
+  B(2, 0) = -dt;
+  B.block<2, 2>(3, 1) = -rotation * dt;
+
+  // Propagate the covariance, for white noise sampled over the time step
+  const fuse_core::Vector3d noise_variance(
+    gyroscope_variance_ / dt, accelerometer_variance_ / dt, accelerometer_variance_ / dt);
+  covariance_ = A * covariance_ * A.transpose() +
+    B * noise_variance.asDiagonal() * B.transpose();
+
+  // Propagate the bias Jacobian
+  bias_jacobian_ = A * bias_jacobian_ + B;
+
+  // Integrate the measurement. The position uses the velocity before this step.
+  delta_.head<2>() += delta_.tail<2>() * dt + acceleration_rotated * half_dt2;
+  delta_.tail<2>() += acceleration_rotated * dt;
+  delta_[2] += (yaw_velocity - bias_[0]) * dt;
+  dt_ += dt;
+  ++steps_;
+}
+
+}  // namespace fuse_models
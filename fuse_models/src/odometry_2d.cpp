@@ -36,6 +36,7 @@
 
 #include <fuse_core/transaction.hpp>
 #include <fuse_core/uuid.hpp>
+#include <fuse_models/common/aggregation.hpp>
 #include <fuse_models/common/sensor_proc.hpp>
 #include <fuse_models/odometry_2d.hpp>
 #include <geometry_msgs/msg/pose_with_covariance_stamped.hpp>
@@ -83,6 +84,13 @@ void Odometry2D::onInit()
     throttled_callback_.setClock(clock_);
   }
 
+  if (params_.throttle_aggregate) {
+    throttled_callback_.setAggregateCallback(
+      [](auto & pending, const auto & message) {
+        common::aggregate(pending, message);
+      });
+  }
+
   if (params_.position_indices.empty() &&
     params_.orientation_indices.empty() &&
     params_.linear_velocity_indices.empty() &&
@@ -102,10 +110,28 @@ void Odometry2D::onInit()
     interfaces_.get_node_parameters_interface(),
     interfaces_.get_node_topics_interface()
   );
+
+  if (params_.cache_static_transforms) {
+    static_transform_cache_ = std::make_unique<common::StaticTransformCache>();
+    pose_static_transform_ = std::make_unique<common::StaticTransformCache::FramePair>(
+      *static_transform_cache_, params_.pose_target_frame);
+    twist_static_transform_ = std::make_unique<common::StaticTransformCache::FramePair>(
+      *static_transform_cache_, params_.twist_target_frame);
+  }
+
+  if (params_.mahalanobis_threshold > 0.0) {
+    gate_ = std::make_unique<common::MahalanobisGate>(
+      params_.mahalanobis_threshold, device_id_, params_.mahalanobis_pose_noise_rate,
+      params_.mahalanobis_twist_noise_rate, params_.mahalanobis_max_rejections);
+  }
 }
 
 void Odometry2D::onStart()
 {
+  if (static_transform_cache_) {
+    static_transform_cache_->subscribe(interfaces_, cb_group_);
+  }
+
   if (!params_.position_indices.empty() ||
     !params_.orientation_indices.empty() ||
     !params_.linear_velocity_indices.empty() ||
@@ -121,8 +147,7 @@ void Odometry2D::onStart()
       params_.topic,
       params_.queue_size,
       std::bind(
-        &OdometryThrottledCallback::callback<
-          const nav_msgs::msg::Odometry &>,
+        &OdometryThrottledCallback::callback,
         &throttled_callback_,
         std::placeholders::_1
       ),
@@ -134,6 +159,22 @@ void Odometry2D::onStart()
 void Odometry2D::onStop()
 {
   sub_.reset();
+  throttled_callback_.reset();
+
+  if (static_transform_cache_) {
+    static_transform_cache_->unsubscribe();
+  }
+
+  if (gate_) {
+    gate_->update(nullptr);
+  }
+}
+
+void Odometry2D::onGraphUpdate(fuse_core::Graph::ConstSharedPtr graph)
+{
+  if (gate_) {
+    gate_->update(std::move(graph));
+  }
 }
 
 void Odometry2D::process(const nav_msgs::msg::Odometry & msg)
@@ -168,7 +209,9 @@ void Odometry2D::process(const nav_msgs::msg::Odometry & msg)
       *tf_buffer_,
       validate,
       *transaction,
-      params_.tf_timeout);
+      params_.tf_timeout,
+      pose_static_transform_.get(),
+      gate_.get());
   }
 
   // Handle the twist data
@@ -184,7 +227,9 @@ void Odometry2D::process(const nav_msgs::msg::Odometry & msg)
     *tf_buffer_,
     validate,
     *transaction,
-    params_.tf_timeout);
+    params_.tf_timeout,
+    twist_static_transform_.get(),
+    gate_.get());
 
   // Send the transaction object to the plugin's parent
   sendTransaction(transaction);
@@ -199,7 +244,10 @@ void Odometry2D::processDifferential(
   transformed_pose->header.frame_id =
     params_.pose_target_frame.empty() ? pose.header.frame_id : params_.pose_target_frame;
 
-  if (!common::transformMessage(*tf_buffer_, pose, *transformed_pose)) {
+  if (!common::transformMessage(
+      *tf_buffer_, pose, *transformed_pose, rclcpp::Duration(0, 0),
+      pose_static_transform_.get()))
+  {
     RCLCPP_WARN_STREAM_THROTTLE(
       logger_, *clock_, 5.0 * 1000,
       "Cannot transform pose message with stamp "
@@ -218,7 +266,10 @@ void Odometry2D::processDifferential(
     transformed_twist.header.frame_id =
       params_.twist_target_frame.empty() ? twist.header.frame_id : params_.twist_target_frame;
 
-    if (!common::transformMessage(*tf_buffer_, twist, transformed_twist)) {
+    if (!common::transformMessage(
+        *tf_buffer_, twist, transformed_twist, rclcpp::Duration(0, 0),
+        twist_static_transform_.get()))
+    {
       RCLCPP_WARN_STREAM_THROTTLE(
         logger_, *clock_, 5.0 * 1000,
         "Cannot transform twist message with stamp " << rclcpp::Time(
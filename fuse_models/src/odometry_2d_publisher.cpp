@@ -51,6 +51,7 @@
 #include <geometry_msgs/msg/accel_with_covariance_stamped.hpp>
 #include <nav_msgs/msg/odometry.hpp>
 #include <pluginlib/class_list_macros.hpp>
+#include <sensor_msgs/msg/imu.hpp>
 #include <tf2_2d/tf2_2d.hpp>
 #include <tf2_geometry_msgs/tf2_geometry_msgs.hpp>
 
@@ -69,6 +70,14 @@ Odometry2DPublisher::Odometry2DPublisher()
 {
 }
 
+Odometry2DPublisher::~Odometry2DPublisher()
+{
+  if (high_rate_spinner_.joinable()) {
+    high_rate_executor_->cancel();
+    high_rate_spinner_.join();
+  }
+}
+
 void Odometry2DPublisher::initialize(
   fuse_core::node_interfaces::NodeInterfaces<ALL_FUSE_CORE_NODE_INTERFACES> interfaces,
   const std::string & name)
@@ -119,6 +128,27 @@ void Odometry2DPublisher::onInit()
     params_.acceleration_topic,
     params_.queue_size,
     pub_options);
+
+  // Process the raw messages of the high-rate output in a dedicated thread, so they are never
+  // delayed by the notifyCallback covariance computation
+  if (!params_.high_rate_odometry_topic.empty() || !params_.high_rate_imu_topic.empty()) {
+    integrator_ = std::make_unique<common::OdometryIntegrator>(params_.high_rate_buffer_size);
+
+    high_rate_cb_group_ = interfaces_.get_node_base_interface()->create_callback_group(
+      rclcpp::CallbackGroupType::MutuallyExclusive, false);
+
+    auto executor_options = rclcpp::ExecutorOptions();
+    executor_options.context = interfaces_.get_node_base_interface()->get_context();
+    high_rate_executor_ = rclcpp::executors::SingleThreadedExecutor::make_shared(executor_options);
+    high_rate_executor_->add_callback_group(
+      high_rate_cb_group_,
+      interfaces_.get_node_base_interface());
+
+    high_rate_spinner_ = std::thread(
+      [this]() {
+        high_rate_executor_->spin();
+      });
+  }
 }
 
 void Odometry2DPublisher::notifyCallback(
@@ -258,6 +288,12 @@ void Odometry2DPublisher::notifyCallback(
     odom_output_ = odom_output;
     acceleration_output_ = acceleration_output;
   }
+
+  if (integrator_) {
+    std::atomic_store(
+      &latest_state_,
+      std::make_shared<const OptimizedState>(OptimizedState{odom_output, acceleration_output}));
+  }
 }
 
 void Odometry2DPublisher::onStart()
@@ -268,6 +304,42 @@ void Odometry2DPublisher::onStart()
   odom_output_ = nav_msgs::msg::Odometry();
   acceleration_output_ = geometry_msgs::msg::AccelWithCovarianceStamped();
 
+  delayed_throttle_filter_.reset();
+
+  // The high-rate output publishes for every raw message instead
+  if (integrator_) {
+    std::atomic_store(&latest_state_, std::shared_ptr<const OptimizedState>());
+    integrated_state_.reset();
+    integrator_->reset();
+    velocity_linear_ = tf2_2d::Vector2();
+    velocity_angular_ = 0.0;
+
+    rclcpp::SubscriptionOptions sub_options;
+    sub_options.callback_group = high_rate_cb_group_;
+
+    if (!params_.high_rate_odometry_topic.empty()) {
+      high_rate_odom_sub_ = rclcpp::create_subscription<nav_msgs::msg::Odometry>(
+        interfaces_,
+        params_.high_rate_odometry_topic,
+        rclcpp::SensorDataQoS(),
+        std::bind(&Odometry2DPublisher::highRateOdometryCallback, this, std::placeholders::_1),
+        sub_options
+      );
+    }
+
+    if (!params_.high_rate_imu_topic.empty()) {
+      high_rate_imu_sub_ = rclcpp::create_subscription<sensor_msgs::msg::Imu>(
+        interfaces_,
+        params_.high_rate_imu_topic,
+        rclcpp::SensorDataQoS(),
+        std::bind(&Odometry2DPublisher::highRateImuCallback, this, std::placeholders::_1),
+        sub_options
+      );
+    }
+
+    return;
+  }
+
   // TODO(CH3): Add this to a separate callback group for async behavior
   publish_timer_ = rclcpp::create_timer(
     interfaces_,
@@ -276,13 +348,16 @@ void Odometry2DPublisher::onStart()
     std::move(std::bind(&Odometry2DPublisher::publishTimerCallback, this)),
     cb_group_
   );
-
-  delayed_throttle_filter_.reset();
 }
 
 void Odometry2DPublisher::onStop()
 {
-  publish_timer_->cancel();
+  if (publish_timer_) {
+    publish_timer_->cancel();
+  }
+
+  high_rate_odom_sub_.reset();
+  high_rate_imu_sub_.reset();
 }
 
 bool Odometry2DPublisher::getState(
@@ -498,10 +573,20 @@ void Odometry2DPublisher::publishTimerCallback()
     }
   }
 
+  publishState(odom_output, acceleration_output);
+}
+
+void Odometry2DPublisher::publishState(
+  const nav_msgs::msg::Odometry & odom_output,
+  const geometry_msgs::msg::AccelWithCovarianceStamped & acceleration_output)
+{
   odom_pub_->publish(odom_output);
   acceleration_pub_->publish(acceleration_output);
 
   if (params_.publish_tf) {
+    tf2_2d::Transform pose;
+    tf2::fromMsg(odom_output.pose.pose, pose);
+
     auto frame_id = odom_output.header.frame_id;
     auto child_frame_id = odom_output.child_frame_id;
 
@@ -545,4 +630,65 @@ void Odometry2DPublisher::publishTimerCallback()
   }
 }
 
+void Odometry2DPublisher::highRateOdometryCallback(const nav_msgs::msg::Odometry & msg)
+{
+  tf2::fromMsg(msg.twist.twist.linear, velocity_linear_);
+  if (params_.high_rate_imu_topic.empty()) {
+    velocity_angular_ = msg.twist.twist.angular.z;
+  }
+
+  integrateAndPublish(msg.header.stamp);
+}
+
+void Odometry2DPublisher::highRateImuCallback(const sensor_msgs::msg::Imu & msg)
+{
+  velocity_angular_ = msg.angular_velocity.z;
+
+  integrateAndPublish(msg.header.stamp);
+}
+
+void Odometry2DPublisher::integrateAndPublish(const rclcpp::Time & stamp)
+{
+  // Restart the integration from the latest optimized state if a new one has been received
+  auto latest_state = std::atomic_load(&latest_state_);
+  if (latest_state && latest_state != integrated_state_) {
+    integrated_state_ = std::move(latest_state);
+
+    const auto & odometry = integrated_state_->odometry;
+    tf2_2d::Transform pose;
+    tf2::fromMsg(odometry.pose.pose, pose);
+    tf2_2d::Vector2 velocity_linear;
+    tf2::fromMsg(odometry.twist.twist.linear, velocity_linear);
+
+    // Without raw odometry, the optimized linear velocity is held
+    if (params_.high_rate_odometry_topic.empty()) {
+      velocity_linear_ = velocity_linear;
+    }
+
+    integrator_->setState(
+      odometry.header.stamp, pose, velocity_linear, odometry.twist.twist.angular.z);
+  }
+
+  if (!integrator_->addVelocity(stamp, velocity_linear_, velocity_angular_)) {
+    RCLCPP_WARN_STREAM_EXPRESSION(
+      logger_, delayed_throttle_filter_.isEnabled() && !integrated_state_,
+      "No valid state data yet. Delaying the high-rate output.");
+    return;
+  }
+
+  auto odom_output = integrated_state_->odometry;
+  odom_output.header.stamp = stamp;
+  odom_output.pose.pose.position.x = integrator_->pose().x();
+  odom_output.pose.pose.position.y = integrator_->pose().y();
+  odom_output.pose.pose.orientation = tf2::toMsg(integrator_->pose().getRotation());
+  odom_output.twist.twist.linear.x = integrator_->velocityLinear().x();
+  odom_output.twist.twist.linear.y = integrator_->velocityLinear().y();
+  odom_output.twist.twist.angular.z = integrator_->velocityAngular();
+
+  auto acceleration_output = integrated_state_->acceleration;
+  acceleration_output.header.stamp = stamp;
+
+  publishState(odom_output, acceleration_output);
+}
+
 }  // namespace fuse_models
@@ -0,0 +1,509 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2018, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <Eigen/Dense>
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fuse_core/async_motion_model.hpp>
+#include <fuse_core/constraint.hpp>
+#include <fuse_core/parameter.hpp>
+#include <fuse_core/transaction.hpp>
+#include <fuse_core/uuid.hpp>
+#include <fuse_core/variable.hpp>
+#include <fuse_models/omnidirectional_3d.hpp>
+#include <fuse_models/omnidirectional_3d_predict.hpp>
+#include <fuse_models/omnidirectional_3d_state_kinematic_constraint.hpp>
+#include <fuse_models/parameters/parameter_base.hpp>
+#include <fuse_variables/acceleration_linear_3d_stamped.hpp>
+#include <fuse_variables/orientation_3d_stamped.hpp>
+#include <fuse_variables/position_3d_stamped.hpp>
+#include <fuse_variables/stamped.hpp>
+#include <fuse_variables/velocity_angular_3d_stamped.hpp>
+#include <fuse_variables/velocity_linear_3d_stamped.hpp>
+#include <pluginlib/class_list_macros.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+// Register this motion model with ROS as a plugin.
+PLUGINLIB_EXPORT_CLASS(fuse_models::Omnidirectional3D, fuse_core::MotionModel)
+
+namespace fuse_models
+{
+
+Omnidirectional3D::Omnidirectional3D()
+: fuse_core::AsyncMotionModel(1),
+  logger_(rclcpp::get_logger("uninitialized")),
+  buffer_length_(rclcpp::Duration::max()),
+  device_id_(fuse_core::uuid::NIL),
+  timestamp_manager_(&Omnidirectional3D::generateMotionModel, this, rclcpp::Duration::max())
+{
+}
+
+void Omnidirectional3D::print(std::ostream & stream) const
+{
+  stream << "state history:\n";
+  for (const auto & state : state_history_) {
+    stream << "- stamp: " << state.first.nanoseconds() << "\n";
+    state.second.print(stream);
+  }
+}
+
+void Omnidirectional3D::StateHistoryElement::print(std::ostream & stream) const
+{
+  stream << "  position uuid: " << position_uuid << "\n"
+         << "  orientation uuid: " << orientation_uuid << "\n"
+         << "  velocity linear uuid: " << vel_linear_uuid << "\n"
+         << "  velocity angular uuid: " << vel_angular_uuid << "\n"
+         << "  acceleration linear uuid: " << acc_linear_uuid << "\n"
+         << "  position: " << position.transpose() << "\n"
+         << "  orientation: " << orientation.transpose() << "\n"
+         << "  velocity linear: " << velocity_linear.transpose() << "\n"
+         << "  velocity angular: " << velocity_angular.transpose() << "\n"
+         << "  acceleration linear: " << acceleration_linear.transpose() << "\n";
+}
+
+void Omnidirectional3D::StateHistoryElement::validate() const
+{
+  if (!position.allFinite()) {
+    throw std::runtime_error("Invalid position " + fuse_core::to_string(position.transpose()));
+  }
+
+  if (!orientation.allFinite()) {
+    throw std::runtime_error(
+            "Invalid orientation " + fuse_core::to_string(orientation.transpose()));
+  }
+
+  if (!velocity_linear.allFinite()) {
+    throw std::runtime_error(
+            "Invalid linear velocity " + fuse_core::to_string(velocity_linear.transpose()));
+  }
+
+  if (!velocity_angular.allFinite()) {
+    throw std::runtime_error(
+            "Invalid angular velocity " + fuse_core::to_string(velocity_angular.transpose()));
+  }
+
+  if (!acceleration_linear.allFinite()) {
+    throw std::runtime_error(
+            "Invalid linear acceleration " +
+            fuse_core::to_string(acceleration_linear.transpose()));
+  }
+}
+
+bool Omnidirectional3D::applyCallback(fuse_core::Transaction & transaction)
+{
+  // Use the timestamp manager to generate just the required motion model segments. The timestamp
+  // manager, in turn, makes calls to the generateMotionModel() function.
+  try {
+    // Now actually generate the motion model segments
+    timestamp_manager_.query(transaction, true);
+  } catch (const std::exception & e) {
+    RCLCPP_ERROR_STREAM_THROTTLE(
+      logger_, *clock_, 10.0 * 1000,
+      "An error occurred while completing the motion model query. Error: " << e.what());
+    return false;
+  }
+  return true;
+}
+
+void Omnidirectional3D::onGraphUpdate(fuse_core::Graph::ConstSharedPtr graph)
+{
+  // Only keep the graph here. The states are updated with its values when generating the motion
+  // models that use them, like in the Unicycle2D motion model.
+  graph_ = std::move(graph);
+  ++graph_update_;
+  purgeStateHistory(state_history_, buffer_length_);
+}
+
+void Omnidirectional3D::initialize(
+  fuse_core::node_interfaces::NodeInterfaces<ALL_FUSE_CORE_NODE_INTERFACES> interfaces,
+  const std::string & name)
+{
+  interfaces_ = interfaces;
+  fuse_core::AsyncMotionModel::initialize(interfaces, name);
+}
+
+void Omnidirectional3D::onInit()
+{
+  logger_ = interfaces_.get_node_logging_interface()->get_logger();
+  clock_ = interfaces_.get_node_clock_interface()->get_clock();
+
+  std::vector<double> process_noise_diagonal;
+  process_noise_diagonal =
+    fuse_core::getParam(
+    interfaces_, fuse_core::joinParameterName(
+      name_,
+      "process_noise_diagonal"),
+    process_noise_diagonal);
+
+  if (process_noise_diagonal.size() != 15) {
+    throw std::runtime_error("Process noise diagonal must be of length 15!");
+  }
+
+  process_noise_covariance_ =
+    Eigen::Map<const Eigen::Matrix<double, 15, 1>>(process_noise_diagonal.data()).asDiagonal();
+
+  disable_checks_ =
+    fuse_core::getParam(
+    interfaces_, fuse_core::joinParameterName(
+      name_,
+      "disable_checks"),
+    disable_checks_);
+
+  double buffer_length = 3.0;
+  buffer_length =
+    fuse_core::getParam(
+    interfaces_, fuse_core::joinParameterName(
+      name_,
+      "buffer_length"),
+    buffer_length);
+
+  if (buffer_length < 0.0) {
+    throw std::runtime_error(
+            "Invalid negative buffer length of " + std::to_string(buffer_length) + " specified.");
+  }
+
+  buffer_length_ =
+    (buffer_length ==
+    0.0) ? rclcpp::Duration::max() : rclcpp::Duration::from_seconds(buffer_length);
+  timestamp_manager_.bufferLength(buffer_length_);
+
+  device_id_ = fuse_variables::loadDeviceId(interfaces_);
+}
+
+void Omnidirectional3D::onStart()
+{
+  timestamp_manager_.clear();
+  state_history_.clear();
+  graph_.reset();
+}
+
+void Omnidirectional3D::generateMotionModel(
+  const rclcpp::Time & beginning_stamp,
+  const rclcpp::Time & ending_stamp,
+  std::vector<fuse_core::Constraint::SharedPtr> & constraints,
+  std::vector<fuse_core::Variable::SharedPtr> & variables)
+{
+  assert(
+    beginning_stamp < ending_stamp ||
+    (beginning_stamp == ending_stamp && state_history_.empty()));
+
+  StateHistoryElement base_state;
+  rclcpp::Time base_time{0, 0, RCL_ROS_TIME};
+
+  // Find an entry that is > beginning_stamp
+  // The entry that is <= will be the one before it
+  auto base_state_pair_it = state_history_.upper_bound(beginning_stamp);
+  if (base_state_pair_it == state_history_.begin()) {
+    RCLCPP_WARN_STREAM_EXPRESSION(
+      logger_, !state_history_.empty(),
+      "Unable to locate a state in this history with stamp <= "
+        << beginning_stamp.nanoseconds() << ". Variables will all be initialized to 0.");
+    base_time = beginning_stamp;
+  } else {
+    --base_state_pair_it;
+    if (graph_) {
+      updateStateHistoryEstimate(*graph_, state_history_, base_state_pair_it, graph_update_);
+    }
+    base_time = base_state_pair_it->first;
+    base_state = base_state_pair_it->second;
+  }
+
+  StateHistoryElement state1;
+
+  // If the nearest state we had was before the beginning stamp, we need to project that state to
+  // the beginning stamp
+  if (base_time != beginning_stamp) {
+    predict(base_state, (beginning_stamp - base_time).seconds(), state1);
+  } else {
+    state1 = base_state;
+  }
+
+  // If dt is zero, we only need to update the state history:
+  const double dt = (ending_stamp - beginning_stamp).seconds();
+
+  if (dt == 0.0) {
+    state1.position_uuid = fuse_variables::Position3DStamped(beginning_stamp, device_id_).uuid();
+    state1.orientation_uuid =
+      fuse_variables::Orientation3DStamped(beginning_stamp, device_id_).uuid();
+    state1.vel_linear_uuid =
+      fuse_variables::VelocityLinear3DStamped(beginning_stamp, device_id_).uuid();
+    state1.vel_angular_uuid =
+      fuse_variables::VelocityAngular3DStamped(beginning_stamp, device_id_).uuid();
+    state1.acc_linear_uuid =
+      fuse_variables::AccelerationLinear3DStamped(beginning_stamp, device_id_).uuid();
+
+    state1.graph_update = graph_update_;
+    state_history_.emplace(beginning_stamp, std::move(state1));
+
+    return;
+  }
+
+  // Now predict to get an initial guess for the state at the ending stamp
+  StateHistoryElement state2;
+  predict(state1, dt, state2);
+
+  // Define the fuse variables required for this constraint
+  auto position1 = fuse_variables::Position3DStamped::make_shared(beginning_stamp, device_id_);
+  auto orientation1 =
+    fuse_variables::Orientation3DStamped::make_shared(beginning_stamp, device_id_);
+  auto velocity_linear1 = fuse_variables::VelocityLinear3DStamped::make_shared(
+    beginning_stamp,
+    device_id_);
+  auto velocity_angular1 = fuse_variables::VelocityAngular3DStamped::make_shared(
+    beginning_stamp,
+    device_id_);
+  auto acceleration_linear1 = fuse_variables::AccelerationLinear3DStamped::make_shared(
+    beginning_stamp, device_id_);
+  auto position2 = fuse_variables::Position3DStamped::make_shared(ending_stamp, device_id_);
+  auto orientation2 = fuse_variables::Orientation3DStamped::make_shared(ending_stamp, device_id_);
+  auto velocity_linear2 = fuse_variables::VelocityLinear3DStamped::make_shared(
+    ending_stamp,
+    device_id_);
+  auto velocity_angular2 = fuse_variables::VelocityAngular3DStamped::make_shared(
+    ending_stamp,
+    device_id_);
+  auto acceleration_linear2 = fuse_variables::AccelerationLinear3DStamped::make_shared(
+    ending_stamp,
+    device_id_);
+
+  // The variables store their components in the same order as the state history elements
+  Eigen::Map<fuse_core::Vector3d>(position1->data()) = state1.position;
+  Eigen::Map<fuse_core::Vector4d>(orientation1->data()) = state1.orientation;
+  Eigen::Map<fuse_core::Vector3d>(velocity_linear1->data()) = state1.velocity_linear;
+  Eigen::Map<fuse_core::Vector3d>(velocity_angular1->data()) = state1.velocity_angular;
+  Eigen::Map<fuse_core::Vector3d>(acceleration_linear1->data()) = state1.acceleration_linear;
+  Eigen::Map<fuse_core::Vector3d>(position2->data()) = state2.position;
+  Eigen::Map<fuse_core::Vector4d>(orientation2->data()) = state2.orientation;
+  Eigen::Map<fuse_core::Vector3d>(velocity_linear2->data()) = state2.velocity_linear;
+  Eigen::Map<fuse_core::Vector3d>(velocity_angular2->data()) = state2.velocity_angular;
+  Eigen::Map<fuse_core::Vector3d>(acceleration_linear2->data()) = state2.acceleration_linear;
+
+  state1.position_uuid = position1->uuid();
+  state1.orientation_uuid = orientation1->uuid();
+  state1.vel_linear_uuid = velocity_linear1->uuid();
+  state1.vel_angular_uuid = velocity_angular1->uuid();
+  state1.acc_linear_uuid = acceleration_linear1->uuid();
+  state2.position_uuid = position2->uuid();
+  state2.orientation_uuid = orientation2->uuid();
+  state2.vel_linear_uuid = velocity_linear2->uuid();
+  state2.vel_angular_uuid = velocity_angular2->uuid();
+  state2.acc_linear_uuid = acceleration_linear2->uuid();
+
+  state1.graph_update = graph_update_;
+  state2.graph_update = graph_update_;
+
+  // Validate
+  const Matrix15d process_noise_covariance = process_noise_covariance_ * dt;
+
+  if (!disable_checks_) {
+    try {
+      validateMotionModel(state1, state2, process_noise_covariance);
+    } catch (const std::runtime_error & ex) {
+      RCLCPP_ERROR_STREAM_THROTTLE(
+        logger_, *clock_, 10.0 * 1000,
+        "Invalid '" << name_ << "' motion model: " << ex.what());
+      return;
+    }
+  }
+
+  state_history_.emplace(beginning_stamp, std::move(state1));
+  state_history_.emplace(ending_stamp, std::move(state2));
+
+  // Create the constraints for this motion model segment
+  auto constraint = fuse_models::Omnidirectional3DStateKinematicConstraint::make_shared(
+    name(),
+    *position1,
+    *orientation1,
+    *velocity_linear1,
+    *velocity_angular1,
+    *acceleration_linear1,
+    *position2,
+    *orientation2,
+    *velocity_linear2,
+    *velocity_angular2,
+    *acceleration_linear2,
+    process_noise_covariance);
+
+  // Update the output variables
+  constraints.push_back(constraint);
+  variables.push_back(position1);
+  variables.push_back(orientation1);
+  variables.push_back(velocity_linear1);
+  variables.push_back(velocity_angular1);
+  variables.push_back(acceleration_linear1);
+  variables.push_back(position2);
+  variables.push_back(orientation2);
+  variables.push_back(velocity_linear2);
+  variables.push_back(velocity_angular2);
+  variables.push_back(acceleration_linear2);
+}
+
+void Omnidirectional3D::predict(
+  const StateHistoryElement & state1,
+  const double dt,
+  StateHistoryElement & state2)
+{
+  predictOmnidirectional3D(
+    state1.position.data(),
+    state1.orientation.data(),
+    state1.velocity_linear.data(),
+    state1.velocity_angular.data(),
+    state1.acceleration_linear.data(),
+    dt,
+    state2.position.data(),
+    state2.orientation.data(),
+    state2.velocity_linear.data(),
+    state2.velocity_angular.data(),
+    state2.acceleration_linear.data());
+}
+
+void Omnidirectional3D::purgeStateHistory(
+  StateHistory & state_history,
+  const rclcpp::Duration & buffer_length)
+{
+  if (state_history.empty()) {
+    return;
+  }
+
+  // Compute the expiration time carefully, as ROS can't handle negative times
+  const auto & ending_stamp = state_history.rbegin()->first;
+
+  rclcpp::Time expiration_time;
+  if (ending_stamp.seconds() > buffer_length.seconds()) {
+    expiration_time = ending_stamp - buffer_length;
+  } else {
+    // NOTE(CH3): Uninitialized. But okay because it's just used for comparison.
+    expiration_time = rclcpp::Time(0, 0, ending_stamp.get_clock_type());
+  }
+
+  // Remove state history elements before the expiration time.
+  // Be careful to ensure that:
+  //  - at least one entry remains at all times
+  //  - the history covers *at least* until the expiration time. Longer is acceptable.
+  auto expiration_iter = state_history.upper_bound(expiration_time);
+  if (expiration_iter != state_history.begin()) {
+    // expiration_iter points to the first element > expiration_time.
+    // Back up one entry, to a point that is <= expiration_time
+    state_history.erase(state_history.begin(), std::prev(expiration_iter));
+  }
+}
+
+void Omnidirectional3D::updateStateHistoryEstimate(
+  const fuse_core::Graph & graph,
+  StateHistory & state_history,
+  StateHistory::iterator state_iter,
+  const uint64_t graph_update)
+{
+  // Walk back from the requested state until a state that is already up to date, in the graph, or
+  // the oldest one. The states walked over are not in the graph yet, so their values are predicted
+  // from the previous state.
+  auto updated_iter = state_iter;
+  while (updated_iter->second.graph_update != graph_update) {
+    auto & current_state = updated_iter->second;
+    if (graph.variableExists(current_state.position_uuid) &&
+      graph.variableExists(current_state.orientation_uuid) &&
+      graph.variableExists(current_state.vel_linear_uuid) &&
+      graph.variableExists(current_state.vel_angular_uuid) &&
+      graph.variableExists(current_state.acc_linear_uuid))
+    {
+      // This state does exist in the graph. Update it directly.
+      current_state.position = Eigen::Map<const fuse_core::Vector3d>(
+        graph.getVariable(current_state.position_uuid).data());
+      current_state.orientation = Eigen::Map<const fuse_core::Vector4d>(
+        graph.getVariable(current_state.orientation_uuid).data());
+      current_state.velocity_linear = Eigen::Map<const fuse_core::Vector3d>(
+        graph.getVariable(current_state.vel_linear_uuid).data());
+      current_state.velocity_angular = Eigen::Map<const fuse_core::Vector3d>(
+        graph.getVariable(current_state.vel_angular_uuid).data());
+      current_state.acceleration_linear = Eigen::Map<const fuse_core::Vector3d>(
+        graph.getVariable(current_state.acc_linear_uuid).data());
+      current_state.graph_update = graph_update;
+    } else if (updated_iter == state_history.begin()) {
+      // There is no previous state to predict this state from, so keep its value
+      current_state.graph_update = graph_update;
+    } else {
+      --updated_iter;
+    }
+  }
+
+  // The states after the updated one are not in the graph yet, so they are predicted from the
+  // corrected state before each one.
+  for (auto previous_iter = updated_iter; previous_iter != state_iter; ++previous_iter) {
+    const auto current_iter = std::next(previous_iter);
+    predict(
+      previous_iter->second, (current_iter->first - previous_iter->first).seconds(),
+      current_iter->second);
+    current_iter->second.graph_update = graph_update;
+  }
+}
+
+void Omnidirectional3D::validateMotionModel(
+  const StateHistoryElement & state1, const StateHistoryElement & state2,
+  const Matrix15d & process_noise_covariance)
+{
+  try {
+    state1.validate();
+  } catch (const std::runtime_error & ex) {
+    throw std::runtime_error("Invalid state #1: " + std::string(ex.what()));
+  }
+
+  try {
+    state2.validate();
+  } catch (const std::runtime_error & ex) {
+    throw std::runtime_error("Invalid state #2: " + std::string(ex.what()));
+  }
+
+  if (!fuse_core::isSymmetric(process_noise_covariance)) {
+    throw std::runtime_error(
+            "Invalid process noise covariance: Non-symmetric partial covariance matrix\n" +
+            fuse_core::to_string(process_noise_covariance, Eigen::FullPrecision));
+  }
+
+  if (!fuse_core::isPositiveDefinite(process_noise_covariance)) {
+    throw std::runtime_error(
+            "Invalid process noise covariance: Non-positive-definite partial covariance matrix\n" +
+            fuse_core::to_string(process_noise_covariance, Eigen::FullPrecision));
+  }
+}
+
+std::ostream & operator<<(std::ostream & stream, const Omnidirectional3D & omnidirectional_3d)
+{
+  omnidirectional_3d.print(stream);
+  return stream;
+}
+
+}  // namespace fuse_models
@@ -98,10 +98,26 @@ void Pose2D::onInit()
     interfaces_.get_node_parameters_interface(),
     interfaces_.get_node_topics_interface()
   );
+
+  if (params_.cache_static_transforms) {
+    static_transform_cache_ = std::make_unique<common::StaticTransformCache>();
+    static_transform_ = std::make_unique<common::StaticTransformCache::FramePair>(
+      *static_transform_cache_, params_.target_frame);
+  }
+
+  if (params_.mahalanobis_threshold > 0.0) {
+    gate_ = std::make_unique<common::MahalanobisGate>(
+      params_.mahalanobis_threshold, device_id_, params_.mahalanobis_pose_noise_rate,
+      fuse_core::Matrix3d::Zero(), params_.mahalanobis_max_rejections);
+  }
 }
 
 void Pose2D::onStart()
 {
+  if (static_transform_cache_) {
+    static_transform_cache_->subscribe(interfaces_, cb_group_);
+  }
+
   if (!params_.position_indices.empty() ||
     !params_.orientation_indices.empty())
   {
@@ -126,6 +142,21 @@ void Pose2D::onStart()
 void Pose2D::onStop()
 {
   sub_.reset();
+
+  if (static_transform_cache_) {
+    static_transform_cache_->unsubscribe();
+  }
+
+  if (gate_) {
+    gate_->update(nullptr);
+  }
+}
+
+void Pose2D::onGraphUpdate(fuse_core::Graph::ConstSharedPtr graph)
+{
+  if (gate_) {
+    gate_->update(std::move(graph));
+  }
 }
 
 void Pose2D::process(const geometry_msgs::msg::PoseWithCovarianceStamped & msg)
@@ -150,7 +181,9 @@ void Pose2D::process(const geometry_msgs::msg::PoseWithCovarianceStamped & msg)
       *tf_buffer_,
       validate,
       *transaction,
-      params_.tf_timeout);
+      params_.tf_timeout,
+      static_transform_.get(),
+      gate_.get());
   }
 
   // Send the transaction object to the plugin's parent
@@ -165,7 +198,10 @@ void Pose2D::processDifferential(
   transformed_pose->header.frame_id =
     params_.target_frame.empty() ? pose.header.frame_id : params_.target_frame;
 
-  if (!common::transformMessage(*tf_buffer_, pose, *transformed_pose)) {
+  if (!common::transformMessage(
+      *tf_buffer_, pose, *transformed_pose, rclcpp::Duration(0, 0),
+      static_transform_.get()))
+  {
     RCLCPP_WARN_STREAM_THROTTLE(
       logger_, *clock_, 5.0 * 1000,
       "Cannot transform pose message with stamp " << rclcpp::Time(pose.header.stamp).nanoseconds()
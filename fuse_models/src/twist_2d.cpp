@@ -33,6 +33,7 @@
  */
 #include <fuse_core/transaction.hpp>
 #include <fuse_core/uuid.hpp>
+#include <fuse_models/common/aggregation.hpp>
 #include <fuse_models/common/sensor_proc.hpp>
 #include <fuse_models/twist_2d.hpp>
 #include <geometry_msgs/msg/twist_with_covariance_stamped.hpp>
@@ -78,6 +79,13 @@ void Twist2D::onInit()
     throttled_callback_.setClock(clock_);
   }
 
+  if (params_.throttle_aggregate) {
+    throttled_callback_.setAggregateCallback(
+      [](auto & pending, const auto & message) {
+        common::aggregate(pending, message);
+      });
+  }
+
   if (params_.linear_indices.empty() &&
     params_.angular_indices.empty())
   {
@@ -95,10 +103,20 @@ void Twist2D::onInit()
     interfaces_.get_node_parameters_interface(),
     interfaces_.get_node_topics_interface()
   );
+
+  if (params_.cache_static_transforms) {
+    static_transform_cache_ = std::make_unique<common::StaticTransformCache>();
+    static_transform_ = std::make_unique<common::StaticTransformCache::FramePair>(
+      *static_transform_cache_, params_.target_frame);
+  }
 }
 
 void Twist2D::onStart()
 {
+  if (static_transform_cache_) {
+    static_transform_cache_->subscribe(interfaces_, cb_group_);
+  }
+
   if (!params_.linear_indices.empty() ||
     !params_.angular_indices.empty())
   {
@@ -110,8 +128,7 @@ void Twist2D::onStart()
       params_.topic,
       params_.queue_size,
       std::bind(
-        &TwistThrottledCallback::callback<
-          const geometry_msgs::msg::TwistWithCovarianceStamped &>,
+        &TwistThrottledCallback::callback,
         &throttled_callback_,
         std::placeholders::_1
       ),
@@ -123,6 +140,11 @@ void Twist2D::onStart()
 void Twist2D::onStop()
 {
   sub_.reset();
+  throttled_callback_.reset();
+
+  if (static_transform_cache_) {
+    static_transform_cache_->unsubscribe();
+  }
 }
 
 void Twist2D::process(const geometry_msgs::msg::TwistWithCovarianceStamped & msg)
@@ -143,7 +165,8 @@ void Twist2D::process(const geometry_msgs::msg::TwistWithCovarianceStamped & msg
     *tf_buffer_,
     !params_.disable_checks,
     *transaction,
-    params_.tf_timeout);
+    params_.tf_timeout,
+    static_transform_.get());
 
   // Send the transaction object to the plugin's parent
   sendTransaction(transaction);
@@ -186,7 +186,11 @@ bool Unicycle2D::applyCallback(fuse_core::Transaction & transaction)
 
 void Unicycle2D::onGraphUpdate(fuse_core::Graph::ConstSharedPtr graph)
 {
-  updateStateHistoryEstimates(*graph, state_history_, buffer_length_);
+  // Only keep the graph here. The states are updated with its values when generating the motion
+  // models that use them, instead of walking the whole state history for every graph.
+  graph_ = std::move(graph);
+  ++graph_update_;
+  purgeStateHistory(state_history_, buffer_length_);
 }
 
 void Unicycle2D::initialize(
@@ -261,6 +265,7 @@ void Unicycle2D::onStart()
 {
   timestamp_manager_.clear();
   state_history_.clear();
+  graph_.reset();
 }
 
 void Unicycle2D::generateMotionModel(
@@ -287,6 +292,9 @@ void Unicycle2D::generateMotionModel(
     base_time = beginning_stamp;
   } else {
     --base_state_pair_it;
+    if (graph_) {
+      updateStateHistoryEstimate(*graph_, state_history_, base_state_pair_it, graph_update_);
+    }
     base_time = base_state_pair_it->first;
     base_state = base_state_pair_it->second;
   }
@@ -323,6 +331,7 @@ void Unicycle2D::generateMotionModel(
     state1.acc_linear_uuid =
       fuse_variables::AccelerationLinear2DStamped(beginning_stamp, device_id_).uuid();
 
+    state1.graph_update = graph_update_;
     state_history_.emplace(beginning_stamp, std::move(state1));
 
     return;
@@ -396,6 +405,8 @@ void Unicycle2D::generateMotionModel(
   state2.vel_yaw_uuid = velocity_yaw2->uuid();
   state2.acc_linear_uuid = acceleration_linear2->uuid();
 
+  state1.graph_update = graph_update_;
+  state2.graph_update = graph_update_;
   state_history_.emplace(beginning_stamp, std::move(state1));
   state_history_.emplace(ending_stamp, std::move(state2));
 
@@ -450,8 +461,7 @@ void Unicycle2D::generateMotionModel(
   variables.push_back(acceleration_linear2);
 }
 
-void Unicycle2D::updateStateHistoryEstimates(
-  const fuse_core::Graph & graph,
+void Unicycle2D::purgeStateHistory(
   StateHistory & state_history,
   const rclcpp::Duration & buffer_length)
 {
@@ -480,15 +490,20 @@ void Unicycle2D::updateStateHistoryEstimates(
     // Back up one entry, to a point that is <= expiration_time
     state_history.erase(state_history.begin(), std::prev(expiration_iter));
   }
+}
 
-  // Update the states in the state history with information from the graph
-  // If a state is not in the graph yet, predict the state in question from the closest previous
-  // state
-  for (auto current_iter = state_history.begin(); current_iter != state_history.end();
-    ++current_iter)
-  {
-    const auto & current_stamp = current_iter->first;
-    auto & current_state = current_iter->second;
+void Unicycle2D::updateStateHistoryEstimate(
+  const fuse_core::Graph & graph,
+  StateHistory & state_history,
+  StateHistory::iterator state_iter,
+  const uint64_t graph_update)
+{
+  // Walk back from the requested state until a state that is already up to date, in the graph, or
+  // the oldest one. The states walked over are not in the graph yet, so their values are predicted
+  // from the previous state.
+  auto updated_iter = state_iter;
+  while (updated_iter->second.graph_update != graph_update) {
+    auto & current_state = updated_iter->second;
     if (graph.variableExists(current_state.position_uuid) &&
       graph.variableExists(current_state.yaw_uuid) &&
       graph.variableExists(current_state.vel_linear_uuid) &&
@@ -518,27 +533,38 @@ void Unicycle2D::updateStateHistoryEstimates(
       current_state.acceleration_linear.setY(
         acc_linear.data()[fuse_variables::
         AccelerationLinear2DStamped::Y]);
-    } else if (current_iter != state_history.begin()) {
-      auto previous_iter = std::prev(current_iter);
-      const auto & previous_stamp = previous_iter->first;
-      const auto & previous_state = previous_iter->second;
-
-      // This state is not in the graph yet, so we can't update/correct the value in our state
-      // history. However, the state *before* this one may have been corrected (or one of its
-      // predecessors may have been), so we can use that corrected value, along with our prediction
-      // logic, to provide a more accurate update to this state.
-      predict(
-        previous_state.pose,
-        previous_state.velocity_linear,
-        previous_state.velocity_yaw,
-        previous_state.acceleration_linear,
-        (current_stamp - previous_stamp).seconds(),
-        current_state.pose,
-        current_state.velocity_linear,
-        current_state.velocity_yaw,
-        current_state.acceleration_linear);
+      current_state.graph_update = graph_update;
+    } else if (updated_iter == state_history.begin()) {
+      // There is no previous state to predict this state from, so keep its value
+      current_state.graph_update = graph_update;
+    } else {
+      --updated_iter;
     }
   }
+
+  // The states after the updated one are not in the graph yet, so we can't update/correct their
+  // values in our state history. However, the state *before* each one may have been corrected (or
+  // one of its predecessors may have been), so we can use that corrected value, along with our
+  // prediction logic, to provide a more accurate update to each state.
+  for (auto previous_iter = updated_iter; previous_iter != state_iter; ++previous_iter) {
+    const auto current_iter = std::next(previous_iter);
+    const auto & previous_stamp = previous_iter->first;
+    const auto & previous_state = previous_iter->second;
+    const auto & current_stamp = current_iter->first;
+    auto & current_state = current_iter->second;
+
+    predict(
+      previous_state.pose,
+      previous_state.velocity_linear,
+      previous_state.velocity_yaw,
+      previous_state.acceleration_linear,
+      (current_stamp - previous_stamp).seconds(),
+      current_state.pose,
+      current_state.velocity_linear,
+      current_state.velocity_yaw,
+      current_state.acceleration_linear);
+    current_state.graph_update = graph_update;
+  }
 }
 
 void Unicycle2D::validateMotionModel(
@@ -378,6 +378,11 @@ void Unicycle2DIgnition::sendPrior(const geometry_msgs::msg::PoseWithCovarianceS
     *linear_acceleration,
     fuse_core::Vector2d(linear_acceleration->x(), linear_acceleration->y()),
     linear_acceleration_cov);
+  position_constraint->jacobianThreshold(params_.jacobian_threshold);
+  orientation_constraint->jacobianThreshold(params_.jacobian_threshold);
+  linear_velocity_constraint->jacobianThreshold(params_.jacobian_threshold);
+  angular_velocity_constraint->jacobianThreshold(params_.jacobian_threshold);
+  linear_acceleration_constraint->jacobianThreshold(params_.jacobian_threshold);
 
   // Create the transaction
   auto transaction = fuse_core::Transaction::make_shared();
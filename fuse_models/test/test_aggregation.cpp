@@ -0,0 +1,169 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2018, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+
+#include <fuse_core/eigen.hpp>
+#include <fuse_core/eigen_gtest.hpp>
+#include <fuse_models/common/aggregation.hpp>
+#include <geometry_msgs/msg/twist_with_covariance_stamped.hpp>
+#include <nav_msgs/msg/odometry.hpp>
+#include <sensor_msgs/msg/imu.hpp>
+
+using fuse_models::common::aggregate;
+using fuse_models::common::aggregateInformationWeighted;
+
+TEST(Aggregation, InformationWeighted)
+{
+  // Two measurements with the same covariance average their means and halve the covariance, while
+  // a measurement without information in a dimension does not change it
+  fuse_core::Vector3d mean(1.0, 2.0, 3.0);
+  std::array<double, 9> covariance = {1.0, 0.0, 0.0, 0.0, 2.0, 0.0, 0.0, 0.0, 4.0};
+  const fuse_core::Vector3d other_mean(3.0, 4.0, 7.0);
+  const std::array<double, 9> other_covariance = {1.0, 0.0, 0.0, 0.0, -1.0, 0.0, 0.0, 0.0, 4.0};
+
+  aggregateInformationWeighted<3>(mean, covariance, other_mean, other_covariance);
+
+  EXPECT_MATRIX_NEAR(fuse_core::Vector3d(2.0, 2.0, 5.0), mean, 1.0e-12);
+  const std::array<double, 9> expected_covariance = {
+    0.5, 0.0, 0.0, 0.0, 2.0, 0.0, 0.0, 0.0, 2.0};
+  for (size_t i = 0; i < covariance.size(); ++i) {
+    EXPECT_NEAR(expected_covariance[i], covariance[i], 1.0e-12) << "index " << i;
+  }
+
+  // A more certain measurement pulls the mean towards it
+  fuse_core::Vector3d weighted_mean(0.0, 0.0, 0.0);
+  std::array<double, 9> weighted_covariance = {1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0};
+  const std::array<double, 9> certain_covariance = {
+    0.25, 0.0, 0.0, 0.0, 0.25, 0.0, 0.0, 0.0, 0.25};
+  aggregateInformationWeighted<3>(
+    weighted_mean, weighted_covariance, fuse_core::Vector3d(5.0, 5.0, 5.0), certain_covariance);
+  EXPECT_MATRIX_NEAR(fuse_core::Vector3d(4.0, 4.0, 4.0), weighted_mean, 1.0e-12);
+  EXPECT_NEAR(0.2, weighted_covariance[0], 1.0e-12);
+}
+
+TEST(Aggregation, Twist)
+{
+  geometry_msgs::msg::TwistWithCovarianceStamped twist;
+  twist.header.stamp.sec = 1;
+  twist.twist.twist.linear.x = 1.0;
+  twist.twist.twist.angular.z = 0.1;
+  twist.twist.covariance[0] = 0.1;
+  twist.twist.covariance[35] = 0.01;
+
+  geometry_msgs::msg::TwistWithCovarianceStamped other = twist;
+  other.header.stamp.sec = 2;
+  other.twist.twist.linear.x = 2.0;
+  other.twist.twist.angular.z = 0.3;
+
+  aggregate(twist, other);
+
+  EXPECT_EQ(2, twist.header.stamp.sec);
+  EXPECT_NEAR(1.5, twist.twist.twist.linear.x, 1.0e-12);
+  EXPECT_NEAR(0.2, twist.twist.twist.angular.z, 1.0e-12);
+  EXPECT_NEAR(0.05, twist.twist.covariance[0], 1.0e-12);
+  EXPECT_NEAR(0.005, twist.twist.covariance[35], 1.0e-12);
+
+  // The unused dimensions keep the newer values
+  EXPECT_EQ(0.0, twist.twist.covariance[7]);
+  EXPECT_EQ(0.0, twist.twist.twist.linear.y);
+}
+
+TEST(Aggregation, OdometryKeepsTheNewestPose)
+{
+  nav_msgs::msg::Odometry odometry;
+  odometry.header.stamp.sec = 1;
+  odometry.pose.pose.position.x = 1.0;
+  odometry.pose.covariance[0] = 1.0;
+  odometry.twist.twist.linear.x = 1.0;
+  odometry.twist.covariance[0] = 0.1;
+
+  nav_msgs::msg::Odometry other = odometry;
+  other.header.stamp.sec = 2;
+  other.pose.pose.position.x = 2.0;
+  other.twist.twist.linear.x = 2.0;
+
+  aggregate(odometry, other);
+
+  // The pose is passed through, while the twist is combined
+  EXPECT_EQ(2, odometry.header.stamp.sec);
+  EXPECT_EQ(2.0, odometry.pose.pose.position.x);
+  EXPECT_EQ(1.0, odometry.pose.covariance[0]);
+  EXPECT_NEAR(1.5, odometry.twist.twist.linear.x, 1.0e-12);
+  EXPECT_NEAR(0.05, odometry.twist.covariance[0], 1.0e-12);
+}
+
+TEST(Aggregation, ImuWithoutOrientation)
+{
+  sensor_msgs::msg::Imu imu;
+  imu.orientation_covariance[0] = -1.0;
+  imu.angular_velocity.z = 0.2;
+  imu.angular_velocity_covariance = {0.01, 0.0, 0.0, 0.0, 0.01, 0.0, 0.0, 0.0, 0.01};
+  imu.linear_acceleration.x = 0.5;
+  imu.linear_acceleration_covariance = {0.1, 0.0, 0.0, 0.0, 0.1, 0.0, 0.0, 0.0, 0.1};
+
+  sensor_msgs::msg::Imu other = imu;
+  other.angular_velocity.z = 0.4;
+  other.linear_acceleration.x = 0.7;
+
+  aggregate(imu, other);
+
+  // The orientation is still flagged as not available
+  EXPECT_EQ(-1.0, imu.orientation_covariance[0]);
+  EXPECT_NEAR(0.3, imu.angular_velocity.z, 1.0e-12);
+  EXPECT_NEAR(0.005, imu.angular_velocity_covariance[8], 1.0e-12);
+  EXPECT_NEAR(0.6, imu.linear_acceleration.x, 1.0e-12);
+  EXPECT_NEAR(0.05, imu.linear_acceleration_covariance[0], 1.0e-12);
+}
+
+TEST(Aggregation, ImuKeepsTheNewestOrientation)
+{
+  sensor_msgs::msg::Imu imu;
+  imu.orientation.z = std::sin(0.05);
+  imu.orientation.w = std::cos(0.05);
+  imu.orientation_covariance = {0.01, 0.0, 0.0, 0.0, 0.01, 0.0, 0.0, 0.0, 0.01};
+
+  sensor_msgs::msg::Imu other = imu;
+  other.orientation.z = std::sin(0.15);
+  other.orientation.w = std::cos(0.15);
+  other.orientation_covariance[8] = 0.02;
+
+  aggregate(imu, other);
+
+  EXPECT_EQ(other.orientation.z, imu.orientation.z);
+  EXPECT_EQ(other.orientation.w, imu.orientation.w);
+  EXPECT_EQ(0.02, imu.orientation_covariance[8]);
+}
@@ -0,0 +1,294 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2018, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <fuse_core/eigen.hpp>
+#include <fuse_core/eigen_gtest.hpp>
+#include <fuse_core/serialization.hpp>
+#include <fuse_core/uuid.hpp>
+#include <fuse_models/imu_2d_preintegrated_constraint.hpp>
+#include <fuse_models/imu_2d_preintegrated_cost_function.hpp>
+#include <fuse_models/imu_2d_preintegration.hpp>
+#include <fuse_variables/imu_bias_2d_stamped.hpp>
+#include <fuse_variables/orientation_2d_stamped.hpp>
+#include <fuse_variables/position_2d_stamped.hpp>
+#include <fuse_variables/velocity_linear_2d_stamped.hpp>
+
+using fuse_models::Imu2DPreintegratedConstraint;
+using fuse_models::Imu2DPreintegratedCostFunction;
+using fuse_models::Imu2DPreintegration;
+
+TEST(Imu2DPreintegration, ConstantAcceleration)
+{
+  // Integrate a constant forward acceleration over one second, with a small nominal bias
+  fuse_core::Vector3d bias;
+  bias << 0.01, 0.02, -0.03;
+  Imu2DPreintegration preintegration(1.0e-3, 1.0e-2, bias);
+
+  const fuse_core::Vector2d acceleration(1.0 + bias[1], bias[2]);
+  for (size_t i = 0; i < 100; ++i) {
+    preintegration.integrate(bias[0], acceleration, 0.01);
+  }
+
+  fuse_core::Vector5d expected;
+  expected << 0.5, 0.0, 0.0, 1.0, 0.0;
+  EXPECT_NEAR(1.0, preintegration.dt(), 1.0e-12);
+  EXPECT_MATRIX_NEAR(expected, preintegration.delta(), 1.0e-12);
+
+  // The uncertainty grows with the integration time, and it is symmetric
+  const fuse_core::Matrix5d covariance = preintegration.covariance();
+  EXPECT_MATRIX_NEAR(covariance, covariance.transpose(), 1.0e-15);
+  EXPECT_LT(0.0, covariance.diagonal().minCoeff());
+
+  // Resetting the preintegration clears the measurement
+  preintegration.reset(fuse_core::Vector3d::Zero());
+  EXPECT_EQ(0.0, preintegration.dt());
+  EXPECT_MATRIX_EQ(fuse_core::Vector5d::Zero(), preintegration.delta());
+  EXPECT_MATRIX_EQ(fuse_core::Matrix5d::Zero(), preintegration.covariance());
+}
+
+TEST(Imu2DPreintegration, BiasJacobian)
+{
+  // Integrate a turning motion with two slightly different nominal biases, and compare the change
+  // of the preintegrated measurement with its first order approximation
+  const auto integrate = [](const fuse_core::Vector3d & bias)
+    {
+      Imu2DPreintegration preintegration(1.0e-3, 1.0e-2, bias);
+      for (size_t i = 0; i < 50; ++i) {
+        const double t = 0.01 * i;
+        preintegration.integrate(
+          0.5 + 0.2 * t, fuse_core::Vector2d(0.3 * std::cos(t), 0.1 + 0.2 * t), 0.01);
+      }
+      return preintegration;
+    };
+
+  const fuse_core::Vector3d bias = fuse_core::Vector3d::Zero();
+  const auto preintegration = integrate(bias);
+
+  const double epsilon = 1.0e-6;
+  for (int i = 0; i < 3; ++i) {
+    const fuse_core::Vector3d bias_perturbed = bias + epsilon * fuse_core::Vector3d::Unit(i);
+    const fuse_core::Vector5d numeric =
+      (integrate(bias_perturbed).delta() - preintegration.delta()) / epsilon;
+    EXPECT_MATRIX_NEAR(numeric, preintegration.biasJacobian().col(i), 1.0e-5) << "bias " << i;
+  }
+}
+
+TEST(Imu2DPreintegratedCostFunction, Evaluate)
+{
+  // Integrate a turning, accelerating motion
+  Imu2DPreintegration preintegration(1.0e-3, 1.0e-2);
+  for (size_t i = 0; i < 20; ++i) {
+    preintegration.integrate(0.4, fuse_core::Vector2d(0.5, 0.2), 0.01);
+  }
+
+  fuse_core::Matrix8d covariance = fuse_core::Matrix8d::Zero();
+  covariance.topLeftCorner<5, 5>() = preintegration.covariance();
+  covariance.bottomRightCorner<3, 3>() = 1.0e-6 * fuse_core::Matrix3d::Identity();
+  const fuse_core::Matrix8d sqrt_information{covariance.inverse().llt().matrixU()};
+
+  fuse_core::Vector3d bias;
+  bias << 0.01, 0.02, -0.03;
+  const Imu2DPreintegratedCostFunction cost_function(
+    preintegration.dt(), preintegration.delta(), preintegration.biasJacobian(), bias,
+    sqrt_information);
+
+  // A second state consistent with the first one and the measurement has zero residuals
+  const fuse_core::Vector5d & delta = preintegration.delta();
+  const double yaw1 = 0.3;
+  fuse_core::Matrix2d rotation1;
+  rotation1 << std::cos(yaw1), -std::sin(yaw1), std::sin(yaw1), std::cos(yaw1);
+  fuse_core::Matrix2d rotation12;
+  rotation12 << std::cos(delta[2]), -std::sin(delta[2]), std::sin(delta[2]), std::cos(delta[2]);
+
+  const fuse_core::Vector2d position1(1.0, 2.0);
+  const fuse_core::Vector2d vel_linear1(0.8, 0.1);
+  const fuse_core::Vector2d position2 =
+    position1 + rotation1 * (vel_linear1 * preintegration.dt() + delta.head<2>());
+  const double yaw2 = yaw1 + delta[2];
+  const fuse_core::Vector2d vel_linear2 = rotation12.transpose() * (vel_linear1 + delta.tail<2>());
+
+  std::vector<double> state1 = {
+    position1.x(), position1.y(), yaw1, vel_linear1.x(), vel_linear1.y(),
+    bias[0], bias[1], bias[2]};
+  std::vector<double> state2 = {
+    position2.x(), position2.y(), yaw2, vel_linear2.x(), vel_linear2.y(),
+    bias[0], bias[1], bias[2]};
+
+  const auto parameters = [&state1, &state2]()
+    {
+      return std::vector<const double *>{
+        &state1[0], &state1[2], &state1[3], &state1[5],
+        &state2[0], &state2[2], &state2[3], &state2[5]};
+    };
+
+  const auto & block_sizes = cost_function.parameter_block_sizes();
+  const auto num_parameter_blocks = block_sizes.size();
+  const auto num_residuals = cost_function.num_residuals();
+
+  std::vector<fuse_core::MatrixXd> J(num_parameter_blocks);
+  std::vector<double *> jacobians(num_parameter_blocks);
+  for (size_t i = 0; i < num_parameter_blocks; ++i) {
+    J[i].resize(num_residuals, block_sizes[i]);
+    jacobians[i] = J[i].data();
+  }
+
+  fuse_core::Vector8d residuals;
+  EXPECT_TRUE(cost_function.Evaluate(parameters().data(), residuals.data(), jacobians.data()));
+  EXPECT_MATRIX_NEAR(fuse_core::Vector8d::Zero(), residuals, 1.0e-9);
+
+  // Perturb the states so all the Jacobian terms are exercised, and compare the analytic Jacobians
+  // with central differences
+  state1[5] += 0.002;
+  state1[6] -= 0.01;
+  state2[2] += 0.05;
+  state2[3] -= 0.1;
+  state2[7] += 0.003;
+  EXPECT_TRUE(cost_function.Evaluate(parameters().data(), residuals.data(), jacobians.data()));
+
+  const double epsilon = 1.0e-6;
+  size_t offset = 0;
+  for (size_t i = 0; i < num_parameter_blocks; ++i) {
+    auto & state = i < 4 ? state1 : state2;
+    if (i == 4) {
+      offset = 0;
+    }
+
+    fuse_core::MatrixXd numeric(num_residuals, block_sizes[i]);
+    for (int j = 0; j < block_sizes[i]; ++j) {
+      fuse_core::Vector8d residuals_plus;
+      fuse_core::Vector8d residuals_minus;
+      state[offset + j] += epsilon;
+      cost_function.Evaluate(parameters().data(), residuals_plus.data(), nullptr);
+      state[offset + j] -= 2.0 * epsilon;
+      cost_function.Evaluate(parameters().data(), residuals_minus.data(), nullptr);
+      state[offset + j] += epsilon;
+      numeric.col(j) = (residuals_plus - residuals_minus) / (2.0 * epsilon);
+    }
+
+    EXPECT_MATRIX_NEAR(numeric, J[i], 1.0e-6 * numeric.cwiseAbs().maxCoeff()) <<
+      "Jacobian " << i;
+    offset += block_sizes[i];
+  }
+}
+
+TEST(Imu2DPreintegratedConstraint, SingleStep)
+{
+  // A single IMU step leaves the measurement covariance singular, so no constraint is created
+  const rclcpp::Time stamp1(1234, 5678);
+  const rclcpp::Time stamp2(1234, 10005678);
+  fuse_variables::Position2DStamped position1(stamp1);
+  fuse_variables::Orientation2DStamped yaw1(stamp1);
+  fuse_variables::VelocityLinear2DStamped linear_velocity1(stamp1);
+  fuse_variables::ImuBias2DStamped bias1(stamp1);
+  fuse_variables::Position2DStamped position2(stamp2);
+  fuse_variables::Orientation2DStamped yaw2(stamp2);
+  fuse_variables::VelocityLinear2DStamped linear_velocity2(stamp2);
+  fuse_variables::ImuBias2DStamped bias2(stamp2);
+  const fuse_core::Matrix3d bias_covariance = 1.0e-6 * fuse_core::Matrix3d::Identity();
+
+  Imu2DPreintegration preintegration(1.0e-3, 1.0e-2);
+  preintegration.integrate(0.4, fuse_core::Vector2d(0.5, 0.2), 0.01);
+  EXPECT_EQ(1u, preintegration.steps());
+  EXPECT_THROW(
+    Imu2DPreintegratedConstraint(
+      "test", position1, yaw1, linear_velocity1, bias1, position2, yaw2, linear_velocity2, bias2,
+      preintegration, bias_covariance),
+    std::invalid_argument);
+
+  // A second step makes it positive definite
+  preintegration.integrate(0.4, fuse_core::Vector2d(0.5, 0.2), 0.01);
+  EXPECT_EQ(2u, preintegration.steps());
+  const Imu2DPreintegratedConstraint constraint(
+    "test", position1, yaw1, linear_velocity1, bias1, position2, yaw2, linear_velocity2, bias2,
+    preintegration, bias_covariance);
+  EXPECT_TRUE(constraint.sqrtInformation().allFinite());
+
+  // Resetting the preintegration clears the step count
+  preintegration.reset(fuse_core::Vector3d::Zero());
+  EXPECT_EQ(0u, preintegration.steps());
+}
+
+TEST(Imu2DPreintegratedConstraint, Serialization)
+{
+  // Construct a constraint
+  const auto device_id = fuse_core::uuid::generate("robby");
+  const rclcpp::Time stamp1(1234, 5678);
+  const rclcpp::Time stamp2(1235, 5678);
+  fuse_variables::Position2DStamped position1(stamp1, device_id);
+  fuse_variables::Orientation2DStamped yaw1(stamp1, device_id);
+  fuse_variables::VelocityLinear2DStamped linear_velocity1(stamp1, device_id);
+  fuse_variables::ImuBias2DStamped bias1(stamp1, device_id);
+  fuse_variables::Position2DStamped position2(stamp2, device_id);
+  fuse_variables::Orientation2DStamped yaw2(stamp2, device_id);
+  fuse_variables::VelocityLinear2DStamped linear_velocity2(stamp2, device_id);
+  fuse_variables::ImuBias2DStamped bias2(stamp2, device_id);
+
+  Imu2DPreintegration preintegration(1.0e-3, 1.0e-2, fuse_core::Vector3d(0.01, 0.02, -0.03));
+  for (size_t i = 0; i < 10; ++i) {
+    preintegration.integrate(0.4, fuse_core::Vector2d(0.5, 0.2), 0.01);
+  }
+
+  Imu2DPreintegratedConstraint expected(
+    "test", position1, yaw1, linear_velocity1, bias1, position2, yaw2, linear_velocity2, bias2,
+    preintegration, 1.0e-6 * fuse_core::Matrix3d::Identity());
+
+  // Serialize the constraint into an archive
+  std::stringstream stream;
+  {
+    fuse_core::TextOutputArchive archive(stream);
+    expected.serialize(archive);
+  }
+
+  // Deserialize a new constraint from that same stream
+  Imu2DPreintegratedConstraint actual;
+  {
+    fuse_core::TextInputArchive archive(stream);
+    actual.deserialize(archive);
+  }
+
+  // Compare
+  EXPECT_EQ(expected.uuid(), actual.uuid());
+  EXPECT_EQ(expected.variables(), actual.variables());
+  EXPECT_EQ(expected.dt(), actual.dt());
+  EXPECT_MATRIX_EQ(expected.delta(), actual.delta());
+  EXPECT_MATRIX_EQ(expected.biasJacobian(), actual.biasJacobian());
+  EXPECT_MATRIX_EQ(expected.bias(), actual.bias());
+  EXPECT_MATRIX_EQ(expected.sqrtInformation(), actual.sqrtInformation());
+}
@@ -0,0 +1,369 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2018, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <fuse_constraints/absolute_constraint.hpp>
+#include <fuse_constraints/absolute_pose_2d_stamped_constraint.hpp>
+#include <fuse_core/eigen.hpp>
+#include <fuse_core/uuid.hpp>
+#include <fuse_graphs/hash_graph.hpp>
+#include <fuse_models/common/mahalanobis_gate.hpp>
+#include <fuse_variables/acceleration_linear_2d_stamped.hpp>
+#include <fuse_variables/orientation_2d_stamped.hpp>
+#include <fuse_variables/position_2d_stamped.hpp>
+#include <fuse_variables/velocity_angular_2d_stamped.hpp>
+#include <fuse_variables/velocity_linear_2d_stamped.hpp>
+#include <rclcpp/time.hpp>
+
+using fuse_models::common::MahalanobisGate;
+
+namespace
+{
+
+// The 99% chi-square quantile for 3 degrees of freedom
+constexpr double threshold = 11.34;
+
+/**
+ * @brief Add a pose prior to the graph
+ */
+void addPose(
+  fuse_graphs::HashGraph & graph, const rclcpp::Time & stamp, const fuse_core::UUID & device_id,
+  const double x, const double y, const double yaw)
+{
+  auto position = fuse_variables::Position2DStamped::make_shared(stamp, device_id);
+  auto orientation = fuse_variables::Orientation2DStamped::make_shared(stamp, device_id);
+  position->x() = x;
+  position->y() = y;
+  orientation->yaw() = yaw;
+
+  fuse_core::Vector3d mean;
+  mean << x, y, yaw;
+  const fuse_core::Matrix3d covariance = 0.01 * fuse_core::Matrix3d::Identity();
+
+  graph.addVariable(position);
+  graph.addVariable(orientation);
+  graph.addConstraint(
+    fuse_constraints::AbsolutePose2DStampedConstraint::make_shared(
+      "test", *position, *orientation, mean, covariance));
+}
+
+/**
+ * @brief Add a twist prior to the graph
+ */
+void addTwist(
+  fuse_graphs::HashGraph & graph, const rclcpp::Time & stamp, const fuse_core::UUID & device_id,
+  const double x, const double y, const double yaw)
+{
+  auto velocity_linear = fuse_variables::VelocityLinear2DStamped::make_shared(stamp, device_id);
+  auto velocity_angular = fuse_variables::VelocityAngular2DStamped::make_shared(stamp, device_id);
+  velocity_linear->x() = x;
+  velocity_linear->y() = y;
+  velocity_angular->yaw() = yaw;
+
+  fuse_core::Vector2d linear_mean;
+  linear_mean << x, y;
+  fuse_core::Vector1d angular_mean;
+  angular_mean << yaw;
+
+  graph.addVariable(velocity_linear);
+  graph.addVariable(velocity_angular);
+  graph.addConstraint(
+    fuse_constraints::AbsoluteVelocityLinear2DStampedConstraint::make_shared(
+      "test", *velocity_linear, linear_mean, 0.01 * fuse_core::Matrix2d::Identity()));
+  graph.addConstraint(
+    fuse_constraints::AbsoluteVelocityAngular2DStampedConstraint::make_shared(
+      "test", *velocity_angular, angular_mean, 0.01 * fuse_core::Matrix1d::Identity()));
+}
+
+}  // namespace
+
+class MahalanobisGateTestFixture : public ::testing::Test
+{
+public:
+  MahalanobisGateTestFixture()
+  : device_id(fuse_core::uuid::generate("robot")),
+    graph(std::make_shared<fuse_graphs::HashGraph>()),
+    covariance(0.01 * fuse_core::Matrix3d::Identity()),
+    linear_indices{0, 1},
+    angular_indices{0}
+  {
+    addPose(*graph, rclcpp::Time(1, 0), device_id, 0.0, 0.0, 0.0);
+    addPose(*graph, rclcpp::Time(2, 0), device_id, 1.0, 0.0, M_PI - 0.05);
+    addTwist(*graph, rclcpp::Time(1, 0), device_id, 0.0, 0.0, 0.0);
+    addTwist(*graph, rclcpp::Time(2, 0), device_id, 1.0, 0.0, 0.5);
+    graph->optimize();
+  }
+
+  /**
+   * @brief Accept measurements at the stamps of the graph estimates, as a new gate would before
+   *        the graph has any estimate
+   */
+  void acceptGraphStamps(MahalanobisGate & gate)
+  {
+    gate.update(nullptr);
+
+    double squared_distance;
+    const fuse_core::Vector3d mean = fuse_core::Vector3d::Zero();
+    for (const auto & stamp : {rclcpp::Time(1, 0), rclcpp::Time(2, 0)}) {
+      ASSERT_TRUE(
+        gate.acceptPose(
+          stamp, mean, covariance, linear_indices, angular_indices, squared_distance));
+      ASSERT_TRUE(
+        gate.acceptTwist(
+          stamp, mean, covariance, linear_indices, angular_indices, squared_distance));
+    }
+
+    gate.update(graph);
+  }
+
+  fuse_core::UUID device_id;
+  std::shared_ptr<fuse_graphs::HashGraph> graph;
+  fuse_core::Matrix3d covariance;
+  std::vector<size_t> linear_indices;
+  std::vector<size_t> angular_indices;
+};
+
+TEST_F(MahalanobisGateTestFixture, AcceptWithoutEstimate)
+{
+  MahalanobisGate gate(threshold, device_id);
+  const rclcpp::Time stamp(2, 0);
+
+  fuse_core::Vector3d mean;
+  mean << 100.0, 100.0, 1.0;
+
+  double squared_distance = -1.0;
+  EXPECT_TRUE(
+    gate.acceptPose(stamp, mean, covariance, linear_indices, angular_indices, squared_distance));
+  EXPECT_EQ(0.0, squared_distance);
+  EXPECT_TRUE(
+    gate.acceptTwist(stamp, mean, covariance, linear_indices, angular_indices, squared_distance));
+  EXPECT_EQ(0.0, squared_distance);
+
+  // The estimates of other devices are ignored
+  MahalanobisGate other_gate(threshold, fuse_core::uuid::generate("other_robot"));
+  EXPECT_TRUE(
+    other_gate.acceptPose(
+      stamp, mean, covariance, linear_indices, angular_indices, squared_distance));
+  other_gate.update(graph);
+  EXPECT_TRUE(
+    other_gate.acceptPose(
+      stamp, mean, covariance, linear_indices, angular_indices, squared_distance));
+  EXPECT_EQ(0.0, squared_distance);
+
+  // The estimate is the one at the stamp of an accepted measurement
+  MahalanobisGate new_gate(threshold, device_id);
+  new_gate.update(graph);
+  EXPECT_TRUE(
+    new_gate.acceptPose(
+      stamp, mean, covariance, linear_indices, angular_indices, squared_distance));
+  EXPECT_EQ(0.0, squared_distance);
+
+  // Discarding the graph discards the estimates
+  gate.update(graph);
+  EXPECT_FALSE(
+    gate.acceptPose(stamp, mean, covariance, linear_indices, angular_indices, squared_distance));
+  gate.update(nullptr);
+  EXPECT_TRUE(
+    gate.acceptPose(stamp, mean, covariance, linear_indices, angular_indices, squared_distance));
+}
+
+TEST_F(MahalanobisGateTestFixture, Pose)
+{
+  MahalanobisGate gate(threshold, device_id);
+  acceptGraphStamps(gate);
+  const rclcpp::Time stamp(2, 0);
+
+  // The measurement is tested against the newest pose, with a wrapped yaw innovation
+  fuse_core::Vector3d mean;
+  mean << 1.1, 0.0, -M_PI + 0.05;
+
+  double squared_distance = 0.0;
+  EXPECT_TRUE(
+    gate.acceptPose(stamp, mean, covariance, linear_indices, angular_indices, squared_distance));
+  EXPECT_NEAR(0.01 / 0.02 + 0.01 / 0.02, squared_distance, 1.0e-3);
+
+  mean << 0.0, 0.0, 0.0;
+  EXPECT_FALSE(
+    gate.acceptPose(stamp, mean, covariance, linear_indices, angular_indices, squared_distance));
+  EXPECT_GT(squared_distance, threshold);
+
+  // Only the requested dimensions are tested
+  mean << 2.0, 0.0, M_PI - 0.05;
+  EXPECT_FALSE(
+    gate.acceptPose(stamp, mean, covariance, linear_indices, angular_indices, squared_distance));
+  EXPECT_TRUE(gate.acceptPose(stamp, mean, covariance, {1}, angular_indices, squared_distance));
+  EXPECT_NEAR(0.0, squared_distance, 1.0e-3);
+  EXPECT_TRUE(gate.acceptPose(stamp, mean, covariance, {}, angular_indices, squared_distance));
+  EXPECT_NEAR(0.0, squared_distance, 1.0e-3);
+}
+
+TEST_F(MahalanobisGateTestFixture, Twist)
+{
+  MahalanobisGate gate(threshold, device_id);
+  acceptGraphStamps(gate);
+  const rclcpp::Time stamp(2, 0);
+
+  fuse_core::Vector3d mean;
+  mean << 1.0, 0.1, 0.6;
+
+  double squared_distance = 0.0;
+  EXPECT_TRUE(
+    gate.acceptTwist(stamp, mean, covariance, linear_indices, angular_indices, squared_distance));
+  EXPECT_NEAR(0.01 / 0.02 + 0.01 / 0.02, squared_distance, 1.0e-3);
+
+  // Only the requested dimensions are tested
+  mean << 1.0, 0.0, 2.0;
+  EXPECT_FALSE(
+    gate.acceptTwist(stamp, mean, covariance, linear_indices, angular_indices, squared_distance));
+  EXPECT_TRUE(gate.acceptTwist(stamp, mean, covariance, linear_indices, {}, squared_distance));
+  EXPECT_NEAR(0.0, squared_distance, 1.0e-3);
+}
+
+TEST_F(MahalanobisGateTestFixture, NoiseRate)
+{
+  const fuse_core::Matrix3d noise_rate = 0.01 * fuse_core::Matrix3d::Identity();
+  MahalanobisGate gate(threshold, device_id, noise_rate, noise_rate);
+  acceptGraphStamps(gate);
+
+  // The estimate covariance grows with the time elapsed until the measurement stamp
+  fuse_core::Vector3d mean;
+  mean << 1.6, 0.0, M_PI - 0.05;
+
+  double squared_distance = 0.0;
+  EXPECT_FALSE(
+    gate.acceptPose(
+      rclcpp::Time(2, 0), mean, covariance, linear_indices, angular_indices, squared_distance));
+  EXPECT_NEAR(0.36 / 0.02, squared_distance, 1.0e-3);
+
+  // Two seconds later the estimate is predicted with its twist of (1.0, 0.0, 0.5)
+  const double yaw = M_PI - 0.05 + 0.5 * 0.5 * 2.0;
+  mean << 1.0 + 2.0 * std::cos(yaw) + 0.6, 2.0 * std::sin(yaw), M_PI - 0.05 + 0.5 * 2.0;
+  EXPECT_TRUE(
+    gate.acceptPose(
+      rclcpp::Time(4, 0), mean, covariance, linear_indices, angular_indices, squared_distance));
+  EXPECT_NEAR(0.36 / 0.04, squared_distance, 1.0e-3);
+
+  mean << 1.6, 0.0, 0.5;
+  EXPECT_TRUE(
+    gate.acceptTwist(
+      rclcpp::Time(4, 0), mean, covariance, linear_indices, angular_indices, squared_distance));
+  EXPECT_NEAR(0.36 / 0.04, squared_distance, 1.0e-3);
+}
+
+TEST_F(MahalanobisGateTestFixture, MaxRejections)
+{
+  MahalanobisGate gate(
+    threshold, device_id, fuse_core::Matrix3d::Zero(), fuse_core::Matrix3d::Zero(), 2);
+  acceptGraphStamps(gate);
+  const rclcpp::Time stamp(2, 0);
+
+  fuse_core::Vector3d mean;
+  mean << 10.0, 0.0, 0.0;
+
+  // The measurement after too many consecutive rejections is accepted anyway
+  double squared_distance = 0.0;
+  EXPECT_FALSE(
+    gate.acceptPose(stamp, mean, covariance, linear_indices, angular_indices, squared_distance));
+  EXPECT_FALSE(
+    gate.acceptPose(stamp, mean, covariance, linear_indices, angular_indices, squared_distance));
+  EXPECT_TRUE(
+    gate.acceptPose(stamp, mean, covariance, linear_indices, angular_indices, squared_distance));
+  EXPECT_GT(squared_distance, threshold);
+
+  // An accepted measurement restarts the count
+  EXPECT_FALSE(
+    gate.acceptPose(stamp, mean, covariance, linear_indices, angular_indices, squared_distance));
+  mean << 1.0, 0.0, M_PI - 0.05;
+  EXPECT_TRUE(
+    gate.acceptPose(stamp, mean, covariance, linear_indices, angular_indices, squared_distance));
+  mean << 10.0, 0.0, 0.0;
+  EXPECT_FALSE(
+    gate.acceptPose(stamp, mean, covariance, linear_indices, angular_indices, squared_distance));
+  EXPECT_FALSE(
+    gate.acceptPose(stamp, mean, covariance, linear_indices, angular_indices, squared_distance));
+  EXPECT_TRUE(
+    gate.acceptPose(stamp, mean, covariance, linear_indices, angular_indices, squared_distance));
+}
+
+TEST_F(MahalanobisGateTestFixture, MovingRobot)
+{
+  // A robot driving north at 1 m/s and accelerating at 0.5 m/s^2, estimated at 1 second only
+  auto moving_graph = std::make_shared<fuse_graphs::HashGraph>();
+  const rclcpp::Time estimate_stamp(1, 0);
+  addPose(*moving_graph, estimate_stamp, device_id, 0.0, 0.0, M_PI / 2.0);
+  addTwist(*moving_graph, estimate_stamp, device_id, 1.0, 0.0, 0.0);
+  auto acceleration = fuse_variables::AccelerationLinear2DStamped::make_shared(
+    estimate_stamp, device_id);
+  acceleration->x() = 0.5;
+  moving_graph->addVariable(acceleration);
+  moving_graph->addConstraint(
+    fuse_constraints::AbsoluteAccelerationLinear2DStampedConstraint::make_shared(
+      "test", *acceleration, fuse_core::Vector2d(0.5, 0.0),
+      0.01 * fuse_core::Matrix2d::Identity()));
+  moving_graph->optimize();
+
+  MahalanobisGate gate(threshold, device_id);
+  double squared_distance = 0.0;
+  fuse_core::Vector3d mean = fuse_core::Vector3d::Zero();
+  ASSERT_TRUE(
+    gate.acceptPose(
+      estimate_stamp, mean, covariance, linear_indices, angular_indices, squared_distance));
+  ASSERT_TRUE(
+    gate.acceptTwist(
+      estimate_stamp, mean, covariance, linear_indices, angular_indices, squared_distance));
+  gate.update(moving_graph);
+
+  // Two seconds later the robot has moved on, so its last estimated pose would be rejected
+  const rclcpp::Time stamp(3, 0);
+  mean << 0.0, 2.0, M_PI / 2.0;
+  EXPECT_TRUE(
+    gate.acceptPose(stamp, mean, covariance, linear_indices, angular_indices, squared_distance));
+  EXPECT_NEAR(0.0, squared_distance, 1.0e-3);
+  mean << 0.0, 0.0, M_PI / 2.0;
+  EXPECT_FALSE(
+    gate.acceptPose(stamp, mean, covariance, linear_indices, angular_indices, squared_distance));
+
+  // The twist is predicted with the linear acceleration
+  mean << 2.0, 0.0, 0.0;
+  EXPECT_TRUE(
+    gate.acceptTwist(stamp, mean, covariance, linear_indices, angular_indices, squared_distance));
+  EXPECT_NEAR(0.0, squared_distance, 1.0e-3);
+  mean << 1.0, 0.0, 0.0;
+  EXPECT_FALSE(
+    gate.acceptTwist(stamp, mean, covariance, linear_indices, angular_indices, squared_distance));
+}
@@ -0,0 +1,106 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2018, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include <fuse_models/common/odometry_integrator.hpp>
+#include <rclcpp/time.hpp>
+#include <tf2_2d/tf2_2d.hpp>
+
+using fuse_models::common::OdometryIntegrator;
+
+TEST(OdometryIntegrator, IntegrateFromState)
+{
+  OdometryIntegrator integrator(10);
+
+  // Nothing is integrated until there is a state
+  EXPECT_FALSE(integrator.hasState());
+  EXPECT_FALSE(integrator.addVelocity(rclcpp::Time(1, 0), tf2_2d::Vector2(1.0, 0.0), 0.0));
+
+  integrator.setState(
+    rclcpp::Time(1, 0), tf2_2d::Transform(1.0, 2.0, 0.0), tf2_2d::Vector2(1.0, 0.0), 0.0);
+  EXPECT_TRUE(integrator.hasState());
+
+  // The velocity is held until the next one is received
+  EXPECT_TRUE(integrator.addVelocity(rclcpp::Time(2, 0), tf2_2d::Vector2(0.0, 0.0), M_PI / 2.0));
+  EXPECT_EQ(rclcpp::Time(2, 0), integrator.stamp());
+  EXPECT_NEAR(2.0, integrator.pose().x(), 1.0e-9);
+  EXPECT_NEAR(2.0, integrator.pose().y(), 1.0e-9);
+  EXPECT_NEAR(0.0, integrator.pose().yaw(), 1.0e-9);
+  EXPECT_EQ(0.0, integrator.velocityLinear().x());
+  EXPECT_EQ(M_PI / 2.0, integrator.velocityAngular());
+
+  EXPECT_TRUE(integrator.addVelocity(rclcpp::Time(3, 0), tf2_2d::Vector2(1.0, 0.0), 0.0));
+  EXPECT_TRUE(integrator.addVelocity(rclcpp::Time(4, 0), tf2_2d::Vector2(1.0, 0.0), 0.0));
+  EXPECT_NEAR(2.0, integrator.pose().x(), 1.0e-9);
+  EXPECT_NEAR(3.0, integrator.pose().y(), 1.0e-9);
+  EXPECT_NEAR(M_PI / 2.0, integrator.pose().yaw(), 1.0e-9);
+
+  // Velocities older than the previous one are ignored
+  EXPECT_FALSE(integrator.addVelocity(rclcpp::Time(3, 500000000), tf2_2d::Vector2(), 0.0));
+  EXPECT_EQ(rclcpp::Time(4, 0), integrator.stamp());
+}
+
+TEST(OdometryIntegrator, IntegrateAgainFromNewState)
+{
+  OdometryIntegrator integrator(10);
+
+  EXPECT_FALSE(integrator.addVelocity(rclcpp::Time(1, 0), tf2_2d::Vector2(1.0, 0.0), 0.0));
+  EXPECT_FALSE(integrator.addVelocity(rclcpp::Time(2, 0), tf2_2d::Vector2(2.0, 0.0), 0.0));
+  EXPECT_FALSE(integrator.addVelocity(rclcpp::Time(3, 0), tf2_2d::Vector2(3.0, 0.0), 0.0));
+
+  // Only the velocities newer than the state are integrated, starting with the state velocity
+  integrator.setState(
+    rclcpp::Time(1, 500000000), tf2_2d::Transform(), tf2_2d::Vector2(1.0, 0.0), 0.0);
+  EXPECT_EQ(rclcpp::Time(3, 0), integrator.stamp());
+  EXPECT_NEAR(0.5 * 1.0 + 1.0 * 2.0, integrator.pose().x(), 1.0e-9);
+  EXPECT_EQ(3.0, integrator.velocityLinear().x());
+
+  integrator.setState(
+    rclcpp::Time(2, 0), tf2_2d::Transform(10.0, 0.0, 0.0), tf2_2d::Vector2(4.0, 0.0), 0.0);
+  EXPECT_EQ(rclcpp::Time(3, 0), integrator.stamp());
+  EXPECT_NEAR(14.0, integrator.pose().x(), 1.0e-9);
+
+  // A state newer than all the velocities is used as is, until a newer velocity is received
+  integrator.setState(rclcpp::Time(5, 0), tf2_2d::Transform(), tf2_2d::Vector2(1.0, 0.0), 0.0);
+  EXPECT_EQ(rclcpp::Time(5, 0), integrator.stamp());
+  EXPECT_FALSE(integrator.addVelocity(rclcpp::Time(4, 0), tf2_2d::Vector2(1.0, 0.0), 0.0));
+  EXPECT_TRUE(integrator.addVelocity(rclcpp::Time(6, 0), tf2_2d::Vector2(1.0, 0.0), 0.0));
+  EXPECT_NEAR(1.0, integrator.pose().x(), 1.0e-9);
+
+  integrator.reset();
+  EXPECT_FALSE(integrator.hasState());
+  EXPECT_FALSE(integrator.addVelocity(rclcpp::Time(7, 0), tf2_2d::Vector2(1.0, 0.0), 0.0));
+}
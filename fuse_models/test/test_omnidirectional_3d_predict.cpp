@@ -0,0 +1,155 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2018, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+
+#include <fuse_core/eigen.hpp>
+#include <fuse_core/eigen_gtest.hpp>
+#include <fuse_core/util.hpp>
+#include <fuse_models/omnidirectional_3d_predict.hpp>
+
+TEST(Predict, predictPlanarMotion)
+{
+  // With the motion on the XY plane, the prediction is the same as the one of the unicycle model
+  double position1[] = {0.0, 0.0, 0.0};
+  double orientation1[] = {1.0, 0.0, 0.0, 0.0};
+  double vel_linear1[] = {1.0, 0.0, 0.0};
+  double vel_angular1[] = {0.0, 0.0, 1.570796327};
+  double acc_linear1[] = {1.0, 0.0, 0.0};
+  const double dt = 0.1;
+  double position2[3];
+  double orientation2[4];
+  double vel_linear2[3];
+  double vel_angular2[3];
+  double acc_linear2[3];
+
+  fuse_models::predictOmnidirectional3D(
+    position1, orientation1, vel_linear1, vel_angular1, acc_linear1, dt, position2, orientation2,
+    vel_linear2, vel_angular2, acc_linear2);
+
+  EXPECT_DOUBLE_EQ(0.105, position2[0]);
+  EXPECT_DOUBLE_EQ(0.0, position2[1]);
+  EXPECT_DOUBLE_EQ(0.0, position2[2]);
+  EXPECT_DOUBLE_EQ(
+    0.1570796327,
+    fuse_core::getYaw(orientation2[0], orientation2[1], orientation2[2], orientation2[3]));
+  EXPECT_DOUBLE_EQ(1.1, vel_linear2[0]);
+  EXPECT_DOUBLE_EQ(0.0, vel_linear2[1]);
+  EXPECT_DOUBLE_EQ(0.0, vel_linear2[2]);
+  EXPECT_DOUBLE_EQ(1.570796327, vel_angular2[2]);
+  EXPECT_DOUBLE_EQ(1.0, acc_linear2[0]);
+
+  // Carry on with the output state from last time - show in-place update support
+  fuse_models::predictOmnidirectional3D(
+    position2, orientation2, vel_linear2, vel_angular2, acc_linear2, dt, position2, orientation2,
+    vel_linear2, vel_angular2, acc_linear2);
+
+  EXPECT_DOUBLE_EQ(0.21858415916807189, position2[0]);
+  EXPECT_DOUBLE_EQ(0.017989963481956205, position2[1]);
+  EXPECT_DOUBLE_EQ(0.0, position2[2]);
+  EXPECT_DOUBLE_EQ(
+    0.3141592654,
+    fuse_core::getYaw(orientation2[0], orientation2[1], orientation2[2], orientation2[3]));
+  EXPECT_DOUBLE_EQ(1.2, vel_linear2[0]);
+  EXPECT_DOUBLE_EQ(1.570796327, vel_angular2[2]);
+  EXPECT_DOUBLE_EQ(1.0, acc_linear2[0]);
+}
+
+TEST(Predict, predictMotionInBodyFrame)
+{
+  // Pitched up by 90 degrees, moving forward in the body frame is moving up in the world frame
+  const double angle_axis[] = {0.0, -M_PI_2, 0.0};
+  double orientation1[4];
+  fuse_core::angleAxisToQuaternion(angle_axis, orientation1);
+
+  const double position1[] = {1.0, 2.0, 3.0};
+  const double vel_linear1[] = {2.0, 0.0, 0.0};
+  const double vel_angular1[] = {0.0, 0.0, 0.0};
+  const double acc_linear1[] = {0.0, 0.0, 0.0};
+  double position2[3];
+  double orientation2[4];
+  double vel_linear2[3];
+  double vel_angular2[3];
+  double acc_linear2[3];
+
+  fuse_models::predictOmnidirectional3D(
+    position1, orientation1, vel_linear1, vel_angular1, acc_linear1, 0.5, position2, orientation2,
+    vel_linear2, vel_angular2, acc_linear2);
+
+  EXPECT_MATRIX_NEAR(
+    fuse_core::Vector3d(1.0, 2.0, 4.0), Eigen::Map<fuse_core::Vector3d>(position2), 1e-12);
+  EXPECT_MATRIX_NEAR(
+    Eigen::Map<fuse_core::Vector4d>(orientation1), Eigen::Map<fuse_core::Vector4d>(orientation2),
+    1e-12);
+}
+
+TEST(Predict, predictWithJacobians)
+{
+  // The prediction is the same with and without the Jacobians
+  const double angle_axis[] = {0.3, -0.2, 0.5};
+  double orientation1[4];
+  fuse_core::angleAxisToQuaternion(angle_axis, orientation1);
+
+  const double position1[] = {1.0, 2.0, 3.0};
+  const double vel_linear1[] = {1.0, 0.5, -0.2};
+  const double vel_angular1[] = {0.1, 0.2, -0.3};
+  const double acc_linear1[] = {0.4, 0.0, 0.1};
+  const double dt = 0.2;
+
+  Eigen::Matrix<double, 16, 1> state2;
+  fuse_models::predictOmnidirectional3D(
+    position1, orientation1, vel_linear1, vel_angular1, acc_linear1, dt, state2.data(),
+    state2.data() + 3, state2.data() + 7, state2.data() + 10, state2.data() + 13);
+
+  fuse_core::Matrix<double, 16, 3> J_position1;
+  fuse_core::Matrix<double, 16, 4> J_orientation1;
+  fuse_core::Matrix<double, 16, 3> J_vel_linear1;
+  fuse_core::Matrix<double, 16, 3> J_vel_angular1;
+  fuse_core::Matrix<double, 16, 3> J_acc_linear1;
+  double * jacobians[] = {J_position1.data(), J_orientation1.data(), J_vel_linear1.data(),
+    J_vel_angular1.data(), J_acc_linear1.data()};
+
+  Eigen::Matrix<double, 16, 1> state2_with_jacobians;
+  fuse_models::predictOmnidirectional3D(
+    position1, orientation1, vel_linear1, vel_angular1, acc_linear1, dt,
+    state2_with_jacobians.data(), state2_with_jacobians.data() + 3,
+    state2_with_jacobians.data() + 7, state2_with_jacobians.data() + 10,
+    state2_with_jacobians.data() + 13, jacobians);
+
+  EXPECT_MATRIX_NEAR(state2, state2_with_jacobians, 1e-15);
+
+  // The position only depends on the first position through the identity
+  EXPECT_MATRIX_EQ(fuse_core::Matrix3d::Identity(), J_position1.topRows<3>());
+  EXPECT_MATRIX_EQ(fuse_core::Matrix3d::Identity(), J_vel_angular1.middleRows<3>(10));
+  EXPECT_MATRIX_EQ(fuse_core::Matrix3d::Identity(), J_acc_linear1.bottomRows<3>());
+}
@@ -0,0 +1,200 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2018, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <ceres/autodiff_cost_function.h>
+#include <ceres/rotation.h>
+#include <Eigen/Dense>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <fuse_core/eigen.hpp>
+#include <fuse_core/eigen_gtest.hpp>
+#include <fuse_models/omnidirectional_3d_predict.hpp>
+#include <fuse_models/omnidirectional_3d_state_cost_function.hpp>
+#include <fuse_models/omnidirectional_3d_state_cost_functor.hpp>
+
+using Matrix15d = fuse_core::Matrix<double, 15, 15>;
+using Vector15d = Eigen::Matrix<double, 15, 1>;
+
+/**
+ * @brief Evaluate the analytic and the automatic differentiation cost functions on the same
+ *        parameters, and check the residuals and Jacobians are the same
+ */
+void expectSameAsAutoDiff(
+  const double dt,
+  const Matrix15d & sqrt_information,
+  const double * const * parameters)
+{
+  const fuse_models::Omnidirectional3DStateCostFunction cost_function{dt, sqrt_information};
+  ceres::AutoDiffCostFunction<fuse_models::Omnidirectional3DStateCostFunctor, 15, 3, 4, 3, 3, 3, 3,
+    4, 3, 3, 3>
+  cost_function_autodiff(new fuse_models::Omnidirectional3DStateCostFunctor(dt, sqrt_information));
+
+  const auto & block_sizes = cost_function.parameter_block_sizes();
+  const auto num_parameter_blocks = block_sizes.size();
+  const auto num_residuals = cost_function.num_residuals();
+
+  std::vector<fuse_core::MatrixXd> J(num_parameter_blocks);
+  std::vector<double *> jacobians(num_parameter_blocks);
+  std::vector<fuse_core::MatrixXd> J_autodiff(num_parameter_blocks);
+  std::vector<double *> jacobians_autodiff(num_parameter_blocks);
+  for (size_t i = 0; i < num_parameter_blocks; ++i) {
+    J[i].resize(num_residuals, block_sizes[i]);
+    jacobians[i] = J[i].data();
+    J_autodiff[i].resize(num_residuals, block_sizes[i]);
+    jacobians_autodiff[i] = J_autodiff[i].data();
+  }
+
+  Vector15d residuals;
+  Vector15d residuals_autodiff;
+  EXPECT_TRUE(cost_function.Evaluate(parameters, residuals.data(), jacobians.data()));
+  EXPECT_TRUE(
+    cost_function_autodiff.Evaluate(
+      parameters, residuals_autodiff.data(),
+      jacobians_autodiff.data()));
+
+  EXPECT_MATRIX_NEAR(residuals_autodiff, residuals, 1e-9);
+
+  const Eigen::IOFormat HeavyFmt(
+    Eigen::FullPrecision, 0, ", ", ";\n", "[", "]", "[", "]");
+
+  for (size_t i = 0; i < num_parameter_blocks; ++i) {
+    EXPECT_MATRIX_NEAR(J_autodiff[i], J[i], 1e-9)
+      << "Autodiff Jacobian[" << i << "] =\n" << J_autodiff[i].format(HeavyFmt)
+      << "\nAnalytic Jacobian[" << i << "] =\n" << J[i].format(HeavyFmt);
+  }
+
+  // Only some of the Jacobians may be requested
+  std::vector<double *> some_jacobians(num_parameter_blocks, nullptr);
+  some_jacobians[3] = J[3].data();
+  some_jacobians[6] = J[6].data();
+  J[3].setZero();
+  J[6].setZero();
+  EXPECT_TRUE(cost_function.Evaluate(parameters, residuals.data(), some_jacobians.data()));
+  EXPECT_MATRIX_NEAR(J_autodiff[3], J[3], 1e-9);
+  EXPECT_MATRIX_NEAR(J_autodiff[6], J[6], 1e-9);
+}
+
+class Omnidirectional3DStateCostFunctionTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    const double process_noise_diagonal[] =
+    {1e-3, 1e-3, 1e-3, 1e-2, 1e-2, 1e-2, 1e-6, 1e-6, 1e-6, 1e-4, 1e-4, 1e-4, 1e-9, 1e-9, 1e-9};
+    const Matrix15d covariance = Vector15d(process_noise_diagonal).asDiagonal();
+    sqrt_information = covariance.inverse().llt().matrixU();
+
+    const double angle_axis[] = {0.1, -0.2, 0.7};
+    ceres::AngleAxisToQuaternion(angle_axis, orientation1);
+  }
+
+  void predict()
+  {
+    fuse_models::predictOmnidirectional3D(
+      position1, orientation1, vel_linear1, vel_angular1, acc_linear1, dt, position2, orientation2,
+      vel_linear2, vel_angular2, acc_linear2);
+  }
+
+  const double * parameters[10] =
+  {
+    position1, orientation1, vel_linear1, vel_angular1, acc_linear1,
+    position2, orientation2, vel_linear2, vel_angular2, acc_linear2
+  };
+
+  double dt{0.1};
+  Matrix15d sqrt_information;
+
+  double position1[3] = {1.0, 2.0, -0.5};
+  double orientation1[4];
+  double vel_linear1[3] = {1.0, 0.3, -0.1};
+  double vel_angular1[3] = {0.2, -0.1, 1.570796327};
+  double acc_linear1[3] = {1.0, -0.5, 0.2};
+
+  double position2[3];
+  double orientation2[4];
+  double vel_linear2[3];
+  double vel_angular2[3];
+  double acc_linear2[3];
+};
+
+TEST_F(Omnidirectional3DStateCostFunctionTest, PredictedStateHasZeroCost)
+{
+  predict();
+
+  const fuse_models::Omnidirectional3DStateCostFunction cost_function{dt, sqrt_information};
+  Vector15d residuals;
+  EXPECT_TRUE(cost_function.Evaluate(parameters, residuals.data(), nullptr));
+  EXPECT_MATRIX_NEAR(Vector15d::Zero(), residuals, 1e-9);
+
+  expectSameAsAutoDiff(dt, sqrt_information, parameters);
+}
+
+TEST_F(Omnidirectional3DStateCostFunctionTest, JacobiansMatchAutoDiff)
+{
+  predict();
+
+  // Move the second state away from the prediction, and make the first orientation a non-unit
+  // quaternion, as Ceres evaluates the Jacobians in the ambient space of the quaternion
+  const double position_offset[] = {0.1, -0.2, 0.05};
+  const double orientation_offset[] = {0.02, 0.1, -0.3};
+  double orientation_delta[4];
+  ceres::AngleAxisToQuaternion(orientation_offset, orientation_delta);
+  double orientation[4];
+  ceres::QuaternionProduct(orientation2, orientation_delta, orientation);
+  for (size_t i = 0; i < 3; ++i) {
+    position2[i] += position_offset[i];
+    vel_linear2[i] += 0.1;
+    vel_angular2[i] -= 0.2;
+    acc_linear2[i] *= 2.0;
+  }
+  for (size_t i = 0; i < 4; ++i) {
+    orientation2[i] = orientation[i];
+    orientation1[i] *= 1.1;
+  }
+
+  expectSameAsAutoDiff(dt, sqrt_information, parameters);
+}
+
+TEST_F(Omnidirectional3DStateCostFunctionTest, JacobiansMatchAutoDiffWithoutRotation)
+{
+  // The zero angular velocity and the zero orientation error use the first order approximations
+  // of the angle-axis conversions
+  for (size_t i = 0; i < 3; ++i) {
+    vel_angular1[i] = 0.0;
+  }
+  predict();
+
+  expectSameAsAutoDiff(dt, sqrt_information, parameters);
+}
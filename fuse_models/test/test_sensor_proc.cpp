@@ -263,3 +263,55 @@ TEST(TestSuite, populatePartialMeasurementEmptyPositionEmptyOrientation)
   EXPECT_EQ(0, pose_mean_partial.size());
   EXPECT_EQ(0, pose_covariance_partial.size());
 }
+
+TEST(TestSuite, populatePartialMeasurementFixedSizeXPositionYawOrientation)
+{
+  fuse_core::Vector3d pose_mean;
+  pose_mean << 1.0, 2.0, 3.0;
+
+  fuse_core::Matrix3d pose_covariance;
+  pose_covariance << 0.1, 0.01, 0.001, 0.01, 0.2, 0.002, 0.001, 0.002, 0.3;
+
+  const std::vector<size_t> position_indices{0};
+  const std::vector<size_t> orientation_indices{0};
+
+  const size_t orientation_offset = 2;
+
+  fm_common::PartialVector<3> pose_mean_partial(
+    position_indices.size() + orientation_indices.size());
+  fm_common::PartialMatrix<3> pose_covariance_partial(
+    pose_mean_partial.rows(),
+    pose_mean_partial.rows());
+
+  fm_common::populatePartialMeasurement(
+    pose_mean,
+    pose_covariance,
+    position_indices,
+    orientation_indices,
+    orientation_offset,
+    pose_mean_partial,
+    pose_covariance_partial);
+
+  // The result matches the one using the merged indices
+  const auto merged_indices = fm_common::mergeIndices(
+    position_indices, orientation_indices,
+    orientation_offset);
+
+  fuse_core::VectorXd expected_pose_mean_partial(merged_indices.size());
+  fuse_core::MatrixXd expected_pose_covariance_partial(
+    expected_pose_mean_partial.rows(),
+    expected_pose_mean_partial.rows());
+
+  fm_common::populatePartialMeasurement(
+    pose_mean,
+    pose_covariance,
+    merged_indices,
+    expected_pose_mean_partial,
+    expected_pose_covariance_partial);
+
+  EXPECT_EQ(expected_pose_mean_partial, fuse_core::VectorXd(pose_mean_partial));
+  EXPECT_EQ(expected_pose_covariance_partial, fuse_core::MatrixXd(pose_covariance_partial));
+
+  EXPECT_NO_THROW(
+    fm_common::validatePartialMeasurement(pose_mean_partial, pose_covariance_partial));
+}
@@ -0,0 +1,198 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2018, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+#include <tf2_ros/buffer.h>
+
+#include <memory>
+#include <string>
+
+#include <fuse_models/common/sensor_proc.hpp>
+#include <fuse_models/common/static_transform_cache.hpp>
+#include <geometry_msgs/msg/pose_with_covariance_stamped.hpp>
+#include <geometry_msgs/msg/transform_stamped.hpp>
+#include <rclcpp/rclcpp.hpp>
+#include <tf2_msgs/msg/tf_message.hpp>
+
+using fuse_models::common::StaticTransformCache;
+
+namespace
+{
+
+geometry_msgs::msg::TransformStamped makeTransform(
+  const std::string & parent_frame,
+  const std::string & child_frame,
+  const double x,
+  const rclcpp::Time & stamp = rclcpp::Time(0, 0, RCL_ROS_TIME))
+{
+  geometry_msgs::msg::TransformStamped transform;
+  transform.header.stamp = stamp;
+  transform.header.frame_id = parent_frame;
+  transform.child_frame_id = child_frame;
+  transform.transform.translation.x = x;
+  transform.transform.rotation.w = 1.0;
+  return transform;
+}
+
+/**
+ * @brief Publish a static transform both to the buffer and to the cache, as the /tf_static
+ *        subscriptions would
+ */
+void setStaticTransform(
+  tf2_ros::Buffer & tf_buffer,
+  StaticTransformCache & cache,
+  const geometry_msgs::msg::TransformStamped & transform)
+{
+  tf_buffer.setTransform(transform, "test", true);
+
+  tf2_msgs::msg::TFMessage message;
+  message.transforms.push_back(transform);
+  cache.addStaticTransforms(message);
+}
+
+}  // namespace
+
+class StaticTransformCacheTestFixture : public ::testing::Test
+{
+public:
+  StaticTransformCacheTestFixture()
+  : tf_buffer(std::make_shared<rclcpp::Clock>(RCL_ROS_TIME))
+  {
+    setStaticTransform(tf_buffer, cache, makeTransform("base_link", "imu_link", 1.0));
+    setStaticTransform(tf_buffer, cache, makeTransform("base_link", "laser", 2.0));
+    tf_buffer.setTransform(
+      makeTransform("odom", "base_link", 10.0, rclcpp::Time(1, 0, RCL_ROS_TIME)), "test");
+  }
+
+  tf2_ros::Buffer tf_buffer;
+  StaticTransformCache cache;
+};
+
+TEST_F(StaticTransformCacheTestFixture, StaticFrames)
+{
+  geometry_msgs::msg::TransformStamped transform;
+  StaticTransformCache::FramePair laser(cache, "laser");
+  ASSERT_TRUE(laser.lookupTransform(tf_buffer, "imu_link", transform));
+  EXPECT_EQ("laser", transform.header.frame_id);
+  EXPECT_EQ("imu_link", transform.child_frame_id);
+  EXPECT_DOUBLE_EQ(-1.0, transform.transform.translation.x);
+
+  // The cached transform is reused
+  transform = geometry_msgs::msg::TransformStamped();
+  ASSERT_TRUE(laser.lookupTransform(tf_buffer, "imu_link", transform));
+  EXPECT_DOUBLE_EQ(-1.0, transform.transform.translation.x);
+
+  StaticTransformCache::FramePair base_link(cache, "base_link");
+  ASSERT_TRUE(base_link.lookupTransform(tf_buffer, "imu_link", transform));
+  EXPECT_DOUBLE_EQ(1.0, transform.transform.translation.x);
+
+  StaticTransformCache::FramePair imu_link(cache, "imu_link");
+  ASSERT_TRUE(imu_link.lookupTransform(tf_buffer, "imu_link", transform));
+  EXPECT_DOUBLE_EQ(0.0, transform.transform.translation.x);
+}
+
+TEST_F(StaticTransformCacheTestFixture, DynamicFrames)
+{
+  geometry_msgs::msg::TransformStamped transform;
+  StaticTransformCache::FramePair odom(cache, "odom");
+  EXPECT_FALSE(odom.lookupTransform(tf_buffer, "imu_link", transform));
+  EXPECT_FALSE(odom.lookupTransform(tf_buffer, "base_link", transform));
+
+  StaticTransformCache::FramePair imu_link(cache, "imu_link");
+  EXPECT_FALSE(imu_link.lookupTransform(tf_buffer, "odom", transform));
+
+  StaticTransformCache::FramePair base_link(cache, "base_link");
+  EXPECT_FALSE(base_link.lookupTransform(tf_buffer, "unknown", transform));
+
+  StaticTransformCache::FramePair empty(cache, "");
+  EXPECT_FALSE(empty.lookupTransform(tf_buffer, "imu_link", transform));
+}
+
+TEST_F(StaticTransformCacheTestFixture, SourceFrameChange)
+{
+  geometry_msgs::msg::TransformStamped transform;
+  StaticTransformCache::FramePair base_link(cache, "base_link");
+  ASSERT_TRUE(base_link.lookupTransform(tf_buffer, "imu_link", transform));
+  EXPECT_DOUBLE_EQ(1.0, transform.transform.translation.x);
+
+  // A message from another frame replaces the cached transform
+  ASSERT_TRUE(base_link.lookupTransform(tf_buffer, "laser", transform));
+  EXPECT_DOUBLE_EQ(2.0, transform.transform.translation.x);
+  EXPECT_FALSE(base_link.lookupTransform(tf_buffer, "odom", transform));
+  ASSERT_TRUE(base_link.lookupTransform(tf_buffer, "imu_link", transform));
+  EXPECT_DOUBLE_EQ(1.0, transform.transform.translation.x);
+}
+
+TEST_F(StaticTransformCacheTestFixture, StaticTreeChange)
+{
+  geometry_msgs::msg::TransformStamped transform;
+  StaticTransformCache::FramePair base_link(cache, "base_link");
+  ASSERT_TRUE(base_link.lookupTransform(tf_buffer, "imu_link", transform));
+  EXPECT_DOUBLE_EQ(1.0, transform.transform.translation.x);
+
+  // An updated static transform replaces the cached one
+  setStaticTransform(tf_buffer, cache, makeTransform("base_link", "imu_link", 3.0));
+  ASSERT_TRUE(base_link.lookupTransform(tf_buffer, "imu_link", transform));
+  EXPECT_DOUBLE_EQ(3.0, transform.transform.translation.x);
+
+  // A frame not known to be static when first requested becomes static later
+  EXPECT_FALSE(base_link.lookupTransform(tf_buffer, "gps", transform));
+  setStaticTransform(tf_buffer, cache, makeTransform("imu_link", "gps", 0.5));
+  ASSERT_TRUE(base_link.lookupTransform(tf_buffer, "gps", transform));
+  EXPECT_DOUBLE_EQ(3.5, transform.transform.translation.x);
+
+  // Nothing is static after unsubscribing
+  cache.unsubscribe();
+  EXPECT_FALSE(base_link.lookupTransform(tf_buffer, "gps", transform));
+}
+
+TEST_F(StaticTransformCacheTestFixture, TransformMessage)
+{
+  geometry_msgs::msg::PoseWithCovarianceStamped pose;
+  pose.header.stamp = rclcpp::Time(5, 0, RCL_ROS_TIME);
+  pose.header.frame_id = "imu_link";
+  pose.pose.pose.position.x = 0.25;
+  pose.pose.pose.orientation.w = 1.0;
+
+  StaticTransformCache::FramePair base_link(cache, "base_link");
+  geometry_msgs::msg::PoseWithCovarianceStamped transformed_pose;
+  transformed_pose.header.frame_id = "base_link";
+  ASSERT_TRUE(
+    fuse_models::common::transformMessage(
+      tf_buffer, pose, transformed_pose, rclcpp::Duration(0, 0), &base_link));
+
+  // The stamp of the message is kept, even though the static transform is stamped at zero
+  EXPECT_EQ(rclcpp::Time(pose.header.stamp), rclcpp::Time(transformed_pose.header.stamp));
+  EXPECT_EQ("base_link", transformed_pose.header.frame_id);
+  EXPECT_DOUBLE_EQ(1.25, transformed_pose.pose.pose.position.x);
+}
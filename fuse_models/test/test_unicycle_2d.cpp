@@ -5,6 +5,11 @@
  ***************************************************************************/
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <iterator>
+
+#include <boost/range/empty.hpp>
+
 #include <fuse_graphs/hash_graph.hpp>
 #include <fuse_models/unicycle_2d.hpp>
 #include <fuse_variables/acceleration_linear_2d_stamped.hpp>
@@ -21,7 +26,11 @@
 class Unicycle2DModelTest : public fuse_models::Unicycle2D
 {
 public:
-  using fuse_models::Unicycle2D::updateStateHistoryEstimates;
+  using fuse_models::Unicycle2D::applyCallback;
+  using fuse_models::Unicycle2D::onGraphUpdate;
+  using fuse_models::Unicycle2D::process_noise_covariance_;
+  using fuse_models::Unicycle2D::purgeStateHistory;
+  using fuse_models::Unicycle2D::updateStateHistoryEstimate;
   using fuse_models::Unicycle2D::StateHistoryElement;
   using fuse_models::Unicycle2D::StateHistory;
 };
@@ -178,9 +187,11 @@ TEST(Unicycle2D, UpdateStateHistoryEstimates)
     tf2_2d::Vector2(0.0, 0.0)});    // NOLINT(whitespace/braces)
 
   // Update the state history
-  Unicycle2DModelTest::updateStateHistoryEstimates(
-    graph, state_history, rclcpp::Duration::from_seconds(
-      10.0));
+  Unicycle2DModelTest::purgeStateHistory(state_history, rclcpp::Duration::from_seconds(10.0));
+  ASSERT_EQ(5ul, state_history.size());
+  for (auto iter = state_history.begin(); iter != state_history.end(); ++iter) {
+    Unicycle2DModelTest::updateStateHistoryEstimate(graph, state_history, iter, 1);
+  }
 
   // Check the state estimates in the state history
   {
@@ -297,3 +308,119 @@ TEST(Unicycle2D, UpdateStateHistoryEstimates)
     EXPECT_NEAR(expected_linear_acceleration.y(), actual_linear_acceleration.y(), 1.0e-9);
   }
 }
+
+TEST(Unicycle2D, UpdateStateHistoryEstimateBounded)
+{
+  // Create the states at 1, 2, 3, 4 and 5 seconds. Only the states at 2 and 4 are in the graph.
+  fuse_graphs::HashGraph graph;
+  Unicycle2DModelTest::StateHistory state_history;
+  for (int32_t seconds = 1; seconds <= 5; ++seconds) {
+    const rclcpp::Time stamp(seconds, 0);
+    auto position = fuse_variables::Position2DStamped::make_shared(stamp);
+    auto yaw = fuse_variables::Orientation2DStamped::make_shared(stamp);
+    auto linear_velocity = fuse_variables::VelocityLinear2DStamped::make_shared(stamp);
+    auto yaw_velocity = fuse_variables::VelocityAngular2DStamped::make_shared(stamp);
+    auto linear_acceleration = fuse_variables::AccelerationLinear2DStamped::make_shared(stamp);
+    position->x() = 10.0 * seconds;
+    linear_velocity->x() = 1.0;
+    if (seconds % 2 == 0) {
+      graph.addVariable(position);
+      graph.addVariable(yaw);
+      graph.addVariable(linear_velocity);
+      graph.addVariable(yaw_velocity);
+      graph.addVariable(linear_acceleration);
+    }
+
+    state_history.emplace(
+      stamp,
+      Unicycle2DModelTest::StateHistoryElement{  // NOLINT(whitespace/braces)
+      position->uuid(),
+      yaw->uuid(),
+      linear_velocity->uuid(),
+      yaw_velocity->uuid(),
+      linear_acceleration->uuid(),
+      tf2_2d::Transform(seconds, 0.0, 0.0),
+      tf2_2d::Vector2(0.0, 0.0),
+      0.0,
+      tf2_2d::Vector2(0.0, 0.0)});    // NOLINT(whitespace/braces)
+  }
+
+  // Update the state at 3 seconds. Only the states from the newest one in the graph are updated.
+  Unicycle2DModelTest::updateStateHistoryEstimate(
+    graph, state_history, state_history.find(rclcpp::Time(3, 0)), 1);
+
+  EXPECT_EQ(0u, state_history[rclcpp::Time(1, 0)].graph_update);
+  EXPECT_NEAR(1.0, state_history[rclcpp::Time(1, 0)].pose.x(), 1.0e-9);
+  EXPECT_EQ(1u, state_history[rclcpp::Time(2, 0)].graph_update);
+  EXPECT_NEAR(20.0, state_history[rclcpp::Time(2, 0)].pose.x(), 1.0e-9);
+  EXPECT_EQ(1u, state_history[rclcpp::Time(3, 0)].graph_update);
+  EXPECT_NEAR(21.0, state_history[rclcpp::Time(3, 0)].pose.x(), 1.0e-9);
+  EXPECT_EQ(0u, state_history[rclcpp::Time(4, 0)].graph_update);
+  EXPECT_NEAR(4.0, state_history[rclcpp::Time(4, 0)].pose.x(), 1.0e-9);
+  EXPECT_EQ(0u, state_history[rclcpp::Time(5, 0)].graph_update);
+  EXPECT_NEAR(5.0, state_history[rclcpp::Time(5, 0)].pose.x(), 1.0e-9);
+
+  // Update the state at 5 seconds. The walk back stops at the state at 4 seconds, in the graph.
+  Unicycle2DModelTest::updateStateHistoryEstimate(
+    graph, state_history, state_history.find(rclcpp::Time(5, 0)), 1);
+
+  EXPECT_NEAR(21.0, state_history[rclcpp::Time(3, 0)].pose.x(), 1.0e-9);
+  EXPECT_EQ(1u, state_history[rclcpp::Time(4, 0)].graph_update);
+  EXPECT_NEAR(40.0, state_history[rclcpp::Time(4, 0)].pose.x(), 1.0e-9);
+  EXPECT_EQ(1u, state_history[rclcpp::Time(5, 0)].graph_update);
+  EXPECT_NEAR(41.0, state_history[rclcpp::Time(5, 0)].pose.x(), 1.0e-9);
+}
+
+TEST(Unicycle2D, SeedFromRestoredState)
+{
+  Unicycle2DModelTest model;
+  model.process_noise_covariance_ = fuse_core::Matrix8d::Identity();
+
+  // A graph restored from a checkpoint, with its newest state at 1 second
+  const rclcpp::Time restored_stamp(1, 0);
+  auto position = fuse_variables::Position2DStamped::make_shared(restored_stamp);
+  auto yaw = fuse_variables::Orientation2DStamped::make_shared(restored_stamp);
+  auto linear_velocity = fuse_variables::VelocityLinear2DStamped::make_shared(restored_stamp);
+  auto yaw_velocity = fuse_variables::VelocityAngular2DStamped::make_shared(restored_stamp);
+  auto linear_acceleration =
+    fuse_variables::AccelerationLinear2DStamped::make_shared(restored_stamp);
+  position->x() = 5.0;
+  linear_velocity->x() = 1.0;
+  auto graph = fuse_graphs::HashGraph::make_shared();
+  graph->addVariable(position);
+  graph->addVariable(yaw);
+  graph->addVariable(linear_velocity);
+  graph->addVariable(yaw_velocity);
+  graph->addVariable(linear_acceleration);
+
+  // The restore transaction seeds the motion model, then the restored graph is delivered
+  fuse_core::Transaction restore_transaction;
+  restore_transaction.stamp(restored_stamp);
+  restore_transaction.addInvolvedStamp(restored_stamp);
+  ASSERT_TRUE(model.applyCallback(restore_transaction));
+  EXPECT_TRUE(boost::empty(restore_transaction.addedConstraints()));
+  EXPECT_TRUE(boost::empty(restore_transaction.addedVariables()));
+  model.onGraphUpdate(graph);
+
+  // The next segment links to the restored state, and starts from its values
+  const rclcpp::Time next_stamp(2, 0);
+  fuse_core::Transaction transaction;
+  transaction.stamp(next_stamp);
+  transaction.addInvolvedStamp(next_stamp);
+  ASSERT_TRUE(model.applyCallback(transaction));
+
+  const auto constraints = transaction.addedConstraints();
+  ASSERT_EQ(1, std::distance(constraints.begin(), constraints.end()));
+  const auto & variables = constraints.begin()->variables();
+  EXPECT_NE(variables.end(), std::find(variables.begin(), variables.end(), position->uuid()));
+
+  const auto next_position_uuid = fuse_variables::Position2DStamped(next_stamp).uuid();
+  const auto added_variables = transaction.addedVariables();
+  const auto next_position = std::find_if(
+    added_variables.begin(), added_variables.end(),
+    [&next_position_uuid](const fuse_core::Variable & variable) {
+      return variable.uuid() == next_position_uuid;
+    });
+  ASSERT_NE(added_variables.end(), next_position);
+  EXPECT_NEAR(6.0, next_position->data()[fuse_variables::Position2DStamped::X], 1.0e-9);
+}
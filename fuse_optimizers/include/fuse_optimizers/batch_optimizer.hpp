@@ -191,6 +191,14 @@ protected:
    */
   void optimizationLoop();
 
+  /**
+   * @brief Perform a single optimization cycle
+   *
+   * The combined transaction is added to the graph, the entire graph is optimized, and all plugins
+   * are notified.
+   */
+  void optimizationCycle();
+
   /**
    * @brief Callback fired at a fixed frequency to trigger a new optimization cycle.
    *
@@ -36,6 +36,7 @@
 #define FUSE_OPTIMIZERS__FIXED_LAG_SMOOTHER_HPP_
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <memory>
@@ -48,6 +49,7 @@
 #include <fuse_core/transaction.hpp>
 #include <fuse_optimizers/fixed_lag_smoother_params.hpp>
 #include <fuse_optimizers/optimizer.hpp>
+#include <fuse_optimizers/phase_profiler.hpp>
 #include <fuse_optimizers/variable_stamp_index.hpp>
 #include <fuse_graphs/hash_graph.hpp>
 #include <fuse_constraints/marginalize_variables.hpp>
@@ -82,6 +84,14 @@ namespace fuse_optimizers
  * next optimization will not begin until the next scheduled optimization period.
  *
  * Parameters:
+ *  - checkpoint_file (string, default: "") If set, the graph and the smoother state are written
+ *                                          to this file at most once per checkpoint_period, and
+ *                                          restored from it on startup, so a restarted node
+ *                                          resumes from the last checkpoint instead of waiting
+ *                                          for a new ignition transaction. The file is written
+ *                                          by a background thread from a snapshot taken at the
+ *                                          end of the optimization cycle.
+ *  - checkpoint_period (float, default: 1.0) The minimum time between two checkpoints in seconds
  *  - lag_duration (float, default: 5.0) The duration of the smoothing window in seconds
  *  - motion_models (struct array) The set of motion model plugins to load
  *    @code{.yaml}
@@ -92,6 +102,9 @@ namespace fuse_optimizers
  *  - optimization_frequency (float, default: 10.0) The target frequency for optimization cycles. If
  *                                                  an optimization takes longer than expected, an
  *                                                  optimization cycle may be skipped.
+ *  - profiler_window_size (int, default: 100) The number of most recent optimization cycles used to
+ *                                             compute the p50/p99/max latency of each optimization
+ *                                             phase reported in the diagnostics.
  *  - publishers (struct array) The set of publisher plugins to load
  *    @code{.yaml}
  *    - name: string  (A unique name for this publisher)
@@ -105,6 +118,9 @@ namespace fuse_optimizers
  *      motion_models: [name1, name2, ...]  (An optional list of motion model names that should be applied)
  *    - ...
  *    @endcode
+ *  - trace_file (string, default: "") If set, the timing of each phase of every optimization cycle
+ *                                     is written to this file in the Chrome trace-event JSON
+ *                                     format.
  *  - transaction_timeout (float, default: 0.10) The maximum time to wait for motion models to be
  *                                               generated for a received transactions.
  *                                               Transactions are processes sequentially, so no new
@@ -192,6 +208,48 @@ protected:
   ceres::Solver::Summary summary_;  //!< Optimization summary, written by optimizationLoop and read
                                     //!< by setDiagnostics
 
+  // Only used by the optimization thread. The profiler statistics may be read by any thread.
+  /**
+   * @brief The optimization cycle phases timed by the profiler_
+   *
+   * PROCESS_QUEUE includes the time spent in APPLY_MOTION_MODELS.
+   */
+  enum Phase : size_t
+  {
+    PROCESS_QUEUE,
+    APPLY_MOTION_MODELS,
+    UPDATE_GRAPH,
+    CREATE_PROBLEM,
+    SOLVE,
+    CLONE_GRAPH,
+    NOTIFY,
+    MARGINALIZE,
+    CHECKPOINT
+  };
+  PhaseProfiler::UniquePtr profiler_;  //!< Per-phase latency tracking of the optimization cycles
+  std::chrono::steady_clock::time_point next_checkpoint_;  //!< The earliest time the next
+                                                           //!< checkpoint may be written
+
+  /**
+   * @brief A copy of the smoother state, waiting to be written to the checkpoint file
+   */
+  struct CheckpointSnapshot
+  {
+    fuse_core::Graph::ConstSharedPtr graph;
+    rclcpp::Time start_time;
+    rclcpp::Time lag_expiration;
+    fuse_core::Transaction marginal_transaction;
+    VariableStampIndex timestamp_tracking;
+  };
+
+  // Guarded by checkpoint_mutex_
+  std::mutex checkpoint_mutex_;  //!< Synchronize access to the checkpoint snapshot and flags
+  std::condition_variable checkpoint_changed_;  //!< Signalled whenever the snapshot or flags change
+  std::unique_ptr<CheckpointSnapshot> checkpoint_snapshot_;  //!< The next snapshot to write, if any
+  bool checkpoint_busy_{false};  //!< True while a snapshot is being written
+  bool checkpoint_running_{true};  //!< False once the checkpoint thread is shutting down
+  std::thread checkpoint_thread_;  //!< Writes the checkpoint snapshots in the background
+
   // Guarded by optimization_requested_mutex_
   std::mutex optimization_requested_mutex_;  //!< Required condition variable mutex
   rclcpp::Time optimization_deadline_;  //!< The deadline for the optimization to complete. Triggers
@@ -217,6 +275,40 @@ protected:
    */
   void autostart();
 
+  /**
+   * @brief Restore the graph and the smoother state from the configured checkpoint file, if any
+   *
+   * On success the smoother is started, and all plugins are notified of the restored graph. If the
+   * checkpoint cannot be read, an error is logged and the smoother starts from scratch.
+   */
+  void restoreCheckpoint();
+
+  /**
+   * @brief Hand a snapshot of the graph and the smoother state to the checkpoint thread, if the
+   *        checkpoint period has elapsed
+   *
+   * Must be called with the optimization_mutex_ held. Only the smoother state is copied here; the
+   * graph is the read-only copy that was already shared with the plugins, and the file is written
+   * by checkpointLoop() without blocking the optimization.
+   *
+   * @param[in] graph A read-only copy of the current graph
+   */
+  void writeCheckpointIfDue(fuse_core::Graph::ConstSharedPtr graph);
+
+  /**
+   * @brief Function that writes the checkpoint snapshots, designed to be run in a separate thread
+   *
+   * If a new snapshot arrives while the previous one is still being written, only the newest one
+   * is kept. Any pending snapshot is written before the thread exits.
+   */
+  void checkpointLoop();
+
+  /**
+   * @brief Discard any pending checkpoint snapshot, wait for a write in progress to complete, and
+   *        delete the checkpoint file
+   */
+  void removeCheckpoint();
+
   /**
    * @brief Perform any required preprocessing steps before \p computeVariablesToMarginalize() is
    *        called
@@ -267,6 +359,18 @@ protected:
    */
   void optimizationLoop();
 
+  /**
+   * @brief Perform a single optimization cycle
+   *
+   * The pending transactions are added to the graph, the graph is optimized, all plugins are
+   * notified, and the expired variables are marginalized out.
+   *
+   * @param[in] optimization_deadline The time by which the cycle was expected to complete. A
+   *                                  warning is logged if it is exceeded.
+   * @return False if the optimizer failed and requested a node shutdown, true otherwise
+   */
+  bool optimizationCycle(const rclcpp::Time & optimization_deadline);
+
   /**
    * @brief Callback fired at a fixed frequency to trigger a new optimization cycle.
    *
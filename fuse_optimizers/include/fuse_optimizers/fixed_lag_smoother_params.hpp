@@ -89,6 +89,39 @@ public:
    */
   ceres::Solver::Options solver_options;
 
+  /**
+   * @brief The number of most recent optimization cycles used to compute the per-phase latency
+   *        percentiles reported in the diagnostics
+   */
+  int profiler_window_size {100};
+
+  /**
+   * @brief If not empty, the timing of every optimization cycle phase is written to this file in the
+   *        Chrome trace-event JSON format
+   */
+  std::string trace_file;
+
+  /**
+   * @brief If not empty, the graph and smoother state are periodically checkpointed to this file,
+   *        and restored from it on startup
+   */
+  std::string checkpoint_file;
+
+  /**
+   * @brief The minimum time between two checkpoints
+   */
+  rclcpp::Duration checkpoint_period {1, 0};
+
+  /**
+   * @brief The Jacobian threshold assigned to the marginal constraints created when variables leave
+   *        the smoothing window
+   *
+   * The marginal cost functions reuse their Jacobians while the variables stay within this distance
+   * of the values the Jacobians were computed at. See fuse_constraints::FirstEstimateCostFunction.
+   * A negative value disables the Jacobian reuse.
+   */
+  double marginal_jacobian_threshold {-1.0};
+
   /**
    * @brief Method for loading parameter values from ROS.
    *
@@ -127,6 +160,16 @@ public:
     fuse_core::getPositiveParam(interfaces, "transaction_timeout", transaction_timeout);
 
     fuse_core::loadSolverOptionsFromROS(interfaces, solver_options, "solver_options");
+
+    fuse_core::getPositiveParam(interfaces, "profiler_window_size", profiler_window_size);
+    trace_file = fuse_core::getParam(interfaces, "trace_file", trace_file);
+
+    checkpoint_file = fuse_core::getParam(interfaces, "checkpoint_file", checkpoint_file);
+    fuse_core::getPositiveParam(interfaces, "checkpoint_period", checkpoint_period);
+
+    marginal_jacobian_threshold = fuse_core::getParam(
+      interfaces, "marginal_jacobian_threshold",
+      marginal_jacobian_threshold);
   }
 };
 
@@ -0,0 +1,101 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2019, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef FUSE_OPTIMIZERS__GRAPH_CHECKPOINT_HPP_
+#define FUSE_OPTIMIZERS__GRAPH_CHECKPOINT_HPP_
+
+#include <string>
+
+#include <fuse_core/graph.hpp>
+#include <fuse_core/transaction.hpp>
+#include <fuse_optimizers/variable_stamp_index.hpp>
+#include <rclcpp/time.hpp>
+
+
+namespace fuse_optimizers
+{
+
+/**
+ * @brief Write a checkpoint of a fixed-lag smoother to a file
+ *
+ * The checkpoint is first written to "<filename>.tmp", then renamed over \p filename, so a crash
+ * while writing never leaves a partial checkpoint behind.
+ *
+ * File layout (all integers in host byte order):
+ *  - header: the 8 magic bytes "FUSECKPT", a uint32 format version, and the uint64 payload length
+ *  - payload: a fuse_core::BinaryOutputArchive holding the start time, the lag expiration, the
+ *             graph, the marginal transaction and the variable timestamp index
+ *
+ * @param[in] filename             The path of the checkpoint file
+ * @param[in] graph                The graph to save
+ * @param[in] start_time           The timestamp of the first ignition sensor transaction
+ * @param[in] lag_expiration       The oldest stamp that is inside the smoother window
+ * @param[in] marginal_transaction The marginals to add during the next optimization cycle
+ * @param[in] timestamp_tracking   The timestamp associated with each variable
+ * @throws std::runtime_error if the file cannot be written
+ */
+void writeCheckpoint(
+  const std::string & filename,
+  const fuse_core::Graph & graph,
+  const rclcpp::Time & start_time,
+  const rclcpp::Time & lag_expiration,
+  const fuse_core::Transaction & marginal_transaction,
+  const VariableStampIndex & timestamp_tracking);
+
+/**
+ * @brief Read a checkpoint written by writeCheckpoint()
+ *
+ * The file is memory-mapped and deserialized in place. Unlike fuse_core::GraphDeserializer, no
+ * plugin libraries are loaded: the library of every Variable, Constraint and Loss type in the
+ * checkpoint must already be loaded, e.g. by the optimizer's own plugins.
+ *
+ * @param[in]  filename             The path of the checkpoint file
+ * @param[out] graph                The graph to restore into
+ * @param[out] start_time           The timestamp of the first ignition sensor transaction
+ * @param[out] lag_expiration       The oldest stamp that is inside the smoother window
+ * @param[out] marginal_transaction The marginals to add during the next optimization cycle
+ * @param[out] timestamp_tracking   The timestamp associated with each variable
+ * @return False if the checkpoint file does not exist, true if it was read
+ * @throws std::runtime_error if the file is not a valid checkpoint or cannot be deserialized
+ */
+bool readCheckpoint(
+  const std::string & filename,
+  fuse_core::Graph & graph,
+  rclcpp::Time & start_time,
+  rclcpp::Time & lag_expiration,
+  fuse_core::Transaction & marginal_transaction,
+  VariableStampIndex & timestamp_tracking);
+
+}  // namespace fuse_optimizers
+
+#endif  // FUSE_OPTIMIZERS__GRAPH_CHECKPOINT_HPP_
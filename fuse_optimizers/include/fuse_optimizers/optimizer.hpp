@@ -36,6 +36,7 @@
 #define FUSE_OPTIMIZERS__OPTIMIZER_HPP_
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -49,6 +50,8 @@
 #include <fuse_core/publisher.hpp>
 #include <fuse_core/sensor_model.hpp>
 #include <fuse_core/transaction.hpp>
+#include <fuse_optimizers/plugin_notifier.hpp>
+#include <fuse_optimizers/transaction_log.hpp>
 #include <pluginlib/class_loader.hpp>
 #include <rclcpp/rclcpp.hpp>
 
@@ -91,7 +94,27 @@ namespace fuse_optimizers
  *  - name: string
  *    type: string
  *  - ...
+ * parallel_notify: bool
+ * start_sensor_models: bool
+ * transaction_log_file: string
  * @endcode
+ *
+ * parallel_notify is disabled by default. When it is enabled, the sensor models and publishers are
+ * notified of graph updates concurrently, each from its own PluginNotifier thread, and notify()
+ * returns without waiting for them. Only enable it if every configured sensor model and publisher
+ * tolerates having its graph callbacks invoked from a thread other than the optimizer thread. A
+ * plugin that is slower than the optimizer skips intermediate graphs, and receives the merge of the
+ * skipped transactions with the next one. Motion models are always notified from the optimizer
+ * thread, so their graph updates are always queued before the next call to applyMotionModels().
+ *
+ * When start_sensor_models is false (it defaults to true), the sensor models are loaded and
+ * initialized, so their configuration (e.g. the ignition flag) is available, but they are never
+ * started or notified of graph updates, so they do not subscribe to any live data. The
+ * replay_transactions tool uses this to feed a recorded transaction log into the optimizer.
+ *
+ * When transaction_log_file is set, every transaction received from a sensor model is written to
+ * that file with a TransactionLogWriter, along with the sensor name and arrival time, so it can be
+ * replayed offline with the replay_transactions tool.
  */
 class Optimizer
 {
@@ -174,6 +197,18 @@ protected:
 
   std::shared_ptr<fuse_core::CallbackAdapter> callback_queue_;
 
+  bool parallel_notify_{false};  //!< Notify sensor models and publishers from their own threads
+  bool start_sensor_models_{true};  //!< Start the sensor models, false when replaying a log
+
+  //! Records every received transaction, if a transaction log file is configured
+  TransactionLogWriter::UniquePtr transaction_log_;
+
+  //! Delivers notifications to each sensor model and publisher when parallel_notify_ is enabled.
+  //! Declared after the plugins so the notification threads are stopped before the plugins are
+  //! destroyed.
+  std::vector<PluginNotifier::UniquePtr> notifiers_;
+  std::mutex notifiers_mutex_;  //!< Guards notifiers_, which is also read by the diagnostics
+
 
   /**
    * @brief Callback fired every time a SensorModel plugin creates a new transaction
@@ -209,6 +244,11 @@ protected:
    */
   void loadSensorModels();
 
+  /**
+   * @brief Create a PluginNotifier for each loaded sensor model and publisher
+   */
+  void createNotifiers();
+
   /**
    * @brief Given a transaction and some timestamps, augment the transaction with constraints from
    *        all associated motion models.
@@ -232,6 +272,9 @@ protected:
   /**
    * @brief Send the sensors, motion models, and publishers updated graph information
    *
+   * If parallel_notify_ is enabled, the sensor models and publishers are handed the graph through
+   * their PluginNotifier and this function returns immediately.
+   *
    * @param[in] transaction A read-only pointer to a transaction containing all recent additions and
    *                        removals
    * @param[in] graph       A read-only pointer to the graph object
@@ -251,6 +294,23 @@ protected:
     const std::string & sensor_name,
     fuse_core::Transaction::SharedPtr transaction);
 
+  /**
+   * @brief Write a received transaction to the transaction log, then pass it on to
+   *        transactionCallback()
+   *
+   * This is executed in the optimizer's callback queue, keeping the serialization cost off the
+   * sensor model threads.
+   *
+   * @param[in] sensor_name The name of the sensor that produced the Transaction
+   * @param[in] arrival     The time the transaction was received
+   * @param[in] transaction The populated Transaction object created by the loaded SensorModel
+   *                        plugin
+   */
+  void recordTransactionCallback(
+    const std::string & sensor_name,
+    const rclcpp::Time & arrival,
+    fuse_core::Transaction::SharedPtr transaction);
+
   /**
    * @brief Clear all of the callbacks inserted into the callback queue by the injectCallback()
    *        method
@@ -264,6 +324,8 @@ protected:
 
   /**
    * @brief Stop all configured plugins (motion models, publishers, and sensor models)
+   *
+   * Any notification still in flight is delivered before the plugins are stopped.
    */
   void stopPlugins();
 
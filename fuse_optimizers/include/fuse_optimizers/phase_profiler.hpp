@@ -0,0 +1,214 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2019, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef FUSE_OPTIMIZERS__PHASE_PROFILER_HPP_
+#define FUSE_OPTIMIZERS__PHASE_PROFILER_HPP_
+
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <diagnostic_updater/diagnostic_status_wrapper.hpp>
+#include <fuse_core/fuse_macros.hpp>
+
+
+namespace fuse_optimizers
+{
+
+/**
+ * @brief Low-overhead timing of the phases of an optimization cycle
+ *
+ * The optimizer brackets each cycle with beginCycle() and endCycle(), and records the time spent in
+ * each phase with record(). A phase may be recorded several times within a cycle; the durations
+ * are summed. At the end of each cycle the per-phase totals are stored in a fixed-size rolling
+ * window, from which the p50, p99 and max latencies are computed on demand.
+ *
+ * Optionally, every recorded phase is also written to a file in the Chrome trace-event JSON array
+ * format (see chrome://tracing or https://ui.perfetto.dev). The events are buffered, and only
+ * written out by writeTrace(), so the optimizer can keep the file I/O out of its critical section.
+ *
+ * beginCycle(), record(), endCycle() and writeTrace() must be called from a single thread.
+ * statistics() and addDiagnostics() may be called from any thread.
+ */
+class PhaseProfiler
+{
+public:
+  FUSE_SMART_PTR_DEFINITIONS(PhaseProfiler)
+
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief Rolling latency statistics for one phase, in seconds
+   */
+  struct Statistics
+  {
+    double p50{0.0};  //!< The median latency within the window
+    double p99{0.0};  //!< The 99th percentile latency within the window
+    double max{0.0};  //!< The maximum latency within the window
+    size_t count{0};  //!< The number of cycles in the window
+  };
+
+  /**
+   * @brief Constructor
+   *
+   * @param[in] phase_names The display name of each phase. Phases are referred to by their index
+   *                        in this list.
+   * @param[in] window_size The number of most recent cycles used to compute the statistics
+   */
+  explicit PhaseProfiler(std::vector<std::string> phase_names, size_t window_size = 100);
+
+  /**
+   * @brief Start writing trace events to the provided file
+   *
+   * Any existing file is overwritten. An empty filename closes the current trace file, if any.
+   *
+   * @param[in] filename The trace file path
+   * @throws std::runtime_error if the file cannot be opened
+   */
+  void openTrace(const std::string & filename);
+
+  /**
+   * @brief Mark the start of a new optimization cycle
+   */
+  void beginCycle();
+
+  /**
+   * @brief Add the time spent in a phase to the current cycle
+   *
+   * @param[in] phase The phase index
+   * @param[in] start The time the phase started
+   * @param[in] stop  The time the phase ended
+   */
+  void record(size_t phase, Clock::time_point start, Clock::time_point stop);
+
+  /**
+   * @brief Mark the end of the current optimization cycle, and store the per-phase totals
+   *
+   * Cycles in which nothing was recorded are discarded. The trace events of the cycle are kept
+   * until the next call to writeTrace().
+   */
+  void endCycle();
+
+  /**
+   * @brief Write the trace events of the cycles ended since the last call to the trace file
+   *
+   * Does nothing if tracing is disabled.
+   */
+  void writeTrace();
+
+  /**
+   * @brief Compute the rolling statistics of a phase
+   *
+   * @param[in] phase The phase index
+   */
+  Statistics statistics(size_t phase) const;
+
+  /**
+   * @brief Compute the rolling statistics of the complete cycle, from beginCycle() to endCycle()
+   */
+  Statistics cycleStatistics() const;
+
+  /**
+   * @brief Add the p50/p99/max latency of every phase and of the complete cycle to a diagnostic
+   *        status
+   *
+   * @param[in,out] status The diagnostic status
+   */
+  void addDiagnostics(diagnostic_updater::DiagnosticStatusWrapper & status) const;
+
+  /**
+   * @brief RAII helper that records the time between its construction and destruction
+   */
+  class Scope
+  {
+public:
+    Scope(PhaseProfiler & profiler, size_t phase)
+    : profiler_(profiler), phase_(phase), start_(Clock::now())
+    {
+    }
+
+    ~Scope()
+    {
+      profiler_.record(phase_, start_, Clock::now());
+    }
+
+private:
+    PhaseProfiler & profiler_;
+    size_t phase_;
+    Clock::time_point start_;
+  };
+
+private:
+  /**
+   * @brief A fixed-size window of the most recent samples
+   */
+  struct Window
+  {
+    std::vector<double> samples;  //!< The samples, in seconds
+    size_t next{0};  //!< The index the next sample is written to
+    size_t count{0};  //!< The number of valid samples
+
+    void push(double sample);
+    Statistics statistics() const;
+  };
+
+  /**
+   * @brief A buffered trace event
+   */
+  struct TraceEvent
+  {
+    size_t phase;  //!< The phase index, or the number of phases for the complete cycle
+    Clock::time_point start;
+    Clock::duration duration;
+  };
+
+  std::vector<std::string> phase_names_;  //!< The display name of each phase
+  Clock::time_point epoch_;  //!< The zero time of the trace file timestamps
+
+  Clock::time_point cycle_start_;  //!< The start time of the current cycle
+  std::vector<Clock::duration> cycle_durations_;  //!< The phase totals of the current cycle
+  bool cycle_recorded_{false};  //!< True if anything was recorded during the current cycle
+  std::vector<TraceEvent> trace_events_;  //!< The trace events of the current cycle
+  std::vector<TraceEvent> ended_trace_events_;  //!< The trace events not written yet
+  std::ofstream trace_file_;  //!< The trace output file, if tracing is enabled
+
+  mutable std::mutex windows_mutex_;  //!< Guards the rolling windows
+  std::vector<Window> windows_;  //!< The rolling window of each phase
+  Window cycle_window_;  //!< The rolling window of the complete cycle
+};
+
+}  // namespace fuse_optimizers
+
+#endif  // FUSE_OPTIMIZERS__PHASE_PROFILER_HPP_
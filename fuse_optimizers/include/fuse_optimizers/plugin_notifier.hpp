@@ -0,0 +1,175 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2019, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef FUSE_OPTIMIZERS__PLUGIN_NOTIFIER_HPP_
+#define FUSE_OPTIMIZERS__PLUGIN_NOTIFIER_HPP_
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <fuse_core/fuse_macros.hpp>
+#include <fuse_core/graph.hpp>
+#include <fuse_core/transaction.hpp>
+
+
+namespace fuse_optimizers
+{
+
+/**
+ * @brief Delivers optimizer notifications to a single plugin from a dedicated thread
+ *
+ * The optimizer notifies every sensor model, motion model and publisher after each optimization
+ * cycle. Some plugins (e.g. synchronous publishers) do real work inside that call. By handing the
+ * notification to a PluginNotifier instead of calling the plugin directly, the optimizer thread
+ * returns immediately and all plugins are serviced concurrently, each from its own thread.
+ *
+ * At most one notification is kept waiting for each plugin. A notification submitted while
+ * another one is still waiting replaces its graph with the newer one and merges the transactions,
+ * so the plugin still sees every change, in order. A plugin that cannot keep up with the optimizer
+ * therefore skips intermediate graphs instead of accumulating graph copies without bound. The time
+ * between submitting a notification and the plugin callback returning is tracked, so such a plugin
+ * is visible in the optimizer diagnostics instead of silently stretching the optimization cycle.
+ */
+class PluginNotifier
+{
+public:
+  FUSE_SMART_PTR_DEFINITIONS(PluginNotifier)
+
+  /**
+   * @brief The function executed for every notification
+   */
+  using Callback = std::function<void (
+        fuse_core::Transaction::ConstSharedPtr transaction,
+        fuse_core::Graph::ConstSharedPtr graph)>;
+
+  /**
+   * @brief Latency statistics for the notifications delivered to a plugin
+   */
+  struct Statistics
+  {
+    size_t delivered{0};  //!< The number of notifications delivered to the plugin
+    size_t pending{0};  //!< The number of notifications waiting to be delivered, zero or one
+    size_t coalesced{0};  //!< The number of notifications merged into a waiting one
+    std::chrono::nanoseconds last_latency{0};  //!< Submit-to-completion time of the last one
+    std::chrono::nanoseconds max_latency{0};  //!< Largest submit-to-completion time so far
+    std::chrono::nanoseconds total_latency{0};  //!< Sum of all submit-to-completion times
+  };
+
+  /**
+   * @brief Constructor
+   *
+   * Starts the notification thread.
+   *
+   * @param[in] name     The name of the notified plugin
+   * @param[in] callback The function used to deliver a notification to the plugin
+   */
+  PluginNotifier(const std::string & name, Callback callback);
+
+  /**
+   * @brief Destructor
+   *
+   * Any notification still pending is discarded. The notification currently being delivered, if
+   * any, is allowed to complete.
+   */
+  virtual ~PluginNotifier();
+
+  /**
+   * @brief The name of the notified plugin
+   */
+  const std::string & name() const {return name_;}
+
+  /**
+   * @brief Queue a notification for delivery to the plugin and return immediately
+   *
+   * If a notification is already waiting, it is replaced by one with the new graph and the merge of
+   * both transactions.
+   *
+   * @param[in] transaction A Transaction object, describing the set of variables that have been
+   *                        added and/or removed
+   * @param[in] graph       A read-only pointer to the graph object
+   */
+  void notify(
+    fuse_core::Transaction::ConstSharedPtr transaction,
+    fuse_core::Graph::ConstSharedPtr graph);
+
+  /**
+   * @brief Block until every queued notification has been delivered to the plugin
+   */
+  void wait();
+
+  /**
+   * @brief Discard the pending notification, if any
+   */
+  void clear();
+
+  /**
+   * @brief Access a copy of the current notification statistics
+   */
+  Statistics statistics() const;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief A queued notification
+   */
+  struct Notification
+  {
+    fuse_core::Transaction::ConstSharedPtr transaction;
+    fuse_core::Graph::ConstSharedPtr graph;
+    Clock::time_point submitted;
+  };
+
+  //! Deliver queued notifications to the plugin until the notifier is destroyed
+  void run();
+
+  std::string name_;  //!< The name of the notified plugin
+  Callback callback_;  //!< The function used to deliver a notification to the plugin
+
+  mutable std::mutex mutex_;  //!< Guards the pending notification, the statistics and the flags
+  std::condition_variable queue_changed_;  //!< Signalled whenever the pending state changes
+  Notification pending_;  //!< The notification waiting to be delivered, if has_pending_
+  bool has_pending_{false};  //!< True while a notification is waiting to be delivered
+  bool busy_{false};  //!< True while a notification is being delivered
+  bool running_{true};  //!< False once the notifier is shutting down
+  Statistics statistics_;  //!< The notification statistics
+  std::thread thread_;  //!< The notification thread
+};
+
+}  // namespace fuse_optimizers
+
+#endif  // FUSE_OPTIMIZERS__PLUGIN_NOTIFIER_HPP_
@@ -0,0 +1,152 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2019, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef FUSE_OPTIMIZERS__TRANSACTION_LOG_HPP_
+#define FUSE_OPTIMIZERS__TRANSACTION_LOG_HPP_
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <fuse_core/fuse_macros.hpp>
+#include <fuse_core/transaction.hpp>
+#include <fuse_core/transaction_deserializer.hpp>
+#include <rclcpp/time.hpp>
+
+
+namespace fuse_optimizers
+{
+
+/**
+ * @brief Writes the transactions received by an optimizer to a compact binary file
+ *
+ * Each record holds the name of the sensor that sent the transaction, the time the optimizer
+ * received it, and the transaction itself, serialized with fuse_core::Transaction::serialize().
+ * The file can be read back with a TransactionLogReader, e.g. to replay a field recording into
+ * an optimizer offline.
+ *
+ * File layout (all integers in host byte order):
+ *  - header: the 8 magic bytes "FUSETXLG", followed by a uint32 format version
+ *  - records: uint32 sensor name length, sensor name bytes, int64 arrival time in nanoseconds,
+ *             int32 arrival time clock type, uint64 payload length, payload bytes
+ *
+ * record() may be called from multiple threads.
+ */
+class TransactionLogWriter
+{
+public:
+  FUSE_SMART_PTR_DEFINITIONS(TransactionLogWriter)
+
+  /**
+   * @brief Constructor
+   *
+   * Any existing file is overwritten.
+   *
+   * @param[in] filename The path of the file to write
+   * @throws std::runtime_error if the file cannot be opened
+   */
+  explicit TransactionLogWriter(const std::string & filename);
+
+  /**
+   * @brief Append a transaction to the log
+   *
+   * @param[in] sensor_name The name of the sensor that sent the transaction
+   * @param[in] arrival     The time the transaction was received by the optimizer
+   * @param[in] transaction The transaction
+   */
+  void record(
+    const std::string & sensor_name,
+    const rclcpp::Time & arrival,
+    const fuse_core::Transaction & transaction);
+
+private:
+  std::mutex mutex_;  //!< Serializes writes to the file
+  std::ofstream file_;  //!< The output file
+  std::vector<unsigned char> buffer_;  //!< Reusable serialization buffer
+};
+
+/**
+ * @brief Reads the transactions written by a TransactionLogWriter
+ *
+ * All Variable, Constraint and Loss plugin libraries are loaded on construction, so that every
+ * recorded type can be deserialized.
+ */
+class TransactionLogReader
+{
+public:
+  FUSE_SMART_PTR_DEFINITIONS(TransactionLogReader)
+
+  /**
+   * @brief A recorded transaction
+   */
+  struct Entry
+  {
+    std::string sensor_name;  //!< The name of the sensor that sent the transaction
+    rclcpp::Time arrival;  //!< The time the transaction was received by the optimizer
+    fuse_core::Transaction::SharedPtr transaction;  //!< The transaction
+  };
+
+  /**
+   * @brief Constructor
+   *
+   * @param[in] filename The path of the file to read
+   * @throws std::runtime_error if the file cannot be opened or is not a transaction log
+   */
+  explicit TransactionLogReader(const std::string & filename);
+
+  /**
+   * @brief Read the next recorded transaction
+   *
+   * @param[out] entry The recorded transaction
+   * @return True if a transaction was read, false at the end of the file
+   * @throws std::runtime_error if the file is truncated or corrupted, or a transaction cannot be
+   *         deserialized
+   */
+  bool next(Entry & entry);
+
+private:
+  std::ifstream file_;  //!< The input file
+  uint64_t file_size_{0};  //!< The size of the input file, in bytes
+  fuse_core::TransactionDeserializer deserializer_;  //!< Loads the plugins and deserializes
+
+  /**
+   * @brief The number of bytes between the current read position and the end of the file
+   */
+  uint64_t remaining();
+};
+
+}  // namespace fuse_optimizers
+
+#endif  // FUSE_OPTIMIZERS__TRANSACTION_LOG_HPP_
@@ -39,9 +39,13 @@
 #include <unordered_set>
 
 #include <fuse_core/fuse_macros.hpp>
+#include <fuse_core/serialization.hpp>
 #include <fuse_core/transaction.hpp>
 #include <fuse_core/uuid.hpp>
 
+#include <boost/serialization/access.hpp>
+#include <boost/serialization/unordered_map.hpp>
+#include <boost/serialization/unordered_set.hpp>
 #include <rclcpp/time.hpp>
 
 
@@ -196,6 +200,25 @@ protected:
    * @brief Update this VariableStampIndex with the removed variables from the provided transaction
    */
   void applyRemovedVariables(const fuse_core::Transaction & transaction);
+
+private:
+  // Allow Boost Serialization access to private methods
+  friend class boost::serialization::access;
+
+  /**
+   * @brief The Boost Serialize method that serializes all of the data members in to/out of the
+   *        archive
+   *
+   * @param[in/out] archive - The archive object that holds the serialized class members
+   * @param[in] version - The version of the archive being read/written. Generally unused.
+   */
+  template<class Archive>
+  void serialize(Archive & archive, const unsigned int /* version */)
+  {
+    archive & stamped_index_;
+    archive & variables_;
+    archive & constraints_;
+  }
 };
 
 }  // namespace fuse_optimizers
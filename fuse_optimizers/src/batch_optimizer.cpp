@@ -148,26 +148,31 @@ void BatchOptimizer::optimizationLoop()
     if (!interfaces_.get_node_base_interface()->get_context()->is_valid()) {
       break;
     }
-    // Copy the combined transaction so it can be shared with all the plugins
-    fuse_core::Transaction::ConstSharedPtr const_transaction;
-    {
-      std::lock_guard<std::mutex> lock(combined_transaction_mutex_);
-      const_transaction = std::move(combined_transaction_);
-      combined_transaction_ = fuse_core::Transaction::make_shared();
-    }
-    // Update the graph
-    graph_->update(*const_transaction);
-    // Optimize the entire graph
-    graph_->optimize(params_.solver_options);
-    // Make a copy of the graph to share
-    fuse_core::Graph::ConstSharedPtr const_graph = graph_->clone();
-    // Optimization is complete. Notify all the things about the graph changes.
-    notify(const_transaction, const_graph);
+    optimizationCycle();
     // Clear the request flag now that this optimization cycle is complete
     optimization_request_ = false;
   }
 }
 
+void BatchOptimizer::optimizationCycle()
+{
+  // Copy the combined transaction so it can be shared with all the plugins
+  fuse_core::Transaction::ConstSharedPtr const_transaction;
+  {
+    std::lock_guard<std::mutex> lock(combined_transaction_mutex_);
+    const_transaction = std::move(combined_transaction_);
+    combined_transaction_ = fuse_core::Transaction::make_shared();
+  }
+  // Update the graph
+  graph_->update(*const_transaction);
+  // Optimize the entire graph
+  graph_->optimize(params_.solver_options);
+  // Make a copy of the graph to share
+  fuse_core::Graph::ConstSharedPtr const_graph = graph_->clone();
+  // Optimization is complete. Notify all the things about the graph changes.
+  notify(const_transaction, const_graph);
+}
+
 void BatchOptimizer::optimizerTimerCallback()
 {
   // If an "ignition" transaction hasn't been received, then we can't do anything yet.
@@ -33,11 +33,15 @@
  */
 
 #include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <iterator>
+#include <memory>
 #include <mutex>
 #include <sstream>
 #include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #include <fuse_constraints/marginalize_variables.hpp>
@@ -46,6 +50,7 @@
 #include <fuse_core/util.hpp>
 #include <fuse_core/uuid.hpp>
 #include <fuse_optimizers/fixed_lag_smoother.hpp>
+#include <fuse_optimizers/graph_checkpoint.hpp>
 #include <fuse_optimizers/optimizer.hpp>
 #include <rclcpp/rclcpp.hpp>
 
@@ -90,12 +95,27 @@ FixedLagSmoother::FixedLagSmoother(
 {
   params_.loadFromROS(interfaces_);
 
+  profiler_ = PhaseProfiler::make_unique(
+    std::vector<std::string>{
+    "Process Queue", "Apply Motion Models", "Update Graph", "Create Problem", "Solve",
+    "Clone Graph", "Notify", "Marginalize", "Checkpoint"},
+    params_.profiler_window_size);
+  profiler_->openTrace(params_.trace_file);
+
   // Test for auto-start
   autostart();
 
+  // Resume from the last checkpoint, if one exists
+  restoreCheckpoint();
+
   // Start the optimization thread
   optimization_thread_ = std::thread(&FixedLagSmoother::optimizationLoop, this);
 
+  // Start the checkpoint thread
+  if (!params_.checkpoint_file.empty()) {
+    checkpoint_thread_ = std::thread(&FixedLagSmoother::checkpointLoop, this);
+  }
+
   // Configure a timer to trigger optimizations
   optimize_timer_ = rclcpp::create_timer(
     interfaces_,
@@ -132,6 +152,15 @@ FixedLagSmoother::~FixedLagSmoother()
   if (optimization_thread_.joinable()) {
     optimization_thread_.join();
   }
+  // Write the last checkpoint and stop the checkpoint thread
+  {
+    std::lock_guard<std::mutex> lock(checkpoint_mutex_);
+    checkpoint_running_ = false;
+  }
+  checkpoint_changed_.notify_all();
+  if (checkpoint_thread_.joinable()) {
+    checkpoint_thread_.join();
+  }
 }
 
 void FixedLagSmoother::autostart()
@@ -149,6 +178,137 @@ void FixedLagSmoother::autostart()
   }
 }
 
+void FixedLagSmoother::restoreCheckpoint()
+{
+  if (params_.checkpoint_file.empty()) {
+    return;
+  }
+  auto start_time = getStartTime();
+  const auto restore_start = std::chrono::steady_clock::now();
+  try {
+    if (!readCheckpoint(
+        params_.checkpoint_file, *graph_, start_time, lag_expiration_, marginal_transaction_,
+        timestamp_tracking_))
+    {
+      return;
+    }
+  } catch (const std::exception & ex) {
+    RCLCPP_ERROR_STREAM(
+      logger_,
+      "Failed to restore the checkpoint: " << ex.what() << " Starting from scratch.");
+    graph_->clear();
+    marginal_transaction_ = fuse_core::Transaction();
+    timestamp_tracking_.clear();
+    lag_expiration_ = rclcpp::Time(0, 1, RCL_ROS_TIME);  // NOTE(CH3): INITIALIZED!
+    return;
+  }
+  const auto restore_seconds =
+    std::chrono::duration<double>(std::chrono::steady_clock::now() - restore_start).count();
+  started_ = true;
+  ignited_ = false;
+  setStartTime(start_time);
+  RCLCPP_INFO_STREAM(
+    logger_,
+    "Restored the graph from the checkpoint " << params_.checkpoint_file << " in "
+                                              << restore_seconds << "s.");
+
+  // Tell the plugins about the restored graph, as if it had just been added
+  const auto newest_stamp = timestamp_tracking_.currentStamp();
+  auto transaction = fuse_core::Transaction::make_shared();
+  transaction->stamp(newest_stamp);
+  for (const auto & variable : graph_->getVariables()) {
+    transaction->addVariable(variable.clone());
+  }
+  for (const auto & constraint : graph_->getConstraints()) {
+    transaction->addConstraint(constraint.clone());
+  }
+  // Seed the motion models with the newest restored state. Otherwise the first segment they
+  // generate starts at the next measurement, disconnected from the restored graph. This runs
+  // before the notification, so the seeded states are refreshed from the restored graph values.
+  if (newest_stamp.get_clock_type() != RCL_CLOCK_UNINITIALIZED) {
+    transaction->addInvolvedStamp(newest_stamp);
+  }
+  for (const auto & name_motion_model : motion_models_) {
+    try {
+      if (!name_motion_model.second->apply(*transaction)) {
+        RCLCPP_WARN_STREAM(
+          logger_,
+          "Failed to seed the motion model '" << name_motion_model.first
+                                              << "' with the restored checkpoint.");
+      }
+    } catch (const std::exception & ex) {
+      RCLCPP_ERROR_STREAM(
+        logger_,
+        "Error seeding the motion model '" << name_motion_model.first
+                                           << "' with the restored checkpoint: " << ex.what());
+    }
+  }
+  notify(std::move(transaction), graph_->clone());
+}
+
+void FixedLagSmoother::writeCheckpointIfDue(fuse_core::Graph::ConstSharedPtr graph)
+{
+  if (params_.checkpoint_file.empty()) {
+    return;
+  }
+  const auto now = std::chrono::steady_clock::now();
+  if (now < next_checkpoint_) {
+    return;
+  }
+  next_checkpoint_ = now + params_.checkpoint_period.to_chrono<std::chrono::nanoseconds>();
+  auto snapshot = std::make_unique<CheckpointSnapshot>();
+  snapshot->graph = std::move(graph);
+  snapshot->start_time = getStartTime();
+  snapshot->lag_expiration = lag_expiration_;
+  snapshot->marginal_transaction = marginal_transaction_;
+  snapshot->timestamp_tracking = timestamp_tracking_;
+  {
+    std::lock_guard<std::mutex> lock(checkpoint_mutex_);
+    checkpoint_snapshot_ = std::move(snapshot);
+  }
+  checkpoint_changed_.notify_all();
+}
+
+void FixedLagSmoother::checkpointLoop()
+{
+  std::unique_lock<std::mutex> lock(checkpoint_mutex_);
+  while (true) {
+    checkpoint_changed_.wait(lock, [this]() {return !checkpoint_running_ || checkpoint_snapshot_;});
+    if (!checkpoint_snapshot_) {
+      break;
+    }
+    auto snapshot = std::move(checkpoint_snapshot_);
+    checkpoint_busy_ = true;
+
+    // Write the file without holding the lock, so the optimizer can keep submitting snapshots
+    lock.unlock();
+    try {
+      writeCheckpoint(
+        params_.checkpoint_file, *snapshot->graph, snapshot->start_time, snapshot->lag_expiration,
+        snapshot->marginal_transaction, snapshot->timestamp_tracking);
+    } catch (const std::exception & ex) {
+      RCLCPP_ERROR_STREAM_THROTTLE(
+        logger_, *clock_, 10.0 * 1000, "Failed to write the checkpoint: " << ex.what());
+    }
+    snapshot.reset();
+    lock.lock();
+
+    checkpoint_busy_ = false;
+    checkpoint_changed_.notify_all();
+  }
+}
+
+void FixedLagSmoother::removeCheckpoint()
+{
+  if (params_.checkpoint_file.empty()) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(checkpoint_mutex_);
+  checkpoint_snapshot_.reset();
+  checkpoint_changed_.wait(lock, [this]() {return !checkpoint_busy_;});
+  std::remove(params_.checkpoint_file.c_str());
+}
+
 void FixedLagSmoother::preprocessMarginalization(const fuse_core::Transaction & new_transaction)
 {
   timestamp_tracking_.addNewTransaction(new_transaction);
@@ -212,85 +372,122 @@ void FixedLagSmoother::optimizationLoop()
       break;
     }
     // Optimize
-    {
-      std::lock_guard<std::mutex> lock(optimization_mutex_);
-      // Apply motion models
-      auto new_transaction = fuse_core::Transaction::make_shared();
-      // DANGER: processQueue obtains a lock from the pending_transactions_mutex_
-      //         We do this to ensure state of the graph does not change between unlocking the
-      //         pending_transactions queue and obtaining the lock for the graph. But we have now
-      //         obtained two different locks. If we are not extremely careful, we could get a
-      //         deadlock.
-      // TODO(CH3): We might have to make sure lag_expiration_ has been initialised
-      processQueue(*new_transaction, lag_expiration_);
-      // Skip this optimization cycle if the transaction is empty because something failed while
-      // processing the pending transactions queue.
-      if (new_transaction->empty()) {
-        continue;
-      }
-      // Prepare for selecting the marginal variables
-      preprocessMarginalization(*new_transaction);
-      // Combine the new transactions with any marginal transaction from the end of the last cycle
-      new_transaction->merge(marginal_transaction_);
-      // Update the graph
-      try {
-        graph_->update(*new_transaction);
-      } catch (const std::exception & ex) {
-        std::ostringstream oss;
-        oss << "Graph:\n";
-        graph_->print(oss);
-        oss << "\nTransaction:\n";
-        new_transaction->print(oss);
-
-        RCLCPP_FATAL_STREAM(
-          logger_,
-          "Failed to update graph with transaction: "
-            << ex.what() << "\nLeaving optimization loop and requesting node shutdown...\n"
-            << oss.str());
-        rclcpp::shutdown();
-        break;
-      }
-      // Optimize the entire graph
-      summary_ = graph_->optimize(params_.solver_options);
-
-      // Optimization is complete. Notify all the things about the graph changes.
-      const auto new_transaction_stamp = new_transaction->stamp();
-      notify(std::move(new_transaction), graph_->clone());
+    const bool keep_running = optimizationCycle(optimization_deadline);
+    // Write the trace of the cycle out of the optimization critical section
+    profiler_->writeTrace();
+    if (!keep_running) {
+      break;
+    }
+  }
+}
 
-      // Abort if optimization failed. Not converging is not a failure because the solution found is
-      // usable.
-      if (!summary_.IsSolutionUsable()) {
-        RCLCPP_FATAL_STREAM(
-          logger_,
-          "Optimization failed after updating the graph with the transaction with timestamp "
-            << new_transaction_stamp.nanoseconds() <<
-            ". Leaving optimization loop and requesting node shutdown...");
-        RCLCPP_INFO(logger_, summary_.FullReport().c_str());
-        rclcpp::shutdown();
-        break;
-      }
+bool FixedLagSmoother::optimizationCycle(const rclcpp::Time & optimization_deadline)
+{
+  std::lock_guard<std::mutex> lock(optimization_mutex_);
+  profiler_->beginCycle();
+  // Apply motion models
+  auto new_transaction = fuse_core::Transaction::make_shared();
+  // DANGER: processQueue obtains a lock from the pending_transactions_mutex_
+  //         We do this to ensure state of the graph does not change between unlocking the
+  //         pending_transactions queue and obtaining the lock for the graph. But we have now
+  //         obtained two different locks. If we are not extremely careful, we could get a
+  //         deadlock.
+  // TODO(CH3): We might have to make sure lag_expiration_ has been initialised
+  {
+    PhaseProfiler::Scope scope(*profiler_, PROCESS_QUEUE);
+    processQueue(*new_transaction, lag_expiration_);
+  }
+  // Skip this optimization cycle if the transaction is empty because something failed while
+  // processing the pending transactions queue.
+  if (new_transaction->empty()) {
+    return true;
+  }
+  // Prepare for selecting the marginal variables
+  preprocessMarginalization(*new_transaction);
+  // Combine the new transactions with any marginal transaction from the end of the last cycle
+  new_transaction->merge(marginal_transaction_);
+  // Update the graph
+  try {
+    PhaseProfiler::Scope scope(*profiler_, UPDATE_GRAPH);
+    graph_->update(*new_transaction);
+  } catch (const std::exception & ex) {
+    std::ostringstream oss;
+    oss << "Graph:\n";
+    graph_->print(oss);
+    oss << "\nTransaction:\n";
+    new_transaction->print(oss);
+
+    RCLCPP_FATAL_STREAM(
+      logger_,
+      "Failed to update graph with transaction: "
+        << ex.what() << "\nLeaving optimization loop and requesting node shutdown...\n"
+        << oss.str());
+    rclcpp::shutdown();
+    return false;
+  }
+  // Optimize the entire graph
+  const auto optimize_start = PhaseProfiler::Clock::now();
+  summary_ = graph_->optimize(params_.solver_options);
+  const auto optimize_stop = PhaseProfiler::Clock::now();
+  // The solver summary only covers the time spent in ceres::Solve(). Attribute the rest to
+  // the construction of the ceres::Problem.
+  const auto solve_duration = std::chrono::duration_cast<PhaseProfiler::Clock::duration>(
+    std::chrono::duration<double>(std::max(summary_.total_time_in_seconds, 0.0)));
+  const auto solve_start = std::max(optimize_start, optimize_stop - solve_duration);
+  profiler_->record(CREATE_PROBLEM, optimize_start, solve_start);
+  profiler_->record(SOLVE, solve_start, optimize_stop);
+
+  // Optimization is complete. Notify all the things about the graph changes.
+  const auto new_transaction_stamp = new_transaction->stamp();
+  const auto clone_start = PhaseProfiler::Clock::now();
+  fuse_core::Graph::ConstSharedPtr graph_clone = graph_->clone();
+  const auto notify_start = PhaseProfiler::Clock::now();
+  profiler_->record(CLONE_GRAPH, clone_start, notify_start);
+  notify(std::move(new_transaction), graph_clone);
+  profiler_->record(NOTIFY, notify_start, PhaseProfiler::Clock::now());
+
+  // Abort if optimization failed. Not converging is not a failure because the solution found is
+  // usable.
+  if (!summary_.IsSolutionUsable()) {
+    RCLCPP_FATAL_STREAM(
+      logger_,
+      "Optimization failed after updating the graph with the transaction with timestamp "
+        << new_transaction_stamp.nanoseconds() <<
+        ". Leaving optimization loop and requesting node shutdown...");
+    RCLCPP_INFO(logger_, summary_.FullReport().c_str());
+    rclcpp::shutdown();
+    return false;
+  }
 
-      // Compute a transaction that marginalizes out those variables.
-      lag_expiration_ = computeLagExpirationTime();
-      marginal_transaction_ = fuse_constraints::marginalizeVariables(
-        interfaces_.get_node_base_interface()->get_name(),
-        computeVariablesToMarginalize(lag_expiration_),
-        *graph_);
-      // Perform any post-marginal cleanup
-      postprocessMarginalization(marginal_transaction_);
-      // Note: The marginal transaction will not be applied until the next optimization iteration
-      // Log a warning if the optimization took too long
-      auto optimization_complete = clock_->now();
-      if (optimization_complete > optimization_deadline) {
-        RCLCPP_WARN_STREAM_THROTTLE(
-          logger_,
-          *clock_,
-          10.0 * 1000,
-          "Optimization exceeded the configured duration by "
-            << (optimization_complete - optimization_deadline).nanoseconds() << "ns");
-      }
-    }
+  // Compute a transaction that marginalizes out those variables.
+  {
+    PhaseProfiler::Scope scope(*profiler_, MARGINALIZE);
+    lag_expiration_ = computeLagExpirationTime();
+    marginal_transaction_ = fuse_constraints::marginalizeVariables(
+      interfaces_.get_node_base_interface()->get_name(),
+      computeVariablesToMarginalize(lag_expiration_),
+      *graph_,
+      params_.marginal_jacobian_threshold);
+    // Perform any post-marginal cleanup
+    postprocessMarginalization(marginal_transaction_);
+  }
+  {
+    PhaseProfiler::Scope scope(*profiler_, CHECKPOINT);
+    writeCheckpointIfDue(std::move(graph_clone));
+  }
+  profiler_->endCycle();
+  // Note: The marginal transaction will not be applied until the next optimization iteration
+  // Log a warning if the optimization took too long
+  auto optimization_complete = clock_->now();
+  if (optimization_complete > optimization_deadline) {
+    RCLCPP_WARN_STREAM_THROTTLE(
+      logger_,
+      *clock_,
+      10.0 * 1000,
+      "Optimization exceeded the configured duration by "
+        << (optimization_complete - optimization_deadline).nanoseconds() << "ns");
   }
+  return true;
 }
 
 void FixedLagSmoother::optimizerTimerCallback()
@@ -328,6 +525,13 @@ void FixedLagSmoother::processQueue(
     return;
   }
 
+  // Apply the motion models to a queued transaction, tracking the time spent doing so
+  auto apply_motion_models = [this](const TransactionQueueElement & element)
+    {
+      PhaseProfiler::Scope scope(*profiler_, APPLY_MOTION_MODELS);
+      return applyMotionModels(element.sensor_name, *element.transaction);
+    };
+
   // If we just started because an ignition sensor transaction was received, we try to process it
   // individually. This is important because we need to update the graph with the ignition sensor
   // transaction in order to get the motion models notified of the initial state. The motion models
@@ -356,7 +560,7 @@ void FixedLagSmoother::processQueue(
           << " is not an ignition sensor transaction. "
           << "This transaction will not be processed individually.");
     } else {
-      if (applyMotionModels(element.sensor_name, *element.transaction)) {
+      if (apply_motion_models(element)) {
         // Processing was successful. Add the results to the final transaction, delete this one, and
         // return, so the transaction from the ignition sensor is processed individually.
         transaction.merge(*element.transaction, true);
@@ -427,7 +631,7 @@ void FixedLagSmoother::processQueue(
     {
       // We should not process transactions from this sensor
       ++transaction_riter;
-    } else if (applyMotionModels(element.sensor_name, *element.transaction)) {
+    } else if (apply_motion_models(element)) {
       // Processing was successful. Add the results to the final transaction, delete this one, and
       // move to the next.
       transaction.merge(*element.transaction, true);
@@ -486,6 +690,8 @@ bool FixedLagSmoother::resetServiceCallback(
     marginal_transaction_ = fuse_core::Transaction();
     timestamp_tracking_.clear();
     lag_expiration_ = rclcpp::Time(0, 1, RCL_ROS_TIME);  // NOTE(CH3): INITIALIZED!
+    // Do not resume from the discarded graph after a restart
+    removeCheckpoint();
   }
   // Tell all the plugins to start
   startPlugins();
@@ -669,6 +875,9 @@ void FixedLagSmoother::setDiagnostics(diagnostic_updater::DiagnosticStatusWrappe
       status.mergeSummary(terminationTypeToDiagnosticStatus(summary.termination_type));
     }
 
+    // Add the rolling latency percentiles of each optimization cycle phase
+    profiler_->addDiagnostics(status);
+
     // Add time since the last optimization request time. This is useful to detect if no
     // transactions are received for too long
     auto optimization_deadline = decltype(optimization_deadline_)();
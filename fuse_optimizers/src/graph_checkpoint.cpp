@@ -0,0 +1,197 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2019, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/stream.hpp>
+#include <fuse_core/serialization.hpp>
+#include <fuse_optimizers/graph_checkpoint.hpp>
+
+namespace fuse_optimizers
+{
+
+namespace
+{
+constexpr char kMagic[8] = {'F', 'U', 'S', 'E', 'C', 'K', 'P', 'T'};
+constexpr uint32_t kVersion = 1;
+constexpr size_t kHeaderSize = sizeof(kMagic) + sizeof(uint32_t) + sizeof(uint64_t);
+
+/**
+ * @brief A read-only memory mapping of a whole file, unmapped on destruction
+ */
+class MappedFile
+{
+public:
+  MappedFile(const void * data, size_t size)
+  : data_(data), size_(size) {}
+
+  ~MappedFile()
+  {
+    if (size_ > 0) {
+      ::munmap(const_cast<void *>(data_), size_);
+    }
+  }
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile & operator=(const MappedFile &) = delete;
+
+  const char * data() const {return static_cast<const char *>(data_);}
+  size_t size() const {return size_;}
+
+private:
+  const void * data_;  //!< The start of the mapping
+  size_t size_;  //!< The length of the mapping in bytes
+};
+}  // namespace
+
+void writeCheckpoint(
+  const std::string & filename,
+  const fuse_core::Graph & graph,
+  const rclcpp::Time & start_time,
+  const rclcpp::Time & lag_expiration,
+  const fuse_core::Transaction & marginal_transaction,
+  const VariableStampIndex & timestamp_tracking)
+{
+  std::vector<unsigned char> payload;
+  {
+    boost::iostreams::stream<fuse_core::MessageBufferStreamSink> stream(payload);
+    // Scope the archive object. The archive is not guaranteed to write to the stream until the
+    // archive goes out of scope.
+    {
+      fuse_core::BinaryOutputArchive archive(stream);
+      archive << start_time;
+      archive << lag_expiration;
+      graph.serialize(archive);
+      marginal_transaction.serialize(archive);
+      archive << timestamp_tracking;
+    }
+  }
+
+  const auto temporary_filename = filename + ".tmp";
+  {
+    std::ofstream file(temporary_filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    const auto payload_size = static_cast<uint64_t>(payload.size());
+    file.write(kMagic, sizeof(kMagic));
+    file.write(reinterpret_cast<const char *>(&kVersion), sizeof(kVersion));
+    file.write(reinterpret_cast<const char *>(&payload_size), sizeof(payload_size));
+    file.write(reinterpret_cast<const char *>(payload.data()), payload.size());
+    file.close();
+    if (!file) {
+      std::remove(temporary_filename.c_str());
+      throw std::runtime_error("Unable to write the checkpoint file '" + temporary_filename + "'.");
+    }
+  }
+  if (std::rename(temporary_filename.c_str(), filename.c_str()) != 0) {
+    std::remove(temporary_filename.c_str());
+    throw std::runtime_error(
+            "Unable to replace the checkpoint file '" + filename + "': " + std::strerror(errno));
+  }
+}
+
+bool readCheckpoint(
+  const std::string & filename,
+  fuse_core::Graph & graph,
+  rclcpp::Time & start_time,
+  rclcpp::Time & lag_expiration,
+  fuse_core::Transaction & marginal_transaction,
+  VariableStampIndex & timestamp_tracking)
+{
+  const int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    if (errno == ENOENT) {
+      return false;
+    }
+    throw std::runtime_error(
+            "Unable to open the checkpoint file '" + filename + "': " + std::strerror(errno));
+  }
+  struct stat file_status;
+  if (::fstat(fd, &file_status) != 0 || static_cast<size_t>(file_status.st_size) < kHeaderSize) {
+    ::close(fd);
+    throw std::runtime_error("The file '" + filename + "' is not a fuse checkpoint.");
+  }
+  const auto size = static_cast<size_t>(file_status.st_size);
+  void * data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    throw std::runtime_error(
+            "Unable to map the checkpoint file '" + filename + "': " + std::strerror(errno));
+  }
+  const MappedFile file(data, size);
+
+  uint32_t version = 0;
+  uint64_t payload_size = 0;
+  std::memcpy(&version, file.data() + sizeof(kMagic), sizeof(version));
+  std::memcpy(&payload_size, file.data() + sizeof(kMagic) + sizeof(version), sizeof(payload_size));
+  if (std::memcmp(file.data(), kMagic, sizeof(kMagic)) != 0) {
+    throw std::runtime_error("The file '" + filename + "' is not a fuse checkpoint.");
+  }
+  if (version != kVersion) {
+    throw std::runtime_error(
+            "The checkpoint file '" + filename + "' has an unsupported version (" +
+            std::to_string(version) + ").");
+  }
+  if (payload_size != file.size() - kHeaderSize) {
+    throw std::runtime_error("The checkpoint file '" + filename + "' is truncated.");
+  }
+
+  // Deserialize directly from the mapped pages
+  boost::iostreams::stream<boost::iostreams::array_source> stream(
+    file.data() + kHeaderSize, payload_size);
+  try {
+    fuse_core::BinaryInputArchive archive(stream);
+    archive >> start_time;
+    archive >> lag_expiration;
+    graph.deserialize(archive);
+    marginal_transaction.deserialize(archive);
+    archive >> timestamp_tracking;
+  } catch (const std::exception & ex) {
+    throw std::runtime_error(
+            "Unable to deserialize the checkpoint file '" + filename + "': " + ex.what());
+  }
+  return true;
+}
+
+}  // namespace fuse_optimizers
@@ -35,6 +35,7 @@
 #include <chrono>
 #include <functional>
 #include <numeric>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -49,6 +50,46 @@
 #include <fuse_optimizers/optimizer.hpp>
 #include <rclcpp/time.hpp>
 
+namespace
+{
+/**
+ * @brief Send a graph update to a sensor model, logging any errors
+ */
+void notifySensorModel(
+  const rclcpp::Logger & logger,
+  const std::string & name,
+  fuse_core::SensorModel & sensor_model,
+  fuse_core::Graph::ConstSharedPtr graph)
+{
+  try {
+    sensor_model.graphCallback(std::move(graph));
+  } catch (const std::exception & e) {
+    RCLCPP_ERROR_STREAM(
+      logger,
+      "Failed calling graphCallback() on sensor '" << name << "'. Error: " << e.what());
+  }
+}
+
+/**
+ * @brief Send a graph update to a publisher, logging any errors
+ */
+void notifyPublisher(
+  const rclcpp::Logger & logger,
+  const std::string & name,
+  fuse_core::Publisher & publisher,
+  fuse_core::Transaction::ConstSharedPtr transaction,
+  fuse_core::Graph::ConstSharedPtr graph)
+{
+  try {
+    publisher.notify(std::move(transaction), std::move(graph));
+  } catch (const std::exception & e) {
+    RCLCPP_ERROR_STREAM(
+      logger,
+      "Failed calling notify() on publisher '" << name << ". Error: " << e.what());
+  }
+}
+}  // namespace
+
 namespace fuse_optimizers
 {
 
@@ -90,6 +131,20 @@ Optimizer::Optimizer(
     interfaces_.get_node_base_interface()->get_namespace(), this, &Optimizer::setDiagnostics);
   diagnostic_updater_.setHardwareID("fuse");
 
+  parallel_notify_ = fuse_core::getParam(interfaces_, "parallel_notify", parallel_notify_);
+  start_sensor_models_ =
+    fuse_core::getParam(interfaces_, "start_sensor_models", start_sensor_models_);
+  if (!start_sensor_models_) {
+    RCLCPP_INFO(logger_, "The sensor models will not be started.");
+  }
+
+  const auto transaction_log_file =
+    fuse_core::getParam(interfaces_, "transaction_log_file", std::string());
+  if (!transaction_log_file.empty()) {
+    transaction_log_ = TransactionLogWriter::make_unique(transaction_log_file);
+    RCLCPP_INFO_STREAM(logger_, "Recording all received transactions to " << transaction_log_file);
+  }
+
   // Wait for a valid time before loading any of the plugins
   clock_->wait_until_started();
 
@@ -98,6 +153,10 @@ Optimizer::Optimizer(
   loadSensorModels();
   loadPublishers();
 
+  if (parallel_notify_) {
+    createNotifiers();
+  }
+
   // Start all the plugins
   startPlugins();
 }
@@ -403,21 +462,56 @@ bool Optimizer::applyMotionModels(
   return success;
 }
 
+void Optimizer::createNotifiers()
+{
+  std::lock_guard<std::mutex> lock(notifiers_mutex_);
+  if (start_sensor_models_) {
+    for (const auto & name__sensor_model : sensor_models_) {
+      const auto & name = name__sensor_model.first;
+      auto & sensor_model = *name__sensor_model.second.model;
+      notifiers_.push_back(
+        PluginNotifier::make_unique(
+          "Sensor Model '" + name + "'",
+          [this, &name, &sensor_model](
+            fuse_core::Transaction::ConstSharedPtr /*transaction*/,
+            fuse_core::Graph::ConstSharedPtr graph)
+          {
+            notifySensorModel(logger_, name, sensor_model, std::move(graph));
+          }));
+    }
+  }
+  for (const auto & name__publisher : publishers_) {
+    const auto & name = name__publisher.first;
+    auto & publisher = *name__publisher.second;
+    notifiers_.push_back(
+      PluginNotifier::make_unique(
+        "Publisher '" + name + "'",
+        [this, &name, &publisher](
+          fuse_core::Transaction::ConstSharedPtr transaction,
+          fuse_core::Graph::ConstSharedPtr graph)
+        {
+          notifyPublisher(logger_, name, publisher, std::move(transaction), std::move(graph));
+        }));
+  }
+}
+
 void Optimizer::notify(
   fuse_core::Transaction::ConstSharedPtr transaction,
   fuse_core::Graph::ConstSharedPtr graph)
 {
-  for (const auto & name__sensor_model : sensor_models_) {
-    try {
-      name__sensor_model.second.model->graphCallback(graph);
-    } catch (const std::exception & e) {
-      RCLCPP_ERROR_STREAM(
-        logger_,
-        "Failed calling graphCallback() on sensor '" << name__sensor_model.first
-                                                     << "'. Error: " << e.what());
-      continue;
+  if (parallel_notify_) {
+    // Hand the graph to every sensor model and publisher thread and move on
+    std::lock_guard<std::mutex> lock(notifiers_mutex_);
+    for (const auto & notifier : notifiers_) {
+      notifier->notify(transaction, graph);
+    }
+  } else if (start_sensor_models_) {
+    for (const auto & name__sensor_model : sensor_models_) {
+      notifySensorModel(logger_, name__sensor_model.first, *name__sensor_model.second.model, graph);
     }
   }
+  // Motion models are always notified from this thread. Their graph callbacks are cheap, and this
+  // guarantees they are queued before the motion models are asked to process the next transaction.
   for (const auto & name__motion_model : motion_models_) {
     try {
       name__motion_model.second->graphCallback(graph);
@@ -429,15 +523,9 @@ void Optimizer::notify(
       continue;
     }
   }
-  for (const auto & name__publisher : publishers_) {
-    try {
-      name__publisher.second->notify(transaction, graph);
-    } catch (const std::exception & e) {
-      RCLCPP_ERROR_STREAM(
-        logger_,
-        "Failed calling notify() on publisher '" << name__publisher.first
-                                                 << ". Error: " << e.what());
-      continue;
+  if (!parallel_notify_) {
+    for (const auto & name__publisher : publishers_) {
+      notifyPublisher(logger_, name__publisher.first, *name__publisher.second, transaction, graph);
     }
   }
 }
@@ -450,11 +538,34 @@ void Optimizer::injectCallback(
   // global callback queue. This returns execution to the sensor's thread quickly by moving the
   // transaction processing to the optimizer's thread. And by using the existing ROS callback queue,
   // we simplify the threading model of the optimizer.
+  if (transaction_log_) {
+    auto callback = std::make_shared<fuse_core::CallbackWrapper<void>>(
+      std::bind(
+        &Optimizer::recordTransactionCallback, this, sensor_name, clock_->now(),
+        std::move(transaction)));
+    callback_queue_->addCallback(callback);
+    return;
+  }
   auto callback = std::make_shared<fuse_core::CallbackWrapper<void>>(
     std::bind(&Optimizer::transactionCallback, this, sensor_name, std::move(transaction)));
   callback_queue_->addCallback(callback);
 }
 
+void Optimizer::recordTransactionCallback(
+  const std::string & sensor_name,
+  const rclcpp::Time & arrival,
+  fuse_core::Transaction::SharedPtr transaction)
+{
+  try {
+    transaction_log_->record(sensor_name, arrival, *transaction);
+  } catch (const std::exception & e) {
+    RCLCPP_ERROR_STREAM(
+      logger_,
+      "Failed to record the transaction from sensor '" << sensor_name << "'. Error: " << e.what());
+  }
+  transactionCallback(sensor_name, std::move(transaction));
+}
+
 void Optimizer::clearCallbacks()
 {
   callback_queue_->removeAllCallbacks();
@@ -465,8 +576,10 @@ void Optimizer::startPlugins()
   for (const auto & name_plugin : motion_models_) {
     name_plugin.second->start();
   }
-  for (const auto & name_plugin : sensor_models_) {
-    name_plugin.second.model->start();
+  if (start_sensor_models_) {
+    for (const auto & name_plugin : sensor_models_) {
+      name_plugin.second.model->start();
+    }
   }
   for (const auto & name_plugin : publishers_) {
     name_plugin.second->start();
@@ -477,11 +590,21 @@ void Optimizer::startPlugins()
 
 void Optimizer::stopPlugins()
 {
+  // Finish delivering any outstanding notifications before the plugins are stopped
+  {
+    std::lock_guard<std::mutex> lock(notifiers_mutex_);
+    for (const auto & notifier : notifiers_) {
+      notifier->wait();
+    }
+  }
+
   for (const auto & name_plugin : publishers_) {
     name_plugin.second->stop();
   }
-  for (const auto & name_plugin : sensor_models_) {
-    name_plugin.second.model->stop();
+  if (start_sensor_models_) {
+    for (const auto & name_plugin : sensor_models_) {
+      name_plugin.second.model->stop();
+    }
   }
   for (const auto & name_plugin : motion_models_) {
     name_plugin.second->stop();
@@ -514,6 +637,20 @@ void Optimizer::setDiagnostics(diagnostic_updater::DiagnosticStatusWrapper & sta
   status.add(
     "Publishers",
     std::accumulate(publishers_.begin(), publishers_.end(), std::string(), print_key));
+
+  std::lock_guard<std::mutex> lock(notifiers_mutex_);
+  for (const auto & notifier : notifiers_) {
+    const auto statistics = notifier->statistics();
+    const auto mean_latency = statistics.delivered > 0 ?
+      std::chrono::duration<double>(statistics.total_latency).count() / statistics.delivered : 0.0;
+    std::ostringstream oss;
+    oss << "last: " << std::chrono::duration<double>(statistics.last_latency).count()
+        << ", mean: " << mean_latency
+        << ", max: " << std::chrono::duration<double>(statistics.max_latency).count()
+        << ", pending: " << statistics.pending
+        << ", coalesced: " << statistics.coalesced;
+    status.add(notifier->name() + " Notify Latency [s]", oss.str());
+  }
 }
 
 }  // namespace fuse_optimizers
@@ -0,0 +1,220 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2019, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fuse_optimizers/phase_profiler.hpp>
+
+namespace fuse_optimizers
+{
+
+namespace
+{
+/**
+ * @brief Convert a duration to (fractional) microseconds, the time unit of the trace-event format
+ */
+double toMicroseconds(PhaseProfiler::Clock::duration duration)
+{
+  return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+/**
+ * @brief Convert a duration to (fractional) seconds
+ */
+double toSeconds(PhaseProfiler::Clock::duration duration)
+{
+  return std::chrono::duration<double>(duration).count();
+}
+
+/**
+ * @brief Format the statistics as a diagnostic value
+ */
+std::string toString(const PhaseProfiler::Statistics & statistics)
+{
+  std::ostringstream oss;
+  oss << "p50: " << statistics.p50 << ", p99: " << statistics.p99 << ", max: " << statistics.max;
+  return oss.str();
+}
+}  // namespace
+
+void PhaseProfiler::Window::push(double sample)
+{
+  samples[next] = sample;
+  next = (next + 1) % samples.size();
+  count = std::min(count + 1, samples.size());
+}
+
+PhaseProfiler::Statistics PhaseProfiler::Window::statistics() const
+{
+  auto statistics = Statistics();
+  statistics.count = count;
+  if (count == 0) {
+    return statistics;
+  }
+
+  // Nearest-rank percentiles over a copy of the window
+  auto sorted = std::vector<double>(samples.begin(), samples.begin() + count);
+  auto percentile = [&sorted](const double fraction)
+    {
+      const auto rank = static_cast<size_t>(std::ceil(fraction * sorted.size()));
+      const auto index = std::min(std::max<size_t>(rank, 1), sorted.size()) - 1;
+      std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+      return sorted[index];
+    };
+  statistics.p50 = percentile(0.50);
+  statistics.p99 = percentile(0.99);
+  statistics.max = *std::max_element(sorted.begin(), sorted.end());
+  return statistics;
+}
+
+PhaseProfiler::PhaseProfiler(std::vector<std::string> phase_names, size_t window_size)
+: phase_names_(std::move(phase_names)),
+  epoch_(Clock::now()),
+  cycle_durations_(phase_names_.size(), Clock::duration::zero())
+{
+  if (window_size == 0) {
+    throw std::invalid_argument("The PhaseProfiler window size must be greater than zero.");
+  }
+  auto window = Window();
+  window.samples.resize(window_size, 0.0);
+  windows_.resize(phase_names_.size(), window);
+  cycle_window_ = window;
+  trace_events_.reserve(4 * phase_names_.size());
+  ended_trace_events_.reserve(4 * phase_names_.size() + 1);
+}
+
+void PhaseProfiler::openTrace(const std::string & filename)
+{
+  if (trace_file_.is_open()) {
+    writeTrace();
+    trace_file_.close();
+  }
+  if (filename.empty()) {
+    return;
+  }
+  trace_file_.open(filename, std::ios::out | std::ios::trunc);
+  if (!trace_file_) {
+    throw std::runtime_error("Unable to open the trace file '" + filename + "'.");
+  }
+  // The JSON array format does not require the closing bracket, so events can be streamed
+  trace_file_ << "[\n";
+  trace_file_.flush();
+}
+
+void PhaseProfiler::beginCycle()
+{
+  cycle_start_ = Clock::now();
+  std::fill(cycle_durations_.begin(), cycle_durations_.end(), Clock::duration::zero());
+  cycle_recorded_ = false;
+  trace_events_.clear();
+}
+
+void PhaseProfiler::record(size_t phase, Clock::time_point start, Clock::time_point stop)
+{
+  const auto duration = stop - start;
+  cycle_durations_.at(phase) += duration;
+  cycle_recorded_ = true;
+  if (trace_file_.is_open()) {
+    trace_events_.push_back({phase, start, duration});  // NOLINT(whitespace/braces)
+  }
+}
+
+void PhaseProfiler::endCycle()
+{
+  if (!cycle_recorded_) {
+    return;
+  }
+  const auto cycle_stop = Clock::now();
+  {
+    std::lock_guard<std::mutex> lock(windows_mutex_);
+    for (size_t phase = 0; phase < windows_.size(); ++phase) {
+      windows_[phase].push(toSeconds(cycle_durations_[phase]));
+    }
+    cycle_window_.push(toSeconds(cycle_stop - cycle_start_));
+  }
+  if (trace_file_.is_open()) {
+    ended_trace_events_.push_back(
+      {phase_names_.size(), cycle_start_, cycle_stop - cycle_start_});  // NOLINT
+    ended_trace_events_.insert(
+      ended_trace_events_.end(), trace_events_.begin(), trace_events_.end());
+  }
+}
+
+void PhaseProfiler::writeTrace()
+{
+  if (!trace_file_.is_open() || ended_trace_events_.empty()) {
+    return;
+  }
+  static const std::string cycle_name = "cycle";
+  trace_file_ << std::fixed << std::setprecision(3);
+  for (const auto & event : ended_trace_events_) {
+    const auto & name = event.phase < phase_names_.size() ? phase_names_[event.phase] : cycle_name;
+    trace_file_ << "{\"name\": \"" << name
+                << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": 1, \"ts\": "
+                << toMicroseconds(event.start - epoch_) << ", \"dur\": "
+                << toMicroseconds(event.duration) << "},\n";
+  }
+  trace_file_.flush();
+  ended_trace_events_.clear();
+}
+
+PhaseProfiler::Statistics PhaseProfiler::statistics(size_t phase) const
+{
+  std::lock_guard<std::mutex> lock(windows_mutex_);
+  return windows_.at(phase).statistics();
+}
+
+PhaseProfiler::Statistics PhaseProfiler::cycleStatistics() const
+{
+  std::lock_guard<std::mutex> lock(windows_mutex_);
+  return cycle_window_.statistics();
+}
+
+void PhaseProfiler::addDiagnostics(diagnostic_updater::DiagnosticStatusWrapper & status) const
+{
+  std::lock_guard<std::mutex> lock(windows_mutex_);
+  for (size_t phase = 0; phase < windows_.size(); ++phase) {
+    status.add(phase_names_[phase] + " Latency [s]", toString(windows_[phase].statistics()));
+  }
+  status.add("Cycle Latency [s]", toString(cycle_window_.statistics()));
+}
+
+}  // namespace fuse_optimizers
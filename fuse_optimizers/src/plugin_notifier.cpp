@@ -0,0 +1,142 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2019, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include <fuse_core/async_publisher.hpp>
+#include <fuse_core/graph.hpp>
+#include <fuse_core/transaction.hpp>
+#include <fuse_optimizers/plugin_notifier.hpp>
+
+namespace fuse_optimizers
+{
+
+PluginNotifier::PluginNotifier(const std::string & name, Callback callback)
+: name_(name),
+  callback_(std::move(callback))
+{
+  thread_ = std::thread(&PluginNotifier::run, this);
+}
+
+PluginNotifier::~PluginNotifier()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_ = false;
+    pending_ = Notification();
+    has_pending_ = false;
+  }
+  queue_changed_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void PluginNotifier::notify(
+  fuse_core::Transaction::ConstSharedPtr transaction,
+  fuse_core::Graph::ConstSharedPtr graph)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!has_pending_) {
+      pending_ = {std::move(transaction), std::move(graph), Clock::now()};  // NOLINT
+      has_pending_ = true;
+      statistics_.pending = 1;
+    } else {
+      // Coalesce with the waiting notification, keeping its submission time for the latency
+      fuse_core::coalesceNotification(
+        pending_.transaction, pending_.graph, std::move(transaction), std::move(graph));
+      ++statistics_.coalesced;
+    }
+  }
+  queue_changed_.notify_all();
+}
+
+void PluginNotifier::wait()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  queue_changed_.wait(lock, [this]() {return !running_ || (!has_pending_ && !busy_);});
+}
+
+void PluginNotifier::clear()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_ = Notification();
+    has_pending_ = false;
+    statistics_.pending = 0;
+  }
+  queue_changed_.notify_all();
+}
+
+PluginNotifier::Statistics PluginNotifier::statistics() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return statistics_;
+}
+
+void PluginNotifier::run()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    queue_changed_.wait(lock, [this]() {return !running_ || has_pending_;});
+    if (!running_) {
+      break;
+    }
+    auto notification = std::move(pending_);
+    pending_ = Notification();
+    has_pending_ = false;
+    statistics_.pending = 0;
+    busy_ = true;
+
+    // Deliver the notification without holding the lock, so the optimizer can keep submitting
+    lock.unlock();
+    callback_(std::move(notification.transaction), std::move(notification.graph));
+    const auto latency = Clock::now() - notification.submitted;
+    lock.lock();
+
+    busy_ = false;
+    ++statistics_.delivered;
+    statistics_.last_latency = latency;
+    statistics_.max_latency = std::max<std::chrono::nanoseconds>(statistics_.max_latency, latency);
+    statistics_.total_latency += latency;
+    queue_changed_.notify_all();
+  }
+  busy_ = false;
+  queue_changed_.notify_all();
+}
+
+}  // namespace fuse_optimizers
@@ -0,0 +1,242 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2019, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fuse_optimizers/batch_optimizer.hpp>
+#include <fuse_optimizers/fixed_lag_smoother.hpp>
+#include <fuse_optimizers/transaction_log.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+namespace
+{
+/**
+ * @brief An optimizer that is driven by a transaction log instead of its timer
+ *
+ * The node is never spun, so the optimization timer never fires and the optimization thread
+ * started by the optimizer stays idle. Every cycle is run synchronously by replay(). The node must
+ * be created with the 'start_sensor_models' parameter set to false, so the sensor models do not
+ * inject live data.
+ */
+template<typename OptimizerType>
+class ReplayOptimizer : public OptimizerType
+{
+public:
+  using OptimizerType::OptimizerType;
+
+  /**
+   * @brief Feed every recorded transaction into the optimizer, running one optimization cycle per
+   *        optimization period of recorded arrival time
+   *
+   * @param[in] reader The transaction log
+   * @param[in] rate   The playback rate relative to the recording. Zero replays as fast as
+   *                   possible.
+   * @return The wall-clock duration of each optimization cycle, in seconds
+   */
+  std::vector<double> replay(fuse_optimizers::TransactionLogReader & reader, double rate)
+  {
+    std::vector<double> cycle_durations;
+    const auto period = this->params_.optimization_period;
+    const auto wall_start = std::chrono::steady_clock::now();
+    fuse_optimizers::TransactionLogReader::Entry entry;
+    bool have_entry = reader.next(entry);
+    if (!have_entry) {
+      return cycle_durations;
+    }
+    const auto log_start = entry.arrival;
+    auto cycle_end = log_start + period;
+    while (have_entry && rclcpp::ok()) {
+      // Queue every transaction that arrived before the end of this optimization period
+      while (have_entry && entry.arrival < cycle_end) {
+        this->transactionCallback(entry.sensor_name, std::move(entry.transaction));
+        have_entry = reader.next(entry);
+      }
+      if (rate > 0.0) {
+        const auto offset = std::chrono::duration<double>((cycle_end - log_start).seconds() / rate);
+        std::this_thread::sleep_until(
+          wall_start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(offset));
+      }
+      if (this->started_ && hasPendingWork()) {
+        const auto cycle_start = std::chrono::steady_clock::now();
+        if (!cycle()) {
+          break;
+        }
+        cycle_durations.push_back(
+          std::chrono::duration<double>(std::chrono::steady_clock::now() - cycle_start).count());
+      }
+      cycle_end += period;
+    }
+    return cycle_durations;
+  }
+
+private:
+  /**
+   * @brief Check if the optimizer timer would have triggered an optimization cycle
+   */
+  bool hasPendingWork();
+
+  /**
+   * @brief Run one optimization cycle
+   *
+   * @return False if the optimizer requested a shutdown, true otherwise
+   */
+  bool cycle();
+};
+
+template<>
+bool ReplayOptimizer<fuse_optimizers::FixedLagSmoother>::hasPendingWork()
+{
+  return true;
+}
+
+template<>
+bool ReplayOptimizer<fuse_optimizers::FixedLagSmoother>::cycle()
+{
+  const bool keep_running = optimizationCycle(clock_->now() + params_.optimization_period);
+  profiler_->writeTrace();
+  return keep_running;
+}
+
+template<>
+bool ReplayOptimizer<fuse_optimizers::BatchOptimizer>::hasPendingWork()
+{
+  std::lock_guard<std::mutex> lock(combined_transaction_mutex_);
+  return !combined_transaction_->empty();
+}
+
+template<>
+bool ReplayOptimizer<fuse_optimizers::BatchOptimizer>::cycle()
+{
+  optimizationCycle();
+  return true;
+}
+
+/**
+ * @brief Create the node and optimizer, and replay the log
+ *
+ * @param[in] node_name The name of the node, matching the recorded optimizer so that the same
+ *                      parameters are loaded
+ * @param[in] filename  The transaction log
+ * @param[in] rate      The playback rate relative to the recording
+ * @return The wall-clock duration of each optimization cycle, in seconds
+ */
+template<typename OptimizerType>
+std::vector<double> replay(const std::string & node_name, const std::string & filename, double rate)
+{
+  // The sensor models are loaded for their configuration only. All sensor data comes from the log.
+  auto options = rclcpp::NodeOptions().append_parameter_override("start_sensor_models", false);
+  auto node = std::make_shared<rclcpp::Node>(node_name, options);
+  fuse_optimizers::TransactionLogReader reader(filename);
+  ReplayOptimizer<OptimizerType> optimizer(*node);
+  return optimizer.replay(reader, rate);
+}
+
+double percentile(const std::vector<double> & sorted, double p)
+{
+  const auto index = static_cast<size_t>(std::ceil(p * sorted.size())) - 1;
+  return sorted[std::min(index, sorted.size() - 1)];
+}
+
+void printUsage()
+{
+  std::cerr << "Usage: replay_transactions <transaction_log> [--rate R]"
+    " [--optimizer fixed_lag|batch] [--ros-args ...]\n"
+    "  Replays a transaction log recorded with the 'transaction_log_file' optimizer parameter\n"
+    "  into an optimizer configured from the ROS parameters, and reports the latency of each\n"
+    "  optimization cycle. --rate 0 (the default) replays as fast as possible. The optimizer\n"
+    "  defaults to the fixed-lag smoother; the node is named fixed_lag_smoother_node or\n"
+    "  batch_optimizer_node accordingly. The sensor models are not started.\n";
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  const auto args = rclcpp::init_and_remove_ros_arguments(argc, argv);
+  std::string filename;
+  double rate = 0.0;
+  std::string optimizer_type = "fixed_lag";
+  for (size_t i = 1; i < args.size(); ++i) {
+    if (args[i] == "--rate" && i + 1 < args.size()) {
+      rate = std::atof(args[++i].c_str());
+    } else if (args[i] == "--optimizer" && i + 1 < args.size()) {
+      optimizer_type = args[++i];
+    } else if (filename.empty() && args[i].rfind("--", 0) != 0) {
+      filename = args[i];
+    } else {
+      printUsage();
+      rclcpp::shutdown();
+      return 1;
+    }
+  }
+  if (filename.empty() || rate < 0.0 ||
+    (optimizer_type != "fixed_lag" && optimizer_type != "batch"))
+  {
+    printUsage();
+    rclcpp::shutdown();
+    return 1;
+  }
+
+  std::vector<double> cycle_durations;
+  if (optimizer_type == "batch") {
+    cycle_durations =
+      replay<fuse_optimizers::BatchOptimizer>("batch_optimizer_node", filename, rate);
+  } else {
+    cycle_durations =
+      replay<fuse_optimizers::FixedLagSmoother>("fixed_lag_smoother_node", filename, rate);
+  }
+  rclcpp::shutdown();
+
+  if (cycle_durations.empty()) {
+    std::cout << "No optimization cycles were run. Does the log contain an ignition transaction?\n";
+    return 0;
+  }
+  auto sorted = cycle_durations;
+  std::sort(sorted.begin(), sorted.end());
+  std::cout << std::fixed << std::setprecision(3)
+            << "cycles: " << sorted.size()
+            << "  p50: " << 1e3 * percentile(sorted, 0.50) << " ms"
+            << "  p99: " << 1e3 * percentile(sorted, 0.99) << " ms"
+            << "  max: " << 1e3 * sorted.back() << " ms\n";
+  return 0;
+}
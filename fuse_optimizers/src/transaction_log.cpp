@@ -0,0 +1,171 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2019, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+#include <fuse_core/transaction.hpp>
+#include <fuse_core/transaction_deserializer.hpp>
+#include <fuse_msgs/msg/serialized_transaction.hpp>
+#include <fuse_optimizers/transaction_log.hpp>
+
+namespace fuse_optimizers
+{
+
+namespace
+{
+constexpr char kMagic[8] = {'F', 'U', 'S', 'E', 'T', 'X', 'L', 'G'};
+constexpr uint32_t kVersion = 1;
+constexpr uint32_t kMaxSensorNameLength = 4096;  // Longer names are treated as corruption
+
+template<typename T>
+void write(std::ostream & stream, const T & value)
+{
+  stream.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template<typename T>
+bool read(std::istream & stream, T & value)
+{
+  return static_cast<bool>(stream.read(reinterpret_cast<char *>(&value), sizeof(T)));
+}
+}  // namespace
+
+TransactionLogWriter::TransactionLogWriter(const std::string & filename)
+: file_(filename, std::ios::out | std::ios::binary | std::ios::trunc)
+{
+  if (!file_) {
+    throw std::runtime_error("Unable to open the transaction log '" + filename + "' for writing.");
+  }
+  file_.write(kMagic, sizeof(kMagic));
+  write(file_, kVersion);
+  file_.flush();
+}
+
+void TransactionLogWriter::record(
+  const std::string & sensor_name,
+  const rclcpp::Time & arrival,
+  const fuse_core::Transaction & transaction)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto msg = fuse_msgs::msg::SerializedTransaction();
+  msg.data.swap(buffer_);
+  msg.data.clear();
+  fuse_core::serializeTransaction(transaction, msg);
+
+  write(file_, static_cast<uint32_t>(sensor_name.size()));
+  file_.write(sensor_name.data(), sensor_name.size());
+  write(file_, static_cast<int64_t>(arrival.nanoseconds()));
+  write(file_, static_cast<int32_t>(arrival.get_clock_type()));
+  write(file_, static_cast<uint64_t>(msg.data.size()));
+  file_.write(reinterpret_cast<const char *>(msg.data.data()), msg.data.size());
+  file_.flush();
+
+  // Keep the allocated buffer around for the next transaction
+  buffer_.swap(msg.data);
+}
+
+TransactionLogReader::TransactionLogReader(const std::string & filename)
+: file_(filename, std::ios::in | std::ios::binary)
+{
+  if (!file_) {
+    throw std::runtime_error("Unable to open the transaction log '" + filename + "' for reading.");
+  }
+  char magic[sizeof(kMagic)];
+  uint32_t version = 0;
+  if (!file_.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+    !read(file_, version))
+  {
+    throw std::runtime_error("The file '" + filename + "' is not a fuse transaction log.");
+  }
+  // Remember the size of the file, so corrupted record lengths can be detected before allocating
+  const auto records_begin = file_.tellg();
+  file_.seekg(0, std::ios::end);
+  file_size_ = static_cast<uint64_t>(file_.tellg());
+  file_.seekg(records_begin);
+  if (version != kVersion) {
+    throw std::runtime_error(
+            "The transaction log '" + filename + "' has an unsupported version (" +
+            std::to_string(version) + ").");
+  }
+}
+
+bool TransactionLogReader::next(Entry & entry)
+{
+  uint32_t name_length = 0;
+  if (!read(file_, name_length)) {
+    return false;
+  }
+  if (name_length > kMaxSensorNameLength || name_length > remaining()) {
+    throw std::runtime_error(
+            "The transaction log is corrupted: invalid sensor name length (" +
+            std::to_string(name_length) + ").");
+  }
+  entry.sensor_name.resize(name_length);
+  int64_t arrival_ns = 0;
+  int32_t clock_type = 0;
+  uint64_t payload_length = 0;
+  if (!file_.read(&entry.sensor_name[0], name_length) ||
+    !read(file_, arrival_ns) ||
+    !read(file_, clock_type) ||
+    !read(file_, payload_length))
+  {
+    throw std::runtime_error("The transaction log is truncated.");
+  }
+  if (payload_length > remaining()) {
+    throw std::runtime_error("The transaction log is truncated.");
+  }
+  auto msg = fuse_msgs::msg::SerializedTransaction();
+  msg.data.resize(payload_length);
+  if (!file_.read(reinterpret_cast<char *>(msg.data.data()), payload_length)) {
+    throw std::runtime_error("The transaction log is truncated.");
+  }
+  entry.arrival = rclcpp::Time(arrival_ns, static_cast<rcl_clock_type_t>(clock_type));
+  entry.transaction = deserializer_.deserialize(msg);
+  return true;
+}
+
+uint64_t TransactionLogReader::remaining()
+{
+  const auto position = file_.tellg();
+  if (position < 0) {
+    return 0;
+  }
+  return file_size_ - std::min(file_size_, static_cast<uint64_t>(position));
+}
+
+}  // namespace fuse_optimizers
@@ -0,0 +1,146 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2019, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fuse_core/transaction.hpp>
+#include <fuse_graphs/hash_graph.hpp>
+#include <fuse_optimizers/graph_checkpoint.hpp>
+#include <fuse_optimizers/variable_stamp_index.hpp>
+#include <fuse_variables/position_2d_stamped.hpp>
+#include <rclcpp/time.hpp>
+
+using fuse_optimizers::readCheckpoint;
+using fuse_optimizers::VariableStampIndex;
+using fuse_optimizers::writeCheckpoint;
+using fuse_variables::Position2DStamped;
+
+TEST(GraphCheckpoint, RoundTrip)
+{
+  const std::string filename = ::testing::TempDir() + "test_graph_checkpoint_round_trip.bin";
+
+  auto position1 = Position2DStamped::make_shared(rclcpp::Time(1, 0, RCL_ROS_TIME));
+  position1->x() = 1.0;
+  position1->y() = 2.0;
+  auto position2 = Position2DStamped::make_shared(rclcpp::Time(2, 0, RCL_ROS_TIME));
+  position2->x() = 3.0;
+  position2->y() = 4.0;
+
+  fuse_core::Transaction transaction;
+  transaction.addVariable(position1);
+  transaction.addVariable(position2);
+  fuse_graphs::HashGraph graph;
+  graph.update(transaction);
+  VariableStampIndex timestamp_tracking;
+  timestamp_tracking.addNewTransaction(transaction);
+  fuse_core::Transaction marginal_transaction;
+  marginal_transaction.removeVariable(position1->uuid());
+
+  writeCheckpoint(
+    filename, graph, rclcpp::Time(1, 0, RCL_ROS_TIME), rclcpp::Time(1, 500, RCL_ROS_TIME),
+    marginal_transaction, timestamp_tracking);
+
+  fuse_graphs::HashGraph restored_graph;
+  rclcpp::Time start_time;
+  rclcpp::Time lag_expiration;
+  fuse_core::Transaction restored_marginal_transaction;
+  VariableStampIndex restored_timestamp_tracking;
+  ASSERT_TRUE(
+    readCheckpoint(
+      filename, restored_graph, start_time, lag_expiration, restored_marginal_transaction,
+      restored_timestamp_tracking));
+
+  EXPECT_EQ(rclcpp::Time(1, 0, RCL_ROS_TIME), start_time);
+  EXPECT_EQ(rclcpp::Time(1, 500, RCL_ROS_TIME), lag_expiration);
+
+  ASSERT_TRUE(restored_graph.variableExists(position1->uuid()));
+  ASSERT_TRUE(restored_graph.variableExists(position2->uuid()));
+  const auto & restored_position2 =
+    dynamic_cast<const Position2DStamped &>(restored_graph.getVariable(position2->uuid()));
+  EXPECT_EQ(position2->stamp(), restored_position2.stamp());
+  EXPECT_EQ(3.0, restored_position2.x());
+  EXPECT_EQ(4.0, restored_position2.y());
+
+  const auto removed_variables = restored_marginal_transaction.removedVariables();
+  ASSERT_EQ(1, std::distance(removed_variables.begin(), removed_variables.end()));
+  EXPECT_EQ(position1->uuid(), *removed_variables.begin());
+
+  EXPECT_EQ(2u, restored_timestamp_tracking.size());
+  EXPECT_EQ(rclcpp::Time(2, 0, RCL_ROS_TIME), restored_timestamp_tracking.currentStamp());
+  std::vector<fuse_core::UUID> expired;
+  restored_timestamp_tracking.query(
+    rclcpp::Time(1, 500, RCL_ROS_TIME), std::back_inserter(expired));
+  ASSERT_EQ(1u, expired.size());
+  EXPECT_EQ(position1->uuid(), expired.front());
+
+  std::remove(filename.c_str());
+}
+
+TEST(GraphCheckpoint, MissingFile)
+{
+  const std::string filename = ::testing::TempDir() + "test_graph_checkpoint_missing.bin";
+  fuse_graphs::HashGraph graph;
+  rclcpp::Time start_time;
+  rclcpp::Time lag_expiration;
+  fuse_core::Transaction marginal_transaction;
+  VariableStampIndex timestamp_tracking;
+  EXPECT_FALSE(
+    readCheckpoint(
+      filename, graph, start_time, lag_expiration, marginal_transaction, timestamp_tracking));
+}
+
+TEST(GraphCheckpoint, NotACheckpoint)
+{
+  const std::string filename = ::testing::TempDir() + "test_graph_checkpoint_invalid.bin";
+  {
+    std::ofstream file(filename);
+    file << "definitely not a fuse checkpoint";
+  }
+  fuse_graphs::HashGraph graph;
+  rclcpp::Time start_time;
+  rclcpp::Time lag_expiration;
+  fuse_core::Transaction marginal_transaction;
+  VariableStampIndex timestamp_tracking;
+  EXPECT_THROW(
+    readCheckpoint(
+      filename, graph, start_time, lag_expiration, marginal_transaction, timestamp_tracking),
+    std::runtime_error);
+  std::remove(filename.c_str());
+}
@@ -0,0 +1,161 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2019, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <diagnostic_updater/diagnostic_status_wrapper.hpp>
+#include <fuse_optimizers/phase_profiler.hpp>
+
+using fuse_optimizers::PhaseProfiler;
+
+TEST(PhaseProfiler, Percentiles)
+{
+  PhaseProfiler profiler({"first", "second"}, 100);
+
+  // Record 1..100 milliseconds for the first phase, and nothing for the second
+  const auto start = PhaseProfiler::Clock::time_point();
+  for (int i = 1; i <= 100; ++i) {
+    profiler.beginCycle();
+    profiler.record(0, start, start + std::chrono::milliseconds(i));
+    profiler.endCycle();
+  }
+
+  auto statistics = profiler.statistics(0);
+  EXPECT_EQ(100u, statistics.count);
+  EXPECT_NEAR(0.050, statistics.p50, 1.0e-9);
+  EXPECT_NEAR(0.099, statistics.p99, 1.0e-9);
+  EXPECT_NEAR(0.100, statistics.max, 1.0e-9);
+
+  statistics = profiler.statistics(1);
+  EXPECT_EQ(100u, statistics.count);
+  EXPECT_EQ(0.0, statistics.max);
+
+  EXPECT_EQ(100u, profiler.cycleStatistics().count);
+}
+
+TEST(PhaseProfiler, RollingWindow)
+{
+  PhaseProfiler profiler({"phase"}, 10);
+
+  const auto start = PhaseProfiler::Clock::time_point();
+  for (int i = 1; i <= 100; ++i) {
+    profiler.beginCycle();
+    profiler.record(0, start, start + std::chrono::milliseconds(i));
+    profiler.endCycle();
+  }
+
+  // Only the last 10 cycles (91..100 ms) are kept
+  auto statistics = profiler.statistics(0);
+  EXPECT_EQ(10u, statistics.count);
+  EXPECT_NEAR(0.095, statistics.p50, 1.0e-9);
+  EXPECT_NEAR(0.100, statistics.max, 1.0e-9);
+}
+
+TEST(PhaseProfiler, AccumulateWithinCycle)
+{
+  PhaseProfiler profiler({"phase"}, 10);
+
+  const auto start = PhaseProfiler::Clock::time_point();
+  profiler.beginCycle();
+  profiler.record(0, start, start + std::chrono::milliseconds(2));
+  profiler.record(0, start, start + std::chrono::milliseconds(3));
+  profiler.endCycle();
+
+  EXPECT_NEAR(0.005, profiler.statistics(0).max, 1.0e-9);
+}
+
+TEST(PhaseProfiler, EmptyCyclesAreDiscarded)
+{
+  PhaseProfiler profiler({"phase"}, 10);
+  profiler.beginCycle();
+  profiler.endCycle();
+  EXPECT_EQ(0u, profiler.statistics(0).count);
+  EXPECT_EQ(0u, profiler.cycleStatistics().count);
+}
+
+TEST(PhaseProfiler, Diagnostics)
+{
+  PhaseProfiler profiler({"first", "second"}, 10);
+  profiler.beginCycle();
+  {
+    PhaseProfiler::Scope scope(profiler, 1);
+  }
+  profiler.endCycle();
+
+  diagnostic_updater::DiagnosticStatusWrapper status;
+  profiler.addDiagnostics(status);
+  ASSERT_EQ(3u, status.values.size());
+  EXPECT_EQ("first Latency [s]", status.values[0].key);
+  EXPECT_EQ("second Latency [s]", status.values[1].key);
+  EXPECT_EQ("Cycle Latency [s]", status.values[2].key);
+}
+
+TEST(PhaseProfiler, Trace)
+{
+  const std::string filename = testing::TempDir() + "test_phase_profiler_trace.json";
+  {
+    PhaseProfiler profiler({"first", "second"}, 10);
+    profiler.openTrace(filename);
+    const auto start = PhaseProfiler::Clock::now();
+    profiler.beginCycle();
+    profiler.record(0, start, start + std::chrono::microseconds(10));
+    profiler.record(1, start + std::chrono::microseconds(10), start + std::chrono::microseconds(30));
+    profiler.endCycle();
+
+    // Nothing is written until requested, so the file I/O can happen outside of the cycle
+    std::ifstream file(filename);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    EXPECT_EQ("[\n", contents.str());
+
+    profiler.writeTrace();
+  }
+
+  std::ifstream file(filename);
+  std::stringstream contents;
+  contents << file.rdbuf();
+  const auto trace = contents.str();
+  EXPECT_EQ(0u, trace.find("[\n"));
+  EXPECT_NE(std::string::npos, trace.find("\"name\": \"cycle\""));
+  EXPECT_NE(std::string::npos, trace.find("\"name\": \"first\""));
+  EXPECT_NE(std::string::npos, trace.find("\"name\": \"second\""));
+  EXPECT_NE(std::string::npos, trace.find("\"dur\": 20.000"));
+  std::remove(filename.c_str());
+}
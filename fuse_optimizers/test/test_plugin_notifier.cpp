@@ -0,0 +1,177 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2019, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <fuse_core/graph.hpp>
+#include <fuse_core/transaction.hpp>
+#include <fuse_optimizers/plugin_notifier.hpp>
+#include <rclcpp/time.hpp>
+
+TEST(PluginNotifier, DeliversInOrder)
+{
+  std::mutex mutex;
+  std::vector<int64_t> received;
+  fuse_optimizers::PluginNotifier notifier(
+    "test",
+    [&](fuse_core::Transaction::ConstSharedPtr transaction, fuse_core::Graph::ConstSharedPtr)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      received.push_back(transaction->stamp().nanoseconds());
+    });
+
+  for (int64_t i = 1; i <= 100; ++i) {
+    auto transaction = fuse_core::Transaction::make_shared();
+    transaction->stamp(rclcpp::Time(i, RCL_ROS_TIME));
+    notifier.notify(transaction, nullptr);
+  }
+  notifier.wait();
+
+  // Notifications submitted while the plugin was busy may have been coalesced, but the ones that
+  // are delivered arrive in order and the newest one is never dropped
+  ASSERT_FALSE(received.empty());
+  ASSERT_LE(received.size(), 100u);
+  for (size_t i = 1; i < received.size(); ++i) {
+    EXPECT_LT(received[i - 1], received[i]);
+  }
+  EXPECT_EQ(100, received.back());
+
+  auto statistics = notifier.statistics();
+  EXPECT_EQ(received.size(), statistics.delivered);
+  EXPECT_EQ(100u, statistics.delivered + statistics.coalesced);
+  EXPECT_EQ(0u, statistics.pending);
+  EXPECT_GE(statistics.max_latency, statistics.last_latency);
+}
+
+TEST(PluginNotifier, CoalescesWhileBusy)
+{
+  std::mutex mutex;
+  std::condition_variable condition;
+  bool release = false;
+  std::vector<fuse_core::Transaction::ConstSharedPtr> received;
+  fuse_optimizers::PluginNotifier notifier(
+    "blocked",
+    [&](fuse_core::Transaction::ConstSharedPtr transaction, fuse_core::Graph::ConstSharedPtr)
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      received.push_back(transaction);
+      condition.wait(lock, [&]() {return release;});
+    });
+
+  auto make_transaction = [](int64_t stamp)
+    {
+      auto transaction = fuse_core::Transaction::make_shared();
+      transaction->stamp(rclcpp::Time(stamp, RCL_ROS_TIME));
+      transaction->addInvolvedStamp(rclcpp::Time(stamp, RCL_ROS_TIME));
+      return transaction;
+    };
+
+  // Block the plugin in the first notification
+  notifier.notify(make_transaction(1), nullptr);
+  while (notifier.statistics().pending != 0u) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  // Everything submitted meanwhile is folded into a single pending notification
+  for (int64_t i = 2; i <= 50; ++i) {
+    notifier.notify(make_transaction(i), nullptr);
+    EXPECT_EQ(1u, notifier.statistics().pending);
+  }
+  EXPECT_EQ(48u, notifier.statistics().coalesced);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    release = true;
+  }
+  condition.notify_all();
+  notifier.wait();
+
+  ASSERT_EQ(2u, received.size());
+  EXPECT_EQ(1, received[0]->stamp().nanoseconds());
+  EXPECT_EQ(50, received[1]->stamp().nanoseconds());
+  const auto involved_stamps = received[1]->involvedStamps();
+  EXPECT_EQ(49, std::distance(involved_stamps.begin(), involved_stamps.end()));
+}
+
+TEST(PluginNotifier, ReturnsImmediately)
+{
+  std::atomic<bool> delivered{false};
+  fuse_optimizers::PluginNotifier notifier(
+    "slow",
+    [&](fuse_core::Transaction::ConstSharedPtr, fuse_core::Graph::ConstSharedPtr)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(200));
+      delivered = true;
+    });
+
+  const auto start = std::chrono::steady_clock::now();
+  notifier.notify(nullptr, nullptr);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_LT(elapsed, std::chrono::milliseconds(100));
+  EXPECT_FALSE(delivered);
+
+  notifier.wait();
+  EXPECT_TRUE(delivered);
+  EXPECT_GE(notifier.statistics().last_latency, std::chrono::milliseconds(200));
+}
+
+TEST(PluginNotifier, Clear)
+{
+  std::atomic<int> count{0};
+  {
+    fuse_optimizers::PluginNotifier notifier(
+      "slow",
+      [&](fuse_core::Transaction::ConstSharedPtr, fuse_core::Graph::ConstSharedPtr)
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        ++count;
+      });
+
+    for (int i = 0; i < 10; ++i) {
+      notifier.notify(nullptr, nullptr);
+    }
+    notifier.clear();
+    notifier.wait();
+    EXPECT_EQ(0u, notifier.statistics().pending);
+  }
+  // At most the notification already being delivered when clear() was called is processed
+  EXPECT_LE(count, 1);
+}
@@ -0,0 +1,137 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2019, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+#include <fuse_core/transaction.hpp>
+#include <fuse_optimizers/transaction_log.hpp>
+#include <rclcpp/time.hpp>
+
+using fuse_optimizers::TransactionLogReader;
+using fuse_optimizers::TransactionLogWriter;
+
+TEST(TransactionLog, RoundTrip)
+{
+  const std::string filename = ::testing::TempDir() + "test_transaction_log_round_trip.bin";
+  {
+    TransactionLogWriter writer(filename);
+    fuse_core::Transaction transaction;
+    transaction.stamp(rclcpp::Time(10, 0, RCL_ROS_TIME));
+    transaction.addInvolvedStamp(rclcpp::Time(9, 500, RCL_ROS_TIME));
+    writer.record("first", rclcpp::Time(11, 0, RCL_ROS_TIME), transaction);
+    transaction.stamp(rclcpp::Time(12, 0, RCL_ROS_TIME));
+    writer.record("second", rclcpp::Time(13, 250, RCL_SYSTEM_TIME), transaction);
+  }
+
+  TransactionLogReader reader(filename);
+  TransactionLogReader::Entry entry;
+  ASSERT_TRUE(reader.next(entry));
+  EXPECT_EQ("first", entry.sensor_name);
+  EXPECT_EQ(rclcpp::Time(11, 0, RCL_ROS_TIME), entry.arrival);
+  ASSERT_TRUE(entry.transaction);
+  EXPECT_EQ(rclcpp::Time(10, 0, RCL_ROS_TIME), entry.transaction->stamp());
+  EXPECT_EQ(rclcpp::Time(9, 500, RCL_ROS_TIME), entry.transaction->minStamp());
+
+  ASSERT_TRUE(reader.next(entry));
+  EXPECT_EQ("second", entry.sensor_name);
+  EXPECT_EQ(13000000250, entry.arrival.nanoseconds());
+  EXPECT_EQ(RCL_SYSTEM_TIME, entry.arrival.get_clock_type());
+  EXPECT_EQ(rclcpp::Time(12, 0, RCL_ROS_TIME), entry.transaction->stamp());
+
+  EXPECT_FALSE(reader.next(entry));
+  std::remove(filename.c_str());
+}
+
+TEST(TransactionLog, Truncated)
+{
+  const std::string filename = ::testing::TempDir() + "test_transaction_log_truncated.bin";
+  {
+    TransactionLogWriter writer(filename);
+    fuse_core::Transaction transaction;
+    writer.record("sensor", rclcpp::Time(1, 0, RCL_ROS_TIME), transaction);
+  }
+  // Drop the last byte of the only record
+  std::string contents;
+  {
+    std::ifstream file(filename, std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+  {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    file.write(contents.data(), contents.size() - 1);
+  }
+
+  TransactionLogReader reader(filename);
+  TransactionLogReader::Entry entry;
+  EXPECT_THROW(reader.next(entry), std::runtime_error);
+  std::remove(filename.c_str());
+}
+
+TEST(TransactionLog, CorruptedLength)
+{
+  const std::string filename = ::testing::TempDir() + "test_transaction_log_corrupted.bin";
+  {
+    TransactionLogWriter writer(filename);
+  }
+  // Append a record header claiming a huge sensor name
+  {
+    std::ofstream file(filename, std::ios::binary | std::ios::app);
+    const uint32_t name_length = 0xFFFFFFF0u;
+    file.write(reinterpret_cast<const char *>(&name_length), sizeof(name_length));
+    file << "sensor";
+  }
+
+  TransactionLogReader reader(filename);
+  TransactionLogReader::Entry entry;
+  EXPECT_THROW(reader.next(entry), std::runtime_error);
+  std::remove(filename.c_str());
+}
+
+TEST(TransactionLog, NotATransactionLog)
+{
+  const std::string filename = ::testing::TempDir() + "test_transaction_log_invalid.bin";
+  {
+    std::ofstream file(filename);
+    file << "definitely not a transaction log";
+  }
+  EXPECT_THROW(TransactionLogReader reader(filename), std::runtime_error);
+  EXPECT_THROW(TransactionLogReader reader(filename + ".missing"), std::runtime_error);
+  std::remove(filename.c_str());
+}
@@ -0,0 +1,113 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2021, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <benchmark/benchmark.h>
+#include <ceres/cost_function.h>
+
+#include <memory>
+#include <vector>
+
+#include <fuse_tutorials/range_constraint.hpp>
+#include <fuse_variables/point_2d_landmark.hpp>
+#include <fuse_variables/position_2d_stamped.hpp>
+#include <rclcpp/time.hpp>
+
+class RangeConstraintBenchmarkFixture : public benchmark::Fixture
+{
+public:
+  RangeConstraintBenchmarkFixture()
+  : robot_position(rclcpp::Time(1, 0)),
+    beacon_position(7),
+    constraint("benchmark", robot_position, beacon_position, 10.2, 0.5),
+    cost_function(constraint.costFunction()),
+    jacobian_robot(2),
+    jacobian_beacon(2)
+  {
+    robot_position.x() = 1.0;
+    robot_position.y() = 2.0;
+    beacon_position.x() = 8.0;
+    beacon_position.y() = 9.5;
+
+    parameters[0] = robot_position.data();
+    parameters[1] = beacon_position.data();
+    jacobians[0] = jacobian_robot.data();
+    jacobians[1] = jacobian_beacon.data();
+  }
+
+  fuse_variables::Position2DStamped robot_position;
+  fuse_variables::Point2DLandmark beacon_position;
+  fuse_tutorials::RangeConstraint constraint;
+  std::unique_ptr<ceres::CostFunction> cost_function;
+
+  const double * parameters[2];
+  double residuals[1];
+  double * jacobians[2];
+
+private:
+  std::vector<double> jacobian_robot;
+  std::vector<double> jacobian_beacon;
+};
+
+BENCHMARK_DEFINE_F(RangeConstraintBenchmarkFixture, Create)(benchmark::State & state)
+{
+  for (auto _ : state) {
+    std::unique_ptr<ceres::CostFunction> created_cost_function(constraint.costFunction());
+    benchmark::DoNotOptimize(created_cost_function.get());
+  }
+}
+
+BENCHMARK_REGISTER_F(RangeConstraintBenchmarkFixture, Create);
+
+BENCHMARK_DEFINE_F(RangeConstraintBenchmarkFixture, Evaluate)(benchmark::State & state)
+{
+  for (auto _ : state) {
+    cost_function->Evaluate(parameters, residuals, nullptr);
+    benchmark::DoNotOptimize(residuals);
+  }
+}
+
+BENCHMARK_REGISTER_F(RangeConstraintBenchmarkFixture, Evaluate);
+
+BENCHMARK_DEFINE_F(
+  RangeConstraintBenchmarkFixture,
+  EvaluateWithJacobians)(benchmark::State & state)
+{
+  for (auto _ : state) {
+    cost_function->Evaluate(parameters, residuals, jacobians);
+    benchmark::DoNotOptimize(residuals);
+  }
+}
+
+BENCHMARK_REGISTER_F(RangeConstraintBenchmarkFixture, EvaluateWithJacobians);
+
+BENCHMARK_MAIN();
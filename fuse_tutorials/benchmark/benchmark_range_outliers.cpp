@@ -0,0 +1,187 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2021, Locus Robotics
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <benchmark/benchmark.h>
+#include <ceres/solver.h>
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <fuse_core/loss.hpp>
+#include <fuse_graphs/hash_graph.hpp>
+#include <fuse_loss/geman_mcclure_loss.hpp>
+#include <fuse_loss/gnc_loss.hpp>
+#include <fuse_tutorials/range_constraint.hpp>
+#include <fuse_variables/point_2d_landmark.hpp>
+#include <fuse_variables/position_2d_stamped.hpp>
+#include <rclcpp/time.hpp>
+
+/**
+ * @brief Range-only localization problem in the spirit of the range sensor simulator, with a
+ *        fraction of the range measurements replaced by outliers
+ *
+ * The beacons are held at their true positions, so the robot positions are the only unknowns. The
+ * robot positions start from a perturbed initial guess.
+ */
+class RangeOutliersBenchmarkFixture : public benchmark::Fixture
+{
+public:
+  static constexpr size_t kBeaconCount = 12;
+  static constexpr size_t kPositionCount = 20;
+  static constexpr double kSigma = 0.1;
+
+  /**
+   * @brief Build the problem, using \p loss for every range constraint
+   *
+   * @param[in] outlier_ratio The fraction of range measurements that are outliers
+   * @param[in] loss          The loss of the range constraints, or nullptr for none
+   */
+  void build(const double outlier_ratio, const fuse_core::Loss::SharedPtr & loss)
+  {
+    std::mt19937 generator(42);
+    std::normal_distribution<double> noise(0.0, kSigma);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::uniform_real_distribution<double> outlier_offset(5.0, 20.0);
+    std::uniform_real_distribution<double> initial_offset(-1.5, 1.5);
+
+    graph = std::make_unique<fuse_graphs::HashGraph>();
+    positions.clear();
+    true_positions.clear();
+
+    std::vector<fuse_variables::Point2DLandmark::SharedPtr> beacons;
+    for (size_t i = 0; i < kBeaconCount; ++i) {
+      auto beacon = fuse_variables::Point2DLandmark::make_shared(i);
+      beacon->x() = 10.0 * (i % 4);
+      beacon->y() = 10.0 * (i / 4);
+      graph->addVariable(beacon);
+      graph->holdVariable(beacon->uuid());
+      beacons.push_back(beacon);
+    }
+
+    for (size_t i = 0; i < kPositionCount; ++i) {
+      const double x = 1.5 * i;
+      const double y = 10.0 + 5.0 * std::sin(0.3 * i);
+      auto position = fuse_variables::Position2DStamped::make_shared(rclcpp::Time(i + 1, 0));
+      position->x() = x + initial_offset(generator);
+      position->y() = y + initial_offset(generator);
+      graph->addVariable(position);
+      positions.push_back(position);
+      true_positions.emplace_back(x, y);
+
+      for (const auto & beacon : beacons) {
+        double range = std::hypot(beacon->x() - x, beacon->y() - y) + noise(generator);
+        if (unit(generator) < outlier_ratio) {
+          range += outlier_offset(generator);
+        }
+        auto constraint = fuse_tutorials::RangeConstraint::make_shared(
+          "benchmark", *position, *beacon, range, kSigma);
+        constraint->loss(loss);
+        graph->addConstraint(constraint);
+      }
+    }
+  }
+
+  /**
+   * @brief The root mean square error of the robot positions
+   */
+  double positionError() const
+  {
+    double sum = 0.0;
+    for (size_t i = 0; i < positions.size(); ++i) {
+      sum += std::pow(positions[i]->x() - true_positions[i].first, 2) +
+        std::pow(positions[i]->y() - true_positions[i].second, 2);
+    }
+    return std::sqrt(sum / positions.size());
+  }
+
+  /**
+   * @brief Optimize problems built with \p make_loss and report the solver iterations and the
+   *        position error
+   */
+  template<typename MakeLoss>
+  void run(benchmark::State & state, MakeLoss make_loss)
+  {
+    const double outlier_ratio = state.range(0) / 100.0;
+    ceres::Solver::Options options;
+    options.max_num_iterations = 100;
+    double iterations = 0.0;
+    double error = 0.0;
+    for (auto _ : state) {
+      state.PauseTiming();
+      build(outlier_ratio, make_loss());
+      state.ResumeTiming();
+
+      const auto summary = graph->optimize(options);
+
+      state.PauseTiming();
+      iterations += summary.num_successful_steps + summary.num_unsuccessful_steps;
+      error += positionError();
+      state.ResumeTiming();
+    }
+    state.counters["iterations"] =
+      benchmark::Counter(iterations, benchmark::Counter::kAvgIterations);
+    state.counters["rmse"] = benchmark::Counter(error, benchmark::Counter::kAvgIterations);
+  }
+
+  std::unique_ptr<fuse_graphs::HashGraph> graph;
+  std::vector<fuse_variables::Position2DStamped::SharedPtr> positions;
+  std::vector<std::pair<double, double>> true_positions;
+};
+
+BENCHMARK_DEFINE_F(RangeOutliersBenchmarkFixture, GemanMcClure)(benchmark::State & state)
+{
+  run(
+    state, []() {
+      return fuse_loss::GemanMcClureLoss::make_shared(1.0);
+    });
+}
+
+BENCHMARK_REGISTER_F(RangeOutliersBenchmarkFixture, GemanMcClure)
+->Arg(0)->Arg(10)->Arg(20)->Arg(30)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(RangeOutliersBenchmarkFixture, GNCGemanMcClure)(benchmark::State & state)
+{
+  run(
+    state, []() {
+      return fuse_loss::GNCLoss::make_shared(
+        100.0, 2.0, fuse_loss::GemanMcClureLoss::make_shared(1.0));
+    });
+}
+
+BENCHMARK_REGISTER_F(RangeOutliersBenchmarkFixture, GNCGemanMcClure)
+->Arg(0)->Arg(10)->Arg(20)->Arg(30)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
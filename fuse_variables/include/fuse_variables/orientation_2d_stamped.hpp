@@ -37,6 +37,7 @@
 #include <ostream>
 
 #include <fuse_core/local_parameterization.hpp>
+#include <fuse_core/manifold.hpp>
 #include <fuse_core/serialization.hpp>
 #include <fuse_core/util.hpp>
 #include <fuse_core/uuid.hpp>
@@ -128,6 +129,61 @@ private:
   }
 };
 
+#if CERES_SUPPORTS_MANIFOLDS
+/**
+ * @brief A Manifold class for 2D Orientations.
+ *
+ * This exposes the closed-form operations of Orientation2DLocalParameterization through the
+ * ceres::Manifold interface, allowing Ceres to evaluate the manifold directly.
+ */
+class Orientation2DManifold : public fuse_core::Manifold
+{
+public:
+  int AmbientSize() const override
+  {
+    return 1;
+  }
+
+  int TangentSize() const override
+  {
+    return 1;
+  }
+
+  bool Plus(
+    const double * x,
+    const double * delta,
+    double * x_plus_delta) const override
+  {
+    return local_parameterization_.Plus(x, delta, x_plus_delta);
+  }
+
+  bool PlusJacobian(
+    const double * x,
+    double * jacobian) const override
+  {
+    return local_parameterization_.ComputeJacobian(x, jacobian);
+  }
+
+  bool Minus(
+    const double * y,
+    const double * x,
+    double * y_minus_x) const override
+  {
+    return local_parameterization_.Minus(x, y, y_minus_x);
+  }
+
+  bool MinusJacobian(
+    const double * x,
+    double * jacobian) const override
+  {
+    return local_parameterization_.ComputeMinusJacobian(x, jacobian);
+  }
+
+private:
+  Orientation2DLocalParameterization local_parameterization_;  //!< The closed-form implementation
+};
+#endif
+
 /**
  * @brief Variable representing a 2D orientation (theta) at a specific time, with a specific piece
  *        of hardware.
@@ -200,6 +256,23 @@ public:
    */
   fuse_core::LocalParameterization * localParameterization() const override;
 
+  /**
+   * @brief Access the shared Ceres local parameterization object to apply to updates of this
+   *        variable
+   *
+   * @return A base pointer to the shared Orientation2DLocalParameterization instance
+   */
+  fuse_core::LocalParameterization * sharedLocalParameterization() const override;
+
+#if CERES_SUPPORTS_MANIFOLDS
+  /**
+   * @brief Access the shared Ceres manifold object to apply to updates of this variable
+   *
+   * @return A base pointer to an instance of Orientation2DManifold
+   */
+  fuse_core::Manifold * manifold() const override;
+#endif
+
 private:
   // Allow Boost Serialization access to private methods
   friend class boost::serialization::access;
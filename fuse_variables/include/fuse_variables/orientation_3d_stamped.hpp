@@ -39,6 +39,7 @@
 #include <ostream>
 
 #include <fuse_core/local_parameterization.hpp>
+#include <fuse_core/manifold.hpp>
 #include <fuse_core/serialization.hpp>
 #include <fuse_core/util.hpp>
 #include <fuse_core/uuid.hpp>
@@ -165,6 +166,61 @@ private:
   }
 };
 
+#if CERES_SUPPORTS_MANIFOLDS
+/**
+ * @brief A Manifold class for 3D Orientations.
+ *
+ * This exposes the closed-form operations of Orientation3DLocalParameterization through the
+ * ceres::Manifold interface, allowing Ceres to evaluate the manifold directly.
+ */
+class Orientation3DManifold : public fuse_core::Manifold
+{
+public:
+  int AmbientSize() const override
+  {
+    return 4;
+  }
+
+  int TangentSize() const override
+  {
+    return 3;
+  }
+
+  bool Plus(
+    const double * x,
+    const double * delta,
+    double * x_plus_delta) const override
+  {
+    return local_parameterization_.Plus(x, delta, x_plus_delta);
+  }
+
+  bool PlusJacobian(
+    const double * x,
+    double * jacobian) const override
+  {
+    return local_parameterization_.ComputeJacobian(x, jacobian);
+  }
+
+  bool Minus(
+    const double * y,
+    const double * x,
+    double * y_minus_x) const override
+  {
+    return local_parameterization_.Minus(x, y, y_minus_x);
+  }
+
+  bool MinusJacobian(
+    const double * x,
+    double * jacobian) const override
+  {
+    return local_parameterization_.ComputeMinusJacobian(x, jacobian);
+  }
+
+private:
+  Orientation3DLocalParameterization local_parameterization_;  //!< The closed-form implementation
+};
+#endif
+
 /**
  * @brief Variable representing a 3D orientation as a quaternion at a specific time and for a
  *        specific piece of hardware (e.g., robot)
@@ -296,6 +352,22 @@ public:
    */
   fuse_core::LocalParameterization * localParameterization() const override;
 
+  /**
+   * @brief Access the shared Ceres local parameterization object for the quaternion
+   *
+   * @return A base pointer to the shared Orientation3DLocalParameterization instance
+   */
+  fuse_core::LocalParameterization * sharedLocalParameterization() const override;
+
+#if CERES_SUPPORTS_MANIFOLDS
+  /**
+   * @brief Access the shared Ceres manifold object to apply to updates of this variable
+   *
+   * @return A base pointer to an instance of Orientation3DManifold
+   */
+  fuse_core::Manifold * manifold() const override;
+#endif
+
 private:
   // Allow Boost Serialization access to private methods
   friend class boost::serialization::access;
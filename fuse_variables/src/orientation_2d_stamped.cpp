@@ -35,6 +35,7 @@
 
 #include <boost/serialization/export.hpp>
 #include <fuse_core/local_parameterization.hpp>
+#include <fuse_core/manifold.hpp>
 #include <fuse_core/uuid.hpp>
 #include <fuse_variables/fixed_size_variable.hpp>
 #include <fuse_variables/orientation_2d_stamped.hpp>
@@ -69,6 +70,20 @@ fuse_core::LocalParameterization * Orientation2DStamped::localParameterization()
   return new Orientation2DLocalParameterization();
 }
 
+fuse_core::LocalParameterization * Orientation2DStamped::sharedLocalParameterization() const
+{
+  static auto * const local_parameterization = new Orientation2DLocalParameterization();
+  return local_parameterization;
+}
+
+#if CERES_SUPPORTS_MANIFOLDS
+fuse_core::Manifold * Orientation2DStamped::manifold() const
+{
+  static auto * const manifold = new Orientation2DManifold();
+  return manifold;
+}
+#endif
+
 }  // namespace fuse_variables
 
 BOOST_CLASS_EXPORT_IMPLEMENT(fuse_variables::Orientation2DLocalParameterization);
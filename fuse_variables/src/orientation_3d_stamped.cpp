@@ -35,6 +35,7 @@
 
 #include <boost/serialization/export.hpp>
 #include <fuse_core/local_parameterization.hpp>
+#include <fuse_core/manifold.hpp>
 #include <fuse_core/uuid.hpp>
 #include <fuse_variables/fixed_size_variable.hpp>
 #include <fuse_variables/orientation_3d_stamped.hpp>
@@ -72,6 +73,20 @@ fuse_core::LocalParameterization * Orientation3DStamped::localParameterization()
   return new Orientation3DLocalParameterization();
 }
 
+fuse_core::LocalParameterization * Orientation3DStamped::sharedLocalParameterization() const
+{
+  static auto * const local_parameterization = new Orientation3DLocalParameterization();
+  return local_parameterization;
+}
+
+#if CERES_SUPPORTS_MANIFOLDS
+fuse_core::Manifold * Orientation3DStamped::manifold() const
+{
+  static auto * const manifold = new Orientation3DManifold();
+  return manifold;
+}
+#endif
+
 }  // namespace fuse_variables
 
 BOOST_CLASS_EXPORT_IMPLEMENT(fuse_variables::Orientation3DLocalParameterization);
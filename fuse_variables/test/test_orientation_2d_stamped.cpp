@@ -226,6 +226,23 @@ TEST(Orientation2DStamped, MinusJacobian)
   delete parameterization;
 }
 
+TEST(Orientation2DStamped, SharedLocalParameterization)
+{
+  auto parameterization = Orientation2DStamped(rclcpp::Time(0, 0)).sharedLocalParameterization();
+  ASSERT_NE(nullptr, parameterization);
+  EXPECT_EQ(
+    parameterization,
+    Orientation2DStamped(rclcpp::Time(1, 0)).sharedLocalParameterization());
+  EXPECT_EQ(1, parameterization->GlobalSize());
+  EXPECT_EQ(1, parameterization->LocalSize());
+
+  double x[1] = {3.0};
+  double delta[1] = {0.5};
+  double actual[1] = {0.0};
+  EXPECT_TRUE(parameterization->Plus(x, delta, actual));
+  EXPECT_NEAR(3.5 - 2 * M_PI, actual[0], 1.0e-5);
+}
+
 struct CostFunctor
 {
   CostFunctor() {}
@@ -237,6 +254,37 @@ struct CostFunctor
   }
 };
 
+#if CERES_SUPPORTS_MANIFOLDS
+TEST(Orientation2DStamped, Manifold)
+{
+  Orientation2DStamped orientation(rclcpp::Time(0, 0));
+  auto manifold = orientation.manifold();
+  ASSERT_NE(nullptr, manifold);
+  EXPECT_EQ(manifold, Orientation2DStamped(rclcpp::Time(1, 0)).manifold());
+  EXPECT_EQ(1, manifold->AmbientSize());
+  EXPECT_EQ(1, manifold->TangentSize());
+
+  // Plus handles the 2*Pi rollover
+  double x1[1] = {3.0};
+  double delta[1] = {0.5};
+  double x2[1] = {0.0};
+  EXPECT_TRUE(manifold->Plus(x1, delta, x2));
+  EXPECT_NEAR(3.5 - 2 * M_PI, x2[0], 1.0e-5);
+
+  // ceres::Manifold::Minus(y, x) is the difference from x to y
+  double actual_delta[1] = {0.0};
+  EXPECT_TRUE(manifold->Minus(x2, x1, actual_delta));
+  EXPECT_NEAR(0.5, actual_delta[0], 1.0e-5);
+
+  double jacobian[1] = {0.0};
+  EXPECT_TRUE(manifold->PlusJacobian(x1, jacobian));
+  EXPECT_EQ(1.0, jacobian[0]);
+  jacobian[0] = 0.0;
+  EXPECT_TRUE(manifold->MinusJacobian(x1, jacobian));
+  EXPECT_EQ(1.0, jacobian[0]);
+}
+#endif
+
 TEST(Orientation2DStamped, Optimization)
 {
   // Create a Orientation2DStamped
@@ -44,6 +44,7 @@
 
 #include <fuse_core/autodiff_local_parameterization.hpp>
 #include <fuse_core/eigen.hpp>
+#include <fuse_core/eigen_gtest.hpp>
 #include <fuse_core/serialization.hpp>
 #include <fuse_variables/orientation_3d_stamped.hpp>
 #include <fuse_variables/stamped.hpp>
@@ -266,6 +267,67 @@ TEST(Orientation3DStamped, MinusJacobian)
   delete parameterization;
 }
 
+TEST(Orientation3DStamped, SharedLocalParameterization)
+{
+  auto parameterization = Orientation3DStamped(rclcpp::Time(0, 0)).sharedLocalParameterization();
+  ASSERT_NE(nullptr, parameterization);
+  EXPECT_EQ(
+    parameterization,
+    Orientation3DStamped(rclcpp::Time(1, 0)).sharedLocalParameterization());
+  EXPECT_EQ(4, parameterization->GlobalSize());
+  EXPECT_EQ(3, parameterization->LocalSize());
+
+  double x[4] = {0.842614977, 0.2, 0.3, 0.4};
+  double delta[3] = {0.15, -0.2, 0.433012702};
+  double result[4] = {0.0, 0.0, 0.0, 0.0};
+  EXPECT_TRUE(parameterization->Plus(x, delta, result));
+  EXPECT_NEAR(0.745561, result[0], 1.0e-5);
+  EXPECT_NEAR(0.360184, result[1], 1.0e-5);
+  EXPECT_NEAR(0.194124, result[2], 1.0e-5);
+  EXPECT_NEAR(0.526043, result[3], 1.0e-5);
+}
+
+#if CERES_SUPPORTS_MANIFOLDS
+TEST(Orientation3DStamped, Manifold)
+{
+  Orientation3DStamped orientation(rclcpp::Time(0, 0));
+  auto manifold = orientation.manifold();
+  auto parameterization = orientation.sharedLocalParameterization();
+  ASSERT_NE(nullptr, manifold);
+  EXPECT_EQ(manifold, Orientation3DStamped(rclcpp::Time(1, 0)).manifold());
+  EXPECT_EQ(4, manifold->AmbientSize());
+  EXPECT_EQ(3, manifold->TangentSize());
+
+  double x1[4] = {0.842614977, 0.2, 0.3, 0.4};
+  double delta[3] = {0.15, -0.2, 0.433012702};
+  double x2[4] = {0.0, 0.0, 0.0, 0.0};
+  EXPECT_TRUE(manifold->Plus(x1, delta, x2));
+  EXPECT_NEAR(0.745561, x2[0], 1.0e-5);
+  EXPECT_NEAR(0.360184, x2[1], 1.0e-5);
+  EXPECT_NEAR(0.194124, x2[2], 1.0e-5);
+  EXPECT_NEAR(0.526043, x2[3], 1.0e-5);
+
+  // ceres::Manifold::Minus(y, x) is the difference from x to y
+  double actual_delta[3] = {0.0, 0.0, 0.0};
+  EXPECT_TRUE(manifold->Minus(x2, x1, actual_delta));
+  EXPECT_NEAR(delta[0], actual_delta[0], 1.0e-5);
+  EXPECT_NEAR(delta[1], actual_delta[1], 1.0e-5);
+  EXPECT_NEAR(delta[2], actual_delta[2], 1.0e-5);
+
+  fuse_core::Matrix<double, 4, 3> expected_plus_jacobian;
+  fuse_core::Matrix<double, 4, 3> actual_plus_jacobian;
+  parameterization->ComputeJacobian(x1, expected_plus_jacobian.data());
+  EXPECT_TRUE(manifold->PlusJacobian(x1, actual_plus_jacobian.data()));
+  EXPECT_MATRIX_EQ(expected_plus_jacobian, actual_plus_jacobian);
+
+  fuse_core::Matrix<double, 3, 4> expected_minus_jacobian;
+  fuse_core::Matrix<double, 3, 4> actual_minus_jacobian;
+  parameterization->ComputeMinusJacobian(x1, expected_minus_jacobian.data());
+  EXPECT_TRUE(manifold->MinusJacobian(x1, actual_minus_jacobian.data()));
+  EXPECT_MATRIX_EQ(expected_minus_jacobian, actual_minus_jacobian);
+}
+#endif
+
 TEST(Orientation3DStamped, Stamped)
 {
   fuse_core::Variable::SharedPtr base = Orientation3DStamped::make_shared(